@@ -18,10 +18,23 @@ _ADV_TYPE_UUID16_MORE = const(0x2)
 _ADV_TYPE_UUID32_MORE = const(0x4)
 _ADV_TYPE_UUID128_MORE = const(0x6)
 _ADV_TYPE_APPEARANCE = const(0x19)
+_ADV_TYPE_MANUFACTURER = const(0xFF)
+
+# Compact beacon data, carried as manufacturer specific data (all little-endian):
+#   2 bytes company id (0xFFFF, reserved for internal use)
+#   1 byte format version
+#   2 bytes beacon id (ASCII, e.g. "b1")
+#   2 bytes X position in centimetres (unsigned)
+#   2 bytes Y position in centimetres (unsigned)
+#   1 byte calibrated Tx power in dBm (signed)
+#   1 byte sequence number, incremented on each payload update
+_BEACON_COMPANY_ID = const(0xFFFF)
+_BEACON_VERSION = const(0x01)
+_BEACON_FORMAT = "<HB2sHHbB"
 
 
 # Generate a payload to be passed to gap_advertise(adv_data=...).
-def advertising_payload(limited_disc=False, br_edr=False, name=None, services=None, appearance=0):
+def advertising_payload(limited_disc=False, br_edr=False, name=None, services=None, appearance=0, manufacturer=None):
     payload = bytearray()
 
     def _append(adv_type, value):
@@ -36,6 +49,9 @@ def advertising_payload(limited_disc=False, br_edr=False, name=None, services=No
     if name:
         _append(_ADV_TYPE_NAME, name)
 
+    if manufacturer:
+        _append(_ADV_TYPE_MANUFACTURER, manufacturer)
+
     if services:
         for uuid in services:
             b = bytes(uuid)
@@ -53,6 +69,13 @@ def advertising_payload(limited_disc=False, br_edr=False, name=None, services=No
     return payload
 
 
+# Generate the compact beacon data to be passed to advertising_payload(manufacturer=...).
+def beacon_data(beacon_id, x, y, tx_power, sequence):
+    return struct.pack(
+        _BEACON_FORMAT, _BEACON_COMPANY_ID, _BEACON_VERSION, beacon_id, x, y, tx_power, sequence & 0xFF
+    )
+
+
 def decode_field(payload, adv_type):
     i = 0
     result = []
@@ -79,7 +102,24 @@ def decode_services(payload):
     return services
 
 
+def decode_beacon(payload):
+    for m in decode_field(payload, _ADV_TYPE_MANUFACTURER):
+        if len(m) >= struct.calcsize(_BEACON_FORMAT):
+            company_id, version, beacon_id, x, y, tx_power, sequence = struct.unpack(
+                _BEACON_FORMAT, m[: struct.calcsize(_BEACON_FORMAT)]
+            )
+            if company_id == _BEACON_COMPANY_ID and version == _BEACON_VERSION:
+                return str(beacon_id, "utf-8"), x, y, tx_power, sequence
+    return None
+
+
 def demo():
+    payload = advertising_payload(
+        services=[bluetooth.UUID(0x181A)], manufacturer=beacon_data(b"b1", 30000, 40000, -60, 0)
+    )
+    print(payload)
+    print(decode_beacon(payload))
+
     payload = advertising_payload(
         name="micropython",
         services=[bluetooth.UUID(0x181A), bluetooth.UUID("6E400001-B5A3-F393-E0A9-E50E24DCCA9E")],
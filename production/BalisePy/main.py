@@ -7,7 +7,7 @@ import bluetooth
 import random
 import struct
 import time
-from ble_advertising import advertising_payload
+from ble_advertising import advertising_payload, beacon_data
 
 from micropython import const
 
@@ -35,18 +35,47 @@ _ENV_SENSE_SERVICE = (
 _ADV_APPEARANCE_GENERIC_THERMOMETER = const(768)
 
 
+# The calibrated Tx power of the beacon, in dBm.
+_TX_POWER = const(-60)
+
+
 class BLETemperature:
-    def __init__(self, ble, name="b1x30000y40000"):
+    # The beacon id and its position in centimetres. With compact=False, the position is advertised
+    # as text in the device name ("b1x30000y40000"), the format read by older receivers.
+    def __init__(self, ble, beacon_id="b1", x=30000, y=40000, compact=True):
         self._ble = ble
         self._ble.active(True)
         self._ble.irq(self._irq)
         ((self._handle,),) = self._ble.gatts_register_services((_ENV_SENSE_SERVICE,))
         self._connections = set()
-        self._payload = advertising_payload(
-            name=name, services=[_ENV_SENSE_UUID], appearance=_ADV_APPEARANCE_GENERIC_THERMOMETER
-        )
+        self._beacon = (beacon_id, x, y)
+        self._compact = compact
+        self._sequence = 0
+        self._update_payload()
         self._advertise()
 
+    def _update_payload(self):
+        beacon_id, x, y = self._beacon
+        if self._compact:
+            self._payload = advertising_payload(
+                services=[_ENV_SENSE_UUID],
+                appearance=_ADV_APPEARANCE_GENERIC_THERMOMETER,
+                manufacturer=beacon_data(beacon_id.encode(), x, y, _TX_POWER, self._sequence),
+            )
+        else:
+            self._payload = advertising_payload(
+                name="%sx%05dy%05d" % (beacon_id, x, y),
+                services=[_ENV_SENSE_UUID],
+                appearance=_ADV_APPEARANCE_GENERIC_THERMOMETER,
+            )
+
+    def next_sequence(self):
+        # Advertise the next sequence number, so the receiver can tell lost advertisements apart.
+        if self._compact:
+            self._sequence = (self._sequence + 1) & 0xFF
+            self._update_payload()
+            self._advertise()
+
     def _irq(self, event, data):
         # Track connections so we can send notifications.
         if event == _IRQ_CENTRAL_CONNECT:
@@ -88,6 +117,7 @@ def demo():
         # Write every second, notify every 10 seconds.
         i = (i + 1) % 10
         temp.set_temperature(t, notify=i == 0, indicate=False)
+        temp.next_sequence()
         # Random walk the temperature.
         t += random.uniform(-0.5, 0.5)
         time.sleep_ms(1000)
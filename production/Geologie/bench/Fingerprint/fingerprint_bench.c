@@ -0,0 +1,211 @@
+/**
+ * @file fingerprint_bench.c
+ *
+ * @brief Mesure la duree d'une localisation par Fingerprint sur des cartes radio de 25 a 100 000 empreintes.
+ *
+ * Les empreintes sont relevees sans bruit sur une grille reguliere d'une piece de 10 m de cote dont les balises sont
+ * reparties sur les murs ; leur puissance est donnee par le modele d'attenuation de Mathematician. Pour chaque
+ * taille de carte, la construction puis les recherches depuis des positions tirees au hasard sont mesurees, avec
+ * l'ecart moyen a la position simulee.
+ *
+ * Usage : fingerprint_bench.out [-n recherches] [-b balises] [-k voisins]
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Fingerprint/fingerprint.c"
+#include "MathematicianLOG/mathematicianLOG.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de recherches mesurees par defaut pour chaque carte.
+ */
+#define NB_QUERIES_DEFAULT (10000)
+
+/**
+ * @brief Le nombre de balises par defaut.
+ */
+#define NB_BEACONS_DEFAULT (16)
+
+/**
+ * @brief Le nombre de voisins par defaut.
+ */
+#define NB_NEIGHBOURS_DEFAULT (4)
+
+/**
+ * @brief Le nombre maximal de balises.
+ */
+#define NB_BEACONS_MAX (64)
+
+/**
+ * @brief Le cote de la piece simulee, en centimetre.
+ */
+#define ROOM_SIZE (1000)
+
+/**
+ * @brief Le coefficient d'attenuation des balises simulees.
+ */
+#define COEFFICIENT_BENCH (2)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de positions de calibration par cote des grilles mesurees.
+ */
+static const uint32_t GRID_SIZES_BENCH[] = { 5, 32, 100, 317 };
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Mesure une taille de carte et affiche la duree des recherches.
+ *
+ * @param gridSize Le nombre de positions de calibration par cote.
+ * @param nbQueries Le nombre de recherches.
+ * @param nbBeacons Le nombre de balises.
+ */
+static void benchConfiguration(uint32_t gridSize, uint32_t nbQueries, uint32_t nbBeacons);
+
+/**
+ * @brief Remplit les balises recues sans bruit depuis une position.
+ */
+static void makeBeaconsData(const Position* robot, BeaconData* beaconsData, uint32_t nbBeacons);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[]) {
+    uint32_t nbQueries = NB_QUERIES_DEFAULT;
+    uint32_t nbBeacons = NB_BEACONS_DEFAULT;
+    uint8_t nbNeighboursBench = NB_NEIGHBOURS_DEFAULT;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:b:k:")) != -1) {
+        switch (option) {
+            case 'n':
+                nbQueries = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+            case 'b':
+                nbBeacons = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+            case 'k':
+                nbNeighboursBench = (uint8_t) atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-n queries] [-b beacons] [-k neighbours]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (nbQueries == 0 || nbBeacons < NB_BEACONS_POSITION || nbBeacons > NB_BEACONS_MAX || nbNeighboursBench == 0) {
+        fprintf(stderr, "At least 1 query, %d to %d beacons and 1 neighbour\n", NB_BEACONS_POSITION, NB_BEACONS_MAX);
+        return EXIT_FAILURE;
+    }
+
+    Fingerprint_setNbNeighbours(nbNeighboursBench);
+    for (uint8_t g = 0; g < sizeof(GRID_SIZES_BENCH) / sizeof(GRID_SIZES_BENCH[0]); g++) {
+        benchConfiguration(GRID_SIZES_BENCH[g], nbQueries, nbBeacons);
+    }
+    Fingerprint_free();
+
+    return EXIT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void benchConfiguration(uint32_t gridSize, uint32_t nbQueries, uint32_t nbBeacons) {
+    BeaconData beaconsData[NB_BEACONS_MAX];
+    double sumErrors = 0;
+    uint32_t nbPositions = 0;
+    uint32_t randomState = 0x9E3779B9U;
+    struct timespec start;
+    struct timespec built;
+    struct timespec stop;
+
+    /* Les balises sont reparties regulierement sur le tour de la piece */
+    for (uint32_t b = 0; b < nbBeacons; b++) {
+        uint32_t perimeter = 4 * ROOM_SIZE * b / nbBeacons;
+        uint32_t side = perimeter / ROOM_SIZE;
+        uint32_t offset = perimeter % ROOM_SIZE;
+
+        beaconsData[b].index = (BeaconIndex) b;
+        beaconsData[b].position.X = side == 0 ? offset : (side == 1 ? ROOM_SIZE : (side == 2 ? ROOM_SIZE - offset : 0));
+        beaconsData[b].position.Y = side == 0 ? 0 : (side == 1 ? offset : (side == 2 ? ROOM_SIZE : ROOM_SIZE - offset));
+        beaconsData[b].coefficientAverage = COEFFICIENT_BENCH;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < gridSize; i++) {
+        for (uint32_t j = 0; j < gridSize; j++) {
+            const Position position = { .X = (2 * i + 1) * ROOM_SIZE / (2 * gridSize), .Y = (2 * j + 1) * ROOM_SIZE / (2 * gridSize) };
+            makeBeaconsData(&position, beaconsData, nbBeacons);
+            Fingerprint_addReference(&position, beaconsData, nbBeacons);
+        }
+    }
+    if (Fingerprint_build() < 0) {
+        fprintf(stderr, "Fail to build a radio map of %u references\n", gridSize * gridSize);
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &built);
+
+    for (uint32_t q = 0; q < nbQueries; q++) {
+        Position robot;
+        Position position;
+
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        robot.X = (randomState >> 16) % ROOM_SIZE;
+        robot.Y = (randomState & 0xFFFF) % ROOM_SIZE;
+        makeBeaconsData(&robot, beaconsData, nbBeacons);
+        if (Fingerprint_getCurrentPosition(beaconsData, nbBeacons, &position) == 0) {
+            sumErrors += hypot((double) position.X - robot.X, (double) position.Y - robot.Y);
+            nbPositions++;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    double buildDuration = (double) (built.tv_sec - start.tv_sec) + (double) (built.tv_nsec - start.tv_nsec) / 1e9;
+    double duration = (double) (stop.tv_sec - built.tv_sec) + (double) (stop.tv_nsec - built.tv_nsec) / 1e9;
+    fprintf(stdout, "%7u references %2u beacons  built in %8.3f ms  %7u queries in %7.3f s  %8.2f us/query  error %6.1f cm\n",
+            gridSize * gridSize, nbBeacons, buildDuration * 1e3, nbQueries, duration, duration * 1e6 / nbQueries,
+            nbPositions > 0 ? sumErrors / nbPositions : 0);
+}
+
+static void makeBeaconsData(const Position* robot, BeaconData* beaconsData, uint32_t nbBeacons) {
+    for (uint32_t b = 0; b < nbBeacons; b++) {
+        beaconsData[b].power = Mathematician_getPower(&beaconsData[b].position, robot, &beaconsData[b].coefficientAverage);
+    }
+}
@@ -0,0 +1,194 @@
+/**
+ * @file particleFilter_bench.c
+ *
+ * @brief Mesure le debit du filtre particulaire de ParticleFilter a 1 000, 10 000 et 100 000 particules.
+ *
+ * Le robot simule parcourt un cercle dans une piece de 10 m de cote dont les balises sont reparties sur les murs ;
+ * leur puissance est donnee par le modele d'attenuation de Mathematician. Chaque nombre de particules est mesure
+ * avec un thread puis avec le groupe de threads, en cycles par seconde et en particules par seconde, pour comparer
+ * l'hote et la carte. L'ecart moyen a la position simulee est affiche avec le debit.
+ *
+ * Usage : particleFilter_bench.out [-n cycles] [-b balises] [-j fils]
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ParticleFilter/particleFilter.c"
+#include "MathematicianLOG/mathematicianLOG.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de cycles de position mesures par defaut pour chaque configuration.
+ */
+#define NB_CYCLES_DEFAULT (200)
+
+/**
+ * @brief Le nombre de balises par defaut.
+ */
+#define NB_BEACONS_DEFAULT (8)
+
+/**
+ * @brief La duree d'un cycle simule, en nanoseconde.
+ */
+#define CYCLE_DURATION (250000000ULL)
+
+/**
+ * @brief Le cote de la piece simulee, en centimetre.
+ */
+#define ROOM_SIZE (1000)
+
+/**
+ * @brief Le coefficient d'attenuation des balises simulees.
+ */
+#define COEFFICIENT_BENCH (2)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les nombres de particules mesures.
+ */
+static const uint32_t NB_PARTICLES_BENCH[] = { 1000, 10000, 100000 };
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Mesure une configuration et affiche son debit.
+ *
+ * @param nbParticlesBench Le nombre de particules.
+ * @param nbWorkersBench Le nombre de threads.
+ * @param nbCycles Le nombre de cycles de position.
+ * @param nbBeacons Le nombre de balises.
+ */
+static void benchConfiguration(uint32_t nbParticlesBench, uint8_t nbWorkersBench, uint32_t nbCycles, uint32_t nbBeacons);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[]) {
+    uint32_t nbCycles = NB_CYCLES_DEFAULT;
+    uint32_t nbBeacons = NB_BEACONS_DEFAULT;
+    long nbCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint8_t nbWorkersBench = nbCpus > PARTICLE_FILTER_NB_WORKERS_MAX ? PARTICLE_FILTER_NB_WORKERS_MAX : (nbCpus > 0 ? (uint8_t) nbCpus : 1);
+    int option;
+
+    while ((option = getopt(argc, argv, "n:b:j:")) != -1) {
+        switch (option) {
+            case 'n':
+                nbCycles = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+            case 'b':
+                nbBeacons = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                nbWorkersBench = (uint8_t) atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-n cycles] [-b beacons] [-j threads]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (nbCycles == 0 || nbBeacons < NB_BEACONS_POSITION || nbBeacons > PARTICLE_FILTER_NB_BEACONS_MAX || nbWorkersBench == 0) {
+        fprintf(stderr, "At least 1 cycle, %d to %d beacons and 1 thread\n", NB_BEACONS_POSITION, PARTICLE_FILTER_NB_BEACONS_MAX);
+        return EXIT_FAILURE;
+    }
+
+    for (uint8_t p = 0; p < sizeof(NB_PARTICLES_BENCH) / sizeof(NB_PARTICLES_BENCH[0]); p++) {
+        benchConfiguration(NB_PARTICLES_BENCH[p], 1, nbCycles, nbBeacons);
+        if (nbWorkersBench > 1) {
+            benchConfiguration(NB_PARTICLES_BENCH[p], nbWorkersBench, nbCycles, nbBeacons);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void benchConfiguration(uint32_t nbParticlesBench, uint8_t nbWorkersBench, uint32_t nbCycles, uint32_t nbBeacons) {
+    const AttenuationCoefficient coefficient = COEFFICIENT_BENCH;
+    BeaconData beaconsData[PARTICLE_FILTER_NB_BEACONS_MAX];
+    uint64_t captureTime = 1000000000ULL;
+    double sumErrors = 0;
+    uint32_t nbPositions = 0;
+    struct timespec start;
+    struct timespec stop;
+
+    ParticleFilter_setNbParticles(nbParticlesBench);
+    ParticleFilter_setNbWorkers(nbWorkersBench);
+    if (ParticleFilter_new() < 0) {
+        fprintf(stderr, "Fail to allocate %u particles\n", nbParticlesBench);
+        return;
+    }
+
+    /* Les balises sont reparties regulierement sur le tour de la piece */
+    for (uint32_t b = 0; b < nbBeacons; b++) {
+        uint32_t perimeter = 4 * ROOM_SIZE * b / nbBeacons;
+        uint32_t side = perimeter / ROOM_SIZE;
+        uint32_t offset = perimeter % ROOM_SIZE;
+
+        beaconsData[b].index = (BeaconIndex) b;
+        beaconsData[b].position.X = side == 0 ? offset : (side == 1 ? ROOM_SIZE : (side == 2 ? ROOM_SIZE - offset : 0));
+        beaconsData[b].position.Y = side == 0 ? 0 : (side == 1 ? offset : (side == 2 ? ROOM_SIZE : ROOM_SIZE - offset));
+        beaconsData[b].coefficientAverage = coefficient;
+        beaconsData[b].rssiVariance = MATHEMATICIAN_RSSI_VARIANCE_MIN;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t cycle = 0; cycle < nbCycles; cycle++) {
+        /* Un tour de 3 m de rayon en 100 cycles, soit 75 cm/s */
+        double angle = 2 * M_PI * cycle / 100;
+        Position robot = { .X = (uint32_t) (ROOM_SIZE / 2 + 300 * cos(angle)), .Y = (uint32_t) (ROOM_SIZE / 2 + 300 * sin(angle)) };
+        Position position;
+
+        captureTime += CYCLE_DURATION;
+        for (uint32_t b = 0; b < nbBeacons; b++) {
+            beaconsData[b].power = Mathematician_getPower(&beaconsData[b].position, &robot, &coefficient);
+            beaconsData[b].timestamp = captureTime;
+        }
+        if (ParticleFilter_getCurrentPosition(beaconsData, nbBeacons, &position) == 0) {
+            sumErrors += hypot((double) position.X - robot.X, (double) position.Y - robot.Y);
+            nbPositions++;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    ParticleFilter_free();
+
+    double duration = (double) (stop.tv_sec - start.tv_sec) + (double) (stop.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stdout, "%7u particles %u thread(s) %6u cycles in %7.3f s  %9.1f cycles/s  %8.3f ms/cycle  %7.1f Mparticles/s  error %6.1f cm\n",
+            nbParticlesBench, nbWorkersBench, nbCycles, duration, nbCycles / duration, duration * 1e3 / nbCycles,
+            (double) nbParticlesBench * nbCycles / duration / 1e6, nbPositions > 0 ? sumErrors / nbPositions : 0);
+}
@@ -0,0 +1,466 @@
+/**
+ * @file translatorBeacon_bench.c
+ *
+ * @brief Mesure le debit de traduction des rapports d'annonce par TranslatorBeacon.
+ *
+ * Les evenements HCI sont construits en memoire (balises au format texte et compact, iBeacon enregistre, telephones,
+ * annonces etendues) ou lus dans des captures btsnoop ou pcap, puis traduits en boucle comme le fait Receiver.
+ * Le debit est donne en rapports par seconde et en nanoseconde par rapport, pour comparer l'hote et la carte.
+ *
+ * Usage : translatorBeacon_bench.out [-n rapports] [-r capture]...
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "TranslatorBeacon/translatorBeacon.c"
+#include "Replayer/replayer.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de rapports traduits par defaut pour chaque mesure.
+ */
+#define NB_REPORTS_DEFAULT (10000000)
+
+/**
+ * @brief Le nombre d'evenements synthetiques, tous differents, parcourus en boucle.
+ */
+#define NB_SYNTHETIC_EVENTS (256)
+
+/**
+ * @brief Le nombre maximal d'evenements lus dans les captures.
+ */
+#define NB_MAX_RECORDED_EVENTS (1 << 20)
+
+/**
+ * @brief Le nombre maximal de captures donnees en parametre.
+ */
+#define NB_MAX_CAPTURES (8)
+
+/**
+ * @brief La taille d'un rapport classique sans ses donnees, RSSI compris.
+ */
+#define LEGACY_REPORT_HEADER_SIZE (LE_ADVERTISING_INFO_SIZE + 1)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Un ensemble d'evenements HCI a traduire, chacun a partir de son en-tete hci_event_hdr.
+ */
+typedef struct {
+    const uint8_t** events;
+    uint16_t* sizes;
+    uint32_t nbEvents;
+    uint32_t nbReports;     /**< Le nombre de rapports annonces par l'ensemble des evenements. */
+} EventSet;
+
+/**
+ * @brief L'iBeacon enregistre comme balise tierce, tel qu'emis.
+ */
+static const uint8_t IBEACON_IDENTIFIER[TRANSLATOR_BEACON_IDENTIFIER_SIZE] = {
+    0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB, 0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0, 0x00, 0x01, 0x00, 0x02
+};
+
+/**
+ * @brief Accumule les champs traduits pour que la traduction ne soit pas retiree par l'optimiseur.
+ */
+static volatile uint32_t sink;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ecrit les donnees d'annonce de la balise synthetique numero i, d'un format choisi par i.
+ *
+ * @param data Les donnees a remplir, au plus 31 octets.
+ * @param i Le numero de la balise.
+ * @return uint8_t La taille des donnees.
+ */
+static uint8_t buildAdvertisingData(uint8_t* data, uint32_t i);
+
+/**
+ * @brief Construit les evenements synthetiques, de 1 a 4 rapports classiques ou un rapport etendu chacun.
+ *
+ * @param eventSet L'ensemble a remplir.
+ * @return int8_t -1 si l'allocation a echoue, 0 sinon.
+ */
+static int8_t buildSyntheticEvents(EventSet* eventSet);
+
+/**
+ * @brief Lit les evenements d'annonce des captures.
+ *
+ * @param paths Les chemins des captures.
+ * @param nbPaths Le nombre de captures.
+ * @param eventSet L'ensemble a remplir, dont les evenements pointent dans les captures projetees en memoire.
+ * @return int8_t -1 si une capture ne peut etre lue, 0 sinon.
+ */
+static int8_t loadRecordedEvents(const char* const* paths, uint8_t nbPaths, EventSet* eventSet);
+
+/**
+ * @brief Traduit les evenements en boucle jusqu'a nbReports rapports avec le lot et affiche le debit.
+ *
+ * @param name Le nom de la mesure.
+ * @param eventSet Les evenements.
+ * @param nbReports Le nombre de rapports a traduire.
+ */
+static void benchBatch(const char* name, const EventSet* eventSet, uint32_t nbReports);
+
+/**
+ * @brief Traduit les evenements en boucle, un rapport a la fois avec l'API d'un rapport, et affiche le debit.
+ *
+ * @param name Le nom de la mesure.
+ * @param eventSet Les evenements.
+ * @param nbReports Le nombre de rapports a traduire.
+ */
+static void benchSingle(const char* name, const EventSet* eventSet, uint32_t nbReports);
+
+/**
+ * @brief Affiche le debit d'une mesure.
+ *
+ * @param name Le nom de la mesure.
+ * @param nbReports Le nombre de rapports traduits.
+ * @param start La date de debut de la mesure.
+ */
+static void printThroughput(const char* name, uint64_t nbReports, const struct timespec* start);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[]) {
+    const char* capturePaths[NB_MAX_CAPTURES];
+    uint8_t nbCaptures = 0;
+    uint32_t nbReports = NB_REPORTS_DEFAULT;
+    EventSet synthetic;
+    EventSet recorded;
+    ThirdPartyBeacon thirdPartyBeacon = { .format = TRANSLATOR_BEACON_IBEACON, .name = "i1", .position = { 1000, 2000 } };
+    int option;
+
+    while ((option = getopt(argc, argv, "n:r:")) != -1) {
+        switch (option) {
+            case 'n':
+                nbReports = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+            case 'r':
+                if (nbCaptures < NB_MAX_CAPTURES) {
+                    capturePaths[nbCaptures++] = optarg;
+                }
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-n reports] [-r capture]...\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    memcpy(thirdPartyBeacon.identifier, IBEACON_IDENTIFIER, TRANSLATOR_BEACON_IDENTIFIER_SIZE);
+    TranslatorBeacon_addThirdPartyBeacon(&thirdPartyBeacon);
+
+    if (buildSyntheticEvents(&synthetic) < 0) {
+        return EXIT_FAILURE;
+    }
+    benchBatch("synthetic, batch", &synthetic, nbReports);
+    benchSingle("synthetic, one by one", &synthetic, nbReports);
+
+    if (nbCaptures > 0) {
+        if (loadRecordedEvents(capturePaths, nbCaptures, &recorded) < 0) {
+            return EXIT_FAILURE;
+        }
+        benchBatch("recorded, batch", &recorded, nbReports);
+        benchSingle("recorded, one by one", &recorded, nbReports);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t buildAdvertisingData(uint8_t* data, uint32_t i) {
+    uint8_t length = 0;
+    uint16_t x = (uint16_t) (i * 37 % 50000);
+    uint16_t y = (uint16_t) (i * 91 % 50000);
+
+    data[length++] = 0x02;
+    data[length++] = 0x01;
+    data[length++] = 0x06;
+
+    switch (i % 4) {
+        case 0:     // Balise BalisePy au format texte
+            data[length++] = 0x0F;
+            data[length++] = AD_TYPE_NAME_COMPLETE;
+            length += (uint8_t) sprintf((char*) data + length, "%02ux%05uy%05u", (unsigned int) (i % 100), (unsigned int) x, (unsigned int) y);
+            data[length++] = 0x03;
+            data[length++] = AD_TYPE_UUID16_COMPLETE;
+            data[length++] = BEACONS_UUID & 0xFF;
+            data[length++] = BEACONS_UUID >> 8;
+            break;
+
+        case 1:     // Balise BalisePy au format compact
+            data[length++] = COMPACT_LENGTH + 1;
+            data[length++] = AD_TYPE_MANUFACTURER_DATA;
+            data[length++] = COMPACT_COMPANY_ID & 0xFF;
+            data[length++] = COMPACT_COMPANY_ID >> 8;
+            data[length++] = COMPACT_VERSION;
+            data[length++] = (uint8_t) ('0' + i / 10 % 10);
+            data[length++] = (uint8_t) ('0' + i % 10);
+            data[length++] = (uint8_t) x;
+            data[length++] = (uint8_t) (x >> 8);
+            data[length++] = (uint8_t) y;
+            data[length++] = (uint8_t) (y >> 8);
+            data[length++] = (uint8_t) -60;
+            data[length++] = (uint8_t) i;
+            data[length++] = 0x03;
+            data[length++] = AD_TYPE_UUID16_COMPLETE;
+            data[length++] = BEACONS_UUID & 0xFF;
+            data[length++] = BEACONS_UUID >> 8;
+            break;
+
+        case 2:     // iBeacon enregistre
+            data[length++] = IBEACON_LENGTH + 1;
+            data[length++] = AD_TYPE_MANUFACTURER_DATA;
+            data[length++] = IBEACON_COMPANY_ID & 0xFF;
+            data[length++] = IBEACON_COMPANY_ID >> 8;
+            data[length++] = IBEACON_TYPE;
+            data[length++] = IBEACON_DATA_SIZE;
+            memcpy(data + length, IBEACON_IDENTIFIER, TRANSLATOR_BEACON_IDENTIFIER_SIZE);
+            length += TRANSLATOR_BEACON_IDENTIFIER_SIZE;
+            data[length++] = (uint8_t) -59;
+            break;
+
+        default:    // Telephone, ecarte
+            data[length++] = 0x05;
+            data[length++] = AD_TYPE_MANUFACTURER_DATA;
+            data[length++] = 0x06;
+            data[length++] = 0x00;
+            data[length++] = (uint8_t) i;
+            data[length++] = (uint8_t) (i >> 8);
+            data[length++] = 0x0A;
+            data[length++] = AD_TYPE_NAME_COMPLETE;
+            memcpy(data + length, "Telephone", 9);
+            length += 9;
+            break;
+    }
+
+    return length;
+}
+
+static int8_t buildSyntheticEvents(EventSet* eventSet) {
+    uint8_t* buffer = malloc(NB_SYNTHETIC_EVENTS * HCI_MAX_EVENT_SIZE);
+    eventSet->events = malloc(NB_SYNTHETIC_EVENTS * sizeof(const uint8_t*));
+    eventSet->sizes = malloc(NB_SYNTHETIC_EVENTS * sizeof(uint16_t));
+    if (buffer == NULL || eventSet->events == NULL || eventSet->sizes == NULL) {
+        fprintf(stderr, "Fail to allocate the synthetic events\n");
+        return -1;
+    }
+
+    eventSet->nbEvents = NB_SYNTHETIC_EVENTS;
+    eventSet->nbReports = 0;
+    for (uint32_t e = 0; e < NB_SYNTHETIC_EVENTS; e++) {
+        uint8_t* event = buffer + e * HCI_MAX_EVENT_SIZE;
+        bool isExtended = e % 8 == 7;
+        uint8_t nbReports = isExtended ? 1 : (uint8_t) (1 + e % 4);
+        uint16_t size = HCI_EVENT_HDR_SIZE + EVT_LE_META_EVENT_SIZE + 1;
+
+        for (uint8_t r = 0; r < nbReports; r++) {
+            uint8_t* report = event + size;
+            uint8_t* data = report + (isExtended ? BEACONS_EXTENDED_CHANNEL_SIZE : LE_ADVERTISING_INFO_SIZE);
+            uint8_t length = buildAdvertisingData(data, e * 4 + r);
+
+            if (isExtended) {
+                BeaconsExtendedChannel* info = (BeaconsExtendedChannel*) report;
+                memset(info, 0, BEACONS_EXTENDED_CHANNEL_SIZE);
+                info->primaryPhy = 0x01;
+                info->sid = 0xFF;
+                info->txPower = BEACON_TX_POWER_UNKNOWN;
+                info->rssi = (int8_t) (-40 - (int8_t) (e % 50));
+                info->length = length;
+                size += BEACONS_EXTENDED_CHANNEL_SIZE + length;
+            } else {
+                BeaconsChannel* info = (BeaconsChannel*) report;
+                memset(info, 0, LE_ADVERTISING_INFO_SIZE);
+                info->length = length;
+                data[length] = (uint8_t) (-40 - (int8_t) (e % 50));
+                size += LEGACY_REPORT_HEADER_SIZE + length;
+            }
+        }
+
+        event[0] = EVT_LE_META_EVENT;
+        event[1] = (uint8_t) (size - HCI_EVENT_HDR_SIZE);
+        event[2] = isExtended ? EVT_LE_EXTENDED_ADVERTISING_REPORT : EVT_LE_ADVERTISING_REPORT;
+        event[3] = nbReports;
+        eventSet->events[e] = event;
+        eventSet->sizes[e] = size;
+        eventSet->nbReports += nbReports;
+    }
+
+    return 0;
+}
+
+static int8_t loadRecordedEvents(const char* const* paths, uint8_t nbPaths, EventSet* eventSet) {
+    eventSet->events = malloc(NB_MAX_RECORDED_EVENTS * sizeof(const uint8_t*));
+    eventSet->sizes = malloc(NB_MAX_RECORDED_EVENTS * sizeof(uint16_t));
+    eventSet->nbEvents = 0;
+    eventSet->nbReports = 0;
+    if (eventSet->events == NULL || eventSet->sizes == NULL) {
+        fprintf(stderr, "Fail to allocate the recorded events\n");
+        return -1;
+    }
+
+    for (uint8_t p = 0; p < nbPaths; p++) {
+        const uint8_t* event;
+        uint16_t size;
+
+        /* La capture reste projetee en memoire jusqu'a la fin du programme, les evenements y sont lus en place */
+        if (Replayer_open(paths[p], REPLAYER_SPEED_MAX) < 0) {
+            return -1;
+        }
+        while (eventSet->nbEvents < NB_MAX_RECORDED_EVENTS && Replayer_nextHciEvent(&event, &size)) {
+            if (size >= HCI_EVENT_HDR_SIZE + EVT_LE_META_EVENT_SIZE + 1 && event[0] == EVT_LE_META_EVENT
+                && (event[2] == EVT_LE_ADVERTISING_REPORT || event[2] == EVT_LE_EXTENDED_ADVERTISING_REPORT)) {
+                eventSet->events[eventSet->nbEvents] = event;
+                eventSet->sizes[eventSet->nbEvents] = size;
+                eventSet->nbEvents++;
+                eventSet->nbReports += event[3];
+            }
+        }
+        fprintf(stdout, "%s: %u advertising events\n", paths[p], eventSet->nbEvents);
+    }
+
+    if (eventSet->nbEvents == 0) {
+        fprintf(stderr, "No advertising event in the captures\n");
+        return -1;
+    }
+    return 0;
+}
+
+static void benchBatch(const char* name, const EventSet* eventSet, uint32_t nbReports) {
+    uint8_t names[TRANSLATOR_BEACON_NB_MAX_REPORTS][SIZE_BEACON_ID];
+    uint16_t uuids[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    int8_t rssis[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    int8_t txPowers[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    uint16_t sequences[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    Position positions[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    BeaconsSignalBatch batch = {
+        .name = names,
+        .uuid = uuids,
+        .rssi = rssis,
+        .txPower = txPowers,
+        .sequence = sequences,
+        .position = positions,
+        .capacity = TRANSLATOR_BEACON_NB_MAX_REPORTS
+    };
+    uint64_t nbTranslated = 0;
+    uint32_t nbBeacons = 0;
+    uint32_t e = 0;
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (nbTranslated < nbReports) {
+        const uint8_t* event = eventSet->events[e];
+        uint8_t nbTranslatedInEvent = TranslatorBeacon_translateReports(event + HCI_EVENT_HDR_SIZE + EVT_LE_META_EVENT_SIZE + 1,
+                                                                        (uint16_t) (eventSet->sizes[e] - HCI_EVENT_HDR_SIZE - EVT_LE_META_EVENT_SIZE - 1),
+                                                                        event[3], event[2] == EVT_LE_EXTENDED_ADVERTISING_REPORT, &batch, NULL);
+
+        for (uint8_t i = 0; i < nbTranslatedInEvent; i++) {
+            nbBeacons += uuids[i] == BEACONS_UUID;
+            sink += positions[i].X;
+        }
+        /* Un evenement sans rapport lisible compte pour un rapport, pour que la boucle finisse */
+        nbTranslated += nbTranslatedInEvent > 0 ? nbTranslatedInEvent : 1;
+        e = e + 1 < eventSet->nbEvents ? e + 1 : 0;
+    }
+    printThroughput(name, nbTranslated, &start);
+    fprintf(stdout, "    %u beacons\n", nbBeacons);
+}
+
+static void benchSingle(const char* name, const EventSet* eventSet, uint32_t nbReports) {
+    uint64_t nbTranslated = 0;
+    uint32_t nbBeacons = 0;
+    uint32_t e = 0;
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (nbTranslated < nbReports) {
+        const uint8_t* event = eventSet->events[e];
+        const uint8_t* report = event + HCI_EVENT_HDR_SIZE + EVT_LE_META_EVENT_SIZE + 1;
+        const uint8_t* end = event + eventSet->sizes[e];
+        bool isExtended = event[2] == EVT_LE_EXTENDED_ADVERTISING_REPORT;
+        uint64_t nbTranslatedBefore = nbTranslated;
+
+        /* L'API d'un rapport suppose le rapport complet : sa taille est verifiee ici */
+        for (uint8_t r = 0; r < event[3]; r++) {
+            BeaconSignal beaconSignal;
+            uint16_t reportSize;
+
+            if (isExtended) {
+                if (report + BEACONS_EXTENDED_CHANNEL_SIZE > end) {
+                    break;
+                }
+                reportSize = BEACONS_EXTENDED_CHANNEL_SIZE + ((const BeaconsExtendedChannel*) report)->length;
+                if (report + reportSize > end) {
+                    break;
+                }
+                beaconSignal = TranslatorBeacon_translateExtendedChannelToBeaconsSignal((const BeaconsExtendedChannel*) report);
+            } else {
+                if (report + LEGACY_REPORT_HEADER_SIZE > end) {
+                    break;
+                }
+                reportSize = LEGACY_REPORT_HEADER_SIZE + ((const BeaconsChannel*) report)->length;
+                if (report + reportSize > end) {
+                    break;
+                }
+                beaconSignal = TranslatorBeacon_translateChannelToBeaconsSignal((const BeaconsChannel*) report);
+            }
+            nbBeacons += beaconSignal.uuid[0] == (BEACONS_UUID & 0xFF) && beaconSignal.uuid[1] == (BEACONS_UUID >> 8);
+            sink += beaconSignal.position.X;
+            nbTranslated++;
+            report += reportSize;
+        }
+        /* Un evenement sans rapport lisible compte pour un rapport, pour que la boucle finisse */
+        nbTranslated += nbTranslated == nbTranslatedBefore;
+        e = e + 1 < eventSet->nbEvents ? e + 1 : 0;
+    }
+    printThroughput(name, nbTranslated, &start);
+    fprintf(stdout, "    %u beacons\n", nbBeacons);
+}
+
+static void printThroughput(const char* name, uint64_t nbReports, const struct timespec* start) {
+    struct timespec stop;
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    double duration = (double) (stop.tv_sec - start->tv_sec) + (double) (stop.tv_nsec - start->tv_nsec) / 1e9;
+
+    fprintf(stdout, "%-24s %10llu reports in %7.3f s  %12.0f reports/s  %8.1f ns/report\n", name,
+            (unsigned long long) nbReports, duration, (double) nbReports / duration, duration * 1e9 / (double) nbReports);
+}
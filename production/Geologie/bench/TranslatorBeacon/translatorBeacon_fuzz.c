@@ -0,0 +1,381 @@
+/**
+ * @file translatorBeacon_fuzz.c
+ *
+ * @brief Harnais de fuzzing de la traduction des rapports d'annonce par TranslatorBeacon.
+ *
+ * Chaque entree donne le type des rapports (premier octet, bit 0 pour les rapports etendus), le nombre de rapports
+ * annonce (deuxieme octet), puis les rapports. Ils sont copies dans un tampon de leur taille exacte pour que les
+ * sanitizers detectent toute lecture au-dela, et la traduction est verifiee : taille consommee, nombre de signaux et
+ * identifiant des balises retenues.
+ *
+ * Sans libFuzzer, le programme mute lui-meme un corpus de rapports valides.
+ * Usage : translatorBeacon_fuzz.out [-n entrees] [-s graine] [-o dossier du corpus a ecrire]
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "TranslatorBeacon/translatorBeacon.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre d'entrees mutees par defaut.
+ */
+#define NB_INPUTS_DEFAULT (1000000)
+
+/**
+ * @brief La taille maximale d'une entree : les deux octets d'en-tete et les rapports d'un evenement HCI.
+ */
+#define INPUT_SIZE_MAX (2 + HCI_MAX_EVENT_SIZE)
+
+/**
+ * @brief Le nombre maximal de mutations appliquees a une entree.
+ */
+#define NB_MAX_MUTATIONS (4)
+
+/**
+ * @brief Arrete le programme si la condition n'est pas verifiee, pour que le fuzzer garde l'entree.
+ */
+#define CHECK(condition)                                                                    \
+    do {                                                                                    \
+        if (!(condition)) {                                                                 \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);   \
+            abort();                                                                        \
+        }                                                                                   \
+    } while (0)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Une entree du corpus.
+ */
+typedef struct {
+    const char* name;
+    const uint8_t* data;
+    uint16_t size;
+} Seed;
+
+/**
+ * @brief Un rapport classique d'une balise au format texte.
+ */
+static const uint8_t SEED_TEXT[] = {
+    0x00, 0x01,
+    0x00, 0x01, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x17,
+    0x02, 0x01, 0x06, 0x0F, 0x09, 'b', '1', 'x', '0', '0', '5', '5', '0', 'y', '0', '0', '2', '0', '0', 0x03, 0x03, 0x1A, 0x18,
+    0xBA
+};
+
+/**
+ * @brief Deux rapports classiques : une balise au format compact et un iBeacon enregistre.
+ */
+static const uint8_t SEED_COMPACT_IBEACON[] = {
+    0x00, 0x02,
+    0x00, 0x01, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0x14,
+    0x02, 0x01, 0x06, 0x0C, 0xFF, 0xFF, 0xFF, 0x01, 'b', '3', 0x30, 0x75, 0x40, 0x9C, 0xC4, 0x2A, 0x03, 0x03, 0x1A, 0x18,
+    0xC4,
+    0x00, 0x01, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x1E,
+    0x02, 0x01, 0x06, 0x1A, 0xFF, 0x4C, 0x00, 0x02, 0x15,
+    0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB, 0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0, 0x00, 0x01, 0x00, 0x02, 0xC5,
+    0xB0
+};
+
+/**
+ * @brief Un rapport etendu d'une balise Eddystone-UID enregistree.
+ */
+static const uint8_t SEED_EDDYSTONE_EXTENDED[] = {
+    0x01, 0x01,
+    0x13, 0x00, 0x01, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0x01, 0x00, 0xFF, 0x7F, 0xC0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F,
+    0x02, 0x01, 0x06, 0x03, 0x03, 0xAA, 0xFE, 0x17, 0x16, 0xAA, 0xFE, 0x00, 0xEE,
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x00, 0x00
+};
+
+static const Seed SEEDS[] = {
+    { "text", SEED_TEXT, sizeof(SEED_TEXT) },
+    { "compact_ibeacon", SEED_COMPACT_IBEACON, sizeof(SEED_COMPACT_IBEACON) },
+    { "eddystone_extended", SEED_EDDYSTONE_EXTENDED, sizeof(SEED_EDDYSTONE_EXTENDED) }
+};
+
+#define NB_SEEDS (sizeof(SEEDS) / sizeof(SEEDS[0]))
+
+/**
+ * @brief Les valeurs donnees aux octets mutes, proches des limites des longueurs.
+ */
+static const uint8_t INTERESTING_VALUES[] = { 0x00, 0x01, 0x02, 0x0E, 0x0F, 0x10, 0x1E, 0x1F, 0x20, 0x7F, 0x80, 0xFE, 0xFF };
+
+/**
+ * @brief L'etat du generateur pseudo-aleatoire (xorshift32).
+ */
+static uint32_t randomState = 1;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Traduit une entree et verifie le resultat, point d'entree de libFuzzer.
+ *
+ * @param data L'entree.
+ * @param size La taille de l'entree.
+ * @return int 0.
+ */
+extern int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+/**
+ * @brief Enregistre les balises tierces des entrees du corpus, au premier appel.
+ */
+static void registerThirdPartyBeacons(void);
+
+/**
+ * @brief Verifie un lot traduit.
+ *
+ * @param batch Le lot.
+ * @param nbReports Le nombre de rapports annonce.
+ * @param size La taille des rapports.
+ * @param consumedSize La taille des rapports traduits.
+ */
+static void checkBatch(const BeaconsSignalBatch* batch, uint8_t nbReports, uint16_t size, uint16_t consumedSize);
+
+/**
+ * @brief Rend le prochain nombre pseudo-aleatoire.
+ *
+ * @return uint32_t Le nombre.
+ */
+static uint32_t nextRandom(void);
+
+/**
+ * @brief Mute une entree en place : octets remplaces, longueur tronquee ou nombre de rapports change.
+ *
+ * @param input L'entree.
+ * @param size La taille de l'entree, mise a jour.
+ */
+static void mutate(uint8_t* input, uint16_t* size);
+
+/**
+ * @brief Ecrit les entrees du corpus dans un dossier, pour libFuzzer.
+ *
+ * @param directory Le dossier, qui doit exister.
+ * @return int8_t -1 si une entree ne peut etre ecrite, 0 sinon.
+ */
+static int8_t writeCorpus(const char* directory);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    uint8_t names[TRANSLATOR_BEACON_NB_MAX_REPORTS][SIZE_BEACON_ID];
+    uint16_t uuids[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    int8_t rssis[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    int8_t txPowers[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    uint16_t sequences[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    Position positions[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    BeaconsSignalBatch batch = {
+        .name = names,
+        .uuid = uuids,
+        .rssi = rssis,
+        .txPower = txPowers,
+        .sequence = sequences,
+        .position = positions,
+        .capacity = TRANSLATOR_BEACON_NB_MAX_REPORTS
+    };
+    uint16_t expectedUuids[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    uint16_t consumedSize;
+    uint16_t offset = 0;
+    uint8_t nbSignals;
+
+    if (size < 2 || size > INPUT_SIZE_MAX) {
+        return 0;
+    }
+    registerThirdPartyBeacons();
+
+    bool isExtended = (data[0] & 0x01) != 0;
+    uint8_t nbReports = data[1];
+    uint16_t reportsSize = (uint16_t) (size - 2);
+
+    /* Un tampon de la taille exacte des rapports : une lecture au-dela est detectee par AddressSanitizer */
+    uint8_t* reports = malloc(reportsSize > 0 ? reportsSize : 1);
+    CHECK(reports != NULL);
+    memcpy(reports, data + 2, reportsSize);
+
+    TranslatorBeacon_translateReports(reports, reportsSize, nbReports, isExtended, &batch, &consumedSize);
+    checkBatch(&batch, nbReports, reportsSize, consumedSize);
+    nbSignals = batch.nbSignals;
+    memcpy(expectedUuids, uuids, nbSignals * sizeof(uint16_t));
+
+    /* Par lots d'un rapport, en reprenant apres la taille consommee, la traduction doit etre la meme */
+    batch.capacity = 1;
+    for (uint8_t i = 0; i < nbSignals; i++) {
+        CHECK(TranslatorBeacon_translateReports(reports + offset, (uint16_t) (reportsSize - offset), 1, isExtended, &batch, &consumedSize) == 1);
+        checkBatch(&batch, 1, (uint16_t) (reportsSize - offset), consumedSize);
+        CHECK(consumedSize > 0);
+        CHECK(uuids[0] == expectedUuids[i]);
+        offset += consumedSize;
+    }
+
+    free(reports);
+    return 0;
+}
+
+#ifndef LIBFUZZER
+
+int main(int argc, char* argv[]) {
+    uint8_t input[INPUT_SIZE_MAX];
+    uint32_t nbInputs = NB_INPUTS_DEFAULT;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:s:o:")) != -1) {
+        switch (option) {
+            case 'n':
+                nbInputs = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                randomState = (uint32_t) strtoul(optarg, NULL, 10);
+                randomState = randomState != 0 ? randomState : 1;
+                break;
+            case 'o':
+                return writeCorpus(optarg) < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+            default:
+                fprintf(stderr, "Usage: %s [-n inputs] [-s seed] [-o corpus directory]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    for (uint32_t i = 0; i < nbInputs; i++) {
+        const Seed* seed = &SEEDS[nextRandom() % NB_SEEDS];
+        uint16_t size = seed->size;
+
+        memcpy(input, seed->data, size);
+        mutate(input, &size);
+        LLVMFuzzerTestOneInput(input, size);
+    }
+
+    fprintf(stdout, "%u inputs translated, no error\n", nbInputs);
+    return EXIT_SUCCESS;
+}
+
+#endif /* LIBFUZZER */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void registerThirdPartyBeacons(void) {
+    static bool isRegistered = false;
+    ThirdPartyBeacon iBeacon = {
+        .format = TRANSLATOR_BEACON_IBEACON,
+        .identifier = { 0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB, 0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0, 0x00, 0x01, 0x00, 0x02 },
+        .name = "i1",
+        .position = { 1000, 2000 }
+    };
+    ThirdPartyBeacon eddystone = {
+        .format = TRANSLATOR_BEACON_EDDYSTONE,
+        .identifier = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF },
+        .name = "e1",
+        .position = { 3000, 500 }
+    };
+
+    if (!isRegistered) {
+        TranslatorBeacon_addThirdPartyBeacon(&iBeacon);
+        TranslatorBeacon_addThirdPartyBeacon(&eddystone);
+        isRegistered = true;
+    }
+}
+
+static void checkBatch(const BeaconsSignalBatch* batch, uint8_t nbReports, uint16_t size, uint16_t consumedSize) {
+    CHECK(batch->nbSignals <= nbReports);
+    CHECK(batch->nbSignals <= batch->capacity);
+    CHECK(consumedSize <= size);
+
+    for (uint8_t i = 0; i < batch->nbSignals; i++) {
+        /* Une balise retenue a toujours un identifiant complet */
+        if (batch->uuid[i] == BEACONS_UUID) {
+            CHECK(batch->name[i][0] != '\0' && batch->name[i][1] != '\0' && batch->name[i][2] == '\0');
+        }
+        CHECK(batch->sequence[i] == BEACON_SEQUENCE_UNKNOWN || batch->sequence[i] <= UINT8_MAX);
+    }
+}
+
+static uint32_t nextRandom(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+static void mutate(uint8_t* input, uint16_t* size) {
+    uint8_t nbMutations = (uint8_t) (1 + nextRandom() % NB_MAX_MUTATIONS);
+
+    for (uint8_t m = 0; m < nbMutations; m++) {
+        uint16_t position = (uint16_t) (nextRandom() % *size);
+
+        switch (nextRandom() % 5) {
+            case 0:     // Un octet quelconque, dont les longueurs
+                input[position] = (uint8_t) nextRandom();
+                break;
+            case 1:     // Une valeur aux limites
+                input[position] = INTERESTING_VALUES[nextRandom() % sizeof(INTERESTING_VALUES)];
+                break;
+            case 2:     // Une longueur decalee d'un octet
+                input[position] += (nextRandom() & 1) ? 1 : 0xFF;
+                break;
+            case 3:     // Des rapports tronques
+                *size = (uint16_t) (2 + nextRandom() % (*size - 1));
+                break;
+            default:    // Un autre nombre de rapports annonce
+                input[1] = (uint8_t) (nextRandom() % 8);
+                break;
+        }
+        if (*size <= 2) {
+            break;
+        }
+    }
+}
+
+static int8_t writeCorpus(const char* directory) {
+    char path[256];
+
+    for (uint8_t i = 0; i < NB_SEEDS; i++) {
+        snprintf(path, sizeof(path), "%s/%s", directory, SEEDS[i].name);
+        FILE* file = fopen(path, "wb");
+        if (file == NULL || fwrite(SEEDS[i].data, 1, SEEDS[i].size, file) != SEEDS[i].size) {
+            fprintf(stderr, "Fail to write %s\n", path);
+            if (file != NULL) {
+                fclose(file);
+            }
+            return -1;
+        }
+        fclose(file);
+    }
+
+    fprintf(stdout, "%u inputs written to %s\n", (unsigned int) NB_SEEDS, directory);
+    return 0;
+}
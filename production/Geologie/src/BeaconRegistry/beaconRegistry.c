@@ -0,0 +1,174 @@
+/**
+ * @file beaconRegistry.c
+ *
+ * @brief Attribue a chaque balise un indice dense, une seule fois, a sa premiere trame.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "beaconRegistry.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../tools.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre maximal de balises enregistrees.
+ */
+static uint16_t capacity = 0;
+
+/**
+ * @brief L'identifiant de chaque balise enregistree, par indice.
+ */
+static uint8_t (*names)[SIZE_BEACON_ID] = NULL;
+
+/**
+ * @brief Le nombre de balises enregistrees, publie apres l'ecriture de leur identifiant.
+ */
+static uint16_t nbBeacons = 0;
+
+/**
+ * @brief La table de hachage a adressage ouvert de l'identifiant vers l'indice + 1, 0 pour une alveole libre.
+ *
+ * Son nombre d'alveoles est une puissance de 2 au moins double de la capacite, #bucketsMask vaut ce nombre - 1.
+ */
+static uint16_t* buckets = NULL;
+static uint32_t bucketsMask;
+
+/**
+ * @brief L'identifiant rendu pour un indice non attribue.
+ */
+static const uint8_t NO_NAME[SIZE_BEACON_ID];
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Calcule l'alveole de depart d'un identifiant dans la table de hachage (FNV-1a).
+ *
+ * @param name L'identifiant de la balise.
+ * @return uint32_t L'alveole de depart.
+ */
+static uint32_t hashName(const uint8_t* name);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern int8_t BeaconRegistry_new(uint16_t newCapacity) {
+    BeaconRegistry_free();
+
+    if (newCapacity == 0 || newCapacity > BEACON_REGISTRY_CAPACITY_MAX) {
+        LOG("[BeaconRegistry] Invalid capacity %d%s", newCapacity, "\n");
+        return -1;
+    }
+
+    uint32_t nbBuckets = 1;
+    while (nbBuckets < 2 * (uint32_t) newCapacity) {
+        nbBuckets <<= 1;
+    }
+
+    names = calloc(newCapacity, SIZE_BEACON_ID);
+    buckets = calloc(nbBuckets, sizeof(uint16_t));
+    if (names == NULL || buckets == NULL) {
+        ERROR(true, "[BeaconRegistry] Fail to allocate the registry");
+        BeaconRegistry_free();
+        return -1;
+    }
+
+    capacity = newCapacity;
+    bucketsMask = nbBuckets - 1;
+    return 0;
+}
+
+extern void BeaconRegistry_free(void) {
+    free(names);
+    free(buckets);
+    names = NULL;
+    buckets = NULL;
+    capacity = 0;
+    nbBeacons = 0;
+}
+
+extern uint16_t BeaconRegistry_getCapacity(void) {
+    return capacity;
+}
+
+extern BeaconIndex BeaconRegistry_getIndex(const uint8_t* name) {
+    if (buckets == NULL) {
+        return BEACON_INDEX_NONE;
+    }
+
+    uint32_t bucket = hashName(name);
+
+    while (buckets[bucket] != 0) {
+        BeaconIndex index = buckets[bucket] - 1;
+        if (memcmp(names[index], name, SIZE_BEACON_ID) == 0) {
+            return index;
+        }
+        bucket = (bucket + 1) & bucketsMask;
+    }
+
+    if (nbBeacons >= capacity) {
+        TRACE("[BeaconRegistry] The registry is full, %.2s is ignored%s", (const char*) name, "\n");
+        return BEACON_INDEX_NONE;
+    }
+
+    BeaconIndex index = nbBeacons;
+    memcpy(names[index], name, SIZE_BEACON_ID);
+    buckets[bucket] = index + 1;
+
+    /* Le nom est ecrit avant que l'indice ne devienne visible des autres threads */
+    __atomic_store_n(&nbBeacons, nbBeacons + 1, __ATOMIC_RELEASE);
+
+    return index;
+}
+
+extern const uint8_t* BeaconRegistry_getName(BeaconIndex index) {
+    if (index >= __atomic_load_n(&nbBeacons, __ATOMIC_ACQUIRE)) {
+        return NO_NAME;
+    }
+    return names[index];
+}
+
+extern uint16_t BeaconRegistry_getNbBeacons(void) {
+    return __atomic_load_n(&nbBeacons, __ATOMIC_ACQUIRE);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t hashName(const uint8_t* name) {
+    uint32_t hash = 2166136261u;
+
+    for (uint8_t i = 0; i < SIZE_BEACON_ID; i++) {
+        hash = (hash ^ name[i]) * 16777619u;
+    }
+
+    return hash & bucketsMask;
+}
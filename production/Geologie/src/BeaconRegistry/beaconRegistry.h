@@ -0,0 +1,103 @@
+/**
+ * @file beaconRegistry.h
+ *
+ * @brief Attribue a chaque balise un indice dense, une seule fois, a sa premiere trame.
+ *
+ * Toute la chaine de traitement designe ensuite la balise par son #BeaconIndex et range ses donnees par acces
+ * direct dans des tableaux dimensionnes une fois au demarrage par la capacite du registre. L'identifiant sous
+ * forme de chaine n'est relu que pour etre envoye a GEOMOBILE.
+ *
+ * Les balises sont enregistrees par un seul thread, celui de Receiver. Un indice et le nom associe ne changent
+ * plus ensuite, les autres threads peuvent donc lire le nom de tout indice que Receiver leur a transmis.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+#ifndef BEACON_REGISTRY_
+#define BEACON_REGISTRY_
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#include "../common.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La capacite par defaut du registre, en nombre de balises.
+ */
+#define BEACON_REGISTRY_CAPACITY_DEFAULT (256)
+
+/**
+ * @brief La capacite maximale du registre, les indices doivent rester differents de #BEACON_INDEX_NONE.
+ */
+#define BEACON_REGISTRY_CAPACITY_MAX (UINT16_MAX - 1)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Cree le registre, vide, pour au plus capacity balises.
+ *
+ * A appeler au demarrage, avant la creation des modules qui dimensionnent leurs tableaux avec
+ * #BeaconRegistry_getCapacity. Un registre existant est detruit.
+ *
+ * @param capacity Le nombre maximal de balises, de 1 a #BEACON_REGISTRY_CAPACITY_MAX.
+ * @return int8_t -1 en cas d'erreur, 0 sinon.
+ */
+extern int8_t BeaconRegistry_new(uint16_t capacity);
+
+/**
+ * @brief Detruit le registre.
+ */
+extern void BeaconRegistry_free(void);
+
+/**
+ * @brief Donne la capacite du registre, les indices vont de 0 a la capacite - 1.
+ *
+ * @return uint16_t La capacite du registre, 0 s'il n'est pas cree.
+ */
+extern uint16_t BeaconRegistry_getCapacity(void);
+
+/**
+ * @brief Donne l'indice d'une balise, en l'enregistrant si elle n'est pas encore connue.
+ *
+ * A n'appeler que depuis le thread de Receiver.
+ *
+ * @param name L'identifiant de la balise, sur #SIZE_BEACON_ID octets.
+ * @return BeaconIndex L'indice de la balise, #BEACON_INDEX_NONE si le registre est plein ou n'est pas cree.
+ */
+extern BeaconIndex BeaconRegistry_getIndex(const uint8_t* name);
+
+/**
+ * @brief Donne l'identifiant d'une balise enregistree.
+ *
+ * @param index L'indice de la balise.
+ * @return const uint8_t* L'identifiant de la balise sur #SIZE_BEACON_ID octets, un identifiant vide si l'indice
+ * n'est pas attribue.
+ */
+extern const uint8_t* BeaconRegistry_getName(BeaconIndex index);
+
+/**
+ * @brief Donne le nombre de balises enregistrees.
+ *
+ * @return uint16_t Le nombre de balises enregistrees.
+ */
+extern uint16_t BeaconRegistry_getNbBeacons(void);
+
+#endif /* BEACON_REGISTRY_ */
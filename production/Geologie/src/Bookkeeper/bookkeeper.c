@@ -373,7 +373,11 @@ static int8_t updateProcessorLoad(void) {
                     uint64_t currentTotal = (currentTotalUser - previousTotalUser) + (currentTotalUserLow - previousTotalUserLow)
                         + (currentTotalSys - previousTotalSys);
 
-                    setPercentProcessorLoad((currentTotal / (currentTotal + (currentTotalIdle - previousTotalIdle))) * 100);
+                    uint64_t currentTotalWithIdle = currentTotal + (currentTotalIdle - previousTotalIdle);
+
+                    if (currentTotalWithIdle > 0) {
+                        setPercentProcessorLoad(((float) currentTotal * 100) / (float) currentTotalWithIdle);
+                    }
                 }
 
                 previousTotalUser = currentTotalUser;
@@ -388,7 +392,7 @@ static int8_t updateProcessorLoad(void) {
 }
 
 static float getPercentMemoryLoad(void) {
-    bool returnValue;
+    float returnValue;
 
     pthread_mutex_lock(&myMutex);
     returnValue = percentMemoryUsed;
@@ -404,7 +408,7 @@ static void setPercentMemoryLoad(float newValue) {
 }
 
 static float getPercentProcessorLoad(void) {
-    bool returnValue;
+    float returnValue;
 
     pthread_mutex_lock(&myMutex);
     returnValue = percentProcessorUsed;
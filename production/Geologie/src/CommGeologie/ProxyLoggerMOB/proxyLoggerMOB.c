@@ -127,14 +127,28 @@ extern int8_t ProxyLoggerMOB_setAllBeaconsData(const BeaconData* beaconsData, ui
     return returnError;
 }
 
-extern int8_t ProxyLoggerMOB_setCurrentPosition(const Position* currentPosition, Date currentDate) {
+extern int8_t ProxyLoggerMOB_setBeaconsStatistics(const BeaconStatistics* beaconsStatistics, uint8_t nbBeacons, Date currentDate) {
+    LOG("[ProxyLoggerMOB] Send the beacons statistics.%s", "\n");
+
+    int8_t returnError;
+    uint16_t size = TranslatorLOG_getTrameSize(SEND_BEACONS_STATISTICS, nbBeacons);
+    Trame* trame = calloc(1, size);
+
+    TranslatorLOG_translateForSendBeaconsStatistics(nbBeacons, beaconsStatistics, currentDate, trame);
+
+    returnError = sendMsg(trame, size);
+
+    return returnError;
+}
+
+extern int8_t ProxyLoggerMOB_setCurrentPosition(const Position* currentPosition, uint32_t captureAge, Date currentDate) {
     LOG("[ProxyLoggerMOB] Send the current position.%s", "\n");
 
     int8_t returnError;
     uint16_t size = TranslatorLOG_getTrameSize(SEND_CURRENT_POSITION, 0);
     Trame* trame = calloc(1, size);
 
-    TranslatorLOG_translateForSendCurrentPosition(currentPosition, currentDate, trame);
+    TranslatorLOG_translateForSendCurrentPosition(currentPosition, captureAge, currentDate, trame);
 
     returnError = sendMsg(trame, size);
 
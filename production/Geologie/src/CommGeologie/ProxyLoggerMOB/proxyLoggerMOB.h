@@ -96,14 +96,25 @@ extern int8_t ProxyLoggerMOB_setCalibrationData(const CalibrationData* calibrati
  */
 extern int8_t ProxyLoggerMOB_setAllBeaconsData(const BeaconData* beaconsData, uint8_t nbBeacons, Date currentDate);
 
+/**
+ * @brief Envoie les statistiques de reception des balises actives a LoggerMOB.
+ *
+ * @param beaconsStatistics Les statistiques des balises a envoyer.
+ * @param nbBeacons Le nombre de statistiques de balise a envoyer
+ * @param currentDate La date a laquelle les statistiques on ete relevee.
+ * @return int8_t -1 en cas d'erreur, 0 sinon.
+ */
+extern int8_t ProxyLoggerMOB_setBeaconsStatistics(const BeaconStatistics* beaconsStatistics, uint8_t nbBeacons, Date currentDate);
+
 /**
  * @brief Envoie la position actuelle a LoggerMOB.
  *
  * @param currentPosition La position a envoyer.
+ * @param captureAge L'anciennete de la position a l'envoi en milliseconde, #CAPTURE_AGE_UNKNOWN si inconnue.
  * @param currentDate La date a laquelle la position a ete relevee.
  * @return int8_t -1 en cas d'erreur, 0 sinon.
  */
-extern int8_t ProxyLoggerMOB_setCurrentPosition(const Position* currentPosition, Date currentDate);
+extern int8_t ProxyLoggerMOB_setCurrentPosition(const Position* currentPosition, uint32_t captureAge, Date currentDate);
 
 /**
  * @brief Envoie la charge memoire et processeur a LoggerMOB.
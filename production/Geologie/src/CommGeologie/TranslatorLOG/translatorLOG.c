@@ -24,6 +24,7 @@
 
 #include "../com_common.h"
 #include "../../common.h"
+#include "../../BeaconRegistry/beaconRegistry.h"
 #include "../../tools.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -62,6 +63,31 @@
  */
 #define SIZE_ATTENUATION_COEFFICIENT (4)
 
+/**
+ * @brief La taille en octet de l'anciennete de la derniere annonce d'une balise.
+ */
+#define SIZE_LAST_SEEN_AGE (4)
+
+/**
+ * @brief La taille en octet de l'anciennete d'une position.
+ */
+#define SIZE_CAPTURE_AGE (4)
+
+/**
+ * @brief La taille en octet du debit d'annonces d'une balise.
+ */
+#define SIZE_ADVERTISING_RATE (4)
+
+/**
+ * @brief La taille en octet de la moyenne ou de la variance du RSSI d'une balise.
+ */
+#define SIZE_RSSI_STATISTIC (4)
+
+/**
+ * @brief La taille en octet du nombre de retraits d'une balise de l'ensemble actif.
+ */
+#define SIZE_NB_DROPOUTS (2)
+
 /**
  * @brief La taille en octet de l'identifiant d'une position de calibration
  */
@@ -87,6 +113,11 @@
  */
 #define SIZE_BEACON_DATA (SIZE_BEACON_ID + SIZE_POSITION + SIZE_POWER + SIZE_ATTENUATION_COEFFICIENT)
 
+/**
+ * @brief La taille en octet des statistiques de reception d'une balise.
+ */
+#define SIZE_BEACON_STATISTICS (SIZE_BEACON_ID + SIZE_LAST_SEEN_AGE + SIZE_ADVERTISING_RATE + 2 * SIZE_RSSI_STATISTIC + SIZE_NB_DROPOUTS)
+
 /**
  * @brief La taille en octet des informations sur la charge memoire et processeur.
  */
@@ -225,6 +256,18 @@ static void convertPositionToByte(const Position* position, Trame* dest);
  */
 static void convertBeaconDataToByte(const BeaconData* beaconData, Trame* dest);
 
+/**
+ * @brief Convertie un #BeaconStatistics en un tableau d'octet.
+ *
+ * Convertie @a beaconStatistics et met la conversion dans @a dest.
+ *
+ * @param beaconStatistics Le #BeaconStatistics a convertire.
+ * @param dest Le tableau d'octet ou mettre la conversion
+ *
+ * @warning @a dest doit avoir une taille superieur ou egale a #SIZE_BEACON_STATISTICS.
+ */
+static void convertBeaconStatisticsToByte(const BeaconStatistics* beaconStatistics, Trame* dest);
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Fonctions publiques
@@ -250,7 +293,10 @@ extern uint16_t TranslatorLOG_getTrameSize(Commande cmd, uint8_t nbElements) {
             returnValue = SIZE_HEADER + 1 + SIZE_TIMESTAMP + nbElements * SIZE_BEACON_DATA;
             break;
         case SEND_CURRENT_POSITION:
-            returnValue = SIZE_HEADER + SIZE_POSITION + SIZE_TIMESTAMP;
+            returnValue = SIZE_HEADER + SIZE_POSITION + SIZE_TIMESTAMP + SIZE_CAPTURE_AGE;
+            break;
+        case SEND_BEACONS_STATISTICS:
+            returnValue = SIZE_HEADER + 1 + SIZE_TIMESTAMP + nbElements * SIZE_BEACON_STATISTICS;
             break;
         case REP_CALIBRATION_POSITIONS:
             returnValue = SIZE_HEADER + 1 + nbElements * SIZE_CALIBRATION_POSITION;
@@ -327,7 +373,23 @@ extern void TranslatorLOG_translateForSendAllBeaconsData(uint8_t nbBeacons, cons
     }
 }
 
-extern void TranslatorLOG_translateForSendCurrentPosition(const Position* currentPosition, Date currentDate, Trame* dest) {
+extern void TranslatorLOG_translateForSendBeaconsStatistics(uint8_t nbBeacons, const BeaconStatistics* beaconsStatistics, Date currentDate, Trame* dest) {
+     /* Header */
+    composeHeader(SEND_BEACONS_STATISTICS, nbBeacons, dest);
+
+    /* Number of beacon */
+    dest[SIZE_HEADER] = nbBeacons;
+
+    /* TimeStamp */
+    convertUint32_tToBytes(currentDate, dest + SIZE_HEADER + 1);
+
+    /* Beacons statistics */
+    for (uint8_t i = 0; i < nbBeacons; i++) {
+        convertBeaconStatisticsToByte(&(beaconsStatistics[i]), dest + SIZE_HEADER + 1 + SIZE_TIMESTAMP + (i * SIZE_BEACON_STATISTICS));
+    }
+}
+
+extern void TranslatorLOG_translateForSendCurrentPosition(const Position* currentPosition, uint32_t captureAge, Date currentDate, Trame* dest) {
      /* Header */
     composeHeader(SEND_CURRENT_POSITION, 0, dest);
 
@@ -336,6 +398,9 @@ extern void TranslatorLOG_translateForSendCurrentPosition(const Position* curren
 
     /* Current position */
     convertPositionToByte(currentPosition, dest + SIZE_HEADER + SIZE_TIMESTAMP);
+
+    /* Capture age */
+    convertUint32_tToBytes(captureAge, dest + SIZE_HEADER + SIZE_TIMESTAMP + SIZE_POSITION);
 }
 
 extern void TranslatorLOG_translateForRepCalibrationPosition(uint8_t nbCalibrationPositions, const CalibrationPosition* calibrationPositions, Trame* dest) {
@@ -410,7 +475,7 @@ extern void TranslatorLOG_translateForSendCalibrationData(const CalibrationData*
     for (uint8_t i = 0; i < nbCalibrationData; i++) {
         uint8_t sizeBeaconCalibrationDataCurrent = 0;
 
-        memcpy(&(dest[sizeBeaconCalibrationDataPrevious]), &(calibrationsData[i].beaconId), SIZE_BEACON_ID);
+        memcpy(&(dest[sizeBeaconCalibrationDataPrevious]), BeaconRegistry_getName(calibrationsData[i].beaconIndex), SIZE_BEACON_ID);
         sizeBeaconCalibrationDataCurrent += SIZE_BEACON_ID;
 
         convertFloatToByte(calibrationsData[i].coefficientAverage, &(dest[sizeBeaconCalibrationDataPrevious + sizeBeaconCalibrationDataCurrent]));
@@ -498,7 +563,7 @@ static void convertPositionToByte(const Position* position, Trame* dest) {
 
 static void convertBeaconDataToByte(const BeaconData* beaconData, Trame* dest) {
     /* ID */
-    memcpy(dest, beaconData->ID, SIZE_BEACON_ID);
+    memcpy(dest, BeaconRegistry_getName(beaconData->index), SIZE_BEACON_ID);
 
     /* Position */
     convertPositionToByte(&(beaconData->position), dest + SIZE_BEACON_ID);
@@ -509,3 +574,26 @@ static void convertBeaconDataToByte(const BeaconData* beaconData, Trame* dest) {
     /* Attenuation Coefficient */
     convertFloatToByte(beaconData->coefficientAverage, dest + SIZE_BEACON_ID + SIZE_POSITION + SIZE_POWER);
 }
+
+static void convertBeaconStatisticsToByte(const BeaconStatistics* beaconStatistics, Trame* dest) {
+    /* ID */
+    memcpy(dest, BeaconRegistry_getName(beaconStatistics->index), SIZE_BEACON_ID);
+    dest += SIZE_BEACON_ID;
+
+    /* Last seen age */
+    convertUint32_tToBytes(beaconStatistics->lastSeenAge, dest);
+    dest += SIZE_LAST_SEEN_AGE;
+
+    /* Advertising rate */
+    convertFloatToByte(beaconStatistics->advertisingRate, dest);
+    dest += SIZE_ADVERTISING_RATE;
+
+    /* RSSI mean and variance */
+    convertFloatToByte(beaconStatistics->rssiMean, dest);
+    dest += SIZE_RSSI_STATISTIC;
+    convertFloatToByte(beaconStatistics->rssiVariance, dest);
+    dest += SIZE_RSSI_STATISTIC;
+
+    /* Number of dropouts */
+    convertUint16_tToBytes(beaconStatistics->nbDropouts, dest);
+}
@@ -122,19 +122,35 @@ extern void TranslatorLOG_translateForSendExperimentalTrajects(const Experimenta
  */
 extern void TranslatorLOG_translateForSendAllBeaconsData(uint8_t nbBeacons, const BeaconData* beaconsData, Date currentDate, Trame* dest);
 
+/**
+ * @brief Traduit les statistiques de reception des balises en une trame. Compose aussi le header.
+ *
+ * Traduit le tableau @a beaconsStatistics en une #Trame et place la traduction dans @a dest.
+ *
+ * @param nbBeacons Le nombre de statistiques de balise a traduire.
+ * @param beaconsStatistics Les statistiques de balise a traduire.
+ * @param currentDate La date a laquelle les statistiques on ete relevee.
+ * @param dest La trame de destination de la traduction.
+ *
+ * @warning @a dest doit etre de la bonne taille.
+ * @see #TranslatorLOG_getTrameSize
+ */
+extern void TranslatorLOG_translateForSendBeaconsStatistics(uint8_t nbBeacons, const BeaconStatistics* beaconsStatistics, Date currentDate, Trame* dest);
+
 /**
  * @brief Traduit la position courante en une trame. Compose aussi le header.
  *
  * Traduit @a currentPosition en une #Trame et place la traduction dans @a dest.
  *
  * @param currentPosition La position courante a traduire.
+ * @param captureAge L'anciennete de la position en milliseconde, #CAPTURE_AGE_UNKNOWN si inconnue.
  * @param currentDate La date a laquelle les donnees on ete relevee.
  * @param dest La trame de destination de la traduction.
  *
  * @warning @a dest doit etre de la bonne taille.
  * @see #TranslatorLOG_getTrameSize
  */
-extern void TranslatorLOG_translateForSendCurrentPosition(const Position* currentPosition, Date currentDate, Trame* dest);
+extern void TranslatorLOG_translateForSendCurrentPosition(const Position* currentPosition, uint32_t captureAge, Date currentDate, Trame* dest);
 
 /**
  * @brief Traduit les donnees de calibration en une trame. Compose aussi le header.
@@ -28,6 +28,11 @@
  */
 #define SIZE_HEADER (3)
 
+/**
+ * @brief L'anciennete envoyee pour une position dont la date de capture est inconnue.
+ */
+#define CAPTURE_AGE_UNKNOWN (UINT32_MAX)
+
 /**
  * @brief Tableau de uint8_t composant un message envoye entre GEOMOBILE et GEOLOGIE.
  */
@@ -63,7 +68,9 @@ typedef enum {
     SIGNAL_CALIRATION_END = 0x0A,           /**< GEOLOGIE signale a GEOMOBILE la fin du calibrage. */
     SIGNAL_CALIBRATION_END_POSITION = 0x0B, /**< GEOLOGIE signale a GEOMOBILE la fin du calibrage a la position actuelle */
 
-    NB_COMMANDE = 11,                       /**< Le nombre de commande */
+    SEND_BEACONS_STATISTICS = 0x0C,         /**< GEOLOGIE envoie a GEOMOBILE les statistiques de reception des balises actives. */
+
+    NB_COMMANDE = 12,                       /**< Le nombre de commande */
 } Commande;
 
 /**
@@ -0,0 +1,326 @@
+/**
+ * @file filterBank.c
+ *
+ * @brief Filtre en continu le RSSI de chaque balise, trame par trame.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "filterBank.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "../tools.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le facteur qui rend l'ecart absolu median comparable a l'ecart type d'un bruit gaussien.
+ */
+#define MAD_SCALE (1.4826f)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La configuration commune a tous les filtres, sans filtre par defaut.
+ */
+static FilterBankConfiguration configuration = {
+    .type = FILTER_BANK_RAW,
+    .window = 9,
+    .alpha = 0.3f,
+    .threshold = 3
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ajoute une valeur a la fenetre glissante, en remplacant la plus ancienne si la fenetre est pleine.
+ *
+ * @param median La mediane glissante.
+ * @param value La nouvelle valeur.
+ */
+static void pushValue(SlidingMedian* median, float value);
+
+/**
+ * @brief Donne la mediane de la fenetre, qui ne doit pas etre vide.
+ *
+ * @param median La mediane glissante.
+ * @return float La mediane.
+ */
+static float getMedian(const SlidingMedian* median);
+
+/**
+ * @brief Ajoute une estimation a la fenetre glissante de la variance, en remplacant la plus ancienne si la fenetre
+ * est pleine.
+ *
+ * @param variance La variance glissante.
+ * @param value La nouvelle estimation.
+ */
+static void pushEstimate(SlidingVariance* variance, int8_t value);
+
+/**
+ * @brief Vrai si l'emplacement a doit etre au dessus de l'emplacement b dans le tas.
+ */
+static bool isBefore(const SlidingMedian* median, bool isLow, uint8_t a, uint8_t b);
+
+/**
+ * @brief Echange deux elements d'un tas en tenant a jour leurs indices.
+ */
+static void swapNodes(SlidingMedian* median, uint8_t* heap, uint8_t i, uint8_t j);
+
+/**
+ * @brief Remonte l'element d'indice i du tas tant qu'il passe avant son parent.
+ */
+static void siftUp(SlidingMedian* median, bool isLow, uint8_t i);
+
+/**
+ * @brief Descend l'element d'indice i du tas tant qu'un de ses enfants passe avant lui.
+ */
+static void siftDown(SlidingMedian* median, bool isLow, uint8_t i);
+
+/**
+ * @brief Deplace la racine d'un tas dans l'autre.
+ */
+static void moveRoot(SlidingMedian* median, bool isLow);
+
+/**
+ * @brief Echange les racines des deux tas si la plus grande des petites valeurs depasse la plus petite des grandes.
+ */
+static void orderRoots(SlidingMedian* median);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern int8_t FilterBank_configure(const FilterBankConfiguration* newConfiguration) {
+    if (newConfiguration->type > FILTER_BANK_HAMPEL
+        || newConfiguration->window == 0 || newConfiguration->window > FILTER_BANK_WINDOW_MAX
+        || !(newConfiguration->alpha > 0) || newConfiguration->alpha > 1
+        || !(newConfiguration->threshold > 0)) {
+        LOG("[FilterBank] Invalid configuration%s", "\n");
+        return -1;
+    }
+
+    configuration = *newConfiguration;
+    return 0;
+}
+
+extern void FilterBank_getConfiguration(FilterBankConfiguration* currentConfiguration) {
+    *currentConfiguration = configuration;
+}
+
+extern void FilterBank_reset(RssiFilter* filter) {
+    filter->isInitialized = false;
+    filter->samples.nbLow = filter->samples.nbHigh = filter->samples.nbValues = filter->samples.oldest = 0;
+    filter->deviations.nbLow = filter->deviations.nbHigh = filter->deviations.nbValues = filter->deviations.oldest = 0;
+    filter->estimates.sum = filter->estimates.sumSquares = 0;
+    filter->estimates.nbValues = filter->estimates.oldest = 0;
+}
+
+extern int8_t FilterBank_update(RssiFilter* filter, int8_t rssi) {
+    float estimate = rssi;
+
+    switch (configuration.type) {
+        case FILTER_BANK_EMA:
+            if (filter->isInitialized) {
+                filter->average += configuration.alpha * (rssi - filter->average);
+            } else {
+                filter->average = rssi;
+            }
+            estimate = filter->average;
+            break;
+
+        case FILTER_BANK_MEDIAN:
+            pushValue(&filter->samples, rssi);
+            estimate = getMedian(&filter->samples);
+            break;
+
+        case FILTER_BANK_HAMPEL: {
+            pushValue(&filter->samples, rssi);
+            float median = getMedian(&filter->samples);
+            float deviation = fabsf(rssi - median);
+            pushValue(&filter->deviations, deviation);
+            if (deviation > configuration.threshold * MAD_SCALE * getMedian(&filter->deviations)) {
+                estimate = median;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    int8_t roundedEstimate = (int8_t) lroundf(estimate);
+    pushEstimate(&filter->estimates, roundedEstimate);
+    filter->isInitialized = true;
+    return roundedEstimate;
+}
+
+extern float FilterBank_getVariance(const RssiFilter* filter) {
+    const SlidingVariance* estimates = &filter->estimates;
+    int64_t nbValues = estimates->nbValues;
+
+    if (nbValues < 2) {
+        return 0;
+    }
+
+    /* n * somme des carres - somme au carre reste entiere : seule la division finale arrondit */
+    float variance = (float) (nbValues * estimates->sumSquares - (int64_t) estimates->sum * estimates->sum) / (float) (nbValues * nbValues);
+    return variance > FILTER_BANK_VARIANCE_MIN ? variance : FILTER_BANK_VARIANCE_MIN;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void pushValue(SlidingMedian* median, float value) {
+    uint8_t slot;
+
+    if (median->nbValues < configuration.window) {
+        /* La fenetre se remplit : la valeur entre par le tas des petites valeurs puis les tas sont reequilibres */
+        slot = median->nbValues++;
+        median->values[slot] = value;
+        median->isLow[slot] = true;
+        median->heapIndex[slot] = median->nbLow;
+        median->low[median->nbLow++] = slot;
+        siftUp(median, true, median->heapIndex[slot]);
+
+        moveRoot(median, true);
+        if (median->nbHigh > median->nbLow) {
+            moveRoot(median, false);
+        }
+    } else {
+        /* La fenetre est pleine : la valeur prend la place de la plus ancienne, dans le meme tas */
+        slot = median->oldest;
+        median->oldest = (uint8_t) ((median->oldest + 1) % median->nbValues);
+        median->values[slot] = value;
+        siftUp(median, median->isLow[slot], median->heapIndex[slot]);
+        siftDown(median, median->isLow[slot], median->heapIndex[slot]);
+        orderRoots(median);
+    }
+}
+
+static float getMedian(const SlidingMedian* median) {
+    if (median->nbLow > median->nbHigh) {
+        return median->values[median->low[0]];
+    }
+    return (median->values[median->low[0]] + median->values[median->high[0]]) / 2;
+}
+
+static void pushEstimate(SlidingVariance* variance, int8_t value) {
+    uint8_t slot;
+
+    if (variance->nbValues < configuration.window) {
+        slot = variance->nbValues++;
+    } else {
+        slot = variance->oldest;
+        variance->oldest = (uint8_t) ((variance->oldest + 1) % variance->nbValues);
+        variance->sum -= variance->values[slot];
+        variance->sumSquares -= variance->values[slot] * variance->values[slot];
+    }
+    variance->values[slot] = value;
+    variance->sum += value;
+    variance->sumSquares += value * value;
+}
+
+static bool isBefore(const SlidingMedian* median, bool isLow, uint8_t a, uint8_t b) {
+    return isLow ? median->values[a] > median->values[b] : median->values[a] < median->values[b];
+}
+
+static void swapNodes(SlidingMedian* median, uint8_t* heap, uint8_t i, uint8_t j) {
+    uint8_t slot = heap[i];
+    heap[i] = heap[j];
+    heap[j] = slot;
+    median->heapIndex[heap[i]] = i;
+    median->heapIndex[heap[j]] = j;
+}
+
+static void siftUp(SlidingMedian* median, bool isLow, uint8_t i) {
+    uint8_t* heap = isLow ? median->low : median->high;
+
+    while (i > 0 && isBefore(median, isLow, heap[i], heap[(i - 1) / 2])) {
+        swapNodes(median, heap, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void siftDown(SlidingMedian* median, bool isLow, uint8_t i) {
+    uint8_t* heap = isLow ? median->low : median->high;
+    uint8_t size = isLow ? median->nbLow : median->nbHigh;
+
+    for (;;) {
+        uint8_t first = i;
+        uint8_t left = 2 * i + 1;
+        uint8_t right = 2 * i + 2;
+
+        if (left < size && isBefore(median, isLow, heap[left], heap[first])) {
+            first = left;
+        }
+        if (right < size && isBefore(median, isLow, heap[right], heap[first])) {
+            first = right;
+        }
+        if (first == i) {
+            return;
+        }
+        swapNodes(median, heap, i, first);
+        i = first;
+    }
+}
+
+static void moveRoot(SlidingMedian* median, bool isLow) {
+    uint8_t* from = isLow ? median->low : median->high;
+    uint8_t* to = isLow ? median->high : median->low;
+    uint8_t* nbFrom = isLow ? &median->nbLow : &median->nbHigh;
+    uint8_t* nbTo = isLow ? &median->nbHigh : &median->nbLow;
+    uint8_t slot = from[0];
+
+    (*nbFrom)--;
+    from[0] = from[*nbFrom];
+    median->heapIndex[from[0]] = 0;
+    siftDown(median, isLow, 0);
+
+    median->isLow[slot] = !isLow;
+    median->heapIndex[slot] = *nbTo;
+    to[(*nbTo)++] = slot;
+    siftUp(median, !isLow, median->heapIndex[slot]);
+}
+
+static void orderRoots(SlidingMedian* median) {
+    if (median->nbHigh == 0 || median->values[median->low[0]] <= median->values[median->high[0]]) {
+        return;
+    }
+
+    uint8_t slot = median->low[0];
+    median->low[0] = median->high[0];
+    median->high[0] = slot;
+    median->isLow[median->low[0]] = true;
+    median->isLow[median->high[0]] = false;
+    siftDown(median, true, 0);
+    siftDown(median, false, 0);
+}
@@ -0,0 +1,170 @@
+/**
+ * @file filterBank.h
+ *
+ * @brief Filtre en continu le RSSI de chaque balise, trame par trame.
+ *
+ * Chaque balise suivie possede son propre #RssiFilter, alloue par l'appelant. Le type de filtre et ses parametres
+ * sont communs a toutes les balises :
+ * - #FILTER_BANK_EMA : moyenne mobile exponentielle, mise a jour en O(1) ;
+ * - #FILTER_BANK_MEDIAN : mediane glissante sur une fenetre circulaire, tenue par deux tas, mise a jour en O(log w) ;
+ * - #FILTER_BANK_HAMPEL : remplace par la mediane glissante les trames qui s'en ecartent de plus de threshold fois
+ *   l'ecart absolu median, estime par une seconde mediane glissante des ecarts, mise a jour en O(log w).
+ *
+ * Chaque filtre tient aussi la variance de ses dernieres estimations, sur la meme fenetre glissante : c'est la
+ * dispersion de la puissance donnee aux calculs de position, que le filtre l'ait lissee ou non.
+ *
+ * Un filtre n'est pas protege contre les acces concurrents : il doit etre mis a jour par un seul thread.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+#ifndef FILTER_BANK_
+#define FILTER_BANK_
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La taille maximale de la fenetre glissante d'un filtre, en nombre de trames.
+ */
+#define FILTER_BANK_WINDOW_MAX (31)
+
+/**
+ * @brief La variance minimale donnee par #FilterBank_getVariance, en dBm carre : celle de l'arrondi des estimations
+ * au dBm entier, pour qu'une balise dont les estimations ne bougent pas ne passe pas pour inconnue.
+ */
+#define FILTER_BANK_VARIANCE_MIN (1.0f / 12)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les filtres disponibles.
+ */
+typedef enum {
+    FILTER_BANK_RAW = 0,    /**< Pas de filtre, le RSSI de la derniere trame est conserve. */
+    FILTER_BANK_EMA,        /**< Moyenne mobile exponentielle. */
+    FILTER_BANK_MEDIAN,     /**< Mediane glissante. */
+    FILTER_BANK_HAMPEL      /**< Filtre de Hampel. */
+} FilterType;
+
+/**
+ * @brief La configuration commune a tous les filtres.
+ */
+typedef struct {
+    FilterType type;    /**< Le filtre applique. */
+    uint8_t window;     /**< La taille de la fenetre glissante, de 1 a #FILTER_BANK_WINDOW_MAX. */
+    float alpha;        /**< Le poids de la nouvelle trame dans la moyenne exponentielle, dans ]0, 1]. */
+    float threshold;    /**< Le seuil du filtre de Hampel, en nombre d'ecarts absolus medians normalises. */
+} FilterBankConfiguration;
+
+/**
+ * @brief La mediane d'une fenetre glissante.
+ *
+ * Les emplacements de la fenetre sont repartis entre un tas max des plus petites valeurs et un tas min des plus
+ * grandes, le premier ayant autant ou un element de plus que le second.
+ */
+typedef struct {
+    float values[FILTER_BANK_WINDOW_MAX];       /**< Les valeurs de la fenetre, par emplacement circulaire. */
+    uint8_t low[FILTER_BANK_WINDOW_MAX];        /**< Le tas max des emplacements des plus petites valeurs. */
+    uint8_t high[FILTER_BANK_WINDOW_MAX];       /**< Le tas min des emplacements des plus grandes valeurs. */
+    uint8_t heapIndex[FILTER_BANK_WINDOW_MAX];  /**< L'indice de chaque emplacement dans son tas. */
+    bool isLow[FILTER_BANK_WINDOW_MAX];         /**< Vrai si l'emplacement est dans le tas des plus petites valeurs. */
+    uint8_t nbLow;                              /**< Le nombre d'elements du tas des plus petites valeurs. */
+    uint8_t nbHigh;                             /**< Le nombre d'elements du tas des plus grandes valeurs. */
+    uint8_t nbValues;                           /**< Le nombre de valeurs dans la fenetre. */
+    uint8_t oldest;                             /**< L'emplacement de la valeur la plus ancienne. */
+} SlidingMedian;
+
+/**
+ * @brief La variance d'une fenetre glissante d'estimations.
+ *
+ * Les estimations etant des RSSI entiers, leur somme et la somme de leurs carres sont tenues exactement, sans
+ * derive au fil des remplacements.
+ */
+typedef struct {
+    int8_t values[FILTER_BANK_WINDOW_MAX];  /**< Les estimations de la fenetre, par emplacement circulaire. */
+    int32_t sum;                            /**< La somme des estimations de la fenetre. */
+    int32_t sumSquares;                     /**< La somme des carres des estimations de la fenetre. */
+    uint8_t nbValues;                       /**< Le nombre d'estimations dans la fenetre. */
+    uint8_t oldest;                         /**< L'emplacement de l'estimation la plus ancienne. */
+} SlidingVariance;
+
+/**
+ * @brief L'etat du filtre d'une balise.
+ */
+typedef struct {
+    float average;              /**< La moyenne exponentielle. */
+    bool isInitialized;         /**< Vrai si le filtre a deja recu une trame. */
+    SlidingMedian samples;      /**< La mediane glissante des RSSI recus. */
+    SlidingMedian deviations;   /**< La mediane glissante des ecarts a la mediane, pour le filtre de Hampel. */
+    SlidingVariance estimates;  /**< La variance glissante des estimations rendues. */
+} RssiFilter;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Change le filtre applique a toutes les balises.
+ *
+ * A appeler avant le demarrage de Receiver, les filtres deja alimentes doivent etre reinitialises.
+ *
+ * @param configuration La nouvelle configuration.
+ * @return int8_t -1 si la configuration est invalide, 0 sinon.
+ */
+extern int8_t FilterBank_configure(const FilterBankConfiguration* configuration);
+
+/**
+ * @brief Donne la configuration courante.
+ *
+ * @param configuration La configuration a remplir.
+ */
+extern void FilterBank_getConfiguration(FilterBankConfiguration* configuration);
+
+/**
+ * @brief Vide le filtre d'une balise.
+ *
+ * @param filter Le filtre a vider.
+ */
+extern void FilterBank_reset(RssiFilter* filter);
+
+/**
+ * @brief Ajoute le RSSI d'une trame au filtre d'une balise.
+ *
+ * @param filter Le filtre de la balise.
+ * @param rssi Le RSSI de la trame.
+ * @return int8_t L'estimation filtree du RSSI de la balise.
+ */
+extern int8_t FilterBank_update(RssiFilter* filter, int8_t rssi);
+
+/**
+ * @brief Donne la variance des dernieres estimations du filtre d'une balise, sur la fenetre glissante.
+ *
+ * @param filter Le filtre de la balise.
+ * @return float La variance en dBm carre, au moins #FILTER_BANK_VARIANCE_MIN, ou 0 si le filtre a rendu moins de
+ * deux estimations depuis sa remise a zero.
+ */
+extern float FilterBank_getVariance(const RssiFilter* filter);
+
+#endif /* FILTER_BANK_ */
@@ -0,0 +1,513 @@
+/**
+ * @file fingerprint.c
+ *
+ * @brief Localise le robot par les empreintes radio relevees aux positions de calibration, moteur alternatif a
+ * Mathematician.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "fingerprint.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "../tools.h"
+#include "../MathematicianLOG/mathematicianLOG.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre d'empreintes de reference allouees a la premiere, la table double ensuite a chaque fois qu'elle
+ * est pleine.
+ */
+#define NB_REFERENCES_INITIAL (32)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Une empreinte relevee a une position de calibration, telle que recue.
+ */
+typedef struct {
+    Position position;                                  /**< La position de calibration. */
+    uint8_t nbMeasures;                                 /**< Le nombre de balises recues, au plus #FINGERPRINT_NB_MEASURES_MAX. */
+    BeaconIndex beacons[FINGERPRINT_NB_MEASURES_MAX];   /**< Les indices des balises recues. */
+    Power powers[FINGERPRINT_NB_MEASURES_MAX];          /**< Leurs puissances. */
+} Reference;
+
+/**
+ * @brief Un noeud de l'arbre k-d : une empreinte de la carte radio.
+ *
+ * L'arbre est implicite : le noeud d'un intervalle de la table en est le milieu, son sous-arbre gauche la moitie
+ * d'avant, dont les puissances sur la dimension de coupe sont inferieures ou egales a la sienne, son sous-arbre
+ * droit la moitie d'apres.
+ */
+typedef struct {
+    float rssi[FINGERPRINT_NB_DIMENSIONS];  /**< Les puissances des balises de la carte, #FINGERPRINT_RSSI_MISSING si elles ne sont pas recues. */
+    Position position;                      /**< La position de calibration. */
+    uint8_t splitDimension;                 /**< La dimension qui separe les deux sous-arbres. */
+} Node;
+
+/**
+ * @brief Un voisin trouve par la recherche.
+ */
+typedef struct {
+    float squaredDistance;  /**< Le carre de la distance entre son empreinte et celle du cycle, en dB². */
+    uint32_t node;          /**< L'indice de son noeud. */
+} Neighbour;
+
+/**
+ * @brief Le nombre de voisins moyennes, 0 si les empreintes sont desactivees.
+ */
+static uint8_t nbNeighbours = 0;
+
+/**
+ * @brief Les empreintes ajoutees depuis la derniere carte oubliee.
+ */
+static Reference* references = NULL;
+static uint32_t nbReferences = 0;
+static uint32_t referencesCapacity = 0;
+
+/**
+ * @brief Vrai si la carte a ete construite depuis le dernier ajout : l'ajout suivant commence une nouvelle
+ * calibration.
+ */
+static bool isBuilt = false;
+
+/**
+ * @brief Les noeuds de l'arbre k-d de la carte radio, aucun tant qu'elle n'est pas construite.
+ */
+static Node* nodes = NULL;
+static uint32_t nbNodes = 0;
+
+/**
+ * @brief La dimension de chaque balise dans la carte radio, par indice de balise, -1 si elle n'en fait pas partie.
+ */
+static int8_t* beaconDimensions = NULL;
+static uint32_t nbBeaconDimensions = 0;
+static uint8_t nbDimensions = 0;
+
+/**
+ * @brief L'empreinte du cycle et les voisins trouves, les plus proches en tete.
+ */
+static float queryRssi[FINGERPRINT_NB_DIMENSIONS];
+static Neighbour neighbours[FINGERPRINT_NB_NEIGHBOURS_MAX];
+static uint8_t nbNeighboursFound;
+static uint8_t nbNeighboursSearched;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Choisit les dimensions de la carte : les balises recues au plus grand nombre de positions, les plus fortes
+ * en moyenne a egalite.
+ *
+ * @return int8_t -1 si l'allocation a echoue, 0 sinon.
+ */
+static int8_t selectDimensions();
+
+/**
+ * @brief Construit l'arbre k-d sur un intervalle de noeuds.
+ *
+ * @param begin Le premier noeud.
+ * @param end Le noeud qui suit le dernier.
+ */
+static void buildTree(uint32_t begin, uint32_t end);
+
+/**
+ * @brief Place a l'indice donne le noeud qui y serait si l'intervalle etait trie sur une dimension, les plus petits
+ * avant et les plus grands apres.
+ *
+ * @param begin Le premier noeud.
+ * @param end Le noeud qui suit le dernier.
+ * @param median L'indice du noeud a placer.
+ * @param dimension La dimension de tri.
+ */
+static void selectNode(uint32_t begin, uint32_t end, uint32_t median, uint8_t dimension);
+
+/**
+ * @brief Echange deux noeuds.
+ */
+static void swapNodes(uint32_t first, uint32_t second);
+
+/**
+ * @brief Cherche les voisins de l'empreinte du cycle dans le sous-arbre d'un intervalle de noeuds.
+ *
+ * @param begin Le premier noeud.
+ * @param end Le noeud qui suit le dernier.
+ */
+static void searchTree(uint32_t begin, uint32_t end);
+
+/**
+ * @brief Ajoute un noeud aux voisins s'il est plus proche que le plus eloigne d'entre eux.
+ *
+ * @param node L'indice du noeud.
+ * @param squaredDistance Le carre de la distance de son empreinte a celle du cycle.
+ */
+static void insertNeighbour(uint32_t node, float squaredDistance);
+
+/**
+ * @brief Indique si un sous-arbre dont toutes les empreintes sont au moins a une distance donnee peut contenir un
+ * voisin.
+ *
+ * @param squaredDistance Le carre de la distance.
+ * @return bool Vrai si les voisins ne sont pas tous trouves ou si le plus eloigne est plus loin.
+ */
+static bool canContainNeighbour(float squaredDistance);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void Fingerprint_setNbNeighbours(uint8_t nbNeighboursRequested) {
+    nbNeighbours = nbNeighboursRequested > FINGERPRINT_NB_NEIGHBOURS_MAX ? FINGERPRINT_NB_NEIGHBOURS_MAX : nbNeighboursRequested;
+}
+
+extern bool Fingerprint_isEnabled() {
+    return nbNeighbours > 0;
+}
+
+extern bool Fingerprint_isReady() {
+    return nbNeighbours > 0 && nbNodes > 0;
+}
+
+extern int8_t Fingerprint_addReference(const Position* position, const BeaconData* beaconsData, uint32_t nbBeacon) {
+    if (nbNeighbours == 0) {
+        return -1;
+    }
+
+    if (isBuilt) {
+        Fingerprint_reset();
+    }
+
+    if (nbReferences == referencesCapacity) {
+        uint32_t capacity = referencesCapacity == 0 ? NB_REFERENCES_INITIAL : 2 * referencesCapacity;
+        Reference* grown = realloc(references, capacity * sizeof(Reference));
+        if (grown == NULL) {
+            ERROR(true, "[Fingerprint] Fail to allocate the references");
+            return -1;
+        }
+        references = grown;
+        referencesCapacity = capacity;
+    }
+
+    Reference* reference = &references[nbReferences];
+    uint8_t weakest = 0;
+    reference->position = *position;
+    reference->nbMeasures = 0;
+    for (uint32_t i = 0; i < nbBeacon; i++) {
+        uint8_t measure = reference->nbMeasures;
+
+        /* Une fois l'empreinte pleine, une balise n'entre qu'a la place de la plus faible des balises gardees */
+        if (reference->nbMeasures == FINGERPRINT_NB_MEASURES_MAX) {
+            if (beaconsData[i].power <= reference->powers[weakest]) {
+                continue;
+            }
+            measure = weakest;
+        } else {
+            reference->nbMeasures++;
+        }
+        reference->beacons[measure] = beaconsData[i].index;
+        reference->powers[measure] = beaconsData[i].power;
+
+        if (reference->nbMeasures == FINGERPRINT_NB_MEASURES_MAX) {
+            weakest = 0;
+            for (uint8_t m = 1; m < FINGERPRINT_NB_MEASURES_MAX; m++) {
+                if (reference->powers[m] < reference->powers[weakest]) {
+                    weakest = m;
+                }
+            }
+        }
+    }
+    nbReferences++;
+
+    return 0;
+}
+
+extern int8_t Fingerprint_build() {
+    nbNodes = 0;
+    isBuilt = true;
+    if (nbReferences == 0) {
+        return -1;
+    }
+
+    Node* allocatedNodes = realloc(nodes, nbReferences * sizeof(Node));
+    if (allocatedNodes != NULL) {
+        nodes = allocatedNodes;
+    }
+    if (allocatedNodes == NULL || selectDimensions() < 0) {
+        ERROR(true, "[Fingerprint] Fail to allocate the radio map");
+        return -1;
+    }
+
+    for (uint32_t r = 0; r < nbReferences; r++) {
+        for (uint8_t d = 0; d < FINGERPRINT_NB_DIMENSIONS; d++) {
+            nodes[r].rssi[d] = FINGERPRINT_RSSI_MISSING;
+        }
+        for (uint8_t i = 0; i < references[r].nbMeasures; i++) {
+            int8_t dimension = beaconDimensions[references[r].beacons[i]];
+            if (dimension >= 0 && references[r].powers[i] > FINGERPRINT_RSSI_MISSING) {
+                nodes[r].rssi[dimension] = references[r].powers[i];
+            }
+        }
+        nodes[r].position = references[r].position;
+        nodes[r].splitDimension = 0;
+    }
+    buildTree(0, nbReferences);
+    nbNodes = nbReferences;
+
+    return 0;
+}
+
+extern int8_t Fingerprint_getCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition) {
+    uint8_t nbSeen = 0;
+
+    if (!Fingerprint_isReady()) {
+        return -1;
+    }
+
+    for (uint8_t d = 0; d < FINGERPRINT_NB_DIMENSIONS; d++) {
+        queryRssi[d] = FINGERPRINT_RSSI_MISSING;
+    }
+    for (uint32_t i = 0; i < nbBeacon; i++) {
+        if (beaconsData[i].index < nbBeaconDimensions && beaconDimensions[beaconsData[i].index] >= 0) {
+            queryRssi[beaconDimensions[beaconsData[i].index]] = beaconsData[i].power > FINGERPRINT_RSSI_MISSING ? beaconsData[i].power : FINGERPRINT_RSSI_MISSING;
+            nbSeen++;
+        }
+    }
+
+    /* Une carte de moins de NB_BEACONS_POSITION balises demande seulement de les recevoir toutes */
+    if (nbSeen < (nbDimensions < NB_BEACONS_POSITION ? nbDimensions : NB_BEACONS_POSITION)) {
+        return -1;
+    }
+
+    nbNeighboursSearched = nbNodes < nbNeighbours ? (uint8_t) nbNodes : nbNeighbours;
+    nbNeighboursFound = 0;
+    searchTree(0, nbNodes);
+
+    double sumWeights = 0;
+    double sumX = 0;
+    double sumY = 0;
+    for (uint8_t k = 0; k < nbNeighboursFound; k++) {
+        double weight = 1.0 / (sqrt(neighbours[k].squaredDistance) + FINGERPRINT_DISTANCE_MIN);
+        sumWeights += weight;
+        sumX += weight * nodes[neighbours[k].node].position.X;
+        sumY += weight * nodes[neighbours[k].node].position.Y;
+    }
+    currentPosition->X = (uint32_t) lround(sumX / sumWeights);
+    currentPosition->Y = (uint32_t) lround(sumY / sumWeights);
+
+    return 0;
+}
+
+extern void Fingerprint_reset() {
+    nbReferences = 0;
+    nbNodes = 0;
+    nbDimensions = 0;
+    isBuilt = false;
+}
+
+extern void Fingerprint_free() {
+    Fingerprint_reset();
+    free(references);
+    free(nodes);
+    free(beaconDimensions);
+    references = NULL;
+    nodes = NULL;
+    beaconDimensions = NULL;
+    referencesCapacity = 0;
+    nbBeaconDimensions = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int8_t selectDimensions() {
+    uint32_t nbIndices = 0;
+
+    for (uint32_t r = 0; r < nbReferences; r++) {
+        for (uint8_t i = 0; i < references[r].nbMeasures; i++) {
+            if (references[r].beacons[i] >= nbIndices) {
+                nbIndices = (uint32_t) references[r].beacons[i] + 1;
+            }
+        }
+    }
+
+    uint32_t* nbPositions = calloc(nbIndices > 0 ? nbIndices : 1, sizeof(uint32_t));
+    float* sumPowers = calloc(nbIndices > 0 ? nbIndices : 1, sizeof(float));
+    int8_t* dimensions = realloc(beaconDimensions, (nbIndices > 0 ? nbIndices : 1) * sizeof(int8_t));
+    if (dimensions != NULL) {
+        beaconDimensions = dimensions;
+    }
+    if (nbPositions == NULL || sumPowers == NULL || dimensions == NULL) {
+        free(nbPositions);
+        free(sumPowers);
+        return -1;
+    }
+    nbBeaconDimensions = nbIndices;
+
+    for (uint32_t r = 0; r < nbReferences; r++) {
+        for (uint8_t i = 0; i < references[r].nbMeasures; i++) {
+            nbPositions[references[r].beacons[i]]++;
+            sumPowers[references[r].beacons[i]] += references[r].powers[i];
+        }
+    }
+
+    for (uint32_t b = 0; b < nbIndices; b++) {
+        beaconDimensions[b] = -1;
+    }
+    for (nbDimensions = 0; nbDimensions < FINGERPRINT_NB_DIMENSIONS; nbDimensions++) {
+        uint32_t best = nbIndices;
+        for (uint32_t b = 0; b < nbIndices; b++) {
+            if (nbPositions[b] == 0 || beaconDimensions[b] >= 0) {
+                continue;
+            }
+            if (best == nbIndices || nbPositions[b] > nbPositions[best]
+                || (nbPositions[b] == nbPositions[best] && sumPowers[b] / nbPositions[b] > sumPowers[best] / nbPositions[best])) {
+                best = b;
+            }
+        }
+        if (best == nbIndices) {
+            break;
+        }
+        beaconDimensions[best] = (int8_t) nbDimensions;
+    }
+
+    free(nbPositions);
+    free(sumPowers);
+    return 0;
+}
+
+static void buildTree(uint32_t begin, uint32_t end) {
+    if (end - begin <= 1) {
+        return;
+    }
+
+    /* La coupe suit la dimension ou les empreintes de l'intervalle sont le plus etalees */
+    uint8_t dimension = 0;
+    float spreadMax = -1;
+    for (uint8_t d = 0; d < nbDimensions; d++) {
+        float minimum = nodes[begin].rssi[d];
+        float maximum = minimum;
+        for (uint32_t i = begin + 1; i < end; i++) {
+            minimum = nodes[i].rssi[d] < minimum ? nodes[i].rssi[d] : minimum;
+            maximum = nodes[i].rssi[d] > maximum ? nodes[i].rssi[d] : maximum;
+        }
+        if (maximum - minimum > spreadMax) {
+            spreadMax = maximum - minimum;
+            dimension = d;
+        }
+    }
+
+    uint32_t median = begin + (end - begin) / 2;
+    selectNode(begin, end, median, dimension);
+    nodes[median].splitDimension = dimension;
+
+    buildTree(begin, median);
+    buildTree(median + 1, end);
+}
+
+static void selectNode(uint32_t begin, uint32_t end, uint32_t median, uint8_t dimension) {
+    /* Partition en trois parts pour que les nombreuses balises non recues, toutes egales, ne degradent pas la selection */
+    while (end - begin > 1) {
+        float pivot = nodes[begin + (end - begin) / 2].rssi[dimension];
+        uint32_t lower = begin;
+        uint32_t upper = end;
+        uint32_t i = begin;
+
+        while (i < upper) {
+            if (nodes[i].rssi[dimension] < pivot) {
+                swapNodes(lower++, i++);
+            } else if (nodes[i].rssi[dimension] > pivot) {
+                swapNodes(i, --upper);
+            } else {
+                i++;
+            }
+        }
+
+        if (median < lower) {
+            end = lower;
+        } else if (median >= upper) {
+            begin = upper;
+        } else {
+            return;
+        }
+    }
+}
+
+static void swapNodes(uint32_t first, uint32_t second) {
+    Node node = nodes[first];
+    nodes[first] = nodes[second];
+    nodes[second] = node;
+}
+
+static void searchTree(uint32_t begin, uint32_t end) {
+    if (begin >= end) {
+        return;
+    }
+
+    uint32_t median = begin + (end - begin) / 2;
+    float squaredDistance = 0;
+    for (uint8_t d = 0; d < FINGERPRINT_NB_DIMENSIONS; d++) {
+        float difference = queryRssi[d] - nodes[median].rssi[d];
+        squaredDistance += difference * difference;
+    }
+    insertNeighbour(median, squaredDistance);
+
+    /* Le sous-arbre du cote de l'empreinte du cycle d'abord, l'autre seulement s'il peut etre plus proche */
+    float difference = queryRssi[nodes[median].splitDimension] - nodes[median].rssi[nodes[median].splitDimension];
+    if (difference < 0) {
+        searchTree(begin, median);
+        if (canContainNeighbour(difference * difference)) {
+            searchTree(median + 1, end);
+        }
+    } else {
+        searchTree(median + 1, end);
+        if (canContainNeighbour(difference * difference)) {
+            searchTree(begin, median);
+        }
+    }
+}
+
+static void insertNeighbour(uint32_t node, float squaredDistance) {
+    if (!canContainNeighbour(squaredDistance)) {
+        return;
+    }
+
+    uint8_t k = nbNeighboursFound < nbNeighboursSearched ? nbNeighboursFound++ : (uint8_t) (nbNeighboursFound - 1);
+    while (k > 0 && neighbours[k - 1].squaredDistance > squaredDistance) {
+        neighbours[k] = neighbours[k - 1];
+        k--;
+    }
+    neighbours[k].squaredDistance = squaredDistance;
+    neighbours[k].node = node;
+}
+
+static bool canContainNeighbour(float squaredDistance) {
+    return nbNeighboursFound < nbNeighboursSearched || squaredDistance < neighbours[nbNeighboursFound - 1].squaredDistance;
+}
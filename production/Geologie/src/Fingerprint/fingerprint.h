@@ -0,0 +1,140 @@
+/**
+ * @file fingerprint.h
+ *
+ * @brief Localise le robot par les empreintes radio relevees aux positions de calibration, moteur alternatif a
+ * Mathematician.
+ *
+ * A chaque position de calibration, la puissance recue de chaque balise est gardee comme empreinte de reference.
+ * A la fin de la calibration, la carte radio est construite : les empreintes deviennent des vecteurs de puissances
+ * sur les balises les plus souvent recues, une balise non recue valant #FINGERPRINT_RSSI_MISSING, et elles sont
+ * rangees dans un arbre k-d. La position du robot est la moyenne des positions des k empreintes les plus proches de
+ * celle du cycle, ponderee par l'inverse de leur distance : la recherche dans l'arbre ne visite qu'une branche par
+ * niveau dans le cas courant, les cartes de milliers de points repondent dans le temps d'un cycle.
+ *
+ * Une nouvelle calibration recommence la carte : la premiere empreinte ajoutee apres une construction efface les
+ * precedentes.
+ *
+ * Fingerprint n'est pas protege contre les acces concurrents : il est appele par le seul thread de Scanner.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+#ifndef FINGERPRINT_
+#define FINGERPRINT_
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../common.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre maximal de voisins moyennes.
+ */
+#define FINGERPRINT_NB_NEIGHBOURS_MAX (8)
+
+/**
+ * @brief Le nombre de dimensions de la carte radio : les balises les plus souvent recues aux positions de
+ * calibration.
+ */
+#define FINGERPRINT_NB_DIMENSIONS (16)
+
+/**
+ * @brief Le nombre maximal de balises gardees par empreinte de reference, les plus fortes.
+ */
+#define FINGERPRINT_NB_MEASURES_MAX (32)
+
+/**
+ * @brief La puissance d'une balise non recue, en dBm : les puissances plus faibles y sont ramenees.
+ */
+#define FINGERPRINT_RSSI_MISSING (-100)
+
+/**
+ * @brief La distance ajoutee a celle de chaque voisin avant d'en prendre l'inverse, en dB, pour qu'une empreinte
+ * identique ne divise pas par zero.
+ */
+#define FINGERPRINT_DISTANCE_MIN (0.5f)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Regle le nombre de voisins moyennes.
+ *
+ * @param nbNeighbours Le nombre de voisins, au plus #FINGERPRINT_NB_NEIGHBOURS_MAX ; 0 (par defaut) pour ne pas
+ * relever d'empreinte et garder le calcul de Mathematician.
+ */
+extern void Fingerprint_setNbNeighbours(uint8_t nbNeighbours);
+
+/**
+ * @brief Indique si les empreintes sont relevees pendant la calibration.
+ *
+ * @return bool Vrai si le nombre de voisins n'est pas nul.
+ */
+extern bool Fingerprint_isEnabled();
+
+/**
+ * @brief Indique si la carte radio est construite et remplace le calcul de Mathematician.
+ *
+ * @return bool Vrai si la carte a au moins une empreinte.
+ */
+extern bool Fingerprint_isReady();
+
+/**
+ * @brief Ajoute l'empreinte relevee a une position de calibration.
+ *
+ * @param position La position de calibration.
+ * @param beaconsData Les balises recues a cette position, dans un ordre quelconque : seules les
+ * #FINGERPRINT_NB_MEASURES_MAX plus fortes sont gardees.
+ * @param nbBeacon Le nombre de balises.
+ * @return int8_t -1 si les empreintes sont desactivees ou si l'allocation a echoue, 0 sinon.
+ */
+extern int8_t Fingerprint_addReference(const Position* position, const BeaconData* beaconsData, uint32_t nbBeacon);
+
+/**
+ * @brief Construit la carte radio a partir des empreintes ajoutees depuis la derniere construction.
+ *
+ * @return int8_t -1 s'il n'y a aucune empreinte ou si l'allocation a echoue, la carte precedente est alors oubliee,
+ * 0 sinon.
+ */
+extern int8_t Fingerprint_build();
+
+/**
+ * @brief Calcule la position du robot a partir des balises recues pendant le cycle.
+ *
+ * @param beaconsData Les balises.
+ * @param nbBeacon Le nombre de balises.
+ * @param currentPosition La position a remplir, inchangee en cas d'erreur.
+ * @return int8_t -1 si la carte n'est pas construite ou si moins de #NB_BEACONS_POSITION de ses balises sont
+ * recues, 0 sinon.
+ */
+extern int8_t Fingerprint_getCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition);
+
+/**
+ * @brief Oublie la carte radio et les empreintes.
+ */
+extern void Fingerprint_reset();
+
+/**
+ * @brief Libere la carte radio et les empreintes.
+ */
+extern void Fingerprint_free();
+
+#endif // FINGERPRINT_
@@ -108,6 +108,7 @@ typedef enum {
     E_FINISH_CALIBRATE_ALL_POSITION,        /**< Evenement indiquant a Geographer que l'ensemble des coefficients d'attenuations ont ete calculer */
     E_NOT_FINISH_CALIBRATE_ALL_POSITION,    /**< Evenement indiquant a Geographer que l'ensemble des coefficient d'attenuation n'ont pas tous ete calculer */
     E_SIGNAL_END_AVERAGE_CALCUL,            /**< Evenement indiquant a Geographer que le calcul de la moyenne des coefficient d'attenuation a ete fait */
+    E_SEND_TRACKED_POSITION,                /**< Evenement indiquant qu'il faut envoyer la position suivie par Tracker */
 
     E_NB_EVENT                              /**< Le nombre d'evenement */
 } EventGeographer;
@@ -127,6 +128,7 @@ typedef enum {
     A_ASK_AVERAGE_CALCUL,                   /**< Demande le calcul de la moyenne des coefficient d'attenuation */
     A_ASK_COMPUTE_ATTENUATION_COEFFICIENT,  /**< Demande de calculer les coefficient d'attenuation */
     A_SET_CALIBRATION_POSITION,             /**< Envoie a GEOMOBILE les position de calibration */
+    A_SEND_TRACKED_POSITION,                /**< Envoie a GEOMOBILE la position suivie */
 
     A_NB_ACTION,                            /**< Le nombre d'action */
 } ActionGeographer;
@@ -136,9 +138,12 @@ typedef enum {
  */
 typedef struct {
     Position* position;                                 /**< La position courante a envoyer a GEOMOBILE */
+    uint64_t captureTime;                               /**< La date de capture de la position sur l'horloge monotone en nanoseconde, 0 si inconnue */
     ProcessorAndMemoryLoad* processorAndMemoryLoad;     /**< La charge processeur et memoire a envoyer a GEOMOBILE */
     BeaconData* beaconsData;                            /**< Les donnees balises courante a envoyer a GEOMOBILE */
     int8_t nbBeaconData;                                /**< Le nombre de balises composant les donnees balises */
+    BeaconStatistics* beaconsStatistics;                /**< Les statistiques de reception des balises actives a envoyer a GEOMOBILE */
+    uint8_t nbBeaconsStatistics;                        /**< Le nombre de balises composant les statistiques */
 } DataCurrent;
 
 /**
@@ -147,11 +152,20 @@ typedef struct {
  */
 typedef struct {
     CalibrationData* calibrationData;   /**< Les donnees de calibration a envoyer a GEOMOBILE */
-    int8_t nbCalibrationData;           /**< Le nombre de donnees de calibration */
+    uint8_t nbCalibrationData;          /**< Le nombre de donnees de calibration */
 } DataCalibration;
 
+/**
+ * @brief La position suivie par Tracker, copiee dans le message.
+ */
+typedef struct {
+    Position position;      /**< La position suivie a envoyer a GEOMOBILE */
+    uint64_t captureTime;   /**< La date de la derniere annonce prise en compte sur l'horloge monotone en nanoseconde, 0 si inconnue */
+} DataTracked;
+
 typedef union {
     DataCurrent current;                            /**< Les donnees courantes a envoyer a GEOMOBILE */
+    DataTracked tracked;                            /**< La position suivie a envoyer a GEOMOBILE */
     DataCalibration calibration;                    /**< Les donnees de calibration a envoyer a GEOMOBILE. */
     CalibrationPositionId calibrationPositionId;    /**< L'identifiant de calibration ou se calibrer */
 } DataToShare;
@@ -298,15 +312,18 @@ static const ExperimentalTraject EXPERIMENTAL_TRAJECTS[NB_EXPERIMENTAL_TRAJECT]
 static const TransitionGeographer stateMachine[S_NB_STATE][E_NB_EVENT] = {
     [S_WATING_FOR_CONNECTION] [E_CONNECTION_ESTABLISHED] = {S_IDLE, A_SEND_EXPERIMENTAL_DATA},
     [S_WATING_FOR_CONNECTION][E_DATE_AND_SEND_DATA] = {S_WATING_FOR_CONNECTION, A_NONE},
+    [S_WATING_FOR_CONNECTION][E_SEND_TRACKED_POSITION] = {S_WATING_FOR_CONNECTION, A_NONE},
     [S_WATING_FOR_CONNECTION][E_STOP] = {S_DEATH, A_STOP},
 
     [S_IDLE][E_ASK_CALIBRATION_POSITIONS] = {S_WAITING_FOR_BE_PLACED, A_SET_CALIBRATION_POSITION},
     [S_IDLE][E_DATE_AND_SEND_DATA] = {S_IDLE, A_SEND_ALL_DATA},
+    [S_IDLE][E_SEND_TRACKED_POSITION] = {S_IDLE, A_SEND_TRACKED_POSITION},
     [S_IDLE][E_CONNECTION_DOWN] = {S_WATING_FOR_CONNECTION, A_NONE},
     [S_IDLE][E_STOP] = {S_DEATH, A_STOP},
 
     [S_WAITING_FOR_BE_PLACED][E_VALIDATE_POSITION] = {S_WAITING_FOR_ATTENUATION_COEFFICIENT_FROM_POSITION, A_ASK_COMPUTE_ATTENUATION_COEFFICIENT},
     [S_WAITING_FOR_BE_PLACED][E_DATE_AND_SEND_DATA] = {S_WAITING_FOR_BE_PLACED, A_NONE},
+    [S_WAITING_FOR_BE_PLACED][E_SEND_TRACKED_POSITION] = {S_WAITING_FOR_BE_PLACED, A_NONE},
     [S_WAITING_FOR_BE_PLACED][E_CONNECTION_DOWN] = {S_WATING_FOR_CONNECTION, A_NONE},
     [S_WAITING_FOR_BE_PLACED][E_STOP] = {S_DEATH, A_STOP},
 
@@ -314,17 +331,20 @@ static const TransitionGeographer stateMachine[S_NB_STATE][E_NB_EVENT] = {
     [S_WAITING_FOR_ATTENUATION_COEFFICIENT_FROM_POSITION][E_CONNECTION_DOWN] = {S_WATING_FOR_CONNECTION, A_NONE},
     [S_WAITING_FOR_ATTENUATION_COEFFICIENT_FROM_POSITION][E_STOP] = {S_DEATH, A_STOP},
     [S_WAITING_FOR_ATTENUATION_COEFFICIENT_FROM_POSITION][E_DATE_AND_SEND_DATA] = {S_WAITING_FOR_ATTENUATION_COEFFICIENT_FROM_POSITION, A_NONE},
+    [S_WAITING_FOR_ATTENUATION_COEFFICIENT_FROM_POSITION][E_SEND_TRACKED_POSITION] = {S_WAITING_FOR_ATTENUATION_COEFFICIENT_FROM_POSITION, A_NONE},
 
     [S_TEST_IF_FINISH_ALL_POSITION][E_FINISH_CALIBRATE_ALL_POSITION] = {S_WAITING_FOR_CALCUL_AVERAGE_COEFFICIENT, A_ASK_AVERAGE_CALCUL},
     [S_TEST_IF_FINISH_ALL_POSITION][E_NOT_FINISH_CALIBRATE_ALL_POSITION] = {S_WAITING_FOR_BE_PLACED, A_INCREASE_CALIBRATION_COUNTER},
     [S_TEST_IF_FINISH_ALL_POSITION][E_CONNECTION_DOWN] = {S_WATING_FOR_CONNECTION, A_NONE},
     [S_TEST_IF_FINISH_ALL_POSITION][E_STOP] = {S_DEATH, A_STOP},
     [S_TEST_IF_FINISH_ALL_POSITION][E_DATE_AND_SEND_DATA] = {S_TEST_IF_FINISH_ALL_POSITION, A_NONE},
+    [S_TEST_IF_FINISH_ALL_POSITION][E_SEND_TRACKED_POSITION] = {S_TEST_IF_FINISH_ALL_POSITION, A_NONE},
 
     [S_WAITING_FOR_CALCUL_AVERAGE_COEFFICIENT][E_SIGNAL_END_AVERAGE_CALCUL] = {S_IDLE,A_SET_CALIBRATION_DATA},
     [S_WAITING_FOR_CALCUL_AVERAGE_COEFFICIENT][E_CONNECTION_DOWN] = {S_WATING_FOR_CONNECTION, A_NONE},
     [S_WAITING_FOR_CALCUL_AVERAGE_COEFFICIENT][E_STOP] = {S_DEATH, A_STOP},
     [S_WAITING_FOR_CALCUL_AVERAGE_COEFFICIENT][E_DATE_AND_SEND_DATA] = {S_WAITING_FOR_CALCUL_AVERAGE_COEFFICIENT, A_NONE},
+    [S_WAITING_FOR_CALCUL_AVERAGE_COEFFICIENT][E_SEND_TRACKED_POSITION] = {S_WAITING_FOR_CALCUL_AVERAGE_COEFFICIENT, A_NONE},
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -340,6 +360,14 @@ static const TransitionGeographer stateMachine[S_NB_STATE][E_NB_EVENT] = {
 */
 static Date getCurrentDate();
 
+/**
+ * @brief Calcule l'anciennete d'une capture a l'instant de l'appel.
+ *
+ * @param captureTime La date de capture sur l'horloge monotone en nanoseconde, 0 si inconnue
+ * @return L'anciennete en milliseconde, #CAPTURE_AGE_UNKNOWN si la date de capture est inconnue.
+*/
+static uint32_t getCaptureAge(uint64_t captureTime);
+
 /**
  * @brief initialise la boite aux lettres
  *
@@ -430,11 +458,23 @@ static int8_t actionSendExperimentalData(const ExperimentalPosition* experimenta
  *
  * @param beaconData Les donnees balises
  * @param nbBeaconData Le nombre de balise / Le nombre de donnees balise
+ * @param beaconsStatistics Les statistiques de reception des balises actives
+ * @param nbBeaconsStatistics Le nombre de statistiques de balise
  * @param position La position de GEOLOGIE
+ * @param captureTime La date de capture de la position sur l'horloge monotone en nanoseconde, 0 si inconnue
  * @param processorAndMemoryLoad La charge processeur et memoire de GEOLOGIE
  * @return int8_t -1 en cas d'erreur, 0 sinon.
  */
-static int8_t actionSendAllData(BeaconData* beaconData, uint8_t nbBeaconData, Position* position, ProcessorAndMemoryLoad* processorAndMemoryLoad);
+static int8_t actionSendAllData(BeaconData* beaconData, uint8_t nbBeaconData, BeaconStatistics* beaconsStatistics, uint8_t nbBeaconsStatistics, Position* position, uint64_t captureTime, ProcessorAndMemoryLoad* processorAndMemoryLoad);
+
+/**
+ * @brief Envoie la position suivie a GEOMOBILE, sans nouvel essai : la suivante arrive a la periode de suivi.
+ *
+ * @param position La position suivie.
+ * @param captureTime La date de la derniere annonce prise en compte sur l'horloge monotone en nanoseconde, 0 si inconnue.
+ * @return int8_t -1 en cas d'erreur, 0 sinon.
+ */
+static int8_t actionSendTrackedPosition(const Position* position, uint64_t captureTime);
 
 /**
  * @brief Envoie les position de calibration a GEOMOBILE.
@@ -607,7 +647,7 @@ extern int8_t Geographer_signalEndUpdateAttenuation() {
     return returnError;
 }
 
-extern int8_t Geographer_signalEndAverageCalcul(CalibrationData* calibrationData, int8_t nbCalibration) { //comment
+extern int8_t Geographer_signalEndAverageCalcul(CalibrationData* calibrationData, uint8_t nbCalibration) { //comment
     int8_t returnError;
 
     MqMsgGeographer msg = { .event = E_SIGNAL_END_AVERAGE_CALCUL };
@@ -618,15 +658,18 @@ extern int8_t Geographer_signalEndAverageCalcul(CalibrationData* calibrationData
     return returnError;
 }
 
-extern int8_t Geographer_dateAndSendData(BeaconData* beaconsData, uint8_t nbBeacons, Position* currentPosition, ProcessorAndMemoryLoad* currentProcessorAndMemoryLoad) {
+extern int8_t Geographer_dateAndSendData(BeaconData* beaconsData, uint8_t nbBeacons, BeaconStatistics* beaconsStatistics, uint8_t nbBeaconsStatistics, Position* currentPosition, uint64_t captureTime, ProcessorAndMemoryLoad* currentProcessorAndMemoryLoad) {
     int8_t returnError = EXIT_FAILURE;
 
     MqMsgGeographer msg = {
         .event = E_DATE_AND_SEND_DATA,
         .data.current.position = currentPosition,
+        .data.current.captureTime = captureTime,
         .data.current.processorAndMemoryLoad = currentProcessorAndMemoryLoad,
         .data.current.beaconsData = beaconsData,
         .data.current.nbBeaconData = nbBeacons,
+        .data.current.beaconsStatistics = beaconsStatistics,
+        .data.current.nbBeaconsStatistics = nbBeaconsStatistics,
     };
 
     LOG("[Geographer] Current ProcessorLoad=%.2f, MemoryLoad=%.2f\n", currentProcessorAndMemoryLoad->processorLoad, currentProcessorAndMemoryLoad->memoryLoad);
@@ -639,6 +682,32 @@ extern int8_t Geographer_dateAndSendData(BeaconData* beaconsData, uint8_t nbBeac
     return returnError;
 }
 
+extern int8_t Geographer_sendTrackedPosition(const Position* trackedPosition, uint64_t captureTime) {
+    int8_t returnError = EXIT_FAILURE;
+
+    MqMsgGeographer msg = {
+        .event = E_SEND_TRACKED_POSITION,
+        .data.tracked.position = *trackedPosition,
+        .data.tracked.captureTime = captureTime,
+    };
+
+    TRACE("[Geographer] Tracked position: X=%d, Y=%d%s", trackedPosition->X, trackedPosition->Y, "\n");
+
+    returnError = sendMsgMq(&msg);
+    ERROR(returnError < 0, "[Geographer] Fail to send the message send tracked position ... Abandonnement");
+
+    return returnError;
+}
+
+extern const ExperimentalTraject* Geographer_getExperimentalTraject(ExperimentalTrajectId id) {
+    for (uint8_t i = 0; i < NB_EXPERIMENTAL_TRAJECT; i++) {
+        if (EXPERIMENTAL_TRAJECTS[i].id == id) {
+            return &EXPERIMENTAL_TRAJECTS[i];
+        }
+    }
+    return NULL;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Fonctions privee
@@ -650,6 +719,19 @@ static Date getCurrentDate() {
     return date;
 }
 
+static uint32_t getCaptureAge(uint64_t captureTime) {
+    struct timespec now;
+    uint64_t age;
+
+    if (captureTime == 0) {
+        return CAPTURE_AGE_UNKNOWN;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    age = ((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec - captureTime) / 1000000;
+    return age >= CAPTURE_AGE_UNKNOWN ? CAPTURE_AGE_UNKNOWN - 1 : (uint32_t) age;
+}
+
 static int8_t setUpMq(void) {
     int8_t returnError = EXIT_SUCCESS;
 
@@ -742,13 +824,18 @@ static int8_t performAction(ActionGeographer action, const MqMsgGeographer* msg)
             break;
 
         case A_SEND_ALL_DATA:
-            returnError = actionSendAllData(msg->data.current.beaconsData, msg->data.current.nbBeaconData, msg->data.current.position, msg->data.current.processorAndMemoryLoad);
+            returnError = actionSendAllData(msg->data.current.beaconsData, msg->data.current.nbBeaconData, msg->data.current.beaconsStatistics,
+                msg->data.current.nbBeaconsStatistics, msg->data.current.position, msg->data.current.captureTime, msg->data.current.processorAndMemoryLoad);
             break;
 
         case A_SET_CALIBRATION_DATA:
             returnError = actionSetCalibrationData(msg->data.calibration.calibrationData, msg->data.calibration.nbCalibrationData);
             break;
 
+        case A_SEND_TRACKED_POSITION:
+            returnError = actionSendTrackedPosition(&msg->data.tracked.position, msg->data.tracked.captureTime);
+            break;
+
         case A_INCREASE_CALIBRATION_COUNTER:
             returnError = actionIncreaseCalibrationCounter();
             break;
@@ -817,9 +904,11 @@ static int8_t actionSendExperimentalData(const ExperimentalPosition* experimenta
     return (returnErrorTraject + returnErrorPosition) < 0 ? -1 : 0;
 }
 
-static int8_t actionSendAllData(BeaconData* beaconData, uint8_t nbBeaconData, Position* position, ProcessorAndMemoryLoad* processorAndMemoryLoad) {
+static int8_t actionSendAllData(BeaconData* beaconData, uint8_t nbBeaconData, BeaconStatistics* beaconsStatistics, uint8_t nbBeaconsStatistics, Position* position, uint64_t captureTime, ProcessorAndMemoryLoad* processorAndMemoryLoad) {
     Date currentDate = getCurrentDate();
+    uint32_t captureAge = getCaptureAge(captureTime);
     int8_t returnErrorBeaconData = 0;
+    int8_t returnErrorStatistics = 0;
     int8_t returnErrorCurrentPosition = 0;
     int8_t returnErrorLoad = 0;
 
@@ -830,10 +919,17 @@ static int8_t actionSendAllData(BeaconData* beaconData, uint8_t nbBeaconData, Po
         ERROR(returnErrorBeaconData < 0, "[Geographer] Fail to send the beacons data ... Abandonment");
     }
 
-    returnErrorCurrentPosition = ProxyLoggerMOB_setCurrentPosition(position, currentDate);
+    returnErrorStatistics = ProxyLoggerMOB_setBeaconsStatistics(beaconsStatistics, nbBeaconsStatistics, currentDate);
+    if (returnErrorStatistics < 0) {
+        ERROR(true, "[Geographer] Fail to send the beacons statistics ... Retry");
+        returnErrorStatistics = ProxyLoggerMOB_setBeaconsStatistics(beaconsStatistics, nbBeaconsStatistics, currentDate);
+        ERROR(returnErrorStatistics < 0, "[Geographer] Fail to send the beacons statistics ... Abandonment");
+    }
+
+    returnErrorCurrentPosition = ProxyLoggerMOB_setCurrentPosition(position, captureAge, currentDate);
     if (returnErrorCurrentPosition < 0) {
         ERROR(true, "[Geographer] Fail to send the current position ... Retry");
-        returnErrorCurrentPosition = ProxyLoggerMOB_setCurrentPosition(position, currentDate);
+        returnErrorCurrentPosition = ProxyLoggerMOB_setCurrentPosition(position, captureAge, currentDate);
         ERROR(returnErrorCurrentPosition < 0, "[Geographer] Fail to send the current position ... Abandonment");
     }
 
@@ -844,13 +940,18 @@ static int8_t actionSendAllData(BeaconData* beaconData, uint8_t nbBeaconData, Po
         ERROR(returnErrorLoad < 0, "[Geographer] Fail to send the beacons data ... Abandonment");
     }
 
-    ERROR((returnErrorBeaconData + returnErrorCurrentPosition + returnErrorLoad) < 0, "[Geographer] Fail to send a curent data ... Abandonment");
+    ERROR((returnErrorBeaconData + returnErrorStatistics + returnErrorCurrentPosition + returnErrorLoad) < 0, "[Geographer] Fail to send a curent data ... Abandonment");
 
-    free(beaconData);
     // free(processorAndMemoryLoad);
     // free(position);
 
-    return (returnErrorBeaconData + returnErrorCurrentPosition + returnErrorLoad) < 0 ? -1 : 0;
+    return (returnErrorBeaconData + returnErrorStatistics + returnErrorCurrentPosition + returnErrorLoad) < 0 ? -1 : 0;
+}
+
+static int8_t actionSendTrackedPosition(const Position* position, uint64_t captureTime) {
+    int8_t returnError = ProxyLoggerMOB_setCurrentPosition(position, getCaptureAge(captureTime), getCurrentDate());
+    ERROR(returnError < 0, "[Geographer] Fail to send the tracked position ... Abandonment");
+    return returnError;
 }
 
 static int8_t actionSetCalibrationPosition(const CalibrationPosition* calibrationPosition, uint8_t nbCalibrationPosition) {
@@ -41,14 +41,6 @@
 #include "../common.h"
 #include "../tools.h"
 
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//
-//                                              Define
-//
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-#define NB_CALIBRATION_POSITION (25)
-
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Fonctions publiques
@@ -147,7 +139,7 @@ extern int8_t Geographer_signalEndUpdateAttenuation();
  * @return retourne 1 s'il y a une erreur dans l'execution de la methode
  *
 */
-extern int8_t Geographer_signalEndAverageCalcul(CalibrationData calibrationData[], int8_t nbCalibration);
+extern int8_t Geographer_signalEndAverageCalcul(CalibrationData calibrationData[], uint8_t nbCalibration);
 
 /**
  * @fn extern int8_t Geographer_signalConnectionEstablished()
@@ -176,19 +168,53 @@ extern int8_t Geographer_signalConnectionEstablished();
 extern int8_t Geographer_signalConnectionDown();
 
 /**
- * @fn extern int8_t Geographer_dateAndSendData(BeaconData beaconsData[], Position currentPosition, ProcessorAndMemoryLoad currentProcessorAndMemoryLoad)
+ * @fn extern int8_t Geographer_dateAndSendData(BeaconData* beaconsData, uint8_t nbBeacons, BeaconStatistics* beaconsStatistics, uint8_t nbBeaconsStatistics, Position* currentPosition, uint64_t captureTime, ProcessorAndMemoryLoad* currentProcessorAndMemoryLoad)
  *
  * @brief Reçoit les donnee actuelle, les dates et les renvoie
  *
  * Cette methode intervient dans la mise a jour automatique des donnees
  *
+ * Les tableaux beaconsData et beaconsStatistics appartiennent a Scanner, ils restent valables jusqu'au cycle de
+ * position suivant.
+ *
+ * La position est envoyee avec son anciennete, calculee a l'envoi a partir de sa date de capture.
+ *
  * @param beaconsData tableau contenant les donnees des balises
  * @param nbBeacons Le nombre de balise dans le tableau beaconsData
+ * @param beaconsStatistics tableau contenant les statistiques de reception des balises actives
+ * @param nbBeaconsStatistics Le nombre de balise dans le tableau beaconsStatistics
  * @param currentPosition position actuelle de la carte mere
+ * @param captureTime date de capture de la position sur l'horloge monotone en nanoseconde, 0 si inconnue
  * @param currentProcessorAndMemoryLoad charge processeur et memoire actuelle
  * @return retourne 1 s'il y a une erreur dans l'execution de la methode
  *
 */
-extern int8_t Geographer_dateAndSendData(BeaconData * beaconsData, uint8_t nbBeacons, Position * currentPosition, ProcessorAndMemoryLoad * currentProcessorAndMemoryLoad);
+extern int8_t Geographer_dateAndSendData(BeaconData * beaconsData, uint8_t nbBeacons, BeaconStatistics * beaconsStatistics, uint8_t nbBeaconsStatistics, Position * currentPosition, uint64_t captureTime, ProcessorAndMemoryLoad * currentProcessorAndMemoryLoad);
+
+/**
+ * @fn extern int8_t Geographer_sendTrackedPosition(const Position* trackedPosition, uint64_t captureTime)
+ *
+ * @brief Envoie a GEOMOBILE la position suivie par Tracker, seule
+ *
+ * Cette methode est appelee au rythme de suivi demande, entre deux envois des donnees actuelles. La position est
+ * copiee dans le message, elle n'est envoyee que si GEOMOBILE est connecte et qu'aucune calibration n'est en cours.
+ *
+ * @param trackedPosition la position suivie
+ * @param captureTime date de la derniere annonce prise en compte sur l'horloge monotone en nanoseconde, 0 si inconnue
+ * @return retourne -1 s'il y a une erreur dans l'execution de la methode
+ *
+*/
+extern int8_t Geographer_sendTrackedPosition(const Position* trackedPosition, uint64_t captureTime);
+
+/**
+ * @fn extern const ExperimentalTraject* Geographer_getExperimentalTraject(ExperimentalTrajectId id)
+ *
+ * @brief Donne un des trajets experimentaux envoyes a GEOMOBILE
+ *
+ * @param id l'identifiant du trajet
+ * @return le trajet, NULL si aucun trajet ne porte cet identifiant
+ *
+*/
+extern const ExperimentalTraject* Geographer_getExperimentalTraject(ExperimentalTrajectId id);
 
 #endif /* GEOGRAPHER_H */
@@ -22,9 +22,40 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * @brief La puissance a 1 metre.
+ * @brief Le nombre d'inconnues du systeme linearise : X, Y et X carre plus Y carre.
  */
-#define POWER_1_METER (-50)
+#define NB_UNKNOWNS (3)
+
+/**
+ * @brief Le rapport minimal entre un pivot de Cholesky et le terme diagonal dont il provient, en deca les balises sont alignees.
+ */
+#define PIVOT_MIN_RATIO (1e-9)
+
+/**
+ * @brief Le nombre d'inconnues de l'affinage par Levenberg-Marquardt : X et Y.
+ */
+#define NB_UNKNOWNS_REFINE (2)
+
+/**
+ * @brief L'amortissement de depart de Levenberg-Marquardt, relatif a la trace de J^T W J, faible car la position de depart est deja proche.
+ */
+#define DAMPING_INITIAL (1e-3)
+
+/**
+ * @brief Le facteur applique a l'amortissement apres un pas refuse, son inverse apres un pas accepte.
+ */
+#define DAMPING_FACTOR (10)
+
+/**
+ * @brief Le systeme des ecarts de distance autour d'une position, accumule sur toutes les balises.
+ */
+typedef struct {
+    double normal[NB_UNKNOWNS][NB_UNKNOWNS];    /**< J^T W J, seuls les termes inferieurs des deux premieres lignes sont remplis. */
+    double gradient[NB_UNKNOWNS];               /**< J^T W r. */
+    double cost;                                /**< La somme ponderee des ecarts au carre. */
+    double squaredResiduals;                    /**< La somme des ecarts au carre, en centimetre carre. */
+    uint32_t nbBeaconsUsed;                     /**< Le nombre de balises utilisables. */
+} RangeSystem;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -64,6 +95,156 @@ static double distanceCalculWithPower(const Power* power, const AttenuationCoeff
     return distance*100;
 }
 
+/**
+ * @fn static bool getRange(const BeaconData* beaconData, double* distance, double* relativeVariance)
+ * @brief methode privee donnant la distance d'une balise selon sa puissance et la variance relative de cette distance
+ *
+ * L'ecart type relatif de la distance est ln(10) / (10 * n) fois l'ecart type du RSSI.
+ *
+ * @param beaconData la balise
+ * @param distance la distance en centimetre, au moins #DISTANCE_MIN
+ * @param relativeVariance la variance de la distance divisee par la distance au carre
+ * @return faux si la balise n'est pas utilisable, son coefficient d'attenuation est nul par exemple
+ */
+static bool getRange(const BeaconData* beaconData, double* distance, double* relativeVariance) {
+    Power power = beaconData->power;
+
+    /* Les RSSI recus sont entiers : leur distance est lue dans la table de la balise plutot que recalculee */
+    if (beaconData->rangeTable != NULL && power >= INT8_MIN && power <= INT8_MAX && power == (int8_t) power) {
+        *distance = beaconData->rangeTable->distances[(int8_t) power - INT8_MIN];
+    } else {
+        *distance = distanceCalculWithPower(&power, &beaconData->coefficientAverage);
+    }
+    if (!isfinite(*distance)) {
+        return false;
+    }
+    if (*distance < DISTANCE_MIN) {
+        *distance = DISTANCE_MIN;
+    }
+
+    double rssiVariance = beaconData->rssiVariance > 0 ? beaconData->rssiVariance : MATHEMATICIAN_RSSI_VARIANCE_DEFAULT;
+    if (rssiVariance < MATHEMATICIAN_RSSI_VARIANCE_MIN) {
+        rssiVariance = MATHEMATICIAN_RSSI_VARIANCE_MIN;
+    }
+
+    double relativeDeviation = beaconData->rangeTable != NULL ? beaconData->rangeTable->relativeDeviation : log(10) / (10 * beaconData->coefficientAverage);
+    *relativeVariance = relativeDeviation * relativeDeviation * rssiVariance;
+    return isfinite(*relativeVariance) && *relativeVariance > 0;
+}
+
+/**
+ * @fn static void setPosition(double x, double y, Position* position)
+ * @brief methode privee arrondissant une position au centimetre, les coordonnees negatives sont ramenees a 0
+ *
+ * @param x l'abscisse en centimetre
+ * @param y l'ordonnee en centimetre
+ * @param position la position a changer
+ */
+static void setPosition(double x, double y, Position* position) {
+    x = round(x);
+    y = round(y);
+    position->X = x > 0 ? (uint32_t) x : 0;
+    position->Y = y > 0 ? (uint32_t) y : 0;
+}
+
+/**
+ * @fn static int8_t solveNormalEquations(double normal[NB_UNKNOWNS][NB_UNKNOWNS], const double rhs[NB_UNKNOWNS], double solution[NB_UNKNOWNS], int nbUnknowns)
+ * @brief resout les equations normales par une factorisation de Cholesky, sans allocation
+ *
+ * Seule la moitie inferieure de @a normal est lue, elle est remplacee par le facteur de Cholesky.
+ *
+ * @param normal la matrice des equations normales, symetrique
+ * @param rhs le second membre
+ * @param solution la solution du systeme
+ * @param nbUnknowns le nombre d'inconnues, au plus #NB_UNKNOWNS
+ * @return 0 en cas de succes, -1 si la matrice n'est pas definie positive
+ */
+static int8_t solveNormalEquations(double normal[NB_UNKNOWNS][NB_UNKNOWNS], const double rhs[NB_UNKNOWNS], double solution[NB_UNKNOWNS], int nbUnknowns) {
+    double intermediate[NB_UNKNOWNS];
+
+    for (int j = 0; j < nbUnknowns; j++) {
+        double pivot = normal[j][j];
+        for (int k = 0; k < j; k++) {
+            pivot -= normal[j][k] * normal[j][k];
+        }
+        /* La negation attrape aussi un pivot NaN */
+        if (!(pivot > PIVOT_MIN_RATIO * normal[j][j])) {
+            return -1;
+        }
+        normal[j][j] = sqrt(pivot);
+        for (int i = j + 1; i < nbUnknowns; i++) {
+            double value = normal[i][j];
+            for (int k = 0; k < j; k++) {
+                value -= normal[i][k] * normal[j][k];
+            }
+            normal[i][j] = value / normal[j][j];
+        }
+    }
+
+    for (int i = 0; i < nbUnknowns; i++) {
+        double value = rhs[i];
+        for (int k = 0; k < i; k++) {
+            value -= normal[i][k] * intermediate[k];
+        }
+        intermediate[i] = value / normal[i][i];
+    }
+    for (int i = nbUnknowns - 1; i >= 0; i--) {
+        double value = intermediate[i];
+        for (int k = i + 1; k < nbUnknowns; k++) {
+            value -= normal[k][i] * solution[k];
+        }
+        solution[i] = value / normal[i][i];
+    }
+    return 0;
+}
+
+/**
+ * @fn static void accumulateRangeSystem(const BeaconData* beaconsData, uint32_t nbBeacon, double x, double y, RangeSystem* system)
+ * @brief methode privee accumulant les ecarts entre la distance a chaque balise et celle donnee par sa puissance
+ *
+ * L'ecart d'une balise est ponderee par l'inverse de la variance de sa distance.
+ *
+ * @param beaconsData tableau contenant les informations des balises
+ * @param nbBeacon nombre de beacons
+ * @param x l'abscisse de la position, en centimetre
+ * @param y l'ordonnee de la position, en centimetre
+ * @param system le systeme a remplir
+ */
+static void accumulateRangeSystem(const BeaconData* beaconsData, uint32_t nbBeacon, double x, double y, RangeSystem* system) {
+    *system = (RangeSystem) { .cost = 0 };
+
+    for (uint32_t i = 0; i < nbBeacon; i++) {
+        double distance;
+        double relativeVariance;
+        if (!getRange(&beaconsData[i], &distance, &relativeVariance)) {
+            continue;
+        }
+
+        double weight = 1 / (distance * distance * relativeVariance);
+        double dx = x - beaconsData[i].position.X;
+        double dy = y - beaconsData[i].position.Y;
+        double beaconDistance = sqrt(dx * dx + dy * dy);
+        double residual = beaconDistance - distance;
+
+        /* Sur la balise le gradient de la distance n'est pas defini, l'ecart compte sans orienter le pas */
+        double row[NB_UNKNOWNS_REFINE] = { 0, 0 };
+        if (beaconDistance > 0) {
+            row[0] = dx / beaconDistance;
+            row[1] = dy / beaconDistance;
+        }
+
+        for (int j = 0; j < NB_UNKNOWNS_REFINE; j++) {
+            for (int k = 0; k <= j; k++) {
+                system->normal[j][k] += weight * row[j] * row[k];
+            }
+            system->gradient[j] += weight * row[j] * residual;
+        }
+        system->cost += weight * residual * residual;
+        system->squaredResiduals += residual * residual;
+        system->nbBeaconsUsed++;
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Fonctions extern
@@ -80,6 +261,23 @@ extern AttenuationCoefficient Mathematician_getAttenuationCoefficient(const Powe
     return attenuationCoefficient;
 }
 
+extern Power Mathematician_getPower(const Position* beaconPosition, const Position* position, const AttenuationCoefficient* attenuationCoefficient) {
+    double distance = distanceCalculWithPosition(beaconPosition, position);
+    if (distance < DISTANCE_MIN) {
+        distance = DISTANCE_MIN;
+    }
+    return POWER_1_METER - 10 * (*attenuationCoefficient) * log10(distance / 100);
+}
+
+extern void Mathematician_fillRangeTable(const AttenuationCoefficient* attenuationCoefficient, RangeTable* rangeTable) {
+    rangeTable->coefficient = *attenuationCoefficient;
+    rangeTable->relativeDeviation = (float) (log(10) / (10 * (*attenuationCoefficient)));
+    for (int16_t rssi = INT8_MIN; rssi <= INT8_MAX; rssi++) {
+        Power power = rssi;
+        rangeTable->distances[rssi - INT8_MIN] = (float) distanceCalculWithPower(&power, attenuationCoefficient);
+    }
+}
+
 extern AttenuationCoefficient Mathematician_getAverageCalcul(const BeaconCoefficients* beaconCoefficients, uint8_t nbCoefficient) {
     AttenuationCoefficient somme = 0;
     AttenuationCoefficient attenuationCoefficient = 0;
@@ -91,61 +289,134 @@ extern AttenuationCoefficient Mathematician_getAverageCalcul(const BeaconCoeffic
 }
 
 
-extern void Mathematician_getCurrentPosition(const BeaconData* beaconsData, uint8_t nbBeacon, Position * currentPosition) {
+extern int8_t Mathematician_getCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition) {
+    double normal[NB_UNKNOWNS][NB_UNKNOWNS] = { { 0 } };
+    double rhs[NB_UNKNOWNS] = { 0 };
+    double solution[NB_UNKNOWNS];
+    double centerX = 0;
+    double centerY = 0;
+    uint32_t nbBeaconsUsed = 0;
+    uint32_t i;
 
-    Position A = beaconsData[0].position;
-    double Ax = (double) beaconsData[0].position.X;
-    double Ay = (double) beaconsData[0].position.Y;
-    double dA = distanceCalculWithPower(&beaconsData[0].power, &beaconsData[0].coefficientAverage);
+    if (nbBeacon < NB_BEACONS_POSITION) {
+        return -1;
+    }
+
+    /* Le repere est centre sur les balises pour que les equations normales restent bien conditionnees */
+    for (i = 0; i < nbBeacon; i++) {
+        centerX += beaconsData[i].position.X;
+        centerY += beaconsData[i].position.Y;
+    }
+    centerX /= nbBeacon;
+    centerY /= nbBeacon;
 
-    Position B = beaconsData[1].position;
-    double dB = distanceCalculWithPower(&beaconsData[1].power, &beaconsData[1].coefficientAverage);
-    double Bx=(double)beaconsData[1].position.X;
-    double By=(double)beaconsData[1].position.Y;
+    for (i = 0; i < nbBeacon; i++) {
+        double distance;
+        double relativeVariance;
+        if (!getRange(&beaconsData[i], &distance, &relativeVariance)) {
+            continue;
+        }
 
-    Position C = beaconsData[2].position;
-    double dC = distanceCalculWithPower(&beaconsData[2].power, &beaconsData[2].coefficientAverage);
-    double Cx=(double)beaconsData[2].position.X;
-    double Cy=(double)beaconsData[2].position.Y;
+        /* La variance de la distance au carre est 4 * d^4 fois la variance relative de la distance */
+        double weight = 1 / (4 * distance * distance * distance * distance * relativeVariance);
+        if (!isfinite(weight)) {
+            continue;
+        }
 
-    double a = 0;
-    double b = 0;
-    double c = 0;
-    double d = 0;
+        /* (x - Xi)^2 + (y - Yi)^2 = di^2 devient -2 Xi x - 2 Yi y + (x^2 + y^2) = di^2 - Xi^2 - Yi^2 */
+        double x = beaconsData[i].position.X - centerX;
+        double y = beaconsData[i].position.Y - centerY;
+        double row[NB_UNKNOWNS] = { -2 * x, -2 * y, 1 };
+        double measure = distance * distance - x * x - y * y;
 
-//considérons que uniquement deux balises max peuvent etre sur le meme Y, jamais 3
-    if (A.Y == B.Y) { // si A et B meme ordonnee
-        a = (Cx - Ax) / (Ay - Cy);
-        b = (Ax * Ax + Ay * Ay - dA * dA - Cx * Cx - Cy * Cy + dC * dC) / (2 * (Ay - Cy));
+        for (int j = 0; j < NB_UNKNOWNS; j++) {
+            for (int k = 0; k <= j; k++) {
+                normal[j][k] += weight * row[j] * row[k];
+            }
+            rhs[j] += weight * row[j] * measure;
+        }
+        nbBeaconsUsed++;
+    }
 
-        c = (Bx - Cx) / (Cy - By);
-        d = (Cx * Cx + Cy * Cy - dC * dC - Bx * Bx - By * By + dB * dB) / (2 * (Cy - By));
+    if (nbBeaconsUsed < NB_BEACONS_POSITION || solveNormalEquations(normal, rhs, solution, NB_UNKNOWNS) < 0) {
+        return -1;
+    }
 
-    } else if (A.Y == C.Y) { // si A et C meme ordonnee
+    setPosition(solution[0] + centerX, solution[1] + centerY, currentPosition);
+    return 0;
+}
 
-        a = (Bx - Ax) / (Ay - By);
-        b = (Ax * Ax + Ay * Ay - dA * dA - Bx * Bx - By * By + dB * dB) / (2 * (Ay - By));
+extern int8_t Mathematician_refineCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition, MathematicianSolveReport* report) {
+    RangeSystem system;
+    RangeSystem candidate;
+    double x = currentPosition->X;
+    double y = currentPosition->Y;
+    double damping = DAMPING_INITIAL;
 
-        c = (Bx - Cx) / (Cy - By);
-        d = (Cx * Cx + Cy * Cy - dC * dC - Bx * Bx - By * By + dB * dB) / (2 * (Cy - By));
+    report->nbIterations = 0;
+    report->converged = false;
 
-    } else if (B.Y == C.Y) { // si C et B meme ordonnee
+    accumulateRangeSystem(beaconsData, nbBeacon, x, y, &system);
+    if (system.nbBeaconsUsed < NB_BEACONS_POSITION) {
+        return -1;
+    }
 
-        a = (Bx - Ax) / (Ay - By);
-        b = (Ax * Ax + Ay * Ay - dA * dA - Bx * Bx - By * By + dB * dB) / (2 * (Ay - By));
+    while (report->nbIterations < MATHEMATICIAN_NB_ITERATIONS_MAX && !report->converged) {
+        double damped[NB_UNKNOWNS][NB_UNKNOWNS];
+        double rhs[NB_UNKNOWNS];
+        double step[NB_UNKNOWNS];
 
-        c = (Cx - Ax) / (Ay - Cy);
-        d = (Ax * Ax + Ay * Ay - dA * dA - Cx * Cx - Cy * Cy + dC * dC) / (2 * (Ay - Cy));
-    } else {
-        a = (Cx - Ax) / (Ay - Cy);
-        b = (Ax * Ax + Ay * Ay - dA * dA - Cx * Cx - Cy * Cy + dC * dC) / (2 * (Ay - Cy));
+        /* L'amortissement suit la trace : il reste efficace quand toutes les balises sont dans la meme direction */
+        double trace = system.normal[0][0] + system.normal[1][1];
+
+        report->nbIterations++;
+        for (int j = 0; j < NB_UNKNOWNS_REFINE; j++) {
+            for (int k = 0; k < j; k++) {
+                damped[j][k] = system.normal[j][k];
+            }
+            damped[j][j] = system.normal[j][j] + damping * trace;
+            rhs[j] = -system.gradient[j];
+        }
+        if (solveNormalEquations(damped, rhs, step, NB_UNKNOWNS_REFINE) < 0) {
+            break;
+        }
+
+        report->converged = sqrt(step[0] * step[0] + step[1] * step[1]) < MATHEMATICIAN_STEP_MIN;
+        accumulateRangeSystem(beaconsData, nbBeacon, x + step[0], y + step[1], &candidate);
+        if (candidate.cost < system.cost) {
+            x += step[0];
+            y += step[1];
+            system = candidate;
+            damping /= DAMPING_FACTOR;
+        } else {
+            damping *= DAMPING_FACTOR;
+        }
+    }
+
+    report->residual = sqrt(system.squaredResiduals / system.nbBeaconsUsed);
+    setPosition(x, y, currentPosition);
+    return 0;
+}
+
+extern int8_t Mathematician_getRange(const BeaconData* beaconData, float* distance, float* variance) {
+    double rangeDistance;
+    double relativeVariance;
+
+    if (!getRange(beaconData, &rangeDistance, &relativeVariance)) {
+        return -1;
+    }
+    *distance = (float) rangeDistance;
+    *variance = (float) (rangeDistance * rangeDistance * relativeVariance);
+    return 0;
+}
+
+extern uint64_t Mathematician_getCaptureTime(const BeaconData* beaconsData, uint32_t nbBeacon) {
+    uint64_t captureTime = 0;
 
-        c = (Bx - Cx) / (Cy - By);
-        d = (Cx * Cx + Cy * Cy - dC * dC - Bx * Bx - By * By + dB * dB) / (2 * (Cy - By));
+    for (uint32_t i = 0; i < nbBeacon; i++) {
+        if (i == 0 || beaconsData[i].timestamp < captureTime) {
+            captureTime = beaconsData[i].timestamp;
+        }
     }
-    double x = (d - b) / (a - c);
-    double y = a * x + b;
-    currentPosition->X = (uint32_t) x;
-    currentPosition->Y= (uint32_t) y;
-    //return currentPosition;
+    return captureTime;
 }
@@ -28,14 +28,58 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <stdbool.h>
+
 #include "../common.h"
 
+/**
+ * @brief La puissance recue a un metre d'une balise, reference du modele d'attenuation.
+ */
+#define POWER_1_METER (-50)
+
+/**
+ * @brief La distance minimale entre une balise et le recepteur prise en compte par le modele, en centimetre.
+ */
+#define DISTANCE_MIN (10)
+
+/**
+ * @brief Le nombre minimal de balises, non alignees, dont #Mathematician_getCurrentPosition a besoin pour calculer une position.
+ */
+#define NB_BEACONS_POSITION (3)
+
+/**
+ * @brief La variance du RSSI, en dB carre, donnee a une balise dont Receiver ne connait pas encore la variance.
+ */
+#define MATHEMATICIAN_RSSI_VARIANCE_DEFAULT (16.0)
+
+/**
+ * @brief La variance minimale du RSSI, en dB carre : une balise tres stable ne masque pas toutes les autres.
+ */
+#define MATHEMATICIAN_RSSI_VARIANCE_MIN (1.0)
+
+/**
+ * @brief Le nombre maximal d'iterations de #Mathematician_refineCurrentPosition.
+ */
+#define MATHEMATICIAN_NB_ITERATIONS_MAX (8)
+
+/**
+ * @brief Le deplacement, en centimetre, en deca duquel #Mathematician_refineCurrentPosition a converge.
+ */
+#define MATHEMATICIAN_STEP_MIN (0.5)
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Variable et structure extern
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-
+/**
+ * @brief Le compte rendu d'un calcul de #Mathematician_refineCurrentPosition.
+ */
+typedef struct {
+    uint8_t nbIterations;   /**< Le nombre d'iterations effectuees. */
+    bool converged;         /**< Vrai si le dernier deplacement est inferieur a #MATHEMATICIAN_STEP_MIN. */
+    float residual;         /**< La moyenne quadratique des ecarts entre les distances a la position et celles des puissances, en centimetre. */
+} MathematicianSolveReport;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -66,13 +110,88 @@ extern AttenuationCoefficient Mathematician_getAverageCalcul(const BeaconCoeffic
 
 
 /**
-* @fn extern AttenuationCoefficient Mathematician_getCurrentPosition(const BeaconCoefficients beaconCoefficients)
-* @brief calcule la position actuelle de la carte mere
+* @fn extern int8_t Mathematician_getCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition)
+* @brief calcule la position actuelle de la carte mere par moindres carres ponderes sur toutes les balises
+*
+* Chaque balise donne une distance par le modele d'attenuation. Les equations des cercles sont linearisees
+* en prenant x carre plus y carre comme troisieme inconnue, puis resolues par les equations normales et une
+* factorisation de Cholesky 3x3 sur la pile. Le poids d'une balise est l'inverse de la variance de sa distance
+* au carre, qui croit avec la distance et avec la variance de son RSSI.
+*
+* Avec trois balises la solution est exacte, chaque balise supplementaire affine la position.
 *
 * @param  beaconsData tableau contenant les informations des balises
 * @param  nbBeacon nombre de beacons
-* @param  currentPosition position actuelle a changer
+* @param  currentPosition position actuelle a changer, inchangee en cas d'erreur
+* @return 0 en cas de succes, -1 s'il y a moins de #NB_BEACONS_POSITION balises utilisables ou si elles sont alignees
+*/
+extern int8_t Mathematician_getCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition);
+
+/**
+* @fn extern int8_t Mathematician_refineCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition, MathematicianSolveReport* report)
+* @brief affine une position par Levenberg-Marquardt sur les ecarts de distance, en partant de la position donnee
+*
+* Les ecarts entre la distance a chaque balise et celle donnee par sa puissance sont ponderes par l'inverse de
+* leur variance, comme dans #Mathematician_getCurrentPosition. Le recepteur ne bouge que de quelques centimetres
+* entre deux positions : partir de la precedente fait converger en une ou deux iterations, au plus
+* #MATHEMATICIAN_NB_ITERATIONS_MAX.
+*
+* @param  beaconsData tableau contenant les informations des balises
+* @param  nbBeacon nombre de beacons
+* @param  currentPosition la position de depart, remplacee par la position affinee
+* @param  report le compte rendu du calcul
+* @return 0 en cas de succes, -1 s'il y a moins de #NB_BEACONS_POSITION balises utilisables, la position est alors inchangee
+*/
+extern int8_t Mathematician_refineCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition, MathematicianSolveReport* report);
+
+/**
+* @fn extern int8_t Mathematician_getRange(const BeaconData* beaconData, float* distance, float* variance)
+* @brief donne la distance d'une balise selon sa puissance et la variance de cette distance
+*
+* La variance provient de celle du RSSI de la balise, comme pour la ponderation de #Mathematician_getCurrentPosition.
+*
+* @param  beaconData la balise
+* @param  distance la distance en centimetre, au moins #DISTANCE_MIN
+* @param  variance la variance de la distance, en centimetre carre
+* @return 0 en cas de succes, -1 si la balise n'est pas utilisable, son coefficient d'attenuation est nul par exemple
+*/
+extern int8_t Mathematician_getRange(const BeaconData* beaconData, float* distance, float* variance);
+
+/**
+* @fn extern uint64_t Mathematician_getCaptureTime(const BeaconData* beaconsData, uint32_t nbBeacon)
+* @brief donne la date de capture de la position calculee par #Mathematician_getCurrentPosition
+*
+* La position est aussi ancienne que le plus ancien des signaux dont elle provient : c'est la date de reception
+* la plus ancienne parmi toutes les balises.
+*
+* @param  beaconsData tableau contenant les informations des balises
+* @param  nbBeacon nombre de beacons
+* @return la date de capture sur l'horloge monotone en nanoseconde, 0 s'il n'y a aucune balise
+*/
+extern uint64_t Mathematician_getCaptureTime(const BeaconData* beaconsData, uint32_t nbBeacon);
+
+/**
+* @fn extern Power Mathematician_getPower(const Position* beaconPosition, const Position* position, const AttenuationCoefficient* attenuationCoefficient)
+* @brief calcule la puissance recue d'une balise selon le modele d'attenuation, inverse du calcul de distance
+*
+* @param  beaconPosition position de la balise
+* @param  position position du recepteur
+* @param  attenuationCoefficient coefficient d'attenuation de la balise
+* @return la puissance recue
+*/
+extern Power Mathematician_getPower(const Position* beaconPosition, const Position* position, const AttenuationCoefficient* attenuationCoefficient);
+
+/**
+* @fn extern void Mathematician_fillRangeTable(const AttenuationCoefficient* attenuationCoefficient, RangeTable* rangeTable)
+* @brief remplit la table d'une balise pour chaque RSSI entier, a refaire quand son coefficient d'attenuation change
+*
+* Une balise dont le champ rangeTable pointe sur sa table n'a plus d'exponentielle ni de logarithme a calculer pour
+* #Mathematician_getCurrentPosition, #Mathematician_refineCurrentPosition et #Mathematician_getRange tant que sa
+* puissance est entiere.
+*
+* @param  attenuationCoefficient coefficient d'attenuation de la balise
+* @param  rangeTable la table a remplir
 */
-extern void Mathematician_getCurrentPosition(const BeaconData * beaconsData,  uint8_t nbBeacon,Position * currentPosition);
+extern void Mathematician_fillRangeTable(const AttenuationCoefficient* attenuationCoefficient, RangeTable* rangeTable);
 
 #endif
@@ -0,0 +1,733 @@
+/**
+ * @file particleFilter.c
+ *
+ * @brief Calcule la position du robot avec un filtre particulaire, moteur alternatif a Mathematician.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "particleFilter.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../tools.h"
+#include "../MathematicianLOG/mathematicianLOG.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief L'alignement des tables de particules, en octet : une ligne de cache, la taille des plus grands registres
+ * vectoriels.
+ */
+#define PARTICLES_ALIGNMENT (64)
+
+/**
+ * @brief Le nombre de particules dont les tranches sont multiples, pour que chaque tranche commence sur une ligne
+ * de cache et que deux threads n'ecrivent jamais la meme.
+ */
+#define CHUNK_GRANULARITY (PARTICLES_ALIGNMENT / sizeof(float))
+
+/**
+ * @brief La graine du generateur pseudo-aleatoire du premier thread, les suivants en sont derives : les calculs sont
+ * reproductibles d'une execution a l'autre.
+ */
+#define RANDOM_SEED (0x9E3779B9U)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les etapes d'un cycle, executees par chaque thread sur sa tranche de particules.
+ */
+typedef enum {
+    PHASE_WEIGHT = 0,       /**< Deplace, replace ou repartit les particules puis calcule leur log-vraisemblance. */
+    PHASE_NORMALIZE,        /**< Calcule les poids et les sommes ponderees. */
+    PHASE_RESAMPLE,         /**< Reechantillonne de facon systematique dans les tables de reechantillonnage. */
+    PHASE_STOP              /**< Arrete le thread. */
+} Phase;
+
+/**
+ * @brief Un thread du groupe et sa tranche de particules, le premier est le thread appelant.
+ */
+typedef struct {
+    pthread_t thread;
+    uint32_t begin;                             /**< La premiere particule de la tranche. */
+    uint32_t end;                               /**< La particule qui suit la derniere de la tranche. */
+    uint32_t randomStates[CHUNK_GRANULARITY];   /**< Les etats des generateurs pseudo-aleatoires du thread, un par particule d'un bloc. */
+    float maxLogLikelihood;                     /**< La plus grande log-vraisemblance de la tranche. */
+    double sumWeights;                          /**< La somme des poids de la tranche. */
+    double sumWeightedX;                        /**< La somme des abscisses ponderees de la tranche. */
+    double sumWeightedY;                        /**< La somme des ordonnees ponderees de la tranche. */
+    double sumSquaredWeights;                   /**< La somme des carres des poids de la tranche. */
+    double cumulativeWeight;                    /**< La somme des poids des tranches precedentes. */
+} Worker;
+
+/**
+ * @brief Le nombre de particules et de threads demandes.
+ */
+static uint32_t nbParticlesConfigured = 0;
+static uint8_t nbWorkersConfigured = 0;
+
+/**
+ * @brief Le nombre de particules allouees, 0 si le filtre est desactive.
+ */
+static uint32_t nbParticles = 0;
+
+/**
+ * @brief Le nombre de threads qui se partagent les particules, thread appelant compris.
+ */
+static uint8_t nbWorkers = 0;
+static Worker workers[PARTICLE_FILTER_NB_WORKERS_MAX];
+
+/**
+ * @brief Le mutex et les conditions du groupe de threads : chaque etape est annoncee par un nouveau numero de
+ * generation et attendue jusqu'a ce qu'aucun thread ne soit en cours.
+ */
+static pthread_mutex_t workersMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t phaseStarted = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t phaseDone = PTHREAD_COND_INITIALIZER;
+static uint32_t generation = 0;
+static uint8_t nbWorkersRunning = 0;
+static Phase phase;
+
+/**
+ * @brief Les particules, une table par coordonnee, en centimetre.
+ */
+static float* particlesX = NULL;
+static float* particlesY = NULL;
+
+/**
+ * @brief Les poids des particules, inutilises tant que #areWeightsUniform est vrai.
+ */
+static float* weights = NULL;
+static float* logLikelihoods = NULL;
+
+/**
+ * @brief Les particules reechantillonnees, echangees avec #particlesX et #particlesY a la fin du reechantillonnage.
+ */
+static float* resampledX = NULL;
+static float* resampledY = NULL;
+
+/**
+ * @brief Vrai si les particules ont ete reparties autour des balises.
+ */
+static bool isSpread = false;
+
+/**
+ * @brief Vrai si toutes les particules ont le meme poids, apres une repartition ou un reechantillonnage.
+ */
+static bool areWeightsUniform = true;
+
+/**
+ * @brief L'inverse de la somme des poids du cycle precedent, pour que les poids ne tendent pas vers 0.
+ */
+static double weightScale = 1;
+
+/**
+ * @brief La date de capture du cycle precedent sur l'horloge monotone, en nanoseconde.
+ */
+static uint64_t lastCaptureTime = 0;
+
+/**
+ * @brief L'etat du generateur pseudo-aleatoire du decalage du reechantillonnage.
+ */
+static uint32_t resampleRandomState = RANDOM_SEED;
+
+/**
+ * @brief Les parametres du cycle en cours, lus par tous les threads.
+ */
+static bool isSpreading;
+static float noiseAmplitude;
+static float areaMinX;
+static float areaMinY;
+static float areaWidth;
+static float areaHeight;
+static double resampleOffset;
+static double totalWeight;
+
+/**
+ * @brief Les balises du cycle en cours : position, carre de la distance et poids de l'ecart sur ce carre, avec la
+ * puissance qui les departage quand il y en a plus de #PARTICLE_FILTER_NB_BEACONS_MAX.
+ */
+static uint32_t nbBeaconsUsed;
+static Power beaconsPower[PARTICLE_FILTER_NB_BEACONS_MAX];
+static float beaconsX[PARTICLE_FILTER_NB_BEACONS_MAX];
+static float beaconsY[PARTICLE_FILTER_NB_BEACONS_MAX];
+static float squaredRanges[PARTICLE_FILTER_NB_BEACONS_MAX];
+static float rangeWeights[PARTICLE_FILTER_NB_BEACONS_MAX];
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Tire un nombre pseudo-aleatoire uniforme dans [0, 1[ avec le generateur xorshift du thread.
+ *
+ * @param state L'etat du generateur, non nul.
+ * @return float Le nombre tire.
+ */
+static float nextRandom(uint32_t* state);
+
+/**
+ * @brief Tire un nombre pseudo-aleatoire uniforme dans [0, 1[ pour chaque particule d'un bloc, avec un generateur
+ * xorshift par particule : la boucle se vectorise.
+ *
+ * @param states Les etats des generateurs du bloc, non nuls.
+ * @param values Les nombres tires.
+ */
+static void nextRandomBlock(uint32_t* restrict states, float* restrict values);
+
+/**
+ * @brief Alloue une table de particules alignee sur #PARTICLES_ALIGNMENT.
+ *
+ * @param table La table a allouer.
+ * @return bool Faux si l'allocation a echoue.
+ */
+static bool allocateParticles(float** table);
+
+/**
+ * @brief Decoupe les particules en une tranche contigue par thread.
+ */
+static void splitParticles();
+
+/**
+ * @brief Deplace ou repartit les particules de la tranche puis calcule leur log-vraisemblance.
+ *
+ * Une part #PARTICLE_FILTER_RANDOM_RATIO des particules deplacees est replacee au hasard autour des balises.
+ *
+ * La log-vraisemblance d'une balise est l'ecart entre les carres de la distance a la particule et de la distance
+ * mesuree, pondere comme dans la methode des moindres carres de Mathematician : les boucles sur les particules ne
+ * contiennent ni racine ni logarithme.
+ *
+ * @param worker Le thread et sa tranche.
+ */
+static void weightChunk(Worker* worker);
+
+/**
+ * @brief Calcule les poids de la tranche et leurs sommes ponderees.
+ *
+ * @param worker Le thread et sa tranche.
+ */
+static void normalizeChunk(Worker* worker);
+
+/**
+ * @brief Tire les particules reechantillonnees qui tombent dans la tranche.
+ *
+ * Les N points du reechantillonnage systematique sont (#resampleOffset + k) * #totalWeight / N. Chaque thread tire
+ * ceux qui tombent entre la somme des poids des tranches precedentes et celle de sa tranche comprise : les threads
+ * ecrivent des particules reechantillonnees disjointes.
+ *
+ * @param worker Le thread et sa tranche.
+ */
+static void resampleChunk(Worker* worker);
+
+/**
+ * @brief Execute une etape sur la tranche d'un thread.
+ *
+ * @param worker Le thread et sa tranche.
+ * @param workerPhase L'etape.
+ */
+static void runChunk(Worker* worker, Phase workerPhase);
+
+/**
+ * @brief Execute une etape sur toutes les tranches, celle du thread appelant comprise, et attend qu'elle soit finie.
+ *
+ * @param nextPhase L'etape.
+ */
+static void runPhase(Phase nextPhase);
+
+/**
+ * @brief La boucle d'un thread du groupe, jusqu'a l'etape #PHASE_STOP.
+ *
+ * @param argument Le thread et sa tranche.
+ * @return void* NULL.
+ */
+static void* runWorker(void* argument);
+
+/**
+ * @brief Libere les tables de particules.
+ */
+static void freeParticles();
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void ParticleFilter_setNbParticles(uint32_t nbParticlesRequested) {
+    nbParticlesConfigured = nbParticlesRequested;
+}
+
+extern void ParticleFilter_setNbWorkers(uint8_t nbWorkersRequested) {
+    nbWorkersConfigured = nbWorkersRequested > PARTICLE_FILTER_NB_WORKERS_MAX ? PARTICLE_FILTER_NB_WORKERS_MAX : nbWorkersRequested;
+}
+
+extern int8_t ParticleFilter_new() {
+    if (nbParticlesConfigured == 0) {
+        return 0;
+    }
+
+    if (!allocateParticles(&particlesX) || !allocateParticles(&particlesY) || !allocateParticles(&weights)
+        || !allocateParticles(&logLikelihoods) || !allocateParticles(&resampledX) || !allocateParticles(&resampledY)) {
+        ERROR(true, "[ParticleFilter] Fail to allocate the particles");
+        freeParticles();
+        return -1;
+    }
+
+    long nbCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t nbWorkersRequested = nbWorkersConfigured > 0 ? nbWorkersConfigured : (nbCpus > 0 ? (uint32_t) nbCpus : 1);
+    uint32_t nbChunksMax = (uint32_t) ((nbParticlesConfigured + CHUNK_GRANULARITY - 1) / CHUNK_GRANULARITY);
+    if (nbWorkersRequested > PARTICLE_FILTER_NB_WORKERS_MAX) {
+        nbWorkersRequested = PARTICLE_FILTER_NB_WORKERS_MAX;
+    }
+    if (nbWorkersRequested > nbChunksMax) {
+        nbWorkersRequested = nbChunksMax;
+    }
+
+    nbParticles = nbParticlesConfigured;
+    generation = 0;
+    nbWorkersRunning = 0;
+    nbWorkers = 1;
+    resampleRandomState = RANDOM_SEED;
+    for (uint8_t i = 0; i < nbWorkersRequested; i++) {
+        for (uint32_t j = 0; j < CHUNK_GRANULARITY; j++) {
+            workers[i].randomStates[j] = RANDOM_SEED * (uint32_t) (2 * (i * CHUNK_GRANULARITY + j) + 1);
+        }
+    }
+    for (uint8_t i = 1; i < nbWorkersRequested; i++) {
+        if (pthread_create(&workers[i].thread, NULL, &runWorker, &workers[i]) != 0) {
+            TRACE("[ParticleFilter] Only %d thread(s) share the particles%s", nbWorkers, "\n");
+            break;
+        }
+        nbWorkers++;
+    }
+    splitParticles();
+    ParticleFilter_reset();
+
+    return 0;
+}
+
+extern void ParticleFilter_free() {
+    if (nbParticles == 0) {
+        return;
+    }
+
+    runPhase(PHASE_STOP);
+    for (uint8_t i = 1; i < nbWorkers; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    nbWorkers = 0;
+    nbParticles = 0;
+    freeParticles();
+}
+
+extern bool ParticleFilter_isEnabled() {
+    return nbParticles > 0;
+}
+
+extern void ParticleFilter_reset() {
+    isSpread = false;
+    areWeightsUniform = true;
+    weightScale = 1;
+    lastCaptureTime = 0;
+}
+
+extern int8_t ParticleFilter_getCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition) {
+    float minX = INFINITY;
+    float minY = INFINITY;
+    float maxX = -INFINITY;
+    float maxY = -INFINITY;
+
+    if (nbParticles == 0) {
+        return -1;
+    }
+
+    nbBeaconsUsed = 0;
+    uint32_t weakest = 0;
+    for (uint32_t i = 0; i < nbBeacon; i++) {
+        float distance;
+        float variance;
+        uint32_t slot = nbBeaconsUsed;
+
+        /* Une fois la table pleine, une balise n'entre qu'a la place de la plus faible des balises gardees */
+        if (nbBeaconsUsed == PARTICLE_FILTER_NB_BEACONS_MAX) {
+            if (beaconsData[i].power <= beaconsPower[weakest]) {
+                continue;
+            }
+            slot = weakest;
+        }
+        if (Mathematician_getRange(&beaconsData[i], &distance, &variance) < 0) {
+            continue;
+        }
+        beaconsPower[slot] = beaconsData[i].power;
+        beaconsX[slot] = (float) beaconsData[i].position.X;
+        beaconsY[slot] = (float) beaconsData[i].position.Y;
+        squaredRanges[slot] = distance * distance;
+        /* La variance du carre de la distance est 4 d^2 var(d), la log-vraisemblance en prend la moitie de l'inverse */
+        rangeWeights[slot] = 1 / (8 * distance * distance * variance);
+        if (nbBeaconsUsed < PARTICLE_FILTER_NB_BEACONS_MAX) {
+            nbBeaconsUsed++;
+            if (nbBeaconsUsed < PARTICLE_FILTER_NB_BEACONS_MAX) {
+                continue;
+            }
+        }
+        weakest = 0;
+        for (uint32_t b = 1; b < nbBeaconsUsed; b++) {
+            if (beaconsPower[b] < beaconsPower[weakest]) {
+                weakest = b;
+            }
+        }
+    }
+    if (nbBeaconsUsed < NB_BEACONS_POSITION) {
+        return -1;
+    }
+    for (uint32_t b = 0; b < nbBeaconsUsed; b++) {
+        minX = fminf(minX, beaconsX[b]);
+        minY = fminf(minY, beaconsY[b]);
+        maxX = fmaxf(maxX, beaconsX[b]);
+        maxY = fmaxf(maxY, beaconsY[b]);
+    }
+
+    uint64_t captureTime = Mathematician_getCaptureTime(beaconsData, nbBeacon);
+    areaMinX = fmaxf(minX - PARTICLE_FILTER_MARGIN, 0);
+    areaMinY = fmaxf(minY - PARTICLE_FILTER_MARGIN, 0);
+    areaWidth = maxX + PARTICLE_FILTER_MARGIN - areaMinX;
+    areaHeight = maxY + PARTICLE_FILTER_MARGIN - areaMinY;
+
+    isSpreading = !isSpread;
+    if (!isSpreading) {
+        double duration = lastCaptureTime != 0 && captureTime > lastCaptureTime ? (captureTime - lastCaptureTime) / 1e9 : 0;
+        double deviation = fmax(PARTICLE_FILTER_SPEED_MAX * duration, PARTICLE_FILTER_NOISE_MIN);
+        /* Un bruit uniforme sur [-a, a] a pour ecart type a / sqrt(3) */
+        noiseAmplitude = (float) (deviation * sqrt(3));
+    }
+
+    runPhase(PHASE_WEIGHT);
+    float maxLogLikelihood = workers[0].maxLogLikelihood;
+    for (uint8_t i = 1; i < nbWorkers; i++) {
+        maxLogLikelihood = fmaxf(maxLogLikelihood, workers[i].maxLogLikelihood);
+    }
+    if (isSpreading) {
+        isSpread = true;
+        areWeightsUniform = true;
+    }
+
+    for (uint8_t i = 0; i < nbWorkers; i++) {
+        workers[i].maxLogLikelihood = maxLogLikelihood;
+    }
+    runPhase(PHASE_NORMALIZE);
+
+    double sumWeightedX = 0;
+    double sumWeightedY = 0;
+    double sumSquaredWeights = 0;
+    totalWeight = 0;
+    for (uint8_t i = 0; i < nbWorkers; i++) {
+        workers[i].cumulativeWeight = totalWeight;
+        totalWeight += workers[i].sumWeights;
+        sumWeightedX += workers[i].sumWeightedX;
+        sumWeightedY += workers[i].sumWeightedY;
+        sumSquaredWeights += workers[i].sumSquaredWeights;
+    }
+    if (!(totalWeight > 0)) {
+        ParticleFilter_reset();
+        return -1;
+    }
+
+    weightScale = 1 / totalWeight;
+    areWeightsUniform = false;
+    if (totalWeight * totalWeight < PARTICLE_FILTER_RESAMPLE_RATIO * nbParticles * sumSquaredWeights) {
+        resampleOffset = nextRandom(&resampleRandomState);
+        runPhase(PHASE_RESAMPLE);
+
+        float* swap = particlesX;
+        particlesX = resampledX;
+        resampledX = swap;
+        swap = particlesY;
+        particlesY = resampledY;
+        resampledY = swap;
+        areWeightsUniform = true;
+    }
+    lastCaptureTime = captureTime;
+
+    double x = round(sumWeightedX / totalWeight);
+    double y = round(sumWeightedY / totalWeight);
+    currentPosition->X = x > 0 ? (uint32_t) x : 0;
+    currentPosition->Y = y > 0 ? (uint32_t) y : 0;
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static float nextRandom(uint32_t* state) {
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    /* Les 24 bits de poids fort remplissent exactement la mantisse d'un flottant */
+    return (float) (x >> 8) * (1.0f / 16777216.0f);
+}
+
+static void nextRandomBlock(uint32_t* restrict states, float* restrict values) {
+    for (uint32_t j = 0; j < CHUNK_GRANULARITY; j++) {
+        uint32_t x = states[j];
+
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        states[j] = x;
+        values[j] = (float) (x >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+static bool allocateParticles(float** table) {
+    void* memory;
+    size_t size = ((nbParticlesConfigured + CHUNK_GRANULARITY - 1) / CHUNK_GRANULARITY) * PARTICLES_ALIGNMENT;
+
+    if (posix_memalign(&memory, PARTICLES_ALIGNMENT, size) != 0) {
+        *table = NULL;
+        return false;
+    }
+    *table = memory;
+    return true;
+}
+
+static void splitParticles() {
+    uint32_t nbChunks = (uint32_t) ((nbParticles + CHUNK_GRANULARITY - 1) / CHUNK_GRANULARITY);
+    uint32_t chunkSize = (uint32_t) (((nbChunks + nbWorkers - 1) / nbWorkers) * CHUNK_GRANULARITY);
+
+    for (uint8_t i = 0; i < nbWorkers; i++) {
+        workers[i].begin = i * chunkSize < nbParticles ? i * chunkSize : nbParticles;
+        workers[i].end = workers[i].begin + chunkSize < nbParticles ? workers[i].begin + chunkSize : nbParticles;
+    }
+}
+
+static void weightChunk(Worker* worker) {
+    float* restrict x = particlesX;
+    float* restrict y = particlesY;
+    float* restrict logLikelihood = logLikelihoods;
+    const uint32_t begin = worker->begin;
+    const uint32_t end = worker->end;
+    /* Les tables sont allouees par bloc entier : la fin du dernier bloc est calculee sans etre lue */
+    const uint32_t paddedEnd = (uint32_t) ((end + CHUNK_GRANULARITY - 1) / CHUNK_GRANULARITY * CHUNK_GRANULARITY);
+
+    /* Un bloc a la fois : les boucles internes ont un nombre d'iterations constant et se vectorisent */
+    for (uint32_t block = begin; block < paddedEnd; block += CHUNK_GRANULARITY) {
+        float randomX[CHUNK_GRANULARITY];
+        float randomY[CHUNK_GRANULARITY];
+        float randomSpreadX[CHUNK_GRANULARITY];
+        float randomSpreadY[CHUNK_GRANULARITY];
+        float randomChoice[CHUNK_GRANULARITY];
+        float blockLogLikelihood[CHUNK_GRANULARITY] = { 0 };
+
+        nextRandomBlock(worker->randomStates, randomX);
+        nextRandomBlock(worker->randomStates, randomY);
+        if (isSpreading) {
+            for (uint32_t j = 0; j < CHUNK_GRANULARITY; j++) {
+                x[block + j] = areaMinX + areaWidth * randomX[j];
+                y[block + j] = areaMinY + areaHeight * randomY[j];
+            }
+        } else {
+            nextRandomBlock(worker->randomStates, randomSpreadX);
+            nextRandomBlock(worker->randomStates, randomSpreadY);
+            nextRandomBlock(worker->randomStates, randomChoice);
+            /* Les deux positions sont calculees et l'une est choisie sans branchement */
+            for (uint32_t j = 0; j < CHUNK_GRANULARITY; j++) {
+                float movedX = x[block + j] + noiseAmplitude * (2 * randomX[j] - 1);
+                float movedY = y[block + j] + noiseAmplitude * (2 * randomY[j] - 1);
+                float spreadX = areaMinX + areaWidth * randomSpreadX[j];
+                float spreadY = areaMinY + areaHeight * randomSpreadY[j];
+                x[block + j] = randomChoice[j] < (float) PARTICLE_FILTER_RANDOM_RATIO ? spreadX : movedX;
+                y[block + j] = randomChoice[j] < (float) PARTICLE_FILTER_RANDOM_RATIO ? spreadY : movedY;
+            }
+        }
+
+        for (uint32_t b = 0; b < nbBeaconsUsed; b++) {
+            const float beaconX = beaconsX[b];
+            const float beaconY = beaconsY[b];
+            const float squaredRange = squaredRanges[b];
+            const float rangeWeight = rangeWeights[b];
+
+            for (uint32_t j = 0; j < CHUNK_GRANULARITY; j++) {
+                float dx = x[block + j] - beaconX;
+                float dy = y[block + j] - beaconY;
+                float residual = dx * dx + dy * dy - squaredRange;
+                blockLogLikelihood[j] -= rangeWeight * residual * residual;
+            }
+        }
+        for (uint32_t j = 0; j < CHUNK_GRANULARITY; j++) {
+            logLikelihood[block + j] = blockLogLikelihood[j];
+        }
+    }
+
+    float maxLogLikelihood = -INFINITY;
+    for (uint32_t i = begin; i < end; i++) {
+        maxLogLikelihood = logLikelihood[i] > maxLogLikelihood ? logLikelihood[i] : maxLogLikelihood;
+    }
+    worker->maxLogLikelihood = maxLogLikelihood;
+}
+
+static void normalizeChunk(Worker* worker) {
+    const float* restrict x = particlesX;
+    const float* restrict y = particlesY;
+    const float* restrict logLikelihood = logLikelihoods;
+    float* restrict weight = weights;
+    const float maxLogLikelihood = worker->maxLogLikelihood;
+    const float scale = (float) weightScale;
+    double sumWeights = 0;
+    double sumWeightedX = 0;
+    double sumWeightedY = 0;
+    double sumSquaredWeights = 0;
+
+    if (areWeightsUniform) {
+        for (uint32_t i = worker->begin; i < worker->end; i++) {
+            weight[i] = expf(logLikelihood[i] - maxLogLikelihood);
+        }
+    } else {
+        for (uint32_t i = worker->begin; i < worker->end; i++) {
+            weight[i] *= scale * expf(logLikelihood[i] - maxLogLikelihood);
+        }
+    }
+
+    for (uint32_t i = worker->begin; i < worker->end; i++) {
+        sumWeights += weight[i];
+        sumWeightedX += weight[i] * x[i];
+        sumWeightedY += weight[i] * y[i];
+        sumSquaredWeights += weight[i] * weight[i];
+    }
+    worker->sumWeights = sumWeights;
+    worker->sumWeightedX = sumWeightedX;
+    worker->sumWeightedY = sumWeightedY;
+    worker->sumSquaredWeights = sumSquaredWeights;
+}
+
+static void resampleChunk(Worker* worker) {
+    const float* restrict x = particlesX;
+    const float* restrict y = particlesY;
+    const float* restrict weight = weights;
+    float* restrict sampledX = resampledX;
+    float* restrict sampledY = resampledY;
+    const uint32_t end = worker->end;
+    const double step = totalWeight / nbParticles;
+    double first = ceil(worker->cumulativeWeight / step - resampleOffset);
+    double last = ceil((worker->cumulativeWeight + worker->sumWeights) / step - resampleOffset);
+    /* Les bornes du premier et du dernier point ne dependent pas des arrondis des sommes */
+    uint32_t k = worker->begin == 0 || first < 0 ? 0 : (first > nbParticles ? nbParticles : (uint32_t) first);
+    uint32_t kEnd = end == nbParticles || last > nbParticles ? nbParticles : (last < 0 ? 0 : (uint32_t) last);
+    double cumulativeWeight = worker->cumulativeWeight + weight[worker->begin];
+    uint32_t i = worker->begin;
+
+    if (worker->begin == end) {
+        return;
+    }
+
+    for (; k < kEnd; k++) {
+        double point = (resampleOffset + k) * step;
+        while (cumulativeWeight <= point && i + 1 < end) {
+            i++;
+            cumulativeWeight += weight[i];
+        }
+        sampledX[k] = x[i];
+        sampledY[k] = y[i];
+    }
+}
+
+static void runChunk(Worker* worker, Phase workerPhase) {
+    switch (workerPhase) {
+        case PHASE_WEIGHT:
+            weightChunk(worker);
+            break;
+
+        case PHASE_NORMALIZE:
+            normalizeChunk(worker);
+            break;
+
+        case PHASE_RESAMPLE:
+            resampleChunk(worker);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void runPhase(Phase nextPhase) {
+    pthread_mutex_lock(&workersMutex);
+    phase = nextPhase;
+    generation++;
+    nbWorkersRunning = nbWorkers - 1;
+    pthread_cond_broadcast(&phaseStarted);
+    pthread_mutex_unlock(&workersMutex);
+
+    runChunk(&workers[0], nextPhase);
+
+    pthread_mutex_lock(&workersMutex);
+    while (nbWorkersRunning > 0) {
+        pthread_cond_wait(&phaseDone, &workersMutex);
+    }
+    pthread_mutex_unlock(&workersMutex);
+}
+
+static void* runWorker(void* argument) {
+    Worker* worker = argument;
+    uint32_t lastGeneration = 0;
+    Phase workerPhase;
+
+    do {
+        pthread_mutex_lock(&workersMutex);
+        while (generation == lastGeneration) {
+            pthread_cond_wait(&phaseStarted, &workersMutex);
+        }
+        lastGeneration = generation;
+        workerPhase = phase;
+        pthread_mutex_unlock(&workersMutex);
+
+        runChunk(worker, workerPhase);
+
+        pthread_mutex_lock(&workersMutex);
+        nbWorkersRunning--;
+        if (nbWorkersRunning == 0) {
+            pthread_cond_signal(&phaseDone);
+        }
+        pthread_mutex_unlock(&workersMutex);
+    } while (workerPhase != PHASE_STOP);
+
+    return NULL;
+}
+
+static void freeParticles() {
+    free(particlesX);
+    free(particlesY);
+    free(weights);
+    free(logLikelihoods);
+    free(resampledX);
+    free(resampledY);
+    particlesX = particlesY = weights = logLikelihoods = resampledX = resampledY = NULL;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file particleFilter.h
+ *
+ * @brief Calcule la position du robot avec un filtre particulaire, moteur alternatif a Mathematician.
+ *
+ * Chaque particule est une position possible du robot. A chaque cycle, les particules sont deplacees au hasard selon
+ * la duree ecoulee depuis le cycle precedent, quelques-unes sont replacees au hasard autour des balises, puis elles
+ * sont ponderees par la vraisemblance des distances de toutes les balises donnees par le modele d'attenuation de
+ * Mathematician. La position est la moyenne ponderee des particules. Quand le nombre effectif de particules tombe
+ * sous #PARTICLE_FILTER_RESAMPLE_RATIO, elles sont reechantillonnees de facon systematique.
+ *
+ * Les particules sont rangees en tables de flottants, une par coordonnee, et les boucles sur les particules sont
+ * vectorisables. Elles sont reparties en tranches contigues entre le thread appelant et un petit groupe de threads :
+ * la robustesse s'achete avec le nombre de particules sur les cartes qui ont des coeurs libres.
+ *
+ * ParticleFilter n'est pas protege contre les acces concurrents : il est appele par le seul thread de Scanner.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+#ifndef PARTICLE_FILTER_
+#define PARTICLE_FILTER_
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../common.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre maximal de threads qui se partagent les particules, thread appelant compris.
+ */
+#define PARTICLE_FILTER_NB_WORKERS_MAX (4)
+
+/**
+ * @brief Le nombre maximal de balises prises en compte a chaque cycle : au dela, seules les plus fortes sont gardees.
+ *
+ * Chaque balise coute un calcul de distance par particule : les plus faibles, dont la distance est la moins sure,
+ * apportent le moins a la vraisemblance.
+ */
+#define PARTICLE_FILTER_NB_BEACONS_MAX (64)
+
+/**
+ * @brief La vitesse maximale du robot, en centimetre par seconde : l'ecart type du deplacement des particules par
+ * seconde ecoulee.
+ */
+#define PARTICLE_FILTER_SPEED_MAX (100)
+
+/**
+ * @brief L'ecart type minimal du deplacement des particules a chaque cycle, en centimetre, pour qu'elles ne se
+ * confondent pas apres un reechantillonnage.
+ */
+#define PARTICLE_FILTER_NOISE_MIN (5)
+
+/**
+ * @brief La marge autour des balises dans laquelle les particules sont reparties au depart, en centimetre.
+ */
+#define PARTICLE_FILTER_MARGIN (200)
+
+/**
+ * @brief La part du nombre de particules sous laquelle le nombre effectif de particules declenche le reechantillonnage.
+ */
+#define PARTICLE_FILTER_RESAMPLE_RATIO (0.5)
+
+/**
+ * @brief La part des particules replacees au hasard autour des balises a chaque cycle, pour retrouver le robot s'il
+ * a ete deplace sans que les particules le suivent.
+ */
+#define PARTICLE_FILTER_RANDOM_RATIO (0.01)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Regle le nombre de particules, a appeler avant #ParticleFilter_new.
+ *
+ * @param nbParticles Le nombre de particules, 0 (par defaut) pour garder le calcul de Mathematician.
+ */
+extern void ParticleFilter_setNbParticles(uint32_t nbParticles);
+
+/**
+ * @brief Regle le nombre de threads qui se partagent les particules, a appeler avant #ParticleFilter_new.
+ *
+ * @param nbWorkers Le nombre de threads, thread appelant compris, au plus #PARTICLE_FILTER_NB_WORKERS_MAX ; 0 (par
+ * defaut) pour un par coeur en ligne.
+ */
+extern void ParticleFilter_setNbWorkers(uint8_t nbWorkers);
+
+/**
+ * @brief Alloue les particules et demarre les threads, sans effet si le nombre de particules est nul.
+ *
+ * @return int8_t -1 si l'allocation ou la creation des threads a echoue, le filtre reste alors desactive, 0 sinon.
+ */
+extern int8_t ParticleFilter_new();
+
+/**
+ * @brief Arrete les threads et libere les particules.
+ */
+extern void ParticleFilter_free();
+
+/**
+ * @brief Indique si le filtre particulaire remplace le calcul de Mathematician.
+ *
+ * @return bool Vrai si les particules sont allouees.
+ */
+extern bool ParticleFilter_isEnabled();
+
+/**
+ * @brief Oublie les particules, elles seront reparties autour des balises au prochain cycle.
+ */
+extern void ParticleFilter_reset();
+
+/**
+ * @brief Calcule la position du robot a partir des balises recues pendant le cycle.
+ *
+ * @param beaconsData Les balises, dans un ordre quelconque : seules les #PARTICLE_FILTER_NB_BEACONS_MAX plus fortes
+ * sont prises en compte.
+ * @param nbBeacon Le nombre de balises.
+ * @param currentPosition La position a remplir, inchangee en cas d'erreur.
+ * @return int8_t -1 si le filtre est desactive ou s'il y a moins de #NB_BEACONS_POSITION balises utilisables, 0 sinon.
+ */
+extern int8_t ParticleFilter_getCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition);
+
+#endif // PARTICLE_FILTER_
@@ -12,8 +12,19 @@
 #include <errno.h>
 #include <curses.h>
 #include <unistd.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/hci.h>
 #include <bluetooth/hci_lib.h>
@@ -23,11 +34,13 @@
 #include <pthread.h>
 #include <stdbool.h>
 #include <assert.h>
+#include <time.h>
 
 #include "receiver.h"
 #include "../TranslatorBeacon/translatorBeacon.h"
-#include "../Watchdog/watchdog.h"
-#include "../Scanner/scanner.h"
+#include "../Replayer/replayer.h"
+#include "../FilterBank/filterBank.h"
+#include "../BeaconRegistry/beaconRegistry.h"
 #include "../common.h"
 #include "../tools.h"
 #include "stdbool.h"
@@ -41,48 +54,291 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#define NB_BEACONS_AVAILABLE (5)
-#define NB_MAX_ADVERTISING_CHANNEL (100)
-#define NB_MAX_BEACONS_AVAILABLE (4)
+/**
+ * @brief Le nombre maximal d'evenements HCI vides de la socket a chaque reveil du thread de scan.
+ */
+#define NB_MAX_HCI_EVENTS (64)
+
+/**
+ * @brief Le delai maximal d'attente d'un evenement HCI en milliseconde, permet de verifier regulierement l'arret du scan.
+ */
+#define HCI_POLL_TIMEOUT (100)
+
+/**
+ * @brief Le delai maximal de reponse du controleur a une commande HCI en milliseconde.
+ */
+#define HCI_REQUEST_TIMEOUT (1000)
+
+/**
+ * @brief Les commandes de scan etendu de Bluetooth 5, absentes des en-tetes de BlueZ.
+ */
+#define OCF_LE_SET_EXTENDED_SCAN_PARAMETERS (0x0041)
+#define OCF_LE_SET_EXTENDED_SCAN_ENABLE (0x0042)
+
+/**
+ * @brief Le PHY LE 1M, seul PHY primaire scanne : les donnees envoyees sur le PHY 2M sont suivies par le controleur.
+ */
+#define SCAN_PHY_LE_1M (0x01)
+
+/**
+ * @brief Le nombre d'arguments du processus de scan : le programme, #RECEIVER_SCAN_PROCESS_ARGUMENT, les
+ * descripteurs de la memoire partagee, du tube et de l'eventfd, le nombre d'adaptateurs et le coeur.
+ */
+#define SCAN_PROCESS_NB_ARGUMENTS (7)
+
+/**
+ * @brief Les parametres de la commande LE Set Extended Scan Parameters, pour le seul PHY LE 1M.
+ */
+typedef struct {
+    uint8_t ownBdaddrType;
+    uint8_t filter;
+    uint8_t phys;
+    uint8_t type;
+    uint16_t interval;
+    uint16_t window;
+} __attribute__((packed)) ExtendedScanParameters;
+
+/**
+ * @brief Les parametres de la commande LE Set Extended Scan Enable.
+ */
+typedef struct {
+    uint8_t enable;
+    uint8_t filterDup;
+    uint16_t duration;
+    uint16_t period;
+} __attribute__((packed)) ExtendedScanEnable;
 
-#define BEACONS_UUID_1 (0x18)
-#define BEACONS_UUID_2 (0x1A)
 
 #define MQ_MAX_MESSAGES (10)
 
-static BeaconSignal beaconsSignal[NB_MAX_BEACONS_AVAILABLE] = {
-    {{'B','1','\0'},  {BEACONS_UUID_1, BEACONS_UUID_2}, -69.51544993, {400, 700}},
-    {{'B','2','\0'},  {BEACONS_UUID_1, BEACONS_UUID_2}, -68.45673382, {980, 100}},
-    {{'B','3','\0'},  {BEACONS_UUID_1, BEACONS_UUID_2}, -72.97218376, {1300, 800}},
-    {{'B','4','\0'},  {BEACONS_UUID_1, BEACONS_UUID_2}, -98, {1500, 1500}}
+/**
+ * @brief L'emplacement d'une balise absente de la table des dernieres donnees recues.
+ */
+#define SLOT_NONE (UINT16_MAX)
+
+/**
+ * @brief Le nombre d'elements des tables par balise, la capacite de BeaconRegistry lors de #Receiver_new.
+ */
+static uint16_t beaconsCapacity = 0;
+
+/**
+ * @brief La table des dernieres donnees recues pour chaque balise, propre au thread de scan.
+ */
+static BeaconSignal* beaconsSignal = NULL;
+static uint32_t NbBeaconsSignal = 0;
+
+/**
+ * @brief L'emplacement de chaque balise dans #beaconsSignal, par #BeaconIndex, #SLOT_NONE si elle n'y est pas.
+ */
+static uint16_t* beaconsSignalSlot = NULL;
+
+/**
+ * @brief Le filtre du RSSI de chaque balise de #beaconsSignal, au meme indice.
+ */
+static RssiFilter* rssiFilters = NULL;
+
+/**
+ * @brief L'etat de sante d'une balise de l'ensemble actif, mis a jour a chaque annonce.
+ *
+ * La moyenne et la variance du RSSI brut sont calculees en ligne par l'algorithme de Welford.
+ */
+typedef struct {
+    uint64_t firstSeen;         /**< La date de la premiere annonce depuis l'entree dans l'ensemble actif, en nanoseconde. */
+    uint32_t nbAdvertisements;  /**< Le nombre d'annonces recues depuis l'entree dans l'ensemble actif. */
+    float rssiMean;             /**< La moyenne du RSSI brut. */
+    float rssiM2;               /**< La somme des carres des ecarts a la moyenne du RSSI brut. */
+} BeaconHealth;
+
+/**
+ * @brief L'etat de sante de chaque balise de #beaconsSignal, au meme indice.
+ */
+static BeaconHealth* beaconsHealth = NULL;
+
+/**
+ * @brief Le nombre de retraits de l'ensemble actif de chaque balise, par #BeaconIndex.
+ */
+static uint16_t* nbDropouts = NULL;
+
+/**
+ * @brief Le delai sans annonce apres lequel une balise est retiree de l'ensemble actif, en milliseconde.
+ */
+static uint32_t beaconTimeout = RECEIVER_BEACON_TIMEOUT_DEFAULT;
+
+/**
+ * @brief La fonction appelee pour chaque annonce fusionnee, NULL pour aucune.
+ */
+static ReceiverReportListener reportListener = NULL;
+
+/**
+ * @brief Vrai si #beaconsSignal a change depuis la derniere publication.
+ */
+static bool isBeaconsSignalUpdated = false;
+
+/**
+ * @brief Une copie complete de #beaconsSignal publiee pour Scanner.
+ *
+ * La sequence est impaire pendant l'ecriture de la copie : un lecteur qui lit la meme sequence paire avant et
+ * apres sa lecture est assure d'avoir lu une copie coherente.
+ */
+typedef struct {
+    uint32_t sequence;
+    uint32_t nbBeaconsSignal;
+    BeaconSignal* beaconsSignal;
+    BeaconStatistics* beaconsStatistics;   /**< Les statistiques de chaque balise, sans l'anciennete calculee a la lecture. */
+} BeaconsSignalSnapshot;
+
+/**
+ * @brief Les deux copies publiees : le thread de scan ecrit toujours celle qui n'est pas la plus recente.
+ */
+static BeaconsSignalSnapshot snapshots[2];
+
+/**
+ * @brief L'indice dans #snapshots de la copie la plus recente.
+ */
+static uint32_t lastSnapshot = 0;
+
+/**
+ * @brief Le nombre de rapports que peut contenir la file de chaque adaptateur, une puissance de 2.
+ */
+#define REPORT_RING_SIZE (2048)
+
+/**
+ * @brief La file sans verrou des rapports d'un adaptateur vers l'etage de fusion.
+ *
+ * Un seul producteur, le thread de scan de l'adaptateur, avance head ; un seul consommateur, l'etage de fusion,
+ * avance tail. Les deux compteurs croissent librement, l'emplacement d'un rapport est son compteur modulo
+ * #REPORT_RING_SIZE.
+ */
+typedef struct {
+    BeaconSignal reports[REPORT_RING_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t nbDroppedReports;  /**< Les rapports perdus car la file etait pleine, ecrit par le producteur. */
+} ReportRing;
+
+/**
+ * @brief Un adaptateur Bluetooth, scanne par son propre thread.
+ */
+typedef struct {
+    uint8_t id;             /**< L'indice de l'adaptateur dans ReceiverShared, recopie dans chacun de ses rapports. */
+    int deviceId;           /**< Le numero N du peripherique hciN, -1 pour le peripherique par defaut. */
+    int socket;             /**< La socket HCI lue par le thread, -1 si l'adaptateur n'est pas ouvert. */
+    bool isHciDevice;       /**< Vrai si la socket a ete ouverte par Receiver, faux si elle a ete donnee par #Receiver_setHciSocket. */
+    bool isScanned;         /**< Vrai si le thread de scan de l'adaptateur a ete lance. */
+    uint32_t scanConfigurationVersion;  /**< La version des parametres du scan appliquee au peripherique. */
+    bool isExtendedScan;    /**< Vrai si le peripherique est scanne avec les commandes etendues, choisi a son ouverture. */
+    pthread_t thread;
+    ReportRing ring;
+    uint8_t hciEvents[NB_MAX_HCI_EVENTS][HCI_MAX_EVENT_SIZE];   /**< Le buffer preallouee dans lequel le thread vide les evenements HCI en attente. */
+    uint16_t hciEventsSize[NB_MAX_HCI_EVENTS];
+    uint64_t hciEventsTimestamp[NB_MAX_HCI_EVENTS];             /**< La date de reception de chaque evenement par le noyau, sur l'horloge monotone, en nanoseconde. */
+} Adapter;
+
+/**
+ * @brief L'etat partage entre l'etage de fusion et les threads de scan.
+ *
+ * Quand les threads de scan tournent dans un processus isole, cet etat est place dans une memoire partagee entre
+ * les deux processus : les files des adaptateurs y restent des files sans verrou a un producteur et un consommateur,
+ * et le mutex des parametres du scan est partage entre processus.
+ */
+typedef struct {
+    Adapter adapters[RECEIVER_NB_MAX_ADAPTERS];     /**< Les adaptateurs scannes, ou l'adaptateur 0 seul pour une socket donnee ou le rejeu d'une capture. */
+    ReceiverScanConfiguration scanConfiguration;    /**< Les parametres du scan du peripherique HCI. */
+    uint32_t scanConfigurationVersion;              /**< La version de scanConfiguration, incrementee a chaque changement. */
+    pthread_mutex_t scanConfigurationMutex;         /**< Le mutex qui protege scanConfiguration et sa version. */
+    ThirdPartyBeacon thirdPartyBeacons[TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY];   /**< Les balises du commerce enregistrees, que le processus de scan enregistre a son tour. */
+    uint8_t nbThirdPartyBeacons;
+} ReceiverShared;
+
+/**
+ * @brief L'etat partage quand le scan tourne dans le processus de Receiver, par defaut un scan passif continu
+ * toutes les 10 ms.
+ *
+ * Chaque thread de scan compare la version des parametres a celle appliquee a son peripherique et reapplique les
+ * parametres quand elle a change.
+ */
+static ReceiverShared localShared = {
+    .scanConfiguration = {
+        .interval = 0x0010,
+        .window = 0x0010,
+        .isActive = false
+    },
+    .scanConfigurationVersion = 0,
+    .scanConfigurationMutex = PTHREAD_MUTEX_INITIALIZER
 };
 
-static BeaconsChannel* beaconsChannel;
-static uint32_t NbBeaconsSignal = 3;
+/**
+ * @brief L'etat partage courant, #localShared ou la memoire partagee avec le processus de scan.
+ */
+static ReceiverShared* shared = &localShared;
+static uint8_t nbAdapters = 0;
+
+/**
+ * @brief Les peripheriques hciN a scanner, donnes par #Receiver_setHciDevices, -1 pour le peripherique par defaut.
+ */
+static int hciDevices[RECEIVER_NB_MAX_ADAPTERS] = {-1};
+static uint8_t nbHciDevices = 1;
+
+/**
+ * @brief La socket donnee par #Receiver_setHciSocket a la place des peripheriques HCI, -1 sinon.
+ */
+static int givenHciSocket = -1;
+
+/**
+ * @brief L'eventfd qui reveille l'etage de fusion quand un adaptateur a ajoute des rapports a sa file.
+ */
+static int mergeEventFd = -1;
+
+/**
+ * @brief Le nombre de rapports traites par l'etage de fusion depuis le demarrage.
+ */
+static uint64_t nbMergedReports = 0;
+
+/**
+ * @brief La capture a rejouer a la place du peripherique HCI, NULL pour scanner, et sa vitesse de rejeu.
+ */
+static const char* capturePath = NULL;
+static float captureSpeed = REPLAYER_SPEED_RECORDED;
+
+/**
+ * @brief Vrai si les threads de scan tournent dans un processus isole, et le coeur auquel il est epingle.
+ */
+static bool isScanProcess = false;
+static int scanProcessCpu = RECEIVER_CPU_ANY;
+
+/**
+ * @brief Le processus de scan, -1 s'il n'est pas lance.
+ */
+static pid_t scanProcess = -1;
+
+/**
+ * @brief Le tube dont la fermeture de l'extremite d'ecriture arrete le processus de scan, y compris a la mort de
+ * Receiver.
+ */
+static int scanProcessPipe[2] = {-1, -1};
+
+/**
+ * @brief La memoire qui porte l'etat partage avec le processus de scan, -1 si l'etat est dans #localShared.
+ */
+static int sharedMemory = -1;
+
+static volatile bool isScanning = false;
 
 typedef enum {
     S_FORGET = 0,
     S_SCANNING,
-    S_TRANSLATING,
     S_DEATH,
     NB_STATE
 }State_RECEIVER;
 
 typedef enum {
     E_STOP = 0,
-    E_ASK_BEACONS_SIGNAL,
-    E_MAJ_BEACONS_CHANNEL,
-    E_TIME_OUT,
-    E_TRANSLATING_DONE,
     NB_EVENT_RECEIVER
 } Event_RECEIVER;
 
 typedef enum {
     A_NOP = 0,
     A_STOP,
-    A_SEND_BEACONS_SIGNAL,
-    A_MAJ_BEACONS_CHANNELS,
-    A_TRANSLATE,
     NB_ACTION_RECEIVER
 } Action_RECEIVER;
 
@@ -93,14 +349,7 @@ typedef struct {
 
 static Transition_RECEIVER stateMachine[NB_STATE - 1][NB_EVENT_RECEIVER] =
 {
-    [S_SCANNING] [E_MAJ_BEACONS_CHANNEL] = {S_SCANNING, A_MAJ_BEACONS_CHANNELS},
-    [S_SCANNING][E_ASK_BEACONS_SIGNAL] = {S_SCANNING, A_SEND_BEACONS_SIGNAL},
-    [S_SCANNING][E_TIME_OUT] = {S_TRANSLATING, A_TRANSLATE},
     [S_SCANNING][E_STOP] = {S_DEATH, A_STOP},
-
-    [S_TRANSLATING][E_ASK_BEACONS_SIGNAL] = {S_SCANNING, A_SEND_BEACONS_SIGNAL},
-    [S_TRANSLATING][E_TRANSLATING_DONE] = {S_SCANNING, A_MAJ_BEACONS_CHANNELS},
-    [S_TRANSLATING][E_STOP] = {S_DEATH, A_STOP},
 };
 
 struct hci_request ble_hci_request(uint16_t ocf, uint8_t clen, void* status, void* cparam) {
@@ -115,8 +364,9 @@ struct hci_request ble_hci_request(uint16_t ocf, uint8_t clen, void* status, voi
     return rq;
 }
 
-State_RECEIVER myState;
+static State_RECEIVER myState;
 static pthread_t myThreadMq;
+static pthread_t myThreadMerge;    // Thread de l'etage de fusion, ou de rejeu
 
 static const char BAL[] = "/BALReceiver";
 static mqd_t descripteur;
@@ -126,9 +376,6 @@ typedef struct {
     Event_RECEIVER event;
 } MqMsgReceiver;
 
-static Watchdog* wtd_TScan;
-static pthread_mutex_t myMutex = PTHREAD_MUTEX_INITIALIZER;
-
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Fonctions static
@@ -162,18 +409,236 @@ static int8_t sendMsg(MqMsgReceiver* this);
 static void mqReceive(MqMsgReceiver* this);
 
 /**
- * @fn static void Receiver_translateChannelToBeaconsSignal()
- * @brief traduit le tableau en variable globale de BeaconChannel en BeaconSignal
+ * @fn static void initAdapters()
+ * @brief Prepare les adaptateurs a ouvrir : la socket donnee, l'adaptateur du rejeu ou chaque peripherique configure
+ */
+static void initAdapters();
+
+/**
+ * @fn static int8_t createSharedState()
+ * @brief Place l'etat partage dans une memoire partagee avec le processus de scan, avec les parametres courants du scan
+ *
+ * @return renvoie -1 si une erreur est detectee, sinon 0
+ */
+static int8_t createSharedState();
+
+/**
+ * @fn static void destroySharedState()
+ * @brief Ramene l'etat partage dans le processus de Receiver, en gardant les parametres courants du scan, et libere la memoire partagee
+ */
+static void destroySharedState();
+
+/**
+ * @fn static void lockScanConfiguration()
+ * @brief Verrouille les parametres du scan, meme si le processus de scan a ete tue en les tenant
+ */
+static void lockScanConfiguration();
+
+/**
+ * @fn static int8_t startScanProcess()
+ * @brief Lance le processus de scan et l'etage de fusion qui lit les files des adaptateurs en memoire partagee
+ *
+ * @return renvoie -1 si une erreur est detectee, sinon 0
+ */
+static int8_t startScanProcess();
+
+/**
+ * @fn static int8_t spawnScanProcess()
+ * @brief Lance le processus de scan, qui ouvre les adaptateurs et lance leurs threads de scan
+ *
+ * @return renvoie -1 si une erreur est detectee, sinon 0
+ */
+static int8_t spawnScanProcess();
+
+/**
+ * @fn static void formatDescriptor(char* buffer, size_t size, int value)
+ * @brief Ecrit un entier en argument du processus de scan
+ *
+ * @param buffer l'argument a remplir
+ * @param size la taille de l'argument
+ * @param value l'entier
+ */
+static void formatDescriptor(char* buffer, size_t size, int value);
+
+/**
+ * @fn static void runScanProcess()
+ * @brief Corps du processus de scan, qui scanne les adaptateurs jusqu'a la fermeture de #scanProcessPipe
+ *
+ * Le processus ne revient jamais : il se termine avec le code 0 apres l'arret, et 1 si aucun adaptateur n'a pu
+ * etre ouvert.
+ */
+static void runScanProcess();
+
+/**
+ * @fn static void superviseScanProcess()
+ * @brief Relance le processus de scan s'il a ete tue par un signal
+ */
+static void superviseScanProcess();
+
+/**
+ * @fn static void stopScanProcess()
+ * @brief Arrete le processus de scan et attend sa fin
+ */
+static void stopScanProcess();
+
+/**
+ * @fn static int8_t openHciDevice(Adapter* adapter)
+ * @brief Ouvre le peripherique HCI de l'adaptateur et active le scan LE
+ *
+ * @param adapter l'adaptateur a ouvrir
+ * @return renvoie -1 si une erreur est detectee, sinon 0
+ */
+static int8_t openHciDevice(Adapter* adapter);
+
+/**
+ * @fn static void closeHciDevice(Adapter* adapter)
+ * @brief Desactive le scan LE et ferme le peripherique HCI de l'adaptateur s'il a ete ouvert par Receiver
+ *
+ * @param adapter l'adaptateur a fermer
+ */
+static void closeHciDevice(Adapter* adapter);
+
+/**
+ * @fn static int8_t setScanEnable(const Adapter* adapter, uint8_t enable)
+ * @brief Active ou desactive le scan LE aupres du controleur, avec la commande classique ou etendue de l'adaptateur
+ *
+ * @param adapter l'adaptateur ouvert
+ * @param enable 0x01 pour activer le scan, 0x00 pour le desactiver
+ * @return renvoie -1 si une erreur est detectee, sinon 0
+ */
+static int8_t setScanEnable(const Adapter* adapter, uint8_t enable);
+
+/**
+ * @fn static int8_t setScanParameters(Adapter* adapter)
+ * @brief Envoie au peripherique de l'adaptateur les parametres courants du scan, qui doit etre desactive
+ *
+ * @param adapter l'adaptateur, dont la version des parametres appliques est mise a jour
+ * @return renvoie -1 si une erreur est detectee, sinon 0
+ */
+static int8_t setScanParameters(Adapter* adapter);
+
+/**
+ * @fn static void applyScanConfiguration(Adapter* adapter)
+ * @brief Applique au peripherique de l'adaptateur les parametres du scan changes pendant le scan
+ *
+ * Le scan est interrompu le temps du changement, seul le thread de scan de l'adaptateur doit l'appeler.
+ *
+ * @param adapter l'adaptateur a reconfigurer
+ */
+static void applyScanConfiguration(Adapter* adapter);
+
+/**
+ * @fn static uint32_t drainHciEvents(Adapter* adapter)
+ * @brief Vide dans le buffer de l'adaptateur l'ensemble des evenements HCI en attente sur sa socket sans bloquer
+ *
+ * Chaque evenement est date de sa reception par le noyau, ou de sa lecture si la socket ne donne pas de date.
+ *
+ * @param adapter l'adaptateur a lire
+ * @return le nombre d'evenements lus
+ */
+static uint32_t drainHciEvents(Adapter* adapter);
+
+/**
+ * @fn static uint64_t getKernelTimestamp(struct msghdr* message)
+ * @brief Donne la date de reception d'un message posee par le noyau
+ *
+ * Une socket HCI brute la donne dans un struct timeval (SOL_HCI, HCI_CMSG_TSTAMP) apres HCI_TIME_STAMP, une autre
+ * socket, comme la socketpair donnee par #Receiver_setHciSocket, dans un struct timespec (SCM_TIMESTAMPNS).
+ *
+ * @param message le message lu par recvmsg, avec ses donnees de controle
+ * @return la date sur l'horloge temps reel en nanoseconde, 0 si le message n'est pas date
+ */
+static uint64_t getKernelTimestamp(struct msghdr* message);
+
+/**
+ * @fn static uint8_t ingestHciEvent(Adapter* adapter, const uint8_t* event, uint16_t size, uint64_t timestamp)
+ * @brief Traduit chaque rapport d'advertising LE contenu dans l'evenement et l'ajoute a la file de l'adaptateur
+ *
+ * Les evenements qui ne sont pas des LE Meta advertising report, classiques ou etendus, sont ignores. Les rapports sont lus en place,
+ * l'evenement peut donc pointer directement dans le buffer de reception ou dans une capture rejouee. Les rapports
+ * qui ne tiennent plus dans la file sont perdus et comptes.
+ *
+ * @param adapter l'adaptateur qui a recu l'evenement
+ * @param event l'evenement HCI a partir de son en-tete hci_event_hdr, sans l'octet de type de paquet
+ * @param size la taille de l'evenement
+ * @param timestamp la date de reception de l'evenement sur l'horloge monotone, en nanoseconde
+ * @return le nombre de rapports d'advertising lus
+ */
+static uint8_t ingestHciEvent(Adapter* adapter, const uint8_t* event, uint16_t size, uint64_t timestamp);
+
+/**
+ * @fn static uint32_t mergeReports()
+ * @brief Vide les files de tous les adaptateurs dans #beaconsSignal, par date de reception croissante
+ *
+ * Chaque file etant deja dans l'ordre de reception, le rapport le plus ancien en tete des files est traite a
+ * chaque fois. Seul l'etage de fusion met a jour #beaconsSignal et BeaconRegistry.
+ *
+ * @return le nombre de rapports traites
+ */
+static uint32_t mergeReports();
+
+/**
+ * @fn static void updateBeaconsSignal(const BeaconSignal* beaconSignal)
+ * @brief Remplace les donnees de la balise dans #beaconsSignal, ou l'ajoute si elle n'est pas encore connue
+ *
+ * La balise est retrouvee par son indice dans BeaconRegistry. Le RSSI conserve est celui estime par le filtre de
+ * la balise, avec la variance de ses dernieres estimations, l'annonce brute est passee a #reportListener.
+ *
+ * @param beaconSignal les donnees extraites de la derniere trame de la balise
+ */
+static void updateBeaconsSignal(const BeaconSignal* beaconSignal);
+
+/**
+ * @fn static void evictStaleBeacons(uint64_t now)
+ * @brief Retire de #beaconsSignal les balises sans annonce depuis plus de #beaconTimeout
+ *
+ * @param now la date courante sur l'horloge monotone, en nanoseconde
+ */
+static void evictStaleBeacons(uint64_t now);
+
+/**
+ * @fn static void removeBeaconsSignal(uint16_t slot)
+ * @brief Retire une balise de #beaconsSignal en y deplacant la derniere, sans decaler les autres
+ *
+ * @param slot l'emplacement de la balise a retirer
+ */
+static void removeBeaconsSignal(uint16_t slot);
+
+/**
+ * @fn static uint64_t getMonotonicTime()
+ * @brief Donne la date courante sur l'horloge monotone
+ *
+ * @return la date en nanoseconde
+ */
+static uint64_t getMonotonicTime();
+
+/**
+ * @fn static uint64_t getRealTime()
+ * @brief Donne la date courante sur l'horloge temps reel, celle des dates posees par le noyau
+ * @return la date en nanoseconde
  */
+static uint64_t getRealTime();
 
-static void Receiver_translateChannelToBeaconsSignal();
+/**
+ * @fn static int8_t allocateBeaconsSignal(uint16_t capacity)
+ * @brief Alloue et vide les tables par balise, une fois pour toutes
+ *
+ * @param capacity le nombre maximal de balises suivies
+ * @return retourne -1 en cas d'erreur, 0 sinon
+ */
+static int8_t allocateBeaconsSignal(uint16_t capacity);
 
 /**
- * @fn static void Receiver_getAllBeaconsChannel()
- * @brief methode privee permettant de memoriser dans beaconsChannel l'ensemble des trames des balises
+ * @fn static void freeBeaconsSignal()
+ * @brief Libere les tables par balise
  */
+static void freeBeaconsSignal();
 
-static void Receiver_getAllBeaconsChannel();
+/**
+ * @fn static void publishBeaconsSignal()
+ * @brief Publie une copie de #beaconsSignal pour Scanner si elle a change, sans jamais bloquer
+ */
+static void publishBeaconsSignal();
 
 /**
  * @fn static void performAction(Action_SCANNER action, MqMsgReceiver * msg)
@@ -191,10 +656,22 @@ static void performAction(Action_RECEIVER action, MqMsgReceiver* msg);
 static void* run(void* _);
 
 /**
- * @fn static void time_out()
- * @brief fonction de callback du watchdog wtd_TScan
+ * @fn static void * runScan(void* adapter)
+ * @brief thread d'un adaptateur qui attend ses evenements HCI, les traduit par lot et les ajoute a sa file
+*/
+static void* runScan(void* adapter);
+
+/**
+ * @fn static void * runMerge()
+ * @brief thread de l'etage de fusion, reveille par les adaptateurs, qui fusionne leurs files et publie le resultat
 */
-static void time_out();
+static void* runMerge(void* _);
+
+/**
+ * @fn static void * runReplay()
+ * @brief thread qui rejoue les evenements HCI de la capture et les traduit comme s'ils venaient du peripherique
+*/
+static void* runReplay(void* _);
 
 static void mqInit() {
 
@@ -236,48 +713,780 @@ static void mqReceive(MqMsgReceiver* msg) {
     mq_receive(descripteur, (char*) msg, sizeof(MqMsgReceiver), NULL);
 }
 
-static void Receiver_translateChannelToBeaconsSignal() {
-    MqMsgReceiver msg = { .event = E_TRANSLATING_DONE };
-    sendMsg(&msg);
+static int8_t setScanEnable(const Adapter* adapter, uint8_t enable) {
+    uint8_t status;
+    struct hci_request rq;
+    le_set_scan_enable_cp scanEnable;
+    ExtendedScanEnable extendedScanEnable;
+
+    /* Chaque annonce est un echantillon de RSSI, les doublons sont conserves */
+    if (adapter->isExtendedScan) {
+        memset(&extendedScanEnable, 0, sizeof(extendedScanEnable));
+        extendedScanEnable.enable = enable;
+        extendedScanEnable.filterDup = 0x00;
+        extendedScanEnable.duration = htobs(0);     // Scan continu, jusqu'a sa desactivation
+        extendedScanEnable.period = htobs(0);
+        rq = ble_hci_request(OCF_LE_SET_EXTENDED_SCAN_ENABLE, sizeof(extendedScanEnable), &status, &extendedScanEnable);
+    } else {
+        memset(&scanEnable, 0, sizeof(scanEnable));
+        scanEnable.enable = enable;
+        scanEnable.filter_dup = 0x00;
+        rq = ble_hci_request(OCF_LE_SET_SCAN_ENABLE, LE_SET_SCAN_ENABLE_CP_SIZE, &status, &scanEnable);
+    }
+
+    return hci_send_req(adapter->socket, &rq, HCI_REQUEST_TIMEOUT) < 0 ? -1 : 0;
 }
 
-static void Receiver_getAllBeaconsChannel() {
-    // Do something in a other process
+static void initAdapters() {
+    if (givenHciSocket >= 0 || capturePath != NULL) {
+        nbAdapters = 1;
+    } else {
+        nbAdapters = nbHciDevices;
+    }
+
+    for (uint8_t i = 0; i < nbAdapters; i++) {
+        shared->adapters[i].id = i;
+        shared->adapters[i].deviceId = (givenHciSocket >= 0 || capturePath != NULL) ? -1 : hciDevices[i];
+        shared->adapters[i].socket = givenHciSocket;
+        shared->adapters[i].isHciDevice = (givenHciSocket < 0 && capturePath == NULL);
+        shared->adapters[i].isScanned = false;
+        shared->adapters[i].ring.head = 0;
+        shared->adapters[i].ring.tail = 0;
+        shared->adapters[i].ring.nbDroppedReports = 0;
+    }
+    nbMergedReports = 0;
 }
 
-static void performAction(Action_RECEIVER action, MqMsgReceiver* msg) {
-    switch (action) {
+static int8_t createSharedState() {
+    ReceiverShared* sharedState;
+    pthread_mutexattr_t mutexAttributes;
+
+    /* Un memfd plutot qu'une memoire anonyme : le processus de scan execute a nouveau GEOLOGIE et la retrouve par son descripteur */
+    sharedMemory = memfd_create("geologie-receiver", 0);
+    if (sharedMemory < 0 || ftruncate(sharedMemory, sizeof(ReceiverShared)) < 0) {
+        ERROR(true, "[Receiver] Fail to create the memory shared with the scan process");
+        if (sharedMemory >= 0) {
+            close(sharedMemory);
+            sharedMemory = -1;
+        }
+        return -1;
+    }
 
-        case A_SEND_BEACONS_SIGNAL:
-            for (uint8_t i = 0; i < NbBeaconsSignal; i++) {
-                beaconsSignal[i].rssi = -((rand() % 104) - 4);
-            }
-            Scanner_setAllBeaconsSignal(beaconsSignal, NbBeaconsSignal);
-            Watchdog_start(wtd_TScan);
-            break;
+    sharedState = mmap(NULL, sizeof(ReceiverShared), PROT_READ | PROT_WRITE, MAP_SHARED, sharedMemory, 0);
+    if (sharedState == MAP_FAILED) {
+        ERROR(true, "[Receiver] Fail to map the memory shared with the scan process");
+        close(sharedMemory);
+        sharedMemory = -1;
+        return -1;
+    }
 
-        case A_MAJ_BEACONS_CHANNELS:
-            Watchdog_start(wtd_TScan);
-            Receiver_getAllBeaconsChannel();
-            break;
+    Receiver_getScanConfiguration(&sharedState->scanConfiguration);
+    sharedState->scanConfigurationVersion = localShared.scanConfigurationVersion;
+    sharedState->nbThirdPartyBeacons = TranslatorBeacon_getThirdPartyBeacons(sharedState->thirdPartyBeacons, TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY);
 
-        case A_TRANSLATE:
-            Receiver_translateChannelToBeaconsSignal(beaconsChannel);
+    pthread_mutexattr_init(&mutexAttributes);
+    pthread_mutexattr_setpshared(&mutexAttributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutexAttributes, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&sharedState->scanConfigurationMutex, &mutexAttributes);
+    pthread_mutexattr_destroy(&mutexAttributes);
 
-        case A_STOP:
-            break;
-        default:
-            break;
+    shared = sharedState;
+    return 0;
+}
+
+static void destroySharedState() {
+    ReceiverScanConfiguration configuration;
+
+    if (shared == &localShared) {
+        return;
     }
 
+    Receiver_getScanConfiguration(&configuration);
+    pthread_mutex_lock(&localShared.scanConfigurationMutex);
+    localShared.scanConfiguration = configuration;
+    localShared.scanConfigurationVersion = shared->scanConfigurationVersion;
+    pthread_mutex_unlock(&localShared.scanConfigurationMutex);
+
+    pthread_mutex_destroy(&shared->scanConfigurationMutex);
+    munmap(shared, sizeof(ReceiverShared));
+    close(sharedMemory);
+    sharedMemory = -1;
+    shared = &localShared;
 }
 
-static void* run(void* _) {
-    while (myState != S_DEATH) {
-        MqMsgReceiver msg;
-        Action_RECEIVER action;
+static void lockScanConfiguration() {
+    /* Le processus de scan ne fait que lire les parametres, ils restent coherents s'il est tue en les tenant */
+    if (pthread_mutex_lock(&shared->scanConfigurationMutex) == EOWNERDEAD) {
+        pthread_mutex_consistent(&shared->scanConfigurationMutex);
+    }
+}
 
-        mqReceive(&msg);
+static int8_t startScanProcess() {
+    /* L'eventfd et l'extremite de lecture du tube sont herites par le processus de scan, pas l'extremite d'ecriture */
+    mergeEventFd = eventfd(0, 0);
+    if (mergeEventFd < 0 || pipe(scanProcessPipe) < 0 || fcntl(scanProcessPipe[1], F_SETFD, FD_CLOEXEC) < 0) {
+        ERROR(true, "[Receiver] Fail to create the channels of the scan process");
+        stopScanProcess();
+        destroySharedState();
+        return -1;
+    }
+
+    isScanning = true;
+    if (spawnScanProcess() < 0) {
+        isScanning = false;
+        stopScanProcess();
+        destroySharedState();
+        return -1;
+    }
+
+    if (pthread_create(&myThreadMerge, NULL, &runMerge, NULL) != 0) {
+        ERROR(true, "[Receiver] Fail to start the merge stage");
+        isScanning = false;
+        stopScanProcess();
+        destroySharedState();
+        return -1;
+    }
+    return 0;
+}
+
+static int8_t spawnScanProcess() {
+    char arguments[SCAN_PROCESS_NB_ARGUMENTS - 2][12];
+    char* argv[SCAN_PROCESS_NB_ARGUMENTS + 1] = {
+        "/proc/self/exe", RECEIVER_SCAN_PROCESS_ARGUMENT,
+        arguments[0], arguments[1], arguments[2], arguments[3], arguments[4], NULL
+    };
+    posix_spawnattr_t attributes;
+    sigset_t signals;
+    pid_t process;
+    int returnSpawn;
+
+    /* Un fork sans exec d'un processus a plusieurs threads n'herite que du thread appelant et des verrous tenus
+     * par les autres : le processus de scan execute a nouveau GEOLOGIE, qui ne reprend que les descripteurs
+     * de la memoire partagee, du tube et de l'eventfd */
+    formatDescriptor(arguments[0], sizeof(arguments[0]), sharedMemory);
+    formatDescriptor(arguments[1], sizeof(arguments[1]), scanProcessPipe[0]);
+    formatDescriptor(arguments[2], sizeof(arguments[2]), mergeEventFd);
+    formatDescriptor(arguments[3], sizeof(arguments[3]), nbAdapters);
+    formatDescriptor(arguments[4], sizeof(arguments[4]), scanProcessCpu);
+
+    sigemptyset(&signals);
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setsigmask(&attributes, &signals);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK);
+    returnSpawn = posix_spawn(&process, argv[0], NULL, &attributes, argv, environ);
+    posix_spawnattr_destroy(&attributes);
+    if (returnSpawn != 0) {
+        ERROR(true, "[Receiver] Fail to start the scan process");
+        scanProcess = -1;
+        return -1;
+    }
+
+    scanProcess = process;
+    LOG("[Receiver] The scan runs in the process %d%s", (int) scanProcess, "\n");
+    return 0;
+}
+
+static void formatDescriptor(char* buffer, size_t size, int value) {
+    snprintf(buffer, size, "%d", value);
+}
+
+static void runScanProcess() {
+    uint8_t nbOpenedAdapters = 0;
+    char stop;
+
+    /* Le CTRL+C est recu par tout le groupe : le processus de scan attend que Receiver l'arrete */
+    signal(SIGINT, SIG_IGN);
+
+    if (scanProcessCpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(scanProcessCpu, &cpus);
+        ERROR(sched_setaffinity(0, sizeof(cpus), &cpus) < 0, "[Receiver] Fail to pin the scan process");
+    }
+
+    for (uint8_t i = 0; i < nbAdapters; i++) {
+        if (openHciDevice(&shared->adapters[i]) < 0) {
+            LOG("[Receiver] The HCI device %d can not be scanned%s", shared->adapters[i].deviceId, "\n");
+        } else {
+            nbOpenedAdapters++;
+        }
+    }
+    if (nbOpenedAdapters == 0) {
+        LOG("[Receiver] No HCI device, no beacon will be scanned%s", "\n");
+        _exit(EXIT_FAILURE);
+    }
+
+    for (uint8_t i = 0; i < nbAdapters; i++) {
+        if (shared->adapters[i].socket >= 0) {
+            shared->adapters[i].isScanned = (pthread_create(&shared->adapters[i].thread, NULL, &runScan, &shared->adapters[i]) == 0);
+            ERROR(!shared->adapters[i].isScanned, "[Receiver] Fail to start the scan thread of an adapter");
+        }
+    }
+
+    /* La lecture ne se termine qu'a la fermeture de l'extremite d'ecriture, par l'arret ou la mort de Receiver */
+    while (read(scanProcessPipe[0], &stop, sizeof(stop)) < 0 && errno == EINTR) {
+    }
+
+    isScanning = false;
+    for (uint8_t i = 0; i < nbAdapters; i++) {
+        if (shared->adapters[i].isScanned) {
+            pthread_join(shared->adapters[i].thread, NULL);
+        }
+        closeHciDevice(&shared->adapters[i]);
+    }
+
+    /* Sans passer par exit : les traitements de fin de GEOLOGIE appartiennent au processus de Receiver */
+    _exit(EXIT_SUCCESS);
+}
+
+static void superviseScanProcess() {
+    int status;
+
+    if (scanProcess < 0 || waitpid(scanProcess, &status, WNOHANG) != scanProcess) {
+        return;
+    }
+
+    if (WIFSIGNALED(status)) {
+        LOG("[Receiver] The scan process was killed by the signal %d, it is restarted%s", WTERMSIG(status), "\n");
+        for (uint8_t i = 0; i < nbAdapters; i++) {
+            shared->adapters[i].socket = shared->adapters[i].isHciDevice ? -1 : givenHciSocket;
+            shared->adapters[i].isScanned = false;
+        }
+        spawnScanProcess();
+    } else {
+        LOG("[Receiver] The scan process stopped%s", "\n");
+        scanProcess = -1;
+    }
+}
+
+static void stopScanProcess() {
+    if (scanProcessPipe[1] >= 0) {
+        close(scanProcessPipe[1]);
+        scanProcessPipe[1] = -1;
+    }
+    if (scanProcess > 0) {
+        waitpid(scanProcess, NULL, 0);
+        scanProcess = -1;
+    }
+    if (scanProcessPipe[0] >= 0) {
+        close(scanProcessPipe[0]);
+        scanProcessPipe[0] = -1;
+    }
+}
+
+static int8_t openHciDevice(Adapter* adapter) {
+    int8_t returnError = 0;
+    struct hci_filter filter;
+    const int enable = 1;
+    int domain = AF_UNSPEC;
+    socklen_t domainSize = sizeof(domain);
+
+    if (adapter->isHciDevice) {
+        adapter->socket = hci_open_dev(adapter->deviceId < 0 ? hci_get_route(NULL) : adapter->deviceId);
+        if (adapter->socket < 0) {
+            ERROR(true, "[Receiver] Fail to open the HCI device");
+            return -1;
+        }
+    } else if (adapter->socket < 0) {
+        return -1;
+    }
+
+    /*
+     * Une socket HCI brute ne pose jamais SCM_TIMESTAMPNS : elle date ses evenements seulement apres HCI_TIME_STAMP.
+     * Sans date du noyau, un evenement est date a sa lecture par le thread de scan.
+     */
+    getsockopt(adapter->socket, SOL_SOCKET, SO_DOMAIN, &domain, &domainSize);
+    if (domain == AF_BLUETOOTH ? setsockopt(adapter->socket, SOL_HCI, HCI_TIME_STAMP, &enable, sizeof(enable)) < 0
+        : setsockopt(adapter->socket, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0) {
+        LOG("[Receiver] The kernel receive timestamps are unavailable, the events are dated when read%s", "\n");
+    }
+
+    if (!adapter->isHciDevice) {
+        return 0;       // Socket donnee par Receiver_setHciSocket, le scan n'est pas a configurer
+    }
+
+    /*
+     * Le noyau ne delivre plus que les evenements LE meta, le thread de scan n'est donc pas reveille par les autres.
+     * Le filtre ne porte que sur le code de l'evenement, les autres sous-evenements LE sont ecartes par ingestHciEvent.
+     * hci_send_req installe son propre filtre le temps d'une commande puis restaure celui-ci.
+     */
+    hci_filter_clear(&filter);
+    hci_filter_set_ptype(HCI_EVENT_PKT, &filter);
+    hci_filter_set_event(EVT_LE_META_EVENT, &filter);
+    returnError = setsockopt(adapter->socket, SOL_HCI, HCI_FILTER, &filter, sizeof(filter)) < 0 ? -1 : 0;
+    ERROR(returnError < 0, "[Receiver] Fail to set the HCI filter");
+
+    /* Un controleur n'accepte plus les commandes etendues apres une commande classique : le choix est fait une fois */
+    lockScanConfiguration();
+    adapter->isExtendedScan = shared->scanConfiguration.isExtended;
+    pthread_mutex_unlock(&shared->scanConfigurationMutex);
+
+    if (returnError >= 0) {
+        returnError = setScanParameters(adapter);
+    }
+
+    if (returnError >= 0) {
+        returnError = setScanEnable(adapter, 0x01);
+        ERROR(returnError < 0, "[Receiver] Fail to enable the scan");
+    }
+
+    if (returnError < 0) {
+        hci_close_dev(adapter->socket);
+        adapter->socket = -1;
+    }
+
+    return returnError;
+}
+
+static int8_t setScanParameters(Adapter* adapter) {
+    int8_t returnError;
+    uint8_t status;
+    struct hci_request rq;
+    le_set_scan_parameters_cp scanParameters;
+    ExtendedScanParameters extendedScanParameters;
+    memset(&scanParameters, 0, sizeof(scanParameters));
+    memset(&extendedScanParameters, 0, sizeof(extendedScanParameters));
+
+    lockScanConfiguration();
+    scanParameters.type = shared->scanConfiguration.isActive ? 0x01 : 0x00;
+    scanParameters.interval = htobs(shared->scanConfiguration.interval);
+    scanParameters.window = htobs(shared->scanConfiguration.window);
+    adapter->scanConfigurationVersion = shared->scanConfigurationVersion;
+    pthread_mutex_unlock(&shared->scanConfigurationMutex);
+
+    scanParameters.own_bdaddr_type = LE_PUBLIC_ADDRESS;
+    scanParameters.filter = 0x00;     // Toutes les annonces, sans liste blanche
+
+    if (adapter->isExtendedScan) {
+        extendedScanParameters.ownBdaddrType = scanParameters.own_bdaddr_type;
+        extendedScanParameters.filter = scanParameters.filter;
+        extendedScanParameters.phys = SCAN_PHY_LE_1M;
+        extendedScanParameters.type = scanParameters.type;
+        extendedScanParameters.interval = scanParameters.interval;
+        extendedScanParameters.window = scanParameters.window;
+        rq = ble_hci_request(OCF_LE_SET_EXTENDED_SCAN_PARAMETERS, sizeof(extendedScanParameters), &status, &extendedScanParameters);
+    } else {
+        rq = ble_hci_request(OCF_LE_SET_SCAN_PARAMETERS, LE_SET_SCAN_PARAMETERS_CP_SIZE, &status, &scanParameters);
+    }
+
+    returnError = hci_send_req(adapter->socket, &rq, HCI_REQUEST_TIMEOUT) < 0 ? -1 : 0;
+    ERROR(returnError < 0, "[Receiver] Fail to set the scan parameters");
+
+    return returnError;
+}
+
+static void applyScanConfiguration(Adapter* adapter) {
+    int8_t returnError = setScanEnable(adapter, 0x00);
+    ERROR(returnError < 0, "[Receiver] Fail to disable the scan");
+
+    /* Un echec laisse l'ancienne version : le changement sera retente au prochain reveil */
+    if (returnError >= 0 && setScanParameters(adapter) < 0) {
+        adapter->scanConfigurationVersion--;
+    }
+
+    returnError = setScanEnable(adapter, 0x01);
+    ERROR(returnError < 0, "[Receiver] Fail to enable the scan");
+}
+
+static void closeHciDevice(Adapter* adapter) {
+    if (adapter->isHciDevice && adapter->socket >= 0) {
+        ERROR(setScanEnable(adapter, 0x00) < 0, "[Receiver] Fail to disable the scan");
+        hci_close_dev(adapter->socket);
+        adapter->socket = -1;
+    }
+}
+
+static uint32_t drainHciEvents(Adapter* adapter) {
+    uint32_t nbEvents = 0;
+    uint8_t control[CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(sizeof(struct timeval))];
+
+    while (nbEvents < NB_MAX_HCI_EVENTS) {
+        struct iovec data = { .iov_base = adapter->hciEvents[nbEvents], .iov_len = HCI_MAX_EVENT_SIZE };
+        struct msghdr message = {
+            .msg_iov = &data,
+            .msg_iovlen = 1,
+            .msg_control = control,
+            .msg_controllen = sizeof(control)
+        };
+
+        ssize_t size = recvmsg(adapter->socket, &message, MSG_DONTWAIT);
+        if (size <= 0) {
+            break;      // Plus aucun evenement en attente (EAGAIN) ou socket fermee
+        }
+        adapter->hciEventsSize[nbEvents] = (uint16_t) size;
+        adapter->hciEventsTimestamp[nbEvents] = getKernelTimestamp(&message);
+        nbEvents++;
+    }
+
+    /*
+     * Le noyau date sur l'horloge temps reel : chaque date est ramenee sur l'horloge monotone par son anciennete
+     * a la fin de la lecture, ce qui la rend insensible a un saut de l'horloge temps reel entre deux lectures.
+     */
+    if (nbEvents > 0) {
+        uint64_t monotonicNow = getMonotonicTime();
+        uint64_t realNow = getRealTime();
+
+        for (uint32_t i = 0; i < nbEvents; i++) {
+            uint64_t kernelTimestamp = adapter->hciEventsTimestamp[i];
+
+            if (kernelTimestamp == 0 || kernelTimestamp > realNow || realNow - kernelTimestamp > monotonicNow) {
+                adapter->hciEventsTimestamp[i] = monotonicNow;      // Pas de date du noyau, ou une date incoherente
+            } else {
+                adapter->hciEventsTimestamp[i] = monotonicNow - (realNow - kernelTimestamp);
+            }
+        }
+    }
+
+    return nbEvents;
+}
+
+static uint64_t getKernelTimestamp(struct msghdr* message) {
+    uint64_t timestamp = 0;
+
+    for (struct cmsghdr* control = CMSG_FIRSTHDR(message); control != NULL; control = CMSG_NXTHDR(message, control)) {
+        if (control->cmsg_level == SOL_HCI && control->cmsg_type == HCI_CMSG_TSTAMP && control->cmsg_len >= CMSG_LEN(sizeof(struct timeval))) {
+            struct timeval date;
+            memcpy(&date, CMSG_DATA(control), sizeof(date));
+            timestamp = (uint64_t) date.tv_sec * 1000000000ULL + (uint64_t) date.tv_usec * 1000ULL;
+        } else if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS && control->cmsg_len >= CMSG_LEN(sizeof(struct timespec))) {
+            struct timespec date;
+            memcpy(&date, CMSG_DATA(control), sizeof(date));
+            timestamp = (uint64_t) date.tv_sec * 1000000000ULL + (uint64_t) date.tv_nsec;
+        }
+    }
+
+    return timestamp;
+}
+
+static uint8_t ingestHciEvent(Adapter* adapter, const uint8_t* event, uint16_t size, uint64_t timestamp) {
+    const uint8_t* end = event + size;
+    ReportRing* ring = &adapter->ring;
+    uint32_t head = ring->head;
+    uint8_t nbReports;
+
+    if (size < HCI_EVENT_HDR_SIZE + EVT_LE_META_EVENT_SIZE + 1) {
+        return 0;
+    }
+
+    const hci_event_hdr* header = (const hci_event_hdr*) event;
+    const evt_le_meta_event* meta = (const evt_le_meta_event*) (event + HCI_EVENT_HDR_SIZE);
+    if (header->evt != EVT_LE_META_EVENT
+        || (meta->subevent != EVT_LE_ADVERTISING_REPORT && meta->subevent != EVT_LE_EXTENDED_ADVERTISING_REPORT)) {
+        return 0;
+    }
+
+    /* Les rapports sont traduits en une fois, champ par champ, dans des tableaux sur la pile */
+    uint8_t names[TRANSLATOR_BEACON_NB_MAX_REPORTS][SIZE_BEACON_ID];
+    uint16_t uuids[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    int8_t rssis[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    int8_t txPowers[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    uint16_t sequences[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    Position positions[TRANSLATOR_BEACON_NB_MAX_REPORTS];
+    BeaconsSignalBatch batch = {
+        .name = names,
+        .uuid = uuids,
+        .rssi = rssis,
+        .txPower = txPowers,
+        .sequence = sequences,
+        .position = positions,
+        .capacity = TRANSLATOR_BEACON_NB_MAX_REPORTS
+    };
+
+    nbReports = TranslatorBeacon_translateReports(meta->data + 1, (uint16_t) (end - (meta->data + 1)), meta->data[0],
+                                                  meta->subevent == EVT_LE_EXTENDED_ADVERTISING_REPORT, &batch, NULL);
+    if (nbReports < meta->data[0]) {
+        TRACE("[Receiver] Truncated advertising report%s", "\n");
+    }
+
+    for (uint8_t i = 0; i < nbReports; i++) {
+        if (uuids[i] != BEACONS_UUID) {
+            continue;
+        }
+        if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) < REPORT_RING_SIZE) {
+            BeaconSignal* report = &ring->reports[head % REPORT_RING_SIZE];
+            memcpy(report->name, names[i], SIZE_BEACON_ID);
+            report->uuid[0] = (uint32_t) (uuids[i] & 0xFF);
+            report->uuid[1] = (uint32_t) (uuids[i] >> 8);
+            report->rssi = rssis[i];
+            report->txPower = txPowers[i];
+            report->sequence = sequences[i];
+            report->position = positions[i];
+            report->adapter = adapter->id;
+            report->timestamp = timestamp;
+            head++;
+        } else {
+            ring->nbDroppedReports++;
+        }
+    }
+
+    /* Les rapports de l'evenement sont rendus visibles a l'etage de fusion en une fois */
+    __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+
+    return nbReports;
+}
+
+static uint32_t mergeReports() {
+    uint32_t heads[RECEIVER_NB_MAX_ADAPTERS];
+    uint32_t tails[RECEIVER_NB_MAX_ADAPTERS];
+    uint32_t nbReports = 0;
+
+    for (uint8_t i = 0; i < nbAdapters; i++) {
+        heads[i] = __atomic_load_n(&shared->adapters[i].ring.head, __ATOMIC_ACQUIRE);
+        tails[i] = shared->adapters[i].ring.tail;
+    }
+
+    while (true) {
+        const BeaconSignal* oldest = NULL;
+        uint8_t oldestAdapter = 0;
+
+        for (uint8_t i = 0; i < nbAdapters; i++) {
+            if (tails[i] != heads[i]) {
+                const BeaconSignal* report = &shared->adapters[i].ring.reports[tails[i] % REPORT_RING_SIZE];
+                if (oldest == NULL || report->timestamp < oldest->timestamp) {
+                    oldest = report;
+                    oldestAdapter = i;
+                }
+            }
+        }
+        if (oldest == NULL) {
+            break;
+        }
+
+        updateBeaconsSignal(oldest);
+        tails[oldestAdapter]++;
+        nbReports++;
+    }
+
+    /* Les emplacements lus sont rendus aux adaptateurs */
+    for (uint8_t i = 0; i < nbAdapters; i++) {
+        __atomic_store_n(&shared->adapters[i].ring.tail, tails[i], __ATOMIC_RELEASE);
+    }
+    nbMergedReports += nbReports;
+
+    return nbReports;
+}
+
+static void updateBeaconsSignal(const BeaconSignal* beaconSignal) {
+    BeaconIndex index = BeaconRegistry_getIndex(beaconSignal->name);
+    if (index == BEACON_INDEX_NONE || index >= beaconsCapacity) {
+        return;
+    }
+
+    uint16_t slot = beaconsSignalSlot[index];
+    if (slot == SLOT_NONE) {
+        if (NbBeaconsSignal >= beaconsCapacity) {
+            TRACE("[Receiver] Too many beacons, %s is ignored%s", (char*) beaconSignal->name, "\n");
+            return;
+        }
+        slot = (uint16_t) NbBeaconsSignal++;
+        beaconsSignalSlot[index] = slot;
+        FilterBank_reset(&rssiFilters[slot]);
+        memset(&beaconsHealth[slot], 0, sizeof(BeaconHealth));
+        beaconsHealth[slot].firstSeen = beaconSignal->timestamp;
+    }
+
+    BeaconHealth* health = &beaconsHealth[slot];
+    float delta = beaconSignal->rssi - health->rssiMean;
+    health->nbAdvertisements++;
+    health->rssiMean += delta / health->nbAdvertisements;
+    health->rssiM2 += delta * (beaconSignal->rssi - health->rssiMean);
+
+    beaconsSignal[slot] = *beaconSignal;
+    beaconsSignal[slot].index = index;
+    beaconsSignal[slot].rssi = FilterBank_update(&rssiFilters[slot], beaconSignal->rssi);
+    beaconsSignal[slot].rssiVariance = FilterBank_getVariance(&rssiFilters[slot]);
+    isBeaconsSignalUpdated = true;
+
+    if (reportListener != NULL) {
+        BeaconSignal report = *beaconSignal;
+        report.index = index;
+        reportListener(&report, health->rssiM2 / health->nbAdvertisements);
+    }
+}
+
+static void evictStaleBeacons(uint64_t now) {
+    uint64_t timeout = (uint64_t) beaconTimeout * 1000000ULL;
+    uint16_t slot = 0;
+
+    if (beaconTimeout == 0) {
+        return;
+    }
+
+    while (slot < NbBeaconsSignal) {
+        if (now > beaconsSignal[slot].timestamp + timeout) {
+            removeBeaconsSignal(slot);      // La derniere balise prend sa place et est examinee a son tour
+        } else {
+            slot++;
+        }
+    }
+}
+
+static void removeBeaconsSignal(uint16_t slot) {
+    BeaconIndex index = beaconsSignal[slot].index;
+    uint16_t last = (uint16_t) (NbBeaconsSignal - 1);
+
+    TRACE("[Receiver] The beacon %s is no longer heard%s", (char*) beaconsSignal[slot].name, "\n");
+    if (nbDropouts[index] < UINT16_MAX) {
+        nbDropouts[index]++;
+    }
+    beaconsSignalSlot[index] = SLOT_NONE;
+
+    if (slot != last) {
+        beaconsSignal[slot] = beaconsSignal[last];
+        rssiFilters[slot] = rssiFilters[last];
+        beaconsHealth[slot] = beaconsHealth[last];
+        beaconsSignalSlot[beaconsSignal[slot].index] = slot;
+    }
+    NbBeaconsSignal--;
+    isBeaconsSignalUpdated = true;
+}
+
+static uint64_t getMonotonicTime() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+static uint64_t getRealTime() {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+static int8_t allocateBeaconsSignal(uint16_t capacity) {
+    freeBeaconsSignal();
+
+    beaconsSignal = calloc(capacity, sizeof(BeaconSignal));
+    beaconsSignalSlot = malloc(capacity * sizeof(uint16_t));
+    rssiFilters = calloc(capacity, sizeof(RssiFilter));
+    beaconsHealth = calloc(capacity, sizeof(BeaconHealth));
+    nbDropouts = calloc(capacity, sizeof(uint16_t));
+    for (uint8_t i = 0; i < 2; i++) {
+        snapshots[i].beaconsSignal = calloc(capacity, sizeof(BeaconSignal));
+        snapshots[i].beaconsStatistics = calloc(capacity, sizeof(BeaconStatistics));
+    }
+
+    if (beaconsSignal == NULL || beaconsSignalSlot == NULL || rssiFilters == NULL || beaconsHealth == NULL || nbDropouts == NULL
+        || snapshots[0].beaconsSignal == NULL || snapshots[1].beaconsSignal == NULL
+        || snapshots[0].beaconsStatistics == NULL || snapshots[1].beaconsStatistics == NULL) {
+        ERROR(true, "[Receiver] Fail to allocate the beacons tables");
+        freeBeaconsSignal();
+        return -1;
+    }
+
+    beaconsCapacity = capacity;
+    memset(beaconsSignalSlot, 0xFF, capacity * sizeof(uint16_t));
+    NbBeaconsSignal = 0;
+    isBeaconsSignalUpdated = false;
+    snapshots[0].sequence = snapshots[1].sequence = 0;
+    snapshots[0].nbBeaconsSignal = snapshots[1].nbBeaconsSignal = 0;
+    lastSnapshot = 0;
+    return 0;
+}
+
+static void freeBeaconsSignal() {
+    free(beaconsSignal);
+    free(beaconsSignalSlot);
+    free(rssiFilters);
+    free(beaconsHealth);
+    free(nbDropouts);
+    beaconsSignal = NULL;
+    beaconsSignalSlot = NULL;
+    rssiFilters = NULL;
+    beaconsHealth = NULL;
+    nbDropouts = NULL;
+    for (uint8_t i = 0; i < 2; i++) {
+        free(snapshots[i].beaconsSignal);
+        free(snapshots[i].beaconsStatistics);
+        snapshots[i].beaconsSignal = NULL;
+        snapshots[i].beaconsStatistics = NULL;
+    }
+    beaconsCapacity = 0;
+    NbBeaconsSignal = 0;
+}
+
+static void publishBeaconsSignal() {
+    if (!isBeaconsSignalUpdated) {
+        return;
+    }
+
+    uint32_t next = 1 - __atomic_load_n(&lastSnapshot, __ATOMIC_RELAXED);
+    BeaconsSignalSnapshot* snapshot = &snapshots[next];
+
+    /* Sequence impaire : la copie est en cours d'ecriture */
+    __atomic_store_n(&snapshot->sequence, snapshot->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    snapshot->nbBeaconsSignal = NbBeaconsSignal;
+    memcpy(snapshot->beaconsSignal, beaconsSignal, NbBeaconsSignal * sizeof(BeaconSignal));
+    for (uint32_t i = 0; i < NbBeaconsSignal; i++) {
+        const BeaconHealth* health = &beaconsHealth[i];
+        BeaconStatistics* statistics = &snapshot->beaconsStatistics[i];
+        uint64_t duration = beaconsSignal[i].timestamp - health->firstSeen;
+
+        statistics->index = beaconsSignal[i].index;
+        statistics->advertisingRate = duration > 0 ? (health->nbAdvertisements - 1) * 1e9f / duration : 0;
+        statistics->rssiMean = health->rssiMean;
+        statistics->rssiVariance = health->nbAdvertisements > 0 ? health->rssiM2 / health->nbAdvertisements : 0;
+        statistics->nbDropouts = nbDropouts[beaconsSignal[i].index];
+    }
+
+    __atomic_store_n(&snapshot->sequence, snapshot->sequence + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&lastSnapshot, next, __ATOMIC_RELEASE);
+
+    isBeaconsSignalUpdated = false;
+}
+
+static void performAction(Action_RECEIVER action, MqMsgReceiver* msg) {
+    switch (action) {
+
+        case A_STOP:
+            if (isScanning) {
+                isScanning = false;
+                if (capturePath != NULL) {
+                    Replayer_stop();
+                } else if (shared == &localShared) {
+                    for (uint8_t i = 0; i < nbAdapters; i++) {
+                        if (shared->adapters[i].isScanned) {
+                            pthread_join(shared->adapters[i].thread, NULL);
+                        }
+                    }
+                }
+                pthread_join(myThreadMerge, NULL);
+            }
+            if (capturePath != NULL) {
+                Replayer_close();
+            } else {
+                /* Le processus de scan ferme lui-meme ses peripheriques */
+                stopScanProcess();
+                for (uint8_t i = 0; i < nbAdapters; i++) {
+                    if (shared->adapters[i].ring.nbDroppedReports > 0) {
+                        LOG("[Receiver] %u advertising reports of the adapter %u were lost%s", shared->adapters[i].ring.nbDroppedReports, i, "\n");
+                    }
+                    if (shared == &localShared) {
+                        closeHciDevice(&shared->adapters[i]);
+                    }
+                }
+                destroySharedState();
+            }
+            if (mergeEventFd >= 0) {
+                close(mergeEventFd);
+                mergeEventFd = -1;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+}
+
+static void* run(void* _) {
+    while (myState != S_DEATH) {
+        MqMsgReceiver msg;
+        Action_RECEIVER action;
+
+        mqReceive(&msg);
 
         action = stateMachine[myState][msg.event].action;
         if (stateMachine[myState][msg.event].destinationState != S_FORGET) {
@@ -290,10 +1499,99 @@ static void* run(void* _) {
     return NULL;
 }
 
-static void time_out() {
-    TRACE("[Receiver] Time out%s", "\n");
-    MqMsgReceiver msg = { .event = E_TIME_OUT };
-    sendMsg(&msg);
+static void* runScan(void* adapter) {
+    Adapter* this = (Adapter*) adapter;
+    struct pollfd pollFd = { .fd = this->socket, .events = POLLIN };
+    const uint64_t wakeUp = 1;
+
+    while (isScanning) {
+        if (this->isHciDevice && this->scanConfigurationVersion != __atomic_load_n(&shared->scanConfigurationVersion, __ATOMIC_RELAXED)) {
+            applyScanConfiguration(this);
+        }
+
+        int returnPoll = poll(&pollFd, 1, HCI_POLL_TIMEOUT);
+
+        if (returnPoll > 0) {
+            uint32_t nbEvents = drainHciEvents(this);
+
+            for (uint32_t i = 0; i < nbEvents; i++) {
+                if (this->hciEventsSize[i] > HCI_TYPE_LEN && this->hciEvents[i][0] == HCI_EVENT_PKT) {
+                    ingestHciEvent(this, this->hciEvents[i] + HCI_TYPE_LEN, this->hciEventsSize[i] - HCI_TYPE_LEN, this->hciEventsTimestamp[i]);
+                }
+            }
+            if (nbEvents > 0) {
+                ERROR(write(mergeEventFd, &wakeUp, sizeof(wakeUp)) < 0, "[Receiver] Fail to wake up the merge stage");
+            }
+
+            if (nbEvents == 0 && (pollFd.revents & (POLLHUP | POLLERR))) {
+                ERROR(true, "[Receiver] The HCI socket is closed");
+                break;
+            }
+        } else if (returnPoll < 0 && errno != EINTR) {
+            ERROR(true, "[Receiver] Error when waiting the HCI events");
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void* runMerge(void* _) {
+    struct pollfd pollFd = { .fd = mergeEventFd, .events = POLLIN };
+    uint64_t nbWakeUps;
+
+    while (isScanning) {
+        int returnPoll = poll(&pollFd, 1, HCI_POLL_TIMEOUT);
+
+        if (returnPoll > 0) {
+            ERROR(read(mergeEventFd, &nbWakeUps, sizeof(nbWakeUps)) < 0, "[Receiver] Fail to read the merge event");
+            mergeReports();
+        } else if (returnPoll < 0 && errno != EINTR) {
+            ERROR(true, "[Receiver] Error when waiting the adapters");
+            break;
+        }
+
+        /* Sans evenement, les balises qui se taisent sont tout de meme retirees */
+        evictStaleBeacons(getMonotonicTime());
+        publishBeaconsSignal();
+
+        if (scanProcess > 0) {
+            superviseScanProcess();
+        }
+    }
+    return NULL;
+}
+
+static void* runReplay(void* _) {
+    const uint8_t* event;
+    uint16_t size;
+    uint64_t nbEvents = 0;
+    uint64_t nbReports = 0;
+    struct timespec startTime;
+    struct timespec endTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+    while (isScanning && Replayer_nextHciEvent(&event, &size)) {
+        /* Le thread de rejeu est a la fois l'unique adaptateur et l'etage de fusion */
+        nbReports += ingestHciEvent(&shared->adapters[0], event, size, getMonotonicTime());
+        mergeReports();
+        nbEvents++;
+
+        /* Sans attente entre les evenements, la publication se fait par lot comme pour le scan */
+        if (captureSpeed > REPLAYER_SPEED_MAX || nbEvents % NB_MAX_HCI_EVENTS == 0) {
+            evictStaleBeacons(getMonotonicTime());
+            publishBeaconsSignal();
+        }
+    }
+    publishBeaconsSignal();
+
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    double duration = (endTime.tv_sec - startTime.tv_sec) + (endTime.tv_nsec - startTime.tv_nsec) / 1e9;
+    LOG("[Receiver] Replay done: %llu events, %llu advertising reports in %.3f s (%.0f reports/s)%s",
+        (unsigned long long) nbEvents, (unsigned long long) nbReports, duration, duration > 0 ? nbReports / duration : 0.0, "\n");
+
+    return NULL;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -305,16 +1603,165 @@ static void time_out() {
 
 extern void Receiver_new() {
     mqInit();
-    pthread_mutex_init(&myMutex, NULL);
+    allocateBeaconsSignal(BeaconRegistry_getCapacity());
+}
+
+extern void Receiver_setHciSocket(int socket) {
+    givenHciSocket = socket;
+}
+
+extern int8_t Receiver_setHciDevices(const int* deviceIds, uint8_t nbDevices) {
+    if (nbDevices == 0 || nbDevices > RECEIVER_NB_MAX_ADAPTERS) {
+        LOG("[Receiver] Between 1 and %d HCI devices can be scanned%s", RECEIVER_NB_MAX_ADAPTERS, "\n");
+        return -1;
+    }
+    for (uint8_t i = 0; i < nbDevices; i++) {
+        if (deviceIds[i] < -1) {
+            LOG("[Receiver] Invalid HCI device %d%s", deviceIds[i], "\n");
+            return -1;
+        }
+    }
+
+    memcpy(hciDevices, deviceIds, nbDevices * sizeof(int));
+    nbHciDevices = nbDevices;
+    return 0;
+}
+
+extern int8_t Receiver_setScanConfiguration(const ReceiverScanConfiguration* configuration) {
+    if (configuration->interval < RECEIVER_SCAN_TIME_MIN || configuration->interval > RECEIVER_SCAN_TIME_MAX
+        || configuration->window < RECEIVER_SCAN_TIME_MIN || configuration->window > configuration->interval) {
+        LOG("[Receiver] Invalid scan configuration%s", "\n");
+        return -1;
+    }
+
+    lockScanConfiguration();
+    shared->scanConfiguration = *configuration;
+    __atomic_store_n(&shared->scanConfigurationVersion, shared->scanConfigurationVersion + 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&shared->scanConfigurationMutex);
+    return 0;
+}
+
+extern void Receiver_getScanConfiguration(ReceiverScanConfiguration* configuration) {
+    lockScanConfiguration();
+    *configuration = shared->scanConfiguration;
+    pthread_mutex_unlock(&shared->scanConfigurationMutex);
+}
+
+extern void Receiver_setBeaconTimeout(uint32_t timeout) {
+    beaconTimeout = timeout;
+}
+
+extern void Receiver_setCaptureFile(const char* path, float speed) {
+    capturePath = path;
+    captureSpeed = speed;
+}
+
+extern void Receiver_setReportListener(ReceiverReportListener listener) {
+    reportListener = listener;
+}
+
+extern void Receiver_setScanProcess(bool isIsolated, int cpu) {
+    isScanProcess = isIsolated;
+    scanProcessCpu = cpu;
+}
 
-    wtd_TScan = Watchdog_construct(1000000, (WatchdogCallback) time_out);
+extern int Receiver_runScanProcess(int argc, char* argv[]) {
+    int memory;
+
+    if (argc != SCAN_PROCESS_NB_ARGUMENTS || strcmp(argv[1], RECEIVER_SCAN_PROCESS_ARGUMENT) != 0) {
+        ERROR(true, "[Receiver] Bad arguments of the scan process");
+        return EXIT_FAILURE;
+    }
+
+    memory = atoi(argv[2]);
+    scanProcessPipe[0] = atoi(argv[3]);
+    mergeEventFd = atoi(argv[4]);
+    nbAdapters = (uint8_t) atoi(argv[5]);
+    scanProcessCpu = atoi(argv[6]);
+
+    shared = mmap(NULL, sizeof(ReceiverShared), PROT_READ | PROT_WRITE, MAP_SHARED, memory, 0);
+    close(memory);
+    if (shared == MAP_FAILED || nbAdapters > RECEIVER_NB_MAX_ADAPTERS) {
+        ERROR(true, "[Receiver] Fail to map the memory shared with Receiver");
+        return EXIT_FAILURE;
+    }
+
+    /* Le processus de scan execute a nouveau GEOLOGIE : son registre des balises du commerce est vide */
+    for (uint8_t i = 0; i < shared->nbThirdPartyBeacons; i++) {
+        TranslatorBeacon_addThirdPartyBeacon(&shared->thirdPartyBeacons[i]);
+    }
+
+    isScanning = true;
+    runScanProcess();       // Ne revient jamais
+    return EXIT_SUCCESS;
 }
 
 extern int8_t Receiver_ask4StartReceiver() {
     int8_t returnError = EXIT_FAILURE;
+    uint8_t nbOpenedAdapters = 0;
     myState = S_SCANNING;
     returnError = pthread_create(&myThreadMq, NULL, &run, NULL);
-    Watchdog_start(wtd_TScan);
+
+    /* Le rejeu n'accede a aucun peripherique, il reste dans le processus de Receiver */
+    if (isScanProcess && capturePath == NULL && createSharedState() < 0) {
+        LOG("[Receiver] The scan runs in the process of Receiver%s", "\n");
+    }
+
+    initAdapters();
+
+    if (capturePath != NULL) {
+        if (Replayer_open(capturePath, captureSpeed) < 0) {
+            LOG("[Receiver] Fail to open the capture %s, no beacon will be replayed%s", capturePath, "\n");
+        } else {
+            isScanning = true;
+            returnError = pthread_create(&myThreadMerge, NULL, &runReplay, NULL);
+            if (returnError != 0) {
+                isScanning = false;
+            }
+        }
+        return returnError;
+    }
+
+    if (shared != &localShared) {
+        return startScanProcess();
+    }
+
+    for (uint8_t i = 0; i < nbAdapters; i++) {
+        if (openHciDevice(&shared->adapters[i]) < 0) {
+            LOG("[Receiver] The HCI device %d can not be scanned%s", shared->adapters[i].deviceId, "\n");
+        } else {
+            nbOpenedAdapters++;
+        }
+    }
+
+    if (nbOpenedAdapters == 0) {
+        LOG("[Receiver] No HCI device, no beacon will be scanned%s", "\n");
+        return returnError;
+    }
+
+    mergeEventFd = eventfd(0, EFD_CLOEXEC);
+    if (mergeEventFd < 0) {
+        ERROR(true, "[Receiver] Fail to create the merge event");
+        for (uint8_t i = 0; i < nbAdapters; i++) {
+            closeHciDevice(&shared->adapters[i]);
+        }
+        return -1;
+    }
+
+    isScanning = true;
+    returnError = pthread_create(&myThreadMerge, NULL, &runMerge, NULL);
+    if (returnError != 0) {
+        ERROR(true, "[Receiver] Fail to start the merge stage");
+        isScanning = false;
+        return returnError;
+    }
+
+    for (uint8_t i = 0; i < nbAdapters; i++) {
+        if (shared->adapters[i].socket >= 0) {
+            shared->adapters[i].isScanned = (pthread_create(&shared->adapters[i].thread, NULL, &runScan, &shared->adapters[i]) == 0);
+            ERROR(!shared->adapters[i].isScanned, "[Receiver] Fail to start the scan thread of an adapter");
+        }
+    }
 
     return returnError;
 }
@@ -329,16 +1776,56 @@ extern int8_t Receiver_ask4StopReceiver() {
 
 extern void Receiver_free() {
     myState = S_DEATH;
-    pthread_mutex_destroy(&myMutex);
+    freeBeaconsSignal();
+}
+
+extern uint32_t Receiver_getBeaconsSignal(BeaconSignal* beaconsSignalRead, uint32_t nbMaxBeaconsSignal) {
+    const BeaconsSignalSnapshot* snapshot;
+    uint32_t sequenceBegin;
+    uint32_t sequenceEnd;
+    uint32_t nbBeaconsSignalRead;
+
+    do {
+        snapshot = &snapshots[__atomic_load_n(&lastSnapshot, __ATOMIC_ACQUIRE)];
+        sequenceBegin = __atomic_load_n(&snapshot->sequence, __ATOMIC_ACQUIRE);
+        if (sequenceBegin & 1) {
+            continue;   // Le thread de scan ecrit deja dans cette copie, une plus recente est publiee
+        }
+
+        nbBeaconsSignalRead = snapshot->nbBeaconsSignal < nbMaxBeaconsSignal ? snapshot->nbBeaconsSignal : nbMaxBeaconsSignal;
+        memcpy(beaconsSignalRead, snapshot->beaconsSignal, nbBeaconsSignalRead * sizeof(BeaconSignal));
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        sequenceEnd = __atomic_load_n(&snapshot->sequence, __ATOMIC_RELAXED);
+    } while ((sequenceBegin & 1) || sequenceBegin != sequenceEnd);
 
-    Watchdog_destroy(wtd_TScan);
+    return nbBeaconsSignalRead;
 }
 
-extern int8_t Receiver_ask4BeaconsSignal() {
-    int8_t returnError = EXIT_FAILURE;
-    MqMsgReceiver msg = {
-                .event = E_ASK_BEACONS_SIGNAL
-    };
-    returnError = sendMsg(&msg);
-    return returnError;
+extern uint32_t Receiver_getBeaconsStatistics(BeaconStatistics* beaconsStatisticsRead, uint32_t nbMaxBeaconsStatistics) {
+    const BeaconsSignalSnapshot* snapshot;
+    uint32_t sequenceBegin;
+    uint32_t sequenceEnd;
+    uint32_t nbBeaconsStatisticsRead;
+    uint64_t now = getMonotonicTime();
+
+    do {
+        snapshot = &snapshots[__atomic_load_n(&lastSnapshot, __ATOMIC_ACQUIRE)];
+        sequenceBegin = __atomic_load_n(&snapshot->sequence, __ATOMIC_ACQUIRE);
+        if (sequenceBegin & 1) {
+            continue;
+        }
+
+        nbBeaconsStatisticsRead = snapshot->nbBeaconsSignal < nbMaxBeaconsStatistics ? snapshot->nbBeaconsSignal : nbMaxBeaconsStatistics;
+        memcpy(beaconsStatisticsRead, snapshot->beaconsStatistics, nbBeaconsStatisticsRead * sizeof(BeaconStatistics));
+        for (uint32_t i = 0; i < nbBeaconsStatisticsRead; i++) {
+            uint64_t lastSeen = snapshot->beaconsSignal[i].timestamp;
+            beaconsStatisticsRead[i].lastSeenAge = now > lastSeen ? (uint32_t) ((now - lastSeen) / 1000000ULL) : 0;
+        }
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        sequenceEnd = __atomic_load_n(&snapshot->sequence, __ATOMIC_RELAXED);
+    } while ((sequenceBegin & 1) || sequenceBegin != sequenceEnd);
+
+    return nbBeaconsStatisticsRead;
 }
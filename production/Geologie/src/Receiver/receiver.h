@@ -10,6 +10,7 @@
  * @license BSD 2-clauses
  */
 
+#include <stdbool.h>
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/hci.h>
 #include "../common.h"
@@ -19,6 +20,97 @@
 
 typedef le_advertising_info BeaconsChannel;
 
+/**
+ * @brief L'UUID de service annonce par les balises (org.bluetooth.service.environmental_sensing), seules retenues.
+ */
+#define BEACONS_UUID (0x181A)
+
+/**
+ * @brief Le sous-evenement LE Extended Advertising Report de Bluetooth 5, absent des en-tetes de BlueZ.
+ */
+#ifndef EVT_LE_EXTENDED_ADVERTISING_REPORT
+#define EVT_LE_EXTENDED_ADVERTISING_REPORT (0x0D)
+#endif
+
+/**
+ * @brief Un rapport d'un LE Extended Advertising Report, suivi de ses donnees.
+ *
+ * Contrairement a #BeaconsChannel, le RSSI et la puissance d'emission precedent les donnees, qui peuvent etre
+ * recues sur le PHY 2M et depasser les 31 octets d'une annonce classique.
+ */
+typedef struct {
+    uint16_t evtType;           /**< Le type de l'annonce, dont l'etat des donnees dans les bits 5 et 6. */
+    uint8_t bdaddrType;
+    bdaddr_t bdaddr;
+    uint8_t primaryPhy;
+    uint8_t secondaryPhy;
+    uint8_t sid;
+    int8_t txPower;             /**< La puissance d'emission en dBm, 127 si elle n'est pas annoncee. */
+    int8_t rssi;                /**< Le RSSI en dBm, 127 s'il n'est pas disponible. */
+    uint16_t periodicInterval;
+    uint8_t directBdaddrType;
+    bdaddr_t directBdaddr;
+    uint8_t length;             /**< La taille des donnees qui suivent. */
+    uint8_t data[];
+} __attribute__((packed)) BeaconsExtendedChannel;
+
+/**
+ * @brief La taille d'un #BeaconsExtendedChannel sans ses donnees.
+ */
+#define BEACONS_EXTENDED_CHANNEL_SIZE (24)
+
+/**
+ * @brief La duree d'une unite de temps du scan, en microseconde.
+ */
+#define RECEIVER_SCAN_TIME_UNIT (625)
+
+/**
+ * @brief Les bornes de l'intervalle et de la fenetre de scan, en unite de #RECEIVER_SCAN_TIME_UNIT.
+ */
+#define RECEIVER_SCAN_TIME_MIN (0x0004)
+#define RECEIVER_SCAN_TIME_MAX (0x4000)
+
+/**
+ * @brief Le nombre maximal d'adaptateurs Bluetooth scannes en parallele.
+ */
+#define RECEIVER_NB_MAX_ADAPTERS (4)
+
+/**
+ * @brief Le delai par defaut sans annonce apres lequel une balise est retiree de l'ensemble actif, en milliseconde.
+ */
+#define RECEIVER_BEACON_TIMEOUT_DEFAULT (5000)
+
+/**
+ * @brief Le coeur du processus de scan quand il n'est epingle a aucun.
+ */
+#define RECEIVER_CPU_ANY (-1)
+
+/**
+ * @brief Le premier argument de GEOLOGIE quand il est execute comme processus de scan, voir #Receiver_runScanProcess.
+ */
+#define RECEIVER_SCAN_PROCESS_ARGUMENT "--scan-process"
+
+/**
+ * @brief Les parametres du scan du peripherique HCI.
+ *
+ * Le controleur ecoute pendant window toutes les interval : une fenetre egale a l'intervalle donne un scan continu,
+ * une fenetre plus courte reduit le nombre de trames recues et donc la charge processeur.
+ */
+typedef struct {
+    uint16_t interval;  /**< L'intervalle de scan, en unite de #RECEIVER_SCAN_TIME_UNIT. */
+    uint16_t window;    /**< La fenetre de scan, au plus l'intervalle, en unite de #RECEIVER_SCAN_TIME_UNIT. */
+    bool isActive;      /**< Vrai pour un scan actif, qui demande en plus les reponses de scan des balises. */
+    bool isExtended;    /**< Vrai pour scanner avec les commandes etendues de Bluetooth 5, qui remontent aussi les annonces etendues, pris en compte a l'ouverture des peripheriques. */
+} ReceiverScanConfiguration;
+
+/**
+ * @brief La fonction appelee par l'etage de fusion pour chaque annonce d'une balise enregistree, dans l'ordre de reception.
+ *
+ * @param report l'annonce, avec l'indice de la balise et son RSSI brut
+ * @param rssiVariance la variance du RSSI brut de la balise depuis son entree dans l'ensemble actif, annonce comprise
+ */
+typedef void (*ReceiverReportListener)(const BeaconSignal* report, float rssiVariance);
+
 
 /**
  * @fn extern void Receiver_new()
@@ -34,6 +126,123 @@ extern void Receiver_new();
 
 extern void Receiver_free();
 
+/**
+ * @fn extern void Receiver_setHciSocket(int socket)
+ * @brief Remplace le peripherique HCI par une socket deja ouverte
+ *
+ * La socket doit conserver les limites des paquets (par exemple une socketpair SOCK_SEQPACKET) et recevoir
+ * les evenements HCI tels que lus sur une socket HCI brute. Receiver ne configure pas le scan et ne ferme pas
+ * cette socket, il y active seulement les dates de reception du noyau (HCI_TIME_STAMP sur une socket HCI, SO_TIMESTAMPNS sinon). Sert notamment aux tests, a appeler avant #Receiver_ask4StartReceiver.
+ *
+ * @param socket la socket a lire, -1 pour revenir au peripherique HCI par defaut
+*/
+
+extern void Receiver_setHciSocket(int socket);
+
+/**
+ * @fn extern int8_t Receiver_setHciDevices(const int* deviceIds, uint8_t nbDevices)
+ * @brief Choisit les peripheriques hciN scannes, chacun par son propre thread
+ *
+ * Les rapports de tous les peripheriques sont fusionnes par date de reception en un seul flux par balise. Un
+ * peripherique qui ne peut pas etre ouvert est ignore. Par defaut, seul le peripherique HCI par defaut est scanne.
+ * A appeler avant #Receiver_ask4StartReceiver.
+ *
+ * @param deviceIds les numeros N des peripheriques hciN, -1 pour le peripherique par defaut
+ * @param nbDevices le nombre de peripheriques, au plus #RECEIVER_NB_MAX_ADAPTERS
+ * @return retourne -1 si les peripheriques sont invalides, 0 sinon
+*/
+
+extern int8_t Receiver_setHciDevices(const int* deviceIds, uint8_t nbDevices);
+
+/**
+ * @fn extern int8_t Receiver_setScanConfiguration(const ReceiverScanConfiguration* configuration)
+ * @brief Change les parametres du scan du peripherique HCI
+ *
+ * Sans effet sur une socket donnee par #Receiver_setHciSocket ou sur le rejeu d'une capture. Appele pendant le
+ * scan, chaque thread de scan applique les nouveaux parametres a son peripherique a son prochain reveil, en
+ * interrompant brievement le scan.
+ *
+ * @param configuration les nouveaux parametres
+ * @return retourne -1 si les parametres sont invalides, 0 sinon
+*/
+
+extern int8_t Receiver_setScanConfiguration(const ReceiverScanConfiguration* configuration);
+
+/**
+ * @fn extern void Receiver_getScanConfiguration(ReceiverScanConfiguration* configuration)
+ * @brief Donne les parametres courants du scan du peripherique HCI
+ *
+ * @param configuration les parametres a remplir
+*/
+
+extern void Receiver_getScanConfiguration(ReceiverScanConfiguration* configuration);
+
+/**
+ * @fn extern void Receiver_setBeaconTimeout(uint32_t timeout)
+ * @brief Change le delai sans annonce apres lequel une balise est retiree de l'ensemble actif
+ *
+ * Une balise retiree n'est plus donnee par #Receiver_getBeaconsSignal tant qu'elle n'emet pas de nouveau, ses
+ * statistiques repartent alors de zero, hormis son nombre de retraits.
+ *
+ * @param timeout le delai en milliseconde, 0 pour ne jamais retirer de balise
+*/
+
+extern void Receiver_setBeaconTimeout(uint32_t timeout);
+
+/**
+ * @fn extern void Receiver_setCaptureFile(const char* path, float speed)
+ * @brief Remplace le peripherique HCI par le rejeu d'une capture btsnoop ou pcap
+ *
+ * Les evenements de la capture sont lus en place dans sa projection memoire et suivent le meme traitement que
+ * ceux du peripherique. A appeler avant #Receiver_ask4StartReceiver.
+ *
+ * @param path le chemin de la capture, NULL pour revenir au peripherique HCI
+ * @param speed le facteur de vitesse du rejeu, 1 pour le rythme de l'enregistrement, 0 pour rejouer sans attendre
+*/
+
+extern void Receiver_setCaptureFile(const char* path, float speed);
+
+/**
+ * @fn extern void Receiver_setScanProcess(bool isIsolated, int cpu)
+ * @brief Fait tourner les threads de scan dans un processus isole, a appeler avant le demarrage
+ *
+ * Un appel HCI qui bloque ou qui plante n'atteint alors plus le processus de GEOLOGIE : les rapports passent par
+ * les files des adaptateurs placees en memoire partagee, et l'etage de fusion est reveille par un eventfd. Le
+ * processus de scan est relance s'il est tue par un signal. Le rejeu d'une capture reste dans le processus de
+ * Receiver.
+ *
+ * @param isIsolated vrai pour scanner dans un processus isole, faux pour scanner dans le processus de Receiver
+ * @param cpu le coeur auquel epingler le processus de scan, #RECEIVER_CPU_ANY pour aucun
+ */
+extern void Receiver_setScanProcess(bool isIsolated, int cpu);
+
+/**
+ * @fn extern int Receiver_runScanProcess(int argc, char* argv[])
+ * @brief Corps du processus de scan, a appeler par main avant toute initialisation quand le premier argument est
+ * #RECEIVER_SCAN_PROCESS_ARGUMENT
+ *
+ * Le processus de scan est lance par posix_spawn sur l'executable courant plutot que par un fork seul, qui ne
+ * copierait que le thread appelant avec les verrous tenus par les autres. Il retrouve l'etat partage par le
+ * descripteur du memfd passe en argument, scanne les adaptateurs jusqu'a l'arret de Receiver et se termine sans
+ * revenir.
+ *
+ * @param argc le nombre d'arguments de main
+ * @param argv les arguments de main
+ * @return int EXIT_FAILURE si les arguments ne sont pas ceux donnes par Receiver
+ */
+extern int Receiver_runScanProcess(int argc, char* argv[]);
+
+/**
+ * @fn extern void Receiver_setReportListener(ReceiverReportListener listener)
+ * @brief Donne la fonction appelee pour chaque annonce, a appeler avant le demarrage
+ *
+ * La fonction est appelee par le thread de l'etage de fusion, ou de rejeu, sans attendre la publication : elle doit
+ * etre breve.
+ *
+ * @param listener la fonction a appeler, NULL pour aucune
+ */
+extern void Receiver_setReportListener(ReceiverReportListener listener);
+
 /**
  * @fn extern int8_t Receiver_ask4StartScanner()
  * @brief Demande le démarrage de Receiver
@@ -51,12 +260,32 @@ extern int8_t Receiver_ask4StartReceiver();
 extern int8_t Receiver_ask4StopReceiver();
 
 /**
- * @fn extern int8_t Receiver_ask4BeaconsSignal()
- * @brief Demande le démarrage du scan
- * @return retourne 1 s'il y a une erreur dans l'execution de la méthode
+ * @fn extern uint32_t Receiver_getBeaconsSignal(BeaconSignal* beaconsSignal, uint32_t nbMaxBeaconsSignal)
+ * @brief Copie les dernieres donnees publiees pour chaque balise
+ *
+ * La copie est toujours complete et coherente. Elle ne bloque jamais le thread de scan : si celui-ci publie
+ * pendant la lecture, la lecture est recommencee sur la copie la plus recente. Le RSSI de chaque balise est celui
+ * estime par son filtre, sa variance celle des estimations sur la fenetre du filtre.
+ *
+ * @param beaconsSignal le tableau a remplir
+ * @param nbMaxBeaconsSignal la taille du tableau
+ * @return le nombre de balises copiees
+*/
+
+extern uint32_t Receiver_getBeaconsSignal(BeaconSignal* beaconsSignal, uint32_t nbMaxBeaconsSignal);
+
+/**
+ * @fn extern uint32_t Receiver_getBeaconsStatistics(BeaconStatistics* beaconsStatistics, uint32_t nbMaxBeaconsStatistics)
+ * @brief Copie les dernieres statistiques publiees pour chaque balise de l'ensemble actif
+ *
+ * La copie suit les memes regles que #Receiver_getBeaconsSignal, les balises sont dans le meme ordre.
+ *
+ * @param beaconsStatistics le tableau a remplir
+ * @param nbMaxBeaconsStatistics la taille du tableau
+ * @return le nombre de balises copiees
 */
 
-extern int8_t Receiver_ask4BeaconsSignal();
+extern uint32_t Receiver_getBeaconsStatistics(BeaconStatistics* beaconsStatistics, uint32_t nbMaxBeaconsStatistics);
 
 
 #endif /* RECEIVERS_H_ */
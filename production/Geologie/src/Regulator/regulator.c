@@ -0,0 +1,230 @@
+/**
+ * @file regulator.c
+ *
+ * @brief Adapte le rythme du scan et du calcul de position a l'activite du robot.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "regulator.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "../BeaconRegistry/beaconRegistry.h"
+#include "../tools.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le poids de la nouvelle mesure dans la vitesse lissee, qui attenue le bruit de la trilateration.
+ */
+#define SPEED_ALPHA (0.5f)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le rythme de chaque niveau, le niveau #REGULATOR_FULL est celui configure au demarrage.
+ */
+static const RegulatorSetting SETTINGS[REGULATOR_NB_LEVELS] = {
+    [REGULATOR_FULL] = { .scanWindowPercent = 100, .updatePeriod = 1000 },
+    [REGULATOR_REDUCED] = { .scanWindowPercent = 50, .updatePeriod = 2000 },
+    [REGULATOR_IDLE] = { .scanWindowPercent = 20, .updatePeriod = 4000 },
+};
+
+/**
+ * @brief Vrai si le rythme est adapte, faux s'il reste a #REGULATOR_FULL.
+ */
+static bool isEnabled = true;
+
+/**
+ * @brief Le niveau courant.
+ */
+static RegulatorLevel level = REGULATOR_FULL;
+
+/**
+ * @brief Le nombre de cycles calmes consecutifs depuis le dernier changement de niveau.
+ */
+static uint32_t nbQuietCycles = 0;
+
+/**
+ * @brief La derniere position prise en compte et sa date de capture, 0 si aucune.
+ */
+static Position lastPosition;
+static uint64_t lastCaptureTime = 0;
+
+/**
+ * @brief La vitesse lissee du robot, en centimetre par seconde.
+ */
+static float speed = 0;
+
+/**
+ * @brief Le numero du cycle courant, 0 avant le premier.
+ */
+static uint32_t cycle = 0;
+
+/**
+ * @brief La puissance de chaque balise et le cycle ou elle a ete recue, par #BeaconIndex.
+ */
+static Power* lastPowers = NULL;
+static uint32_t* lastCycles = NULL;
+static uint16_t capacity = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Met a jour la vitesse lissee avec une nouvelle position.
+ *
+ * @param position La position courante.
+ * @param captureTime La date de capture de la position, la vitesse n'est pas mise a jour si elle est deja connue.
+ */
+static void updateSpeed(const Position* position, uint64_t captureTime);
+
+/**
+ * @brief Calcule la moyenne des carres des variations de puissance des balises recues au cycle precedent et au
+ * cycle courant, puis retient les puissances du cycle courant.
+ *
+ * @param beaconsData Les donnees des balises du cycle courant.
+ * @param nbBeacons Le nombre de balises.
+ * @return float La moyenne, 0 si aucune balise n'a ete recue aux deux cycles.
+ */
+static float getPowerVariation(const BeaconData* beaconsData, uint32_t nbBeacons);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern int8_t Regulator_new() {
+    Regulator_free();
+
+    capacity = BeaconRegistry_getCapacity();
+    lastPowers = calloc(capacity, sizeof(Power));
+    lastCycles = calloc(capacity, sizeof(uint32_t));
+    if (lastPowers == NULL || lastCycles == NULL) {
+        ERROR(true, "[Regulator] Fail to allocate the beacons tables");
+        Regulator_free();
+        return -1;
+    }
+
+    level = REGULATOR_FULL;
+    nbQuietCycles = 0;
+    lastCaptureTime = 0;
+    speed = 0;
+    cycle = 0;
+    return 0;
+}
+
+extern void Regulator_free() {
+    free(lastPowers);
+    free(lastCycles);
+    lastPowers = NULL;
+    lastCycles = NULL;
+    capacity = 0;
+}
+
+extern void Regulator_setEnabled(bool enabled) {
+    isEnabled = enabled;
+}
+
+extern RegulatorLevel Regulator_update(const Position* position, uint64_t captureTime, const BeaconData* beaconsData, uint32_t nbBeacons, const ProcessorAndMemoryLoad* processorAndMemoryLoad) {
+    updateSpeed(position, captureTime);
+    float powerVariation = getPowerVariation(beaconsData, nbBeacons);
+
+    if (!isEnabled) {
+        return REGULATOR_FULL;
+    }
+
+    if (speed > REGULATOR_SPEED_MOVING || powerVariation > REGULATOR_POWER_VARIATION_UNSTABLE) {
+        /* Le moindre changement remet le rythme au maximum, sans attendre */
+        if (level != REGULATOR_FULL) {
+            TRACE("[Regulator] Activity detected (speed %.1f cm/s, power variation %.1f), full rate%s", speed, powerVariation, "\n");
+        }
+        level = REGULATOR_FULL;
+        nbQuietCycles = 0;
+    } else if (++nbQuietCycles >= REGULATOR_NB_QUIET_CYCLES) {
+        /* Le niveau le plus bas n'est atteint que si le processeur est charge, une charge inconnue est negative */
+        RegulatorLevel lowestLevel = processorAndMemoryLoad->processorLoad >= REGULATOR_PROCESSOR_LOAD_HIGH ? REGULATOR_IDLE : REGULATOR_REDUCED;
+
+        if (level < lowestLevel) {
+            level++;
+        } else if (level > lowestLevel) {
+            level--;
+        }
+        nbQuietCycles = 0;
+    }
+
+    return level;
+}
+
+extern void Regulator_getSetting(RegulatorLevel regulatorLevel, RegulatorSetting* setting) {
+    *setting = SETTINGS[regulatorLevel < REGULATOR_NB_LEVELS ? regulatorLevel : REGULATOR_FULL];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void updateSpeed(const Position* position, uint64_t captureTime) {
+    if (captureTime == 0 || captureTime <= lastCaptureTime) {
+        return;     // Pas de nouvelle position
+    }
+
+    if (lastCaptureTime != 0) {
+        float dx = (float) position->X - (float) lastPosition.X;
+        float dy = (float) position->Y - (float) lastPosition.Y;
+        float duration = (float) (captureTime - lastCaptureTime) / 1e9f;
+
+        speed = SPEED_ALPHA * (sqrtf(dx * dx + dy * dy) / duration) + (1 - SPEED_ALPHA) * speed;
+    }
+
+    lastPosition = *position;
+    lastCaptureTime = captureTime;
+}
+
+static float getPowerVariation(const BeaconData* beaconsData, uint32_t nbBeacons) {
+    float sumSquares = 0;
+    uint32_t nbCompared = 0;
+
+    cycle++;
+    for (uint32_t i = 0; i < nbBeacons; i++) {
+        BeaconIndex index = beaconsData[i].index;
+
+        if (index >= capacity) {
+            continue;
+        }
+        if (lastCycles[index] == cycle - 1 && cycle > 1) {
+            float variation = beaconsData[i].power - lastPowers[index];
+            sumSquares += variation * variation;
+            nbCompared++;
+        }
+        lastPowers[index] = beaconsData[i].power;
+        lastCycles[index] = cycle;
+    }
+
+    return nbCompared > 0 ? sumSquares / (float) nbCompared : 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file regulator.h
+ *
+ * @brief Adapte le rythme du scan et du calcul de position a l'activite du robot.
+ *
+ * A chaque cycle de position, Regulator estime la vitesse du robot a partir des positions successives et la
+ * variation du RSSI des balises d'un cycle a l'autre. Tant que l'une ou l'autre depasse son seuil, le rythme est
+ * maximal. Apres #REGULATOR_NB_QUIET_CYCLES cycles calmes, il descend d'un niveau ; il ne descend au plus bas que si
+ * la charge processeur mesuree par Bookkeeper est forte, la carte etant partagee avec le logiciel du robot.
+ *
+ * Regulator n'est pas protege contre les acces concurrents : il est mis a jour par le seul thread de Scanner.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+#ifndef REGULATOR_
+#define REGULATOR_
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../common.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La vitesse lissee au-dela de laquelle le robot est considere en mouvement, en centimetre par seconde.
+ */
+#define REGULATOR_SPEED_MOVING (20)
+
+/**
+ * @brief La moyenne des carres des variations de puissance d'un cycle a l'autre au-dela de laquelle le signal est
+ * considere instable.
+ */
+#define REGULATOR_POWER_VARIATION_UNSTABLE (4)
+
+/**
+ * @brief La charge processeur, en pourcentage, a partir de laquelle le rythme peut descendre au niveau le plus bas.
+ */
+#define REGULATOR_PROCESSOR_LOAD_HIGH (50)
+
+/**
+ * @brief Le nombre de cycles calmes consecutifs avant de descendre d'un niveau.
+ */
+#define REGULATOR_NB_QUIET_CYCLES (5)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les niveaux de rythme, du plus rapide au plus econome.
+ */
+typedef enum {
+    REGULATOR_FULL = 0,     /**< Le rythme configure au demarrage. */
+    REGULATOR_REDUCED,      /**< Le robot est immobile. */
+    REGULATOR_IDLE,         /**< Le robot est immobile et le processeur est charge. */
+    REGULATOR_NB_LEVELS
+} RegulatorLevel;
+
+/**
+ * @brief Le rythme applique a un niveau.
+ */
+typedef struct {
+    uint8_t scanWindowPercent;  /**< La fenetre de scan, en pourcentage de celle configuree au demarrage. */
+    uint32_t updatePeriod;      /**< La periode du calcul de position, en milliseconde. */
+} RegulatorSetting;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Alloue les tables par balise de Regulator, a la capacite de BeaconRegistry, et repart du niveau #REGULATOR_FULL.
+ *
+ * @return int8_t -1 si l'allocation a echoue, 0 sinon.
+ */
+extern int8_t Regulator_new();
+
+/**
+ * @brief Libere les tables par balise de Regulator.
+ */
+extern void Regulator_free();
+
+/**
+ * @brief Active ou desactive la regulation, desactivee le niveau reste #REGULATOR_FULL.
+ *
+ * @param enabled Vrai pour adapter le rythme, faux pour le garder fixe.
+ */
+extern void Regulator_setEnabled(bool enabled);
+
+/**
+ * @brief Prend en compte un cycle de position et donne le niveau de rythme a appliquer.
+ *
+ * @param position La position courante.
+ * @param captureTime La date de capture de la position sur l'horloge monotone en nanoseconde, 0 si aucune position
+ * n'a encore ete calculee. Une date deja vue signifie que la position n'a pas ete mise a jour.
+ * @param beaconsData Les donnees des balises recues pendant le cycle.
+ * @param nbBeacons Le nombre de balises de @a beaconsData.
+ * @param processorAndMemoryLoad La charge mesuree par Bookkeeper, negative si inconnue.
+ * @return RegulatorLevel Le niveau a appliquer.
+ */
+extern RegulatorLevel Regulator_update(const Position* position, uint64_t captureTime, const BeaconData* beaconsData, uint32_t nbBeacons, const ProcessorAndMemoryLoad* processorAndMemoryLoad);
+
+/**
+ * @brief Donne le rythme applique a un niveau.
+ *
+ * @param regulatorLevel Le niveau.
+ * @param setting Le rythme a remplir.
+ */
+extern void Regulator_getSetting(RegulatorLevel regulatorLevel, RegulatorSetting* setting);
+
+#endif // REGULATOR_
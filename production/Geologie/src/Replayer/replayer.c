@@ -0,0 +1,455 @@
+/**
+ * @file replayer.c
+ *
+ * @brief Rejoue les evenements HCI d'une capture btsnoop ou pcap sans les copier.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "replayer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../tools.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief L'identifiant en debut de fichier btsnoop, '\0' compris.
+ */
+#define BTSNOOP_ID "btsnoop"
+#define BTSNOOP_ID_SIZE (8)
+
+#define BTSNOOP_VERSION (1)
+#define BTSNOOP_HEADER_SIZE (16)
+#define BTSNOOP_RECORD_HEADER_SIZE (24)
+
+#define BTSNOOP_DATALINK_HCI (1001)
+#define BTSNOOP_DATALINK_H4 (1002)
+
+/**
+ * @brief Les drapeaux d'un enregistrement btsnoop : paquet recu par l'hote, commande ou evenement.
+ */
+#define BTSNOOP_FLAG_RECEIVED (0x01)
+#define BTSNOOP_FLAG_COMMAND_EVENT (0x02)
+
+#define PCAP_HEADER_SIZE (24)
+#define PCAP_RECORD_HEADER_SIZE (16)
+
+/**
+ * @brief Les nombres magiques pcap, horodatage a la microseconde ou a la nanoseconde.
+ */
+#define PCAP_MAGIC_MICROSECOND (0xA1B2C3D4)
+#define PCAP_MAGIC_NANOSECOND (0xA1B23C4D)
+
+#define PCAP_LINKTYPE_H4 (187)
+#define PCAP_LINKTYPE_H4_WITH_PHDR (201)
+
+/**
+ * @brief La taille de l'en-tete de direction de DLT_BLUETOOTH_HCI_H4_WITH_PHDR.
+ */
+#define PCAP_PHDR_SIZE (4)
+
+/**
+ * @brief L'indicateur de paquet H4 d'un evenement HCI.
+ */
+#define H4_EVENT_PKT (0x04)
+
+/**
+ * @brief La taille de l'en-tete d'un evenement HCI (code et taille des parametres).
+ */
+#define HCI_EVENT_HEADER_SIZE (2)
+
+/**
+ * @brief La duree maximale d'une attente de rejeu en nanoseconde, permet de verifier regulierement l'arret du rejeu.
+ */
+#define REPLAY_SLEEP_MAX (100000000L)
+
+#define NANOSECOND_PER_SECOND (1000000000ULL)
+#define NANOSECOND_PER_MICROSECOND (1000ULL)
+
+/**
+ * @brief Les formats de capture supportes.
+ */
+typedef enum {
+    FORMAT_BTSNOOP_HCI = 0,     /**< btsnoop, HCI non encapsule */
+    FORMAT_BTSNOOP_H4,          /**< btsnoop, HCI UART H4 */
+    FORMAT_PCAP_H4,             /**< pcap, DLT_BLUETOOTH_HCI_H4 */
+    FORMAT_PCAP_H4_WITH_PHDR    /**< pcap, DLT_BLUETOOTH_HCI_H4_WITH_PHDR */
+} CaptureFormat;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variables privees
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La projection en memoire de la capture.
+ */
+static const uint8_t* capture = NULL;
+static size_t captureSize = 0;
+
+/**
+ * @brief La position du prochain enregistrement dans #capture.
+ */
+static size_t cursor = 0;
+
+static CaptureFormat format;
+
+/**
+ * @brief Vrai si les champs de la capture sont en grand boutiste (toujours le cas en btsnoop).
+ */
+static bool isBigEndian;
+
+/**
+ * @brief Vrai si la capture pcap est horodatee a la nanoseconde.
+ */
+static bool isNanosecond;
+
+static float replaySpeed = REPLAYER_SPEED_RECORDED;
+
+/**
+ * @brief L'horodatage du premier evenement rejoue et l'heure a laquelle il l'a ete, references du rythme de rejeu.
+ */
+static bool isFirstEvent;
+static volatile bool isStopped;
+static uint64_t firstTimestamp;
+static struct timespec firstReplayTime;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lit un entier de 32 bits dans la capture.
+ *
+ * @param data Les octets a lire.
+ * @param bigEndian Vrai si l'entier est en grand boutiste.
+ * @return uint32_t L'entier lu.
+ */
+static uint32_t readUint32(const uint8_t* data, bool bigEndian);
+
+/**
+ * @brief Lit l'en-tete de la capture et en deduit son format.
+ *
+ * @return int8_t -1 si le format n'est pas supporte, 0 sinon.
+ */
+static int8_t readHeader(void);
+
+/**
+ * @brief Avance sur le prochain enregistrement de la capture.
+ *
+ * @param data Pointe sur les donnees de l'enregistrement.
+ * @param size La taille des donnees.
+ * @param flags Les drapeaux btsnoop de l'enregistrement, 0 en pcap.
+ * @param timestamp L'horodatage de l'enregistrement en nanoseconde.
+ * @return bool false a la fin de la capture ou sur un enregistrement tronque, true sinon.
+ */
+static bool nextRecord(const uint8_t** data, uint32_t* size, uint32_t* flags, uint64_t* timestamp);
+
+/**
+ * @brief Attend l'heure de rejeu d'un evenement selon la vitesse de rejeu.
+ *
+ * @param timestamp L'horodatage de l'evenement en nanoseconde.
+ * @return bool false si le rejeu a ete arrete pendant l'attente, true sinon.
+ */
+static bool waitReplayTime(uint64_t timestamp);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern int8_t Replayer_open(const char* path, float speed) {
+    int8_t returnError = EXIT_SUCCESS;
+    struct stat fileStat;
+    void* mapping;
+    int fd;
+
+    Replayer_close();
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ERROR(true, "[Replayer] Fail to open the capture");
+        return -1;
+    }
+
+    returnError = fstat(fd, &fileStat);
+    ERROR(returnError < 0, "[Replayer] Fail to get the size of the capture");
+
+    if (returnError >= 0 && fileStat.st_size == 0) {
+        LOG("[Replayer] The capture %s is empty%s", path, "\n");
+        returnError = -1;
+    }
+
+    if (returnError >= 0) {
+        mapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ERROR(true, "[Replayer] Fail to map the capture");
+            returnError = -1;
+        } else {
+            madvise(mapping, fileStat.st_size, MADV_SEQUENTIAL);
+            capture = (const uint8_t*) mapping;
+            captureSize = fileStat.st_size;
+        }
+    }
+
+    close(fd);
+
+    if (returnError >= 0) {
+        returnError = readHeader();
+        if (returnError < 0) {
+            LOG("[Replayer] The capture %s is neither a btsnoop nor a pcap HCI capture%s", path, "\n");
+            Replayer_close();
+        }
+    }
+
+    replaySpeed = speed;
+    isFirstEvent = true;
+    isStopped = false;
+
+    return returnError;
+}
+
+extern void Replayer_close(void) {
+    if (capture != NULL) {
+        munmap((void*) capture, captureSize);
+        capture = NULL;
+        captureSize = 0;
+    }
+}
+
+extern void Replayer_stop(void) {
+    isStopped = true;
+}
+
+extern bool Replayer_nextHciEvent(const uint8_t** event, uint16_t* size) {
+    const uint8_t* data;
+    uint32_t dataSize;
+    uint32_t flags;
+    uint64_t timestamp;
+
+    if (capture == NULL) {
+        return false;
+    }
+
+    while (!isStopped && nextRecord(&data, &dataSize, &flags, &timestamp)) {
+        const uint8_t* hciEvent = NULL;
+        uint32_t hciEventSize = 0;
+
+        switch (format) {
+            case FORMAT_BTSNOOP_HCI:
+                if ((flags & (BTSNOOP_FLAG_RECEIVED | BTSNOOP_FLAG_COMMAND_EVENT)) == (BTSNOOP_FLAG_RECEIVED | BTSNOOP_FLAG_COMMAND_EVENT)) {
+                    hciEvent = data;
+                    hciEventSize = dataSize;
+                }
+                break;
+
+            case FORMAT_BTSNOOP_H4:
+                if ((flags & BTSNOOP_FLAG_RECEIVED) && dataSize > 1 && data[0] == H4_EVENT_PKT) {
+                    hciEvent = data + 1;
+                    hciEventSize = dataSize - 1;
+                }
+                break;
+
+            case FORMAT_PCAP_H4:
+                if (dataSize > 1 && data[0] == H4_EVENT_PKT) {
+                    hciEvent = data + 1;
+                    hciEventSize = dataSize - 1;
+                }
+                break;
+
+            case FORMAT_PCAP_H4_WITH_PHDR:
+                if (dataSize > PCAP_PHDR_SIZE + 1 && data[PCAP_PHDR_SIZE] == H4_EVENT_PKT) {
+                    hciEvent = data + PCAP_PHDR_SIZE + 1;
+                    hciEventSize = dataSize - PCAP_PHDR_SIZE - 1;
+                }
+                break;
+        }
+
+        if (hciEvent != NULL && hciEventSize >= HCI_EVENT_HEADER_SIZE && hciEventSize <= UINT16_MAX) {
+            if (!waitReplayTime(timestamp)) {
+                return false;
+            }
+
+            *event = hciEvent;
+            *size = (uint16_t) hciEventSize;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions privees
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t readUint32(const uint8_t* data, bool bigEndian) {
+    if (bigEndian) {
+        return ((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 8) | data[3];
+    } else {
+        return ((uint32_t) data[3] << 24) | ((uint32_t) data[2] << 16) | ((uint32_t) data[1] << 8) | data[0];
+    }
+}
+
+static int8_t readHeader(void) {
+    int8_t returnError = -1;
+
+    if (captureSize >= BTSNOOP_HEADER_SIZE && memcmp(capture, BTSNOOP_ID, BTSNOOP_ID_SIZE) == 0) {
+        uint32_t version = readUint32(capture + 8, true);
+        uint32_t datalink = readUint32(capture + 12, true);
+
+        isBigEndian = true;
+        cursor = BTSNOOP_HEADER_SIZE;
+
+        if (version == BTSNOOP_VERSION && datalink == BTSNOOP_DATALINK_HCI) {
+            format = FORMAT_BTSNOOP_HCI;
+            returnError = 0;
+        } else if (version == BTSNOOP_VERSION && datalink == BTSNOOP_DATALINK_H4) {
+            format = FORMAT_BTSNOOP_H4;
+            returnError = 0;
+        }
+    } else if (captureSize >= PCAP_HEADER_SIZE) {
+        uint32_t magic = readUint32(capture, false);
+
+        if (magic == PCAP_MAGIC_MICROSECOND || magic == PCAP_MAGIC_NANOSECOND) {
+            isBigEndian = false;
+        } else {
+            magic = readUint32(capture, true);
+            isBigEndian = true;
+        }
+        isNanosecond = (magic == PCAP_MAGIC_NANOSECOND);
+        cursor = PCAP_HEADER_SIZE;
+
+        if (magic == PCAP_MAGIC_MICROSECOND || magic == PCAP_MAGIC_NANOSECOND) {
+            uint32_t linktype = readUint32(capture + 20, isBigEndian);
+
+            if (linktype == PCAP_LINKTYPE_H4) {
+                format = FORMAT_PCAP_H4;
+                returnError = 0;
+            } else if (linktype == PCAP_LINKTYPE_H4_WITH_PHDR) {
+                format = FORMAT_PCAP_H4_WITH_PHDR;
+                returnError = 0;
+            }
+        }
+    }
+
+    return returnError;
+}
+
+static bool nextRecord(const uint8_t** data, uint32_t* size, uint32_t* flags, uint64_t* timestamp) {
+    const uint8_t* header = capture + cursor;
+    uint32_t includedSize;
+    size_t headerSize;
+
+    if (format == FORMAT_BTSNOOP_HCI || format == FORMAT_BTSNOOP_H4) {
+        headerSize = BTSNOOP_RECORD_HEADER_SIZE;
+        if (captureSize - cursor < headerSize) {
+            return false;
+        }
+
+        includedSize = readUint32(header + 4, true);
+        *flags = readUint32(header + 8, true);
+        /* Microsecondes depuis l'an 0, seul l'ecart entre deux enregistrements compte */
+        *timestamp = (((uint64_t) readUint32(header + 16, true) << 32) | readUint32(header + 20, true)) * NANOSECOND_PER_MICROSECOND;
+    } else {
+        headerSize = PCAP_RECORD_HEADER_SIZE;
+        if (captureSize - cursor < headerSize) {
+            return false;
+        }
+
+        includedSize = readUint32(header + 8, isBigEndian);
+        *flags = 0;
+        *timestamp = readUint32(header, isBigEndian) * NANOSECOND_PER_SECOND
+                     + readUint32(header + 4, isBigEndian) * (isNanosecond ? 1 : NANOSECOND_PER_MICROSECOND);
+    }
+
+    if (captureSize - cursor - headerSize < includedSize) {
+        TRACE("[Replayer] Truncated record at offset %zu%s", cursor, "\n");
+        cursor = captureSize;
+        return false;
+    }
+
+    *data = header + headerSize;
+    *size = includedSize;
+    cursor += headerSize + includedSize;
+
+    return true;
+}
+
+static bool waitReplayTime(uint64_t timestamp) {
+    struct timespec replayTime;
+    struct timespec now;
+    uint64_t delay;
+
+    if (replaySpeed <= REPLAYER_SPEED_MAX) {
+        return true;
+    }
+
+    if (isFirstEvent) {
+        isFirstEvent = false;
+        firstTimestamp = timestamp;
+        clock_gettime(CLOCK_MONOTONIC, &firstReplayTime);
+        return true;
+    }
+
+    delay = timestamp > firstTimestamp ? (uint64_t) ((timestamp - firstTimestamp) / replaySpeed) : 0;
+
+    replayTime.tv_sec = firstReplayTime.tv_sec + delay / NANOSECOND_PER_SECOND;
+    replayTime.tv_nsec = firstReplayTime.tv_nsec + delay % NANOSECOND_PER_SECOND;
+    if (replayTime.tv_nsec >= (long) NANOSECOND_PER_SECOND) {
+        replayTime.tv_sec++;
+        replayTime.tv_nsec -= NANOSECOND_PER_SECOND;
+    }
+
+    /* Attente par tranches pour que Replayer_stop soit pris en compte meme entre deux enregistrements eloignes */
+    while (!isStopped) {
+        struct timespec wakeUpTime;
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (now.tv_sec > replayTime.tv_sec || (now.tv_sec == replayTime.tv_sec && now.tv_nsec >= replayTime.tv_nsec)) {
+            break;
+        }
+
+        wakeUpTime.tv_sec = now.tv_sec;
+        wakeUpTime.tv_nsec = now.tv_nsec + REPLAY_SLEEP_MAX;
+        if (wakeUpTime.tv_nsec >= (long) NANOSECOND_PER_SECOND) {
+            wakeUpTime.tv_sec++;
+            wakeUpTime.tv_nsec -= NANOSECOND_PER_SECOND;
+        }
+        if (wakeUpTime.tv_sec > replayTime.tv_sec || (wakeUpTime.tv_sec == replayTime.tv_sec && wakeUpTime.tv_nsec > replayTime.tv_nsec)) {
+            wakeUpTime = replayTime;
+        }
+
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeUpTime, NULL);
+    }
+
+    return !isStopped;
+}
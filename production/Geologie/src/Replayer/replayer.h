@@ -0,0 +1,89 @@
+/**
+ * @file replayer.h
+ *
+ * @brief Rejoue les evenements HCI d'une capture btsnoop ou pcap sans les copier.
+ *
+ * La capture est projetee en memoire (mmap) et chaque evenement est rendu sous la forme d'un pointeur dans la
+ * projection, au rythme de l'enregistrement, N fois plus vite ou aussi vite que possible.
+ *
+ * Formats supportes :
+ * - btsnoop version 1, liens HCI non encapsule (1001) et HCI UART H4 (1002) ;
+ * - pcap (microseconde ou nanoseconde, petit ou grand boutiste), liens DLT_BLUETOOTH_HCI_H4 (187) et
+ *   DLT_BLUETOOTH_HCI_H4_WITH_PHDR (201).
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+#ifndef REPLAYER_
+#define REPLAYER_
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La vitesse de rejeu a donner pour rejouer la capture aussi vite que possible.
+ */
+#define REPLAYER_SPEED_MAX (0.0f)
+
+/**
+ * @brief La vitesse de rejeu a donner pour rejouer la capture au rythme de l'enregistrement.
+ */
+#define REPLAYER_SPEED_RECORDED (1.0f)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ouvre et projette en memoire la capture a rejouer.
+ *
+ * @param path Le chemin de la capture btsnoop ou pcap.
+ * @param speed Le facteur de vitesse du rejeu, #REPLAYER_SPEED_RECORDED pour le rythme de l'enregistrement,
+ * #REPLAYER_SPEED_MAX pour rejouer sans attendre.
+ * @return int8_t -1 en cas d'erreur, 0 sinon.
+ */
+extern int8_t Replayer_open(const char* path, float speed);
+
+/**
+ * @brief Ferme la capture ouverte par #Replayer_open.
+ *
+ * Les pointeurs rendus par #Replayer_nextHciEvent ne sont plus valides apres cet appel.
+ */
+extern void Replayer_close(void);
+
+/**
+ * @brief Arrete le rejeu, #Replayer_nextHciEvent rend false des que possible.
+ *
+ * Peut etre appele depuis un autre thread que celui qui rejoue la capture.
+ */
+extern void Replayer_stop(void);
+
+/**
+ * @brief Rend le prochain evenement HCI recu de la capture, en attendant son heure de rejeu.
+ *
+ * Les commandes, les donnees ACL et les paquets emis par l'hote sont sautes.
+ *
+ * @param event Pointe sur l'evenement dans la capture, a partir de l'en-tete hci_event_hdr.
+ * @param size La taille de l'evenement.
+ * @return bool false a la fin de la capture, sur un enregistrement tronque ou apres #Replayer_stop, true sinon.
+ */
+extern bool Replayer_nextHciEvent(const uint8_t** event, uint16_t* size);
+
+#endif /* REPLAYER_ */
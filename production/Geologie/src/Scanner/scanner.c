@@ -23,13 +23,19 @@
 #include <mqueue.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <time.h>
 
 #include "../tools.h"
 #include "../common.h"
 #include "../Receiver/receiver.h"
+#include "../BeaconRegistry/beaconRegistry.h"
 #include "../Geographer/geographer.h"
 #include "../Bookkeeper/bookkeeper.h"
 #include "../Watchdog/watchdog.h"
+#include "../Regulator/regulator.h"
+#include "../Tracker/tracker.h"
+#include "../Fingerprint/fingerprint.h"
+#include "../ParticleFilter/particleFilter.h"
 #include "scanner.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -39,9 +45,22 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define MQ_MAX_MESSAGES (5)
-#define MAX_BEACONS_COEFFICIENTS (30) //Check
-#define NB_BEACONS_MAX (10)
-#define BEACON_ID_LENGTH (3)
+#define NB_BEACONS_MIN_POSITION (3)
+
+/**
+ * @brief Le nombre maximal de balises envoyees a GEOMOBILE, leur nombre tient sur un octet dans la trame.
+ */
+#define NB_BEACONS_SENT_MAX (UINT8_MAX)
+
+/**
+ * @brief Le coefficient d'attenuation d'une balise qui n'a pas encore ete calibree.
+ */
+#define DEFAULT_COEFFICIENT_AVERAGE (3)
+
+/**
+ * @brief L'emplacement d'une balise qui n'a pas de donnees de calibration en cours de calcul.
+ */
+#define CALIBRATION_NONE (UINT16_MAX)
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -53,22 +72,85 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static BeaconData* beaconsData;
+/**
+ * @brief Le nombre d'elements des tables par balise, la capacite de BeaconRegistry lors de #Scanner_new.
+ *
+ * Toutes les tables sont allouees une fois dans #Scanner_new, aucun cycle de position n'alloue de memoire.
+ */
+static uint16_t beaconsCapacity = 0;
+
+/**
+ * @brief Les deux tampons de #BeaconData : Geographer envoie l'un pendant que le cycle suivant remplit l'autre.
+ */
+static BeaconData* beaconsDataBuffers[2] = {NULL, NULL};
+static uint8_t currentBeaconsDataBuffer = 0;
+static BeaconData* beaconsData = NULL;
+
+/**
+ * @brief Les statistiques de reception des balises envoyees a Geographer, alternees avec #beaconsDataBuffers.
+ */
+static BeaconStatistics* beaconsStatisticsBuffers[2] = {NULL, NULL};
+
 static Position currentPosition;
+
+/**
+ * @brief La date de capture de #currentPosition sur l'horloge monotone en nanoseconde, 0 tant qu'aucune position n'a ete calculee.
+ */
+static uint64_t currentPositionCaptureTime = 0;
 static ProcessorAndMemoryLoad currentProcessorAndMemoryLoad;
-static BeaconCoefficients* beaconsCoefficients;
-static BeaconSignal* beaconsSignal;
-static CalibrationData* calibrationData;
-static uint32_t beaconsIds[NB_BEACONS_MAX];
-static uint32_t nbBeaconsCoefficients;
+
+/**
+ * @brief Les parametres du scan au demarrage, ceux du niveau #REGULATOR_FULL, et le niveau de rythme applique.
+ */
+static ReceiverScanConfiguration fullScanConfiguration;
+static RegulatorLevel regulatorLevel = REGULATOR_FULL;
+static BeaconSignal* beaconsSignal = NULL;
 static uint32_t nbBeaconsAvailable;
-static uint32_t beaconsCoefficientsindex;
+
+/**
+ * @brief Les coefficients d'attenuation mesures a chaque position de calibration, dans l'ordre de leur mesure.
+ */
+static BeaconCoefficients* beaconsCoefficients = NULL;
+static uint32_t nbBeaconsCoefficients;
+static uint32_t maxBeaconsCoefficients;
+
+/**
+ * @brief Les donnees de calibration de chaque balise et leurs coefficients, regroupes par balise.
+ *
+ * Les #NB_BEACONS_SENT_MAX premieres sont envoyees a Geographer, elles restent valables jusqu'au calcul de moyenne suivant.
+ */
+static CalibrationData* calibrationData = NULL;
+static BeaconCoefficients* calibrationCoefficients = NULL;
+
+/**
+ * @brief L'emplacement de chaque balise dans #calibrationData pendant le calcul de moyenne, par #BeaconIndex.
+ */
+static uint16_t* calibrationSlot = NULL;
+
+/**
+ * @brief Les deux tables de distances de chaque balise, aux indices 2 * #BeaconIndex et 2 * #BeaconIndex + 1.
+ */
+static RangeTable* rangeTables = NULL;
+
+/**
+ * @brief La table publiee de chaque balise, par #BeaconIndex, qui porte son coefficient d'attenuation moyen.
+ *
+ * L'etage de fusion de Receiver la lit pendant que la calibration remplit l'autre table de la balise, publiee
+ * ensuite par un echange atomique du pointeur : une table publiee n'est jamais reecrite avant la calibration
+ * suivante. Le coefficient et les distances d'une balise sont toujours lus dans la meme table, jamais l'un
+ * avant une calibration et les autres apres.
+ */
+static RangeTable** publishedRangeTables = NULL;
+
+/**
+ * @brief La periode d'envoi de la position suivie a Geographer en milliseconde, 0 si le suivi est desactive.
+ */
+static uint32_t trackingPeriod = 0;
 
 typedef enum {
     S_FORGET,
     S_DEATH,
     S_BEGINNING,
-    S_WAITING_DATA_BEACONS,
     S_COMPUTE_POSITION,
     S_COMPUTE_LOAD,
     // S_COMPUTE_CALIBRATION_POSITION,
@@ -81,9 +163,9 @@ typedef enum {
     //E_ASK_BEACONS_SIGNAL,
     E_ASK_UPDATE_COEF_FROM_POSITION,
     E_ASK_AVERAGE_CALCUL,
-    E_SET_BEACONS_SIGNAL,
     E_SET_PROCESSOR_AND_MEMORY,
     E_TIME_OUT,
+    E_PUBLISH_TRACK,
     NB_EVENT_SCANNER
 } Event_SCANNER;
 
@@ -94,9 +176,9 @@ typedef enum {
     A_ASK_CALIBRATION_FROM_POSITION_TIMER,
     A_ASK_CALIBRATION_AVERAGE,
     A_ASK_CALIBRATION_AVERAGE_TIMER,
-    A_ASK_BEACONS_SIGNAL,
     A_SET_CURRENT_POSITION,
     A_SET_CURRENT_PROCESSOR_AND_MEMORY,
+    A_PUBLISH_TRACK,
     NB_ACTION_SCANNER
 } Action_SCANNER;
 
@@ -107,31 +189,27 @@ typedef struct {
 
 static Transition_SCANNER stateMachine[NB_STATE][NB_EVENT_SCANNER] =
 {
-    [S_BEGINNING] [E_TIME_OUT] = {S_WAITING_DATA_BEACONS, A_ASK_BEACONS_SIGNAL},
+    [S_BEGINNING] [E_TIME_OUT] = {S_COMPUTE_POSITION, A_SET_CURRENT_POSITION},
     [S_BEGINNING][E_STOP] = {S_DEATH, A_STOP},
-
-    [S_WAITING_DATA_BEACONS][E_SET_BEACONS_SIGNAL] = {S_COMPUTE_POSITION, A_SET_CURRENT_POSITION},
-    [S_WAITING_DATA_BEACONS][E_STOP] = {S_DEATH, A_STOP},
-    [S_WAITING_DATA_BEACONS][E_ASK_UPDATE_COEF_FROM_POSITION] = {S_WAITING_DATA_BEACONS, A_ASK_CALIBRATION_FROM_POSITION},
-    [S_WAITING_DATA_BEACONS][E_ASK_AVERAGE_CALCUL] = {S_WAITING_DATA_BEACONS, A_ASK_CALIBRATION_AVERAGE},
+    [S_BEGINNING][E_PUBLISH_TRACK] = {S_BEGINNING, A_PUBLISH_TRACK},
 
     [S_COMPUTE_POSITION][E_SET_PROCESSOR_AND_MEMORY] = {S_COMPUTE_LOAD, A_SET_CURRENT_PROCESSOR_AND_MEMORY},
     [S_COMPUTE_POSITION][E_STOP] = {S_DEATH, A_STOP},
     [S_COMPUTE_POSITION][E_ASK_UPDATE_COEF_FROM_POSITION] = {S_COMPUTE_POSITION, A_ASK_CALIBRATION_FROM_POSITION},
     [S_COMPUTE_POSITION][E_ASK_AVERAGE_CALCUL] = {S_COMPUTE_POSITION, A_ASK_CALIBRATION_AVERAGE},
+    [S_COMPUTE_POSITION][E_PUBLISH_TRACK] = {S_COMPUTE_POSITION, A_PUBLISH_TRACK},
 
-    [S_COMPUTE_LOAD][E_TIME_OUT] = {S_WAITING_DATA_BEACONS, A_ASK_BEACONS_SIGNAL},
+    [S_COMPUTE_LOAD][E_TIME_OUT] = {S_COMPUTE_POSITION, A_SET_CURRENT_POSITION},
     [S_COMPUTE_LOAD][E_STOP] = {S_DEATH, A_STOP},
     [S_COMPUTE_LOAD][E_ASK_UPDATE_COEF_FROM_POSITION] = {S_COMPUTE_LOAD, A_ASK_CALIBRATION_FROM_POSITION_TIMER},
     [S_COMPUTE_LOAD][E_ASK_AVERAGE_CALCUL] = {S_COMPUTE_LOAD, A_ASK_CALIBRATION_AVERAGE_TIMER},
+    [S_COMPUTE_LOAD][E_PUBLISH_TRACK] = {S_COMPUTE_LOAD, A_PUBLISH_TRACK},
 };
 
 typedef struct {
     Event_SCANNER event;
-    BeaconSignal* beaconsSignal;
     ProcessorAndMemoryLoad currentProcessorAndMemoryLoad;
     CalibrationPosition calibrationPosition;
-    uint32_t nbBeaconsAvailable;
 }MqMsgScanner;
 
 static State_SCANNER myState;
@@ -143,6 +221,11 @@ static struct mq_attr attr;
 
 static Watchdog* wtd_TMaj;
 
+/**
+ * @brief Le watchdog qui rythme l'envoi de la position suivie, toutes les #trackingPeriod millisecondes.
+ */
+static Watchdog* wtd_TTrack;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Fonctions privee
@@ -185,16 +268,84 @@ static void mqReceive(MqMsgScanner* this);
 static void translateBeaconsSignalToBeaconsData(BeaconSignal* beaconsSignal, BeaconData* dest);
 
 /**
- * @fn static void sortBeaconsCoefficientId(BeaconCoefficients * beaconsCoefficients)
- * @brief recupère l'ensemble des identifiants des balises scannees
+ * @fn static void applyRegulatorLevel(RegulatorLevel level)
+ * @brief Applique a Receiver et au watchdog de mise a jour le rythme d'un niveau donne par Regulator
+ *
+ * @param level le niveau a appliquer, sans effet s'il est deja applique
+ */
+static void applyRegulatorLevel(RegulatorLevel level);
+
+/**
+ * @fn static void selectStrongestBeacons(BeaconData* beaconsData, uint32_t nbBeacons)
+ * @brief Place en tete du tableau les #NB_BEACONS_MIN_POSITION balises recues le plus fort, de la plus forte a la
+ * moins forte, en O(n)
+ *
+ * Ce sont les plus proches, donc les plus fiables : Mathematician part de ces premieres balises. Le reste du tableau
+ * n'est pas trie ; s'il y a plus de #NB_BEACONS_SENT_MAX balises, les #NB_BEACONS_SENT_MAX plus fortes sont
+ * d'abord regroupees en tete, dans un ordre quelconque, pour etre celles envoyees dans la trame.
+ *
+ * @param beaconsData le tableau de BeaconData a reordonner
+ * @param nbBeacons le nombre de balises du tableau
+*/
+static void selectStrongestBeacons(BeaconData* beaconsData, uint32_t nbBeacons);
+
+/**
+ * @fn static void partitionStrongestBeacons(BeaconData* beaconsData, uint32_t nbBeacons, uint32_t nbStrongest)
+ * @brief Regroupe en tete du tableau les nbStrongest balises recues le plus fort, dans un ordre quelconque, en O(n)
+ * en moyenne
+ *
+ * @param beaconsData le tableau de BeaconData a reordonner
+ * @param nbBeacons le nombre de balises du tableau, plus grand que nbStrongest
+ * @param nbStrongest le nombre de balises a regrouper
+*/
+static void partitionStrongestBeacons(BeaconData* beaconsData, uint32_t nbBeacons, uint32_t nbStrongest);
+
+/**
+ * @fn static void swapBeaconsData(BeaconData* beaconsData, uint32_t first, uint32_t second)
+ * @brief Echange deux balises du tableau
+*/
+static void swapBeaconsData(BeaconData* beaconsData, uint32_t first, uint32_t second);
+
+/**
+ * @fn static int8_t computeCurrentPosition()
+ * @brief Met a jour #currentPosition avec les balises de #beaconsData
+ *
+ * La position precedente sert de depart a l'affinage par Levenberg-Marquardt. S'il n'y en a pas encore ou si
+ * l'affinage ne converge pas, la position repart des moindres carres lineaires.
+ *
+ * @return 0 en cas de succes, -1 si les balises sont alignees, la position est alors inchangee
+*/
+static int8_t computeCurrentPosition();
+
+/**
+ * @brief Corrige la position suivie par Tracker avec l'annonce fusionnee par Receiver.
  *
- * @param beaconsCoefficients pointeur vers un tableau de beaconCoefficient a partir duquel seront extraits les identifiants
+ * Appelee par l'etage de fusion de Receiver pour chaque annonce, hors du thread de Scanner.
+ *
+ * @param report L'annonce brute de la balise, son indice dans BeaconRegistry renseigne.
+ * @param rssiVariance La variance du RSSI de la balise, en dBm carre.
+ */
+static void trackReport(const BeaconSignal* report, float rssiVariance);
+
+/**
+ * @brief Remplit la table de distances libre d'une balise avec son nouveau coefficient, puis la publie.
+ *
+ * @param index L'indice de la balise.
+ * @param coefficient Le coefficient d'attenuation moyen de la balise.
+ */
+static void publishRangeTable(BeaconIndex index, const AttenuationCoefficient* coefficient);
+
+/**
+ * @fn static uint32_t groupBeaconsCoefficients()
+ * @brief Regroupe par balise les coefficients mesures dans #calibrationData, en deux passages sur #beaconsCoefficients
+ *
+ * @return le nombre de balises de #calibrationData
 */
-static void sortBeaconsCoefficientId(BeaconCoefficients* beaconsCoefficients);
+static uint32_t groupBeaconsCoefficients();
 
 /**
  * @fn static void perform_setCurrentPosition(MqMsgScanner * msg)
- * @brief perform_action dans le cas de A_SET_CURRENT_POSITION
+ * @brief perform_action dans le cas de A_SET_CURRENT_POSITION, lit les dernieres donnees publiees par Receiver
  *
  * @param msg message qui contient les donnees necessaire a l'execution de la fonction
 */
@@ -231,10 +382,9 @@ static void perform_askCalibrationAverage(MqMsgScanner* msg);
 static void perform_stop();
 
 /**
- * @fn static void perform_askBeaconsSignal()
- * @brief perform_action dans le cas de A_ASK_BEACONS_SIGNAL
-*/
-static void perform_askBeaconsSignal();
+ * @brief Envoie a Geographer la position suivie, predite a la date courante, puis relance #wtd_TTrack.
+ */
+static void perform_publishTrack();
 
 /**
  * @fn static void performAction(Action_SCANNER action, MqMsgScanner * msg)
@@ -288,59 +438,201 @@ static void mqReceive(MqMsgScanner* msg) {
 }
 
 static void translateBeaconsSignalToBeaconsData(BeaconSignal* beaconsSignal, BeaconData* dest) {
-    uint32_t i;
-    uint32_t j;
-    for (i = 0; i < nbBeaconsAvailable; i++) {
-        BeaconData data;
-        memcpy(data.ID, beaconsSignal[i].name, BEACON_ID_LENGTH);
-        data.position = beaconsSignal[i].position;
-        data.power = beaconsSignal[i].rssi;
-        data.coefficientAverage = 3;
-
-        for (j = 0; j < nbBeaconsAvailable; j++) {
-            if (strcmp((char*) data.ID, (char*) calibrationData[j].beaconId) == 0) {
-                data.coefficientAverage = calibrationData[j].coefficientAverage;
-            }
-        }
+    for (uint32_t i = 0; i < nbBeaconsAvailable; i++) {
+        dest[i].index = beaconsSignal[i].index;
+        dest[i].position = beaconsSignal[i].position;
+        dest[i].power = beaconsSignal[i].rssi;
+        dest[i].rangeTable = __atomic_load_n(&publishedRangeTables[beaconsSignal[i].index], __ATOMIC_ACQUIRE);
+        dest[i].coefficientAverage = dest[i].rangeTable->coefficient;
+        dest[i].timestamp = beaconsSignal[i].timestamp;
+        dest[i].rssiVariance = beaconsSignal[i].rssiVariance;
+    }
+}
+
+static void applyRegulatorLevel(RegulatorLevel level) {
+    RegulatorSetting setting;
+    ReceiverScanConfiguration scanConfiguration = fullScanConfiguration;
+
+    if (level == regulatorLevel) {
+        return;
+    }
 
-        dest[i] = data;
+    Regulator_getSetting(level, &setting);
+    scanConfiguration.window = (uint16_t) ((uint32_t) fullScanConfiguration.window * setting.scanWindowPercent / 100);
+    if (scanConfiguration.window < RECEIVER_SCAN_TIME_MIN) {
+        scanConfiguration.window = RECEIVER_SCAN_TIME_MIN;
     }
+
+    ERROR(Receiver_setScanConfiguration(&scanConfiguration) < 0, "[Scanner] Fail to change the scan window");
+    Watchdog_setDelay(wtd_TMaj, setting.updatePeriod * 1000);
+    regulatorLevel = level;
+
+    LOG("[Scanner] Duty cycle level %d: scan window %d%%, position every %d ms%s", level, setting.scanWindowPercent, setting.updatePeriod, "\n");
 }
 
-static void sortBeaconsCoefficientId(BeaconCoefficients* beaconsCoefficients) {
-    TRACE("[Scanner] sortCoefficient%s", "\n");
-    uint32_t index_beaconCoef;
-    uint32_t index_beaconsIds = 0;
-    uint32_t j;
-    bool idFind;
-    for (index_beaconCoef = 0; index_beaconCoef < nbBeaconsCoefficients; index_beaconCoef++) {
-        if (index_beaconCoef == 0) {
-            beaconsIds[index_beaconsIds] = beaconsCoefficients[index_beaconCoef].beaconId[2];
-            index_beaconsIds++;
-        } else {
-            idFind = true;
-            for (j = 0; j < nbBeaconsAvailable; j++) {
-                if (beaconsCoefficients[index_beaconCoef].beaconId[2] != beaconsIds[j]) {
-                    idFind = false;
-                }
+static void selectStrongestBeacons(BeaconData* beaconsData, uint32_t nbBeacons) {
+    if (nbBeacons > NB_BEACONS_SENT_MAX) {
+        partitionStrongestBeacons(beaconsData, nbBeacons, NB_BEACONS_SENT_MAX);
+        nbBeacons = NB_BEACONS_SENT_MAX;
+    }
+
+    for (uint32_t rank = 0; rank < NB_BEACONS_MIN_POSITION && rank < nbBeacons; rank++) {
+        uint32_t strongest = rank;
+        for (uint32_t i = rank + 1; i < nbBeacons; i++) {
+            if (beaconsData[i].power > beaconsData[strongest].power) {
+                strongest = i;
             }
-            if (idFind == false) {
-                beaconsIds[index_beaconsIds] = beaconsCoefficients[index_beaconCoef].beaconId[2];
-                index_beaconsIds++;
+        }
+        swapBeaconsData(beaconsData, rank, strongest);
+    }
+}
+
+static void partitionStrongestBeacons(BeaconData* beaconsData, uint32_t nbBeacons, uint32_t nbStrongest) {
+    uint32_t begin = 0;
+    uint32_t end = nbBeacons;
+    uint32_t last = nbStrongest - 1;
+
+    /* Partition en trois parts : les RSSI entiers sont souvent egaux, ils ne degradent pas la selection */
+    while (end - begin > 1) {
+        Power pivot = beaconsData[begin + (end - begin) / 2].power;
+        uint32_t stronger = begin;
+        uint32_t weaker = end;
+        uint32_t i = begin;
+
+        while (i < weaker) {
+            if (beaconsData[i].power > pivot) {
+                swapBeaconsData(beaconsData, stronger++, i++);
+            } else if (beaconsData[i].power < pivot) {
+                swapBeaconsData(beaconsData, i, --weaker);
+            } else {
+                i++;
             }
         }
+
+        if (last < stronger) {
+            end = stronger;
+        } else if (last >= weaker) {
+            begin = weaker;
+        } else {
+            return;
+        }
+    }
+}
+
+static void swapBeaconsData(BeaconData* beaconsData, uint32_t first, uint32_t second) {
+    BeaconData beaconData = beaconsData[first];
+    beaconsData[first] = beaconsData[second];
+    beaconsData[second] = beaconData;
+}
+
+static int8_t computeCurrentPosition() {
+    MathematicianSolveReport report = { .converged = false };
+    Position position = currentPosition;
+
+    if (Fingerprint_getCurrentPosition(beaconsData, nbBeaconsAvailable, &currentPosition) == 0) {
+        return 0;
+    }
+
+    if (ParticleFilter_isEnabled()) {
+        return ParticleFilter_getCurrentPosition(beaconsData, nbBeaconsAvailable, &currentPosition);
+    }
+
+    if (currentPositionCaptureTime == 0 || Mathematician_refineCurrentPosition(beaconsData, nbBeaconsAvailable, &position, &report) < 0 || !report.converged) {
+        if (Mathematician_getCurrentPosition(beaconsData, nbBeaconsAvailable, &position) < 0) {
+            return -1;
+        }
+        ERROR(Mathematician_refineCurrentPosition(beaconsData, nbBeaconsAvailable, &position, &report) < 0, "[Scanner] Fail to refine the position");
+    }
+
+    TRACE("[Scanner] Position refined in %d iteration(s), converged %d, residual %.1f cm%s", report.nbIterations, report.converged, report.residual, "\n");
+    currentPosition = position;
+    return 0;
+}
+
+static void trackReport(const BeaconSignal* report, float rssiVariance) {
+    const RangeTable* rangeTable = __atomic_load_n(&publishedRangeTables[report->index], __ATOMIC_ACQUIRE);
+    BeaconData beaconData = {
+        .index = report->index,
+        .position = report->position,
+        .power = report->rssi,
+        .coefficientAverage = rangeTable->coefficient,
+        .timestamp = report->timestamp,
+        .rssiVariance = rssiVariance,
+        .rangeTable = rangeTable,
+    };
+
+    Tracker_updateRange(&beaconData);
+}
+
+static void publishRangeTable(BeaconIndex index, const AttenuationCoefficient* coefficient) {
+    RangeTable* spare = &rangeTables[2 * index];
+
+    /* Seul le thread de Scanner publie : la table libre est celle que l'etage de fusion ne peut plus lire */
+    if (__atomic_load_n(&publishedRangeTables[index], __ATOMIC_RELAXED) == spare) {
+        spare++;
+    }
+    Mathematician_fillRangeTable(coefficient, spare);
+    __atomic_store_n(&publishedRangeTables[index], spare, __ATOMIC_RELEASE);
+}
+
+static uint32_t groupBeaconsCoefficients() {
+    uint32_t nbCalibrationData = 0;
+    uint32_t i;
+
+    /* Premier passage : une entree par balise et le nombre de ses coefficients */
+    for (i = 0; i < nbBeaconsCoefficients; i++) {
+        BeaconIndex index = beaconsCoefficients[i].beaconIndex;
+        if (calibrationSlot[index] == CALIBRATION_NONE) {
+            calibrationSlot[index] = (uint16_t) nbCalibrationData;
+            calibrationData[nbCalibrationData].beaconIndex = index;
+            calibrationData[nbCalibrationData].nbCoefficient = 0;
+            nbCalibrationData++;
+        }
+        calibrationData[calibrationSlot[index]].nbCoefficient++;
+    }
+
+    BeaconCoefficients* nextCoefficients = calibrationCoefficients;
+    for (i = 0; i < nbCalibrationData; i++) {
+        calibrationData[i].beaconCoefficient = nextCoefficients;
+        nextCoefficients += calibrationData[i].nbCoefficient;
+        calibrationData[i].nbCoefficient = 0;
     }
+
+    /* Second passage : chaque coefficient rejoint ceux de sa balise */
+    for (i = 0; i < nbBeaconsCoefficients; i++) {
+        uint16_t slot = calibrationSlot[beaconsCoefficients[i].beaconIndex];
+        calibrationData[slot].beaconCoefficient[calibrationData[slot].nbCoefficient++] = beaconsCoefficients[i];
+    }
+
+    for (i = 0; i < nbCalibrationData; i++) {
+        calibrationSlot[calibrationData[i].beaconIndex] = CALIBRATION_NONE;
+    }
+
+    return nbCalibrationData;
 }
 
 
 
 static void perform_setCurrentPosition(MqMsgScanner* msg) {
-    nbBeaconsAvailable = msg->nbBeaconsAvailable;
+    nbBeaconsAvailable = Receiver_getBeaconsSignal(beaconsSignal, beaconsCapacity);
 
-    beaconsData = malloc(nbBeaconsAvailable * sizeof(BeaconData));
+    currentBeaconsDataBuffer = 1 - currentBeaconsDataBuffer;
+    beaconsData = beaconsDataBuffers[currentBeaconsDataBuffer];
 
-    translateBeaconsSignalToBeaconsData(msg->beaconsSignal, beaconsData);
-    Mathematician_getCurrentPosition(beaconsData, nbBeaconsAvailable, &currentPosition);
+    translateBeaconsSignalToBeaconsData(beaconsSignal, beaconsData);
+    if (nbBeaconsAvailable >= NB_BEACONS_MIN_POSITION) {
+        selectStrongestBeacons(beaconsData, nbBeaconsAvailable);
+        if (computeCurrentPosition() < 0) {
+            TRACE("[Scanner] The %d beacons received are aligned, the position is not updated%s", nbBeaconsAvailable, "\n");
+        } else {
+            currentPositionCaptureTime = Mathematician_getCaptureTime(beaconsData, nbBeaconsAvailable);
+            if (trackingPeriod > 0 && Tracker_setPosition(&currentPosition, currentPositionCaptureTime)) {
+                TRACE("[Scanner] Tracker started from X=%d, Y=%d%s", currentPosition.X, currentPosition.Y, "\n");
+            }
+        }
+    } else {
+        TRACE("[Scanner] Only %d beacon(s) received, the position is not updated%s", nbBeaconsAvailable, "\n");
+    }
     Bookkeeper_ask4CurrentProcessorAndMemoryLoad();
 
 }
@@ -348,53 +640,54 @@ static void perform_setCurrentPosition(MqMsgScanner* msg) {
 static void perform_setCurrentProcessorAndMemoryLoad(MqMsgScanner* msg) {
     currentProcessorAndMemoryLoad = msg->currentProcessorAndMemoryLoad;
 
-    Geographer_dateAndSendData(beaconsData, nbBeaconsAvailable, &(currentPosition), &(currentProcessorAndMemoryLoad));
+    /* selectStrongestBeacons a regroupe en tete les plus fortes : ce sont elles qui sont envoyees si toutes ne tiennent pas dans la trame */
+    uint8_t nbBeaconsSent = nbBeaconsAvailable > NB_BEACONS_SENT_MAX ? NB_BEACONS_SENT_MAX : (uint8_t) nbBeaconsAvailable;
+
+    BeaconStatistics* beaconsStatistics = beaconsStatisticsBuffers[currentBeaconsDataBuffer];
+    uint8_t nbBeaconsStatistics = (uint8_t) Receiver_getBeaconsStatistics(beaconsStatistics, NB_BEACONS_SENT_MAX);
+
+    Geographer_dateAndSendData(beaconsData, nbBeaconsSent, beaconsStatistics, nbBeaconsStatistics, &(currentPosition), currentPositionCaptureTime, &(currentProcessorAndMemoryLoad));
+
+    /* Le rythme du cycle suivant depend de l'activite observee pendant celui-ci */
+    applyRegulatorLevel(Regulator_update(&currentPosition, currentPositionCaptureTime, beaconsData, nbBeaconsAvailable, &currentProcessorAndMemoryLoad));
 
     Watchdog_start(wtd_TMaj);
 
 }
 
 static void perform_askCalibrationFromPosition(MqMsgScanner* msg) {
-    if (beaconsCoefficients == NULL) { //on fait ca pour pas redefinir a chaque fois qu'on retourne dans cette methode
-        nbBeaconsCoefficients = 25 * nbBeaconsAvailable;
-        beaconsCoefficients = malloc(nbBeaconsCoefficients * sizeof(BeaconCoefficients)); //TODO TODO TODO METTRE UN DEFINE
-        beaconsCoefficientsindex = 0;
-    }
-
     for (uint32_t index = 0; index < nbBeaconsAvailable; index++) {
+        if (nbBeaconsCoefficients >= maxBeaconsCoefficients) {
+            TRACE("[Scanner] Too many attenuation coefficients, the calibration position %d is incomplete%s", msg->calibrationPosition.id, "\n");
+            break;
+        }
         BeaconCoefficients coef;
-        memcpy(coef.beaconId, beaconsData[index].ID, sizeof(beaconsData[index].ID));
+        coef.beaconIndex = beaconsData[index].index;
         coef.positionId = msg->calibrationPosition.id;
         coef.attenuationCoefficient = Mathematician_getAttenuationCoefficient(&(beaconsData[index].power), &(beaconsData[index].position), &(msg->calibrationPosition));
-        beaconsCoefficients[beaconsCoefficientsindex] = coef;
-        beaconsCoefficientsindex++;
+        beaconsCoefficients[nbBeaconsCoefficients] = coef;
+        nbBeaconsCoefficients++;
+    }
+    if (Fingerprint_isEnabled() && Fingerprint_addReference(&(msg->calibrationPosition.position), beaconsData, nbBeaconsAvailable) < 0) {
+        TRACE("[Scanner] The fingerprint of the calibration position %d is lost%s", msg->calibrationPosition.id, "\n");
     }
     Geographer_signalEndUpdateAttenuation();
 }
 
 static void perform_askCalibrationAverage(MqMsgScanner* msg) {
-    sortBeaconsCoefficientId(beaconsCoefficients);
-    for (uint32_t index_balise = 0; index_balise < nbBeaconsAvailable; index_balise++) {
-        CalibrationData cd;
-        uint32_t index_coef = 0;
-        for (uint32_t j = 0; j < nbBeaconsCoefficients; j++) {
-            if (beaconsCoefficients[j].beaconId[2] == beaconsIds[index_balise]) {
-                index_coef++;
-            }
-        }
+    uint32_t nbCalibrationData = groupBeaconsCoefficients();
 
-        BeaconCoefficients* coef = calloc(1, index_coef);
+    for (uint32_t i = 0; i < nbCalibrationData; i++) {
+        calibrationData[i].coefficientAverage = Mathematician_getAverageCalcul(calibrationData[i].beaconCoefficient, calibrationData[i].nbCoefficient);
+        publishRangeTable(calibrationData[i].beaconIndex, &(calibrationData[i].coefficientAverage));
+    }
 
-        for (uint32_t j = 0; j < nbBeaconsCoefficients; j++) {
-            if (beaconsCoefficients[j].beaconId[2] == beaconsIds[index_balise]) {
-                coef[j] = beaconsCoefficients[j];
-                memcpy(cd.beaconId, beaconsCoefficients[j].beaconId, sizeof(beaconsCoefficients[j].beaconId));
-            }
-        }
+    nbBeaconsCoefficients = 0;
+    if (Fingerprint_isEnabled() && Fingerprint_build() < 0) {
+        TRACE("[Scanner] No fingerprint recorded, the radio map is not built%s", "\n");
     }
-    free(beaconsCoefficients);
-    beaconsCoefficients = NULL;
-    Geographer_signalEndAverageCalcul(calibrationData, nbBeaconsAvailable * sizeof(calibrationData)); //TODO
+    /* Toutes les balises ont leur table, seules les premieres tiennent dans la trame envoyee a GEOMOBILE */
+    Geographer_signalEndAverageCalcul(calibrationData, nbCalibrationData > NB_BEACONS_SENT_MAX ? NB_BEACONS_SENT_MAX : (uint8_t) nbCalibrationData);
 }
 static void perform_askCalibrationFromPositionTimer(MqMsgScanner* msg) {
     Watchdog_cancel(wtd_TMaj);
@@ -408,17 +701,26 @@ static void perform_askCalibrationAverageTimer(MqMsgScanner* msg) {
 }
 
 
+static void perform_publishTrack() {
+    struct timespec now;
+    TrackerState trackerState;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (Tracker_getState((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec, &trackerState) == 0) {
+        Geographer_sendTrackedPosition(&trackerState.position, trackerState.timestamp);
+    }
+
+    Watchdog_start(wtd_TTrack);
+}
+
 static void perform_stop() {
     Watchdog_cancel(wtd_TMaj);
+    Watchdog_cancel(wtd_TTrack);
+    Receiver_setReportListener(NULL);
     Receiver_ask4StopReceiver();
     Bookkeeper_askStopBookkeeper();
 }
 
-static void perform_askBeaconsSignal() {
-    Receiver_ask4BeaconsSignal();
-
-}
-
 static void scanner_performAction(Action_SCANNER action, MqMsgScanner* msg) {
     switch (action) {
         case A_NOP:
@@ -434,10 +736,6 @@ static void scanner_performAction(Action_SCANNER action, MqMsgScanner* msg) {
         case A_STOP:
             perform_stop();
             break;
-        case A_ASK_BEACONS_SIGNAL:
-            perform_askBeaconsSignal();
-            break;
-
         case A_SET_CURRENT_POSITION:
             perform_setCurrentPosition(msg);
             break;
@@ -454,6 +752,10 @@ static void scanner_performAction(Action_SCANNER action, MqMsgScanner* msg) {
             perform_askCalibrationAverage(msg);
             break;
 
+        case A_PUBLISH_TRACK:
+            perform_publishTrack();
+            break;
+
         default:
             break;
     }
@@ -478,6 +780,17 @@ void __real_ScannerTime_out()
     sendMsg(&msg);
 }
 
+/**
+ * @fn static void ScannerTrack_out()
+ * @brief fonction de callback du watchdog wtd_TTrack
+*/
+static void ScannerTrack_out() {
+    MqMsgScanner msg = {
+        .event = E_PUBLISH_TRACK
+    };
+    sendMsg(&msg);
+}
+
 #ifndef _TESTING_MODE
 static void Scanner_transitionFct(MqMsgScanner msg)
 #else                                           //cas ou l'on teste
@@ -526,30 +839,102 @@ static void* run() {
 extern void Scanner_new() {
     mqInit();
     wtd_TMaj = Watchdog_construct(1 * 1000 * 1000, &(ScannerTime_out));
+    wtd_TTrack = Watchdog_construct(1 * 1000 * 1000, &(ScannerTrack_out));
     Receiver_new();
     Bookkeeper_new();
 
-    beaconsCoefficients = malloc(sizeof(beaconsCoefficients[25]));
-    beaconsSignal = malloc(sizeof(beaconsSignal[3]));
-    calibrationData = malloc(sizeof(CalibrationData[25]));
+    beaconsCapacity = BeaconRegistry_getCapacity();
+    maxBeaconsCoefficients = NB_CALIBRATION_POSITION * (uint32_t) beaconsCapacity;
+    beaconsDataBuffers[0] = calloc(beaconsCapacity, sizeof(BeaconData));
+    beaconsDataBuffers[1] = calloc(beaconsCapacity, sizeof(BeaconData));
+    beaconsStatisticsBuffers[0] = calloc(NB_BEACONS_SENT_MAX, sizeof(BeaconStatistics));
+    beaconsStatisticsBuffers[1] = calloc(NB_BEACONS_SENT_MAX, sizeof(BeaconStatistics));
+    beaconsSignal = calloc(beaconsCapacity, sizeof(BeaconSignal));
+    beaconsCoefficients = calloc(maxBeaconsCoefficients, sizeof(BeaconCoefficients));
+    calibrationData = calloc(beaconsCapacity, sizeof(CalibrationData));
+    calibrationCoefficients = calloc(maxBeaconsCoefficients, sizeof(BeaconCoefficients));
+    calibrationSlot = malloc(beaconsCapacity * sizeof(uint16_t));
+    rangeTables = malloc(2 * beaconsCapacity * sizeof(RangeTable));
+    publishedRangeTables = malloc(beaconsCapacity * sizeof(RangeTable*));
+
+    if (beaconsDataBuffers[0] == NULL || beaconsDataBuffers[1] == NULL || beaconsStatisticsBuffers[0] == NULL || beaconsStatisticsBuffers[1] == NULL || beaconsSignal == NULL || beaconsCoefficients == NULL
+        || calibrationData == NULL || calibrationCoefficients == NULL || calibrationSlot == NULL
+        || rangeTables == NULL || publishedRangeTables == NULL) {
+        ERROR(true, "[Scanner] Fail to allocate the beacons tables");
+        beaconsCapacity = 0;
+        maxBeaconsCoefficients = 0;
+        return;
+    }
 
+    ERROR(Regulator_new() < 0, "[Scanner] Fail to create the regulator");
+    ERROR(ParticleFilter_new() < 0, "[Scanner] Fail to create the particle filter");
+
+    beaconsData = beaconsDataBuffers[currentBeaconsDataBuffer];
+    nbBeaconsAvailable = 0;
+    nbBeaconsCoefficients = 0;
+    memset(calibrationSlot, 0xFF, beaconsCapacity * sizeof(uint16_t));
+    for (uint32_t i = 0; i < beaconsCapacity; i++) {
+        /* Toutes les balises partent du meme coefficient, la premiere table sert aux suivantes */
+        if (i == 0) {
+            const AttenuationCoefficient coefficient = DEFAULT_COEFFICIENT_AVERAGE;
+            Mathematician_fillRangeTable(&coefficient, &rangeTables[0]);
+        } else {
+            rangeTables[2 * i] = rangeTables[0];
+        }
+        publishedRangeTables[i] = &rangeTables[2 * i];
+    }
 }
 
 
 extern void Scanner_free() {
     myState = S_DEATH;
     Watchdog_destroy(wtd_TMaj);
+    Watchdog_destroy(wtd_TTrack);
     Receiver_free();
     Bookkeeper_free();
+    Regulator_free();
+    ParticleFilter_free();
+    Fingerprint_free();
+
+    free(beaconsDataBuffers[0]);
+    free(beaconsDataBuffers[1]);
+    free(beaconsStatisticsBuffers[0]);
+    free(beaconsStatisticsBuffers[1]);
+    free(beaconsSignal);
+    free(beaconsCoefficients);
+    free(calibrationData);
+    free(calibrationCoefficients);
+    free(calibrationSlot);
+    free(rangeTables);
+    free(publishedRangeTables);
+    beaconsDataBuffers[0] = beaconsDataBuffers[1] = beaconsData = NULL;
+    beaconsStatisticsBuffers[0] = beaconsStatisticsBuffers[1] = NULL;
+    beaconsSignal = NULL;
+    beaconsCoefficients = calibrationCoefficients = NULL;
+    calibrationData = NULL;
+    calibrationSlot = NULL;
+    rangeTables = NULL;
+    publishedRangeTables = NULL;
+    beaconsCapacity = 0;
 }
 
 
 extern void Scanner_ask4StartScanner() {
     myState = S_BEGINNING;
+    Receiver_getScanConfiguration(&fullScanConfiguration);
+    regulatorLevel = REGULATOR_FULL;
     Receiver_ask4StartReceiver();
     Bookkeeper_askStartBookkeeper();
+    if (trackingPeriod > 0) {
+        Tracker_reset();
+        Watchdog_setDelay(wtd_TTrack, trackingPeriod * 1000);
+        Receiver_setReportListener(&trackReport);
+    }
     sleep(1);
     Watchdog_start(wtd_TMaj);
+    if (trackingPeriod > 0) {
+        Watchdog_start(wtd_TTrack);
+    }
     pthread_create(&myThreadMq, NULL, &run, NULL);
 
 }
@@ -583,17 +968,6 @@ extern void Scanner_ask4AverageCalcul() {
 }
 
 
-extern void Scanner_setAllBeaconsSignal(BeaconSignal* beaconsSignal, uint32_t nbBeaconsAvailable) {
-    MqMsgScanner msg = {
-                .event = E_SET_BEACONS_SIGNAL,
-                .beaconsSignal = beaconsSignal,
-                .nbBeaconsAvailable = nbBeaconsAvailable
-    };
-
-    sendMsg(&msg);
-}
-
-
 extern void Scanner_setCurrentProcessorAndMemoryLoad(ProcessorAndMemoryLoad currentPAndMLoad) {
     MqMsgScanner msg = {
                 .event = E_SET_PROCESSOR_AND_MEMORY,
@@ -602,3 +976,7 @@ extern void Scanner_setCurrentProcessorAndMemoryLoad(ProcessorAndMemoryLoad curr
 
     sendMsg(&msg);
 }
+
+extern void Scanner_setTrackingPeriod(uint32_t period) {
+    trackingPeriod = period;
+}
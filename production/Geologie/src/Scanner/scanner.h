@@ -133,21 +133,21 @@ extern void Scanner_ask4UpdateAttenuationCoefficientFromPosition(const Calibrati
 extern void Scanner_ask4AverageCalcul();
 
 /**
- * @fn extern int Scanner_setAllBeaconsSignal(BeaconsSignal beaconsSignal)
- * @brief Envoie les donnée d’émission de toutes les balises détectées.
- * @param beaconsSignal : Id, Position et RSSI d'une balise
+ * @brief Envoie les charges processeur et memoire
+ * @param currentProcessorAndMemoryLoad : charge memoire et processeur
  *
  * @return retourne 1 s'il y a une erreur dans l'execution de la méthode
 */
-
-extern void Scanner_setAllBeaconsSignal(BeaconSignal * beaconsSignal, uint32_t NbBeaconsAvailable);
+extern void Scanner_setCurrentProcessorAndMemoryLoad(ProcessorAndMemoryLoad currentPAndMLoad);
 
 /**
- * @brief Envoie les charges processeur et memoire
- * @param currentProcessorAndMemoryLoad : charge memoire et processeur
+ * @brief Regle la periode d'envoi de la position suivie annonce par annonce par Tracker
  *
- * @return retourne 1 s'il y a une erreur dans l'execution de la méthode
+ * Doit etre appelee avant #Scanner_ask4StartScanner. Le suivi est desactive par defaut : seule la position calculee
+ * a chaque cycle est envoyee.
+ *
+ * @param period la periode d'envoi en milliseconde, 0 pour desactiver le suivi
 */
-extern void Scanner_setCurrentProcessorAndMemoryLoad(ProcessorAndMemoryLoad currentPAndMLoad);
+extern void Scanner_setTrackingPeriod(uint32_t period);
 
 #endif /* SCANNER_H */
@@ -0,0 +1,538 @@
+/**
+ * @file simulator.c
+ *
+ * @brief Simule un champ de balises vu par un robot virtuel suivant un des trajets experimentaux.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "simulator.h"
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+
+#include "../Geographer/geographer.h"
+#include "../MathematicianLOG/mathematicianLOG.h"
+#include "../Receiver/receiver.h"
+#include "../tools.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La marge autour du trajet dans laquelle les balises sont reparties, en centimetre.
+ */
+#define AREA_MARGIN (200)
+
+/**
+ * @brief La taille des donnees d'annonce d'une balise, identique a celle de BalisePy.
+ */
+#define ADVERTISING_DATA_LENGTH (23)
+
+/**
+ * @brief La taille d'un rapport d'advertising dans un evenement, RSSI compris.
+ */
+#define ADVERTISING_REPORT_SIZE (LE_ADVERTISING_INFO_SIZE + ADVERTISING_DATA_LENGTH + 1)
+
+/**
+ * @brief La taille de l'en-tete d'un evenement LE advertising report : type de paquet, code, taille, sous-evenement, nombre de rapports.
+ */
+#define ADVERTISING_EVENT_HEADER_SIZE (HCI_TYPE_LEN + HCI_EVENT_HDR_SIZE + EVT_LE_META_EVENT_SIZE + 1)
+
+/**
+ * @brief Le nombre maximal de rapports regroupes dans un evenement.
+ */
+#define NB_MAX_REPORTS_PER_EVENT ((HCI_MAX_EVENT_SIZE - EVT_LE_META_EVENT_SIZE - 1) / ADVERTISING_REPORT_SIZE)
+
+/**
+ * @brief Le delai aleatoire maximal ajoute a chaque intervalle d'annonce (advDelay de la norme), en nanoseconde.
+ */
+#define ADVERTISING_DELAY_MAX (10000000ULL)
+
+/**
+ * @brief La duree maximale d'une attente, permet de verifier regulierement l'arret de la simulation, en nanoseconde.
+ */
+#define SLEEP_MAX (100000000ULL)
+
+/**
+ * @brief Le retard au dela duquel une balise reprend son rythme d'annonce au lieu de rattraper les annonces manquees, en nanoseconde.
+ */
+#define CATCH_UP_MAX (1000000000ULL)
+
+#define NANOSECOND_PER_SECOND (1000000000ULL)
+
+/**
+ * @brief Les bornes du RSSI representable dans un rapport d'advertising.
+ */
+#define RSSI_MIN (-127)
+#define RSSI_MAX (20)
+
+/**
+ * @brief Les caracteres utilises pour nommer les balises simulees, deux caracteres par balise.
+ */
+static const char NAME_ALPHABET[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+#define NAME_ALPHABET_LENGTH (sizeof(NAME_ALPHABET) - 1)
+
+/**
+ * @brief Une balise simulee.
+ */
+typedef struct {
+    Position position;              /**< La position de la balise. */
+    uint8_t advertisingData[ADVERTISING_DATA_LENGTH];   /**< Les donnees d'annonce, nom et position encodes comme BalisePy. */
+    uint64_t nextAdvertising;       /**< La date de la prochaine annonce depuis le debut de la simulation, en nanoseconde. */
+} SimulatedBeacon;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variables privees
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static SimulatorConfiguration configuration;
+
+static const ExperimentalTraject* traject = NULL;
+
+/**
+ * @brief La longueur du trajet en centimetre.
+ */
+static float trajectLength;
+
+static SimulatedBeacon* beacons = NULL;
+
+/**
+ * @brief La socketpair reliant la simulation a Receiver : 0 est lue par Receiver, 1 est ecrite par la simulation.
+ */
+static int simulatorSocket[2] = {-1, -1};
+
+/**
+ * @brief L'evenement HCI en cours de construction.
+ */
+static uint8_t advertisingEvent[HCI_TYPE_LEN + HCI_MAX_EVENT_SIZE];
+static uint8_t nbReportsInEvent;
+
+/**
+ * @brief L'etat du generateur pseudo-aleatoire du bruit.
+ */
+static uint32_t randomState;
+
+static Position truePosition;
+static pthread_mutex_t truePositionMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_t simulatorThread;
+static volatile bool isRunning = false;
+
+/**
+ * @brief Les statistiques de la simulation.
+ */
+static uint64_t nbReportsSent;
+static uint64_t nbReportsDropped;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le thread de simulation, emet les annonces des balises au fil du temps.
+ *
+ * @param _ Inutilise.
+ */
+static void* run(void* _);
+
+/**
+ * @brief Donne la position sur le trajet apres un parcours en aller-retour.
+ *
+ * @param distance La distance parcourue depuis le debut du trajet en centimetre.
+ * @param position La position atteinte.
+ */
+static void getTrajectPosition(float distance, Position* position);
+
+/**
+ * @brief Repartit les balises en grille sur la zone englobant le trajet et prepare leurs donnees d'annonce.
+ */
+static void placeBeacons(void);
+
+/**
+ * @brief Ajoute le rapport d'advertising d'une balise a l'evenement en cours et l'envoie s'il est plein.
+ *
+ * @param beaconIndex L'indice de la balise.
+ * @param rssi Le RSSI du rapport.
+ */
+static void addAdvertisingReport(uint16_t beaconIndex, int8_t rssi);
+
+/**
+ * @brief Envoie l'evenement en cours a Receiver.
+ */
+static void flushAdvertisingEvent(void);
+
+/**
+ * @brief Calcule le RSSI bruite recu d'une balise.
+ *
+ * @param beacon La balise.
+ * @param position La position du robot.
+ * @return int8_t Le RSSI.
+ */
+static int8_t getRssi(const SimulatedBeacon* beacon, const Position* position);
+
+/**
+ * @brief Tire un nombre pseudo-aleatoire uniforme dans ]0, 1].
+ *
+ * @return float Le nombre tire.
+ */
+static float getUniform(void);
+
+/**
+ * @brief Tire un nombre pseudo-aleatoire de loi normale centree reduite.
+ *
+ * @return float Le nombre tire.
+ */
+static float getGaussian(void);
+
+/**
+ * @brief Donne le temps ecoule depuis une date de reference, en nanoseconde.
+ *
+ * @param startTime La date de reference.
+ * @return uint64_t Le temps ecoule.
+ */
+static uint64_t getElapsedTime(const struct timespec* startTime);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern int8_t Simulator_new(const SimulatorConfiguration* simulatorConfiguration) {
+    int8_t returnError = EXIT_SUCCESS;
+
+    configuration = *simulatorConfiguration;
+
+    traject = Geographer_getExperimentalTraject(configuration.trajectId);
+    if (traject == NULL || traject->nbPosition == 0) {
+        LOG("[Simulator] Unknown experimental traject %d%s", configuration.trajectId, "\n");
+        return -1;
+    }
+
+    if (configuration.nbBeacons == 0 || configuration.nbBeacons > NAME_ALPHABET_LENGTH * NAME_ALPHABET_LENGTH
+        || configuration.advertisingRate <= 0 || configuration.speed < 0 || configuration.noise < 0) {
+        LOG("[Simulator] Invalid configuration%s", "\n");
+        return -1;
+    }
+
+    trajectLength = 0;
+    for (uint8_t i = 1; i < traject->nbPosition; i++) {
+        float dX = (float) traject->traject[i].X - traject->traject[i - 1].X;
+        float dY = (float) traject->traject[i].Y - traject->traject[i - 1].Y;
+        trajectLength += sqrtf(dX * dX + dY * dY);
+    }
+
+    beacons = calloc(configuration.nbBeacons, sizeof(SimulatedBeacon));
+    if (beacons == NULL) {
+        ERROR(true, "[Simulator] Fail to allocate the beacons");
+        return -1;
+    }
+    placeBeacons();
+
+    randomState = configuration.seed != 0 ? configuration.seed : 1;
+    nbReportsSent = 0;
+    nbReportsDropped = 0;
+    getTrajectPosition(0, &truePosition);
+
+    returnError = socketpair(AF_UNIX, SOCK_SEQPACKET, 0, simulatorSocket);
+    ERROR(returnError < 0, "[Simulator] Fail to create the socketpair");
+
+    if (returnError < 0) {
+        free(beacons);
+        beacons = NULL;
+    } else {
+        Receiver_setHciSocket(simulatorSocket[0]);
+    }
+
+    return returnError;
+}
+
+extern int8_t Simulator_free(void) {
+    Receiver_setHciSocket(-1);
+
+    for (int i = 0; i < 2; i++) {
+        if (simulatorSocket[i] >= 0) {
+            close(simulatorSocket[i]);
+            simulatorSocket[i] = -1;
+        }
+    }
+
+    free(beacons);
+    beacons = NULL;
+
+    return 0;
+}
+
+extern int8_t Simulator_start(void) {
+    int8_t returnError = EXIT_SUCCESS;
+
+    isRunning = true;
+    returnError = pthread_create(&simulatorThread, NULL, &run, NULL);
+    ERROR(returnError != 0, "[Simulator] Fail to create the thread");
+
+    if (returnError != 0) {
+        isRunning = false;
+        returnError = -1;
+    }
+
+    return returnError;
+}
+
+extern int8_t Simulator_stop(void) {
+    int8_t returnError = EXIT_SUCCESS;
+
+    if (isRunning) {
+        isRunning = false;
+        returnError = pthread_join(simulatorThread, NULL);
+        ERROR(returnError != 0, "[Simulator] Fail to join the thread");
+
+        LOG("[Simulator] %llu advertising reports sent, %llu dropped%s",
+            (unsigned long long) nbReportsSent, (unsigned long long) nbReportsDropped, "\n");
+    }
+
+    return returnError != 0 ? -1 : 0;
+}
+
+extern void Simulator_getTruePosition(Position* position) {
+    pthread_mutex_lock(&truePositionMutex);
+    *position = truePosition;
+    pthread_mutex_unlock(&truePositionMutex);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions privees
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void* run(void* _) {
+    struct timespec startTime;
+    uint64_t advertisingInterval = (uint64_t) (NANOSECOND_PER_SECOND / configuration.advertisingRate);
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+    /* Les balises ne sont pas synchronisees entre elles */
+    for (uint16_t i = 0; i < configuration.nbBeacons; i++) {
+        beacons[i].nextAdvertising = (uint64_t) (getUniform() * advertisingInterval);
+    }
+
+    while (isRunning) {
+        uint64_t now = getElapsedTime(&startTime);
+        uint64_t nextWakeUp = now + SLEEP_MAX;
+        Position position;
+
+        getTrajectPosition(configuration.speed * now / NANOSECOND_PER_SECOND, &position);
+        pthread_mutex_lock(&truePositionMutex);
+        truePosition = position;
+        pthread_mutex_unlock(&truePositionMutex);
+
+        for (uint16_t i = 0; i < configuration.nbBeacons; i++) {
+            SimulatedBeacon* beacon = &beacons[i];
+
+            if (beacon->nextAdvertising <= now) {
+                addAdvertisingReport(i, getRssi(beacon, &position));
+
+                beacon->nextAdvertising += advertisingInterval + (uint64_t) (getUniform() * ADVERTISING_DELAY_MAX);
+                if (beacon->nextAdvertising + CATCH_UP_MAX < now) {
+                    beacon->nextAdvertising = now + advertisingInterval;
+                }
+            }
+
+            if (beacon->nextAdvertising < nextWakeUp) {
+                nextWakeUp = beacon->nextAdvertising;
+            }
+        }
+        flushAdvertisingEvent();
+
+        now = getElapsedTime(&startTime);
+        if (nextWakeUp > now) {
+            struct timespec sleepTime = {
+                .tv_sec = (nextWakeUp - now) / NANOSECOND_PER_SECOND,
+                .tv_nsec = (nextWakeUp - now) % NANOSECOND_PER_SECOND
+            };
+            nanosleep(&sleepTime, NULL);
+        }
+    }
+
+    return NULL;
+}
+
+static void getTrajectPosition(float distance, Position* position) {
+    const Position* points = traject->traject;
+
+    if (traject->nbPosition == 1 || trajectLength <= 0) {
+        *position = points[0];
+        return;
+    }
+
+    /* Aller-retour : le robot fait demi-tour en bout de trajet */
+    distance = fmodf(distance, 2 * trajectLength);
+    if (distance > trajectLength) {
+        distance = 2 * trajectLength - distance;
+    }
+
+    for (uint8_t i = 1; i < traject->nbPosition; i++) {
+        float dX = (float) points[i].X - points[i - 1].X;
+        float dY = (float) points[i].Y - points[i - 1].Y;
+        float segmentLength = sqrtf(dX * dX + dY * dY);
+
+        if (distance <= segmentLength || i == traject->nbPosition - 1) {
+            float ratio = segmentLength > 0 ? fminf(distance / segmentLength, 1) : 0;
+            position->X = (uint32_t) lroundf(points[i - 1].X + ratio * dX);
+            position->Y = (uint32_t) lroundf(points[i - 1].Y + ratio * dY);
+            return;
+        }
+        distance -= segmentLength;
+    }
+}
+
+static void placeBeacons(void) {
+    uint32_t minX = traject->traject[0].X;
+    uint32_t maxX = traject->traject[0].X;
+    uint32_t minY = traject->traject[0].Y;
+    uint32_t maxY = traject->traject[0].Y;
+
+    for (uint8_t i = 1; i < traject->nbPosition; i++) {
+        minX = traject->traject[i].X < minX ? traject->traject[i].X : minX;
+        maxX = traject->traject[i].X > maxX ? traject->traject[i].X : maxX;
+        minY = traject->traject[i].Y < minY ? traject->traject[i].Y : minY;
+        maxY = traject->traject[i].Y > maxY ? traject->traject[i].Y : maxY;
+    }
+    minX = minX > AREA_MARGIN ? minX - AREA_MARGIN : 0;
+    minY = minY > AREA_MARGIN ? minY - AREA_MARGIN : 0;
+    maxX += AREA_MARGIN;
+    maxY += AREA_MARGIN;
+
+    uint16_t nbColumns = (uint16_t) ceilf(sqrtf(configuration.nbBeacons));
+    uint16_t nbRows = (configuration.nbBeacons + nbColumns - 1) / nbColumns;
+
+    for (uint16_t i = 0; i < configuration.nbBeacons; i++) {
+        SimulatedBeacon* beacon = &beacons[i];
+        uint16_t column = i % nbColumns;
+        uint16_t row = i / nbColumns;
+        char name[3];
+
+        beacon->position.X = minX + (nbColumns > 1 ? (maxX - minX) * column / (nbColumns - 1) : (maxX - minX) / 2);
+        beacon->position.Y = minY + (nbRows > 1 ? (maxY - minY) * row / (nbRows - 1) : (maxY - minY) / 2);
+
+        name[0] = NAME_ALPHABET[i / NAME_ALPHABET_LENGTH];
+        name[1] = NAME_ALPHABET[i % NAME_ALPHABET_LENGTH];
+        name[2] = '\0';
+
+        /* Flags, nom complet "<nom>x<X>y<Y>" et UUID 0x181A, comme les annonces de BalisePy */
+        uint8_t header[] = {0x02, 0x01, 0x06, 0x0F, 0x09};
+        uint8_t service[] = {0x03, 0x03, 0x1A, 0x18};
+        char completeName[15];
+        snprintf(completeName, sizeof(completeName), "%.2sx%05uy%05u", name,
+                 (unsigned int) (beacon->position.X % 100000), (unsigned int) (beacon->position.Y % 100000));
+
+        memcpy(beacon->advertisingData, header, sizeof(header));
+        memcpy(beacon->advertisingData + sizeof(header), completeName, 14);
+        memcpy(beacon->advertisingData + sizeof(header) + 14, service, sizeof(service));
+    }
+}
+
+static void addAdvertisingReport(uint16_t beaconIndex, int8_t rssi) {
+    uint8_t* report = advertisingEvent + ADVERTISING_EVENT_HEADER_SIZE + nbReportsInEvent * ADVERTISING_REPORT_SIZE;
+
+    report[0] = 0x00;                               // ADV_IND
+    report[1] = LE_RANDOM_ADDRESS;
+    report[2] = (uint8_t) beaconIndex;              // Adresse statique aleatoire derivee de l'indice
+    report[3] = (uint8_t) (beaconIndex >> 8);
+    memset(report + 4, 0x00, 3);
+    report[7] = 0xC0;
+    report[8] = ADVERTISING_DATA_LENGTH;
+    memcpy(report + 9, beacons[beaconIndex].advertisingData, ADVERTISING_DATA_LENGTH);
+    report[9 + ADVERTISING_DATA_LENGTH] = (uint8_t) rssi;
+
+    nbReportsInEvent++;
+    if (nbReportsInEvent == NB_MAX_REPORTS_PER_EVENT) {
+        flushAdvertisingEvent();
+    }
+}
+
+static void flushAdvertisingEvent(void) {
+    if (nbReportsInEvent == 0) {
+        return;
+    }
+
+    uint16_t size = ADVERTISING_EVENT_HEADER_SIZE + nbReportsInEvent * ADVERTISING_REPORT_SIZE;
+
+    advertisingEvent[0] = HCI_EVENT_PKT;
+    advertisingEvent[1] = EVT_LE_META_EVENT;
+    advertisingEvent[2] = (uint8_t) (size - HCI_TYPE_LEN - HCI_EVENT_HDR_SIZE);
+    advertisingEvent[3] = EVT_LE_ADVERTISING_REPORT;
+    advertisingEvent[4] = nbReportsInEvent;
+
+    /* Comme un controleur dont l'hote ne lit pas assez vite, les rapports sont perdus plutot que de ralentir la simulation */
+    if (send(simulatorSocket[1], advertisingEvent, size, MSG_DONTWAIT) == size) {
+        nbReportsSent += nbReportsInEvent;
+    } else {
+        nbReportsDropped += nbReportsInEvent;
+    }
+
+    nbReportsInEvent = 0;
+}
+
+static int8_t getRssi(const SimulatedBeacon* beacon, const Position* position) {
+    Power power = Mathematician_getPower(&beacon->position, position, &configuration.attenuationCoefficient);
+    long rssi = lroundf(power + configuration.noise * getGaussian());
+
+    if (rssi < RSSI_MIN) {
+        rssi = RSSI_MIN;
+    } else if (rssi > RSSI_MAX) {
+        rssi = RSSI_MAX;
+    }
+
+    return (int8_t) rssi;
+}
+
+static float getUniform(void) {
+    /* xorshift32 */
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    return (randomState >> 8) * (1.0f / 16777216.0f) + (1.0f / 16777216.0f);
+}
+
+static float getGaussian(void) {
+    /* Box-Muller */
+    return sqrtf(-2 * logf(getUniform())) * cosf(2 * (float) M_PI * getUniform());
+}
+
+static uint64_t getElapsedTime(const struct timespec* startTime) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (now.tv_sec - startTime->tv_sec) * NANOSECOND_PER_SECOND + now.tv_nsec - startTime->tv_nsec;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file simulator.h
+ *
+ * @brief Simule un champ de balises vu par un robot virtuel suivant un des trajets experimentaux.
+ *
+ * Le robot parcourt le trajet choisi en aller-retour a vitesse constante. Chaque balise emet ses annonces au
+ * rythme demande avec un RSSI tire du modele d'attenuation de MathematicianLOG, bruite. Les annonces sont
+ * regroupees en evenements LE advertising report et ecrites dans une socketpair donnee a Receiver, elles suivent
+ * donc le meme traitement que celles du peripherique HCI. La position reelle du robot reste disponible pour
+ * evaluer la position calculee.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+#ifndef SIMULATOR_
+#define SIMULATOR_
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#include "../common.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La configuration de la simulation.
+ */
+typedef struct {
+    ExperimentalTrajectId trajectId;                /**< Le trajet experimental suivi par le robot virtuel. */
+    float speed;                                    /**< La vitesse du robot en cm/s. */
+    uint16_t nbBeacons;                             /**< Le nombre de balises reparties en grille autour du trajet. */
+    float advertisingRate;                          /**< Le nombre d'annonces par seconde de chaque balise. */
+    float noise;                                    /**< L'ecart type du bruit ajoute au RSSI en dB. */
+    AttenuationCoefficient attenuationCoefficient;  /**< Le coefficient d'attenuation du modele. */
+    uint32_t seed;                                  /**< La graine du bruit, pour rejouer une simulation a l'identique. */
+} SimulatorConfiguration;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initialise Simulator, place les balises et branche la simulation sur Receiver.
+ *
+ * A appeler avant le demarrage de Receiver.
+ *
+ * @param configuration La configuration de la simulation.
+ * @return int8_t -1 en cas d'erreur, 0 sinon.
+ */
+extern int8_t Simulator_new(const SimulatorConfiguration* configuration);
+
+/**
+ * @brief Detruit Simulator.
+ *
+ * @return int8_t -1 en cas d'erreur, 0 sinon.
+ */
+extern int8_t Simulator_free(void);
+
+/**
+ * @brief Demarre l'emission des annonces.
+ *
+ * @return int8_t -1 en cas d'erreur, 0 sinon.
+ */
+extern int8_t Simulator_start(void);
+
+/**
+ * @brief Arrete l'emission des annonces.
+ *
+ * @return int8_t -1 en cas d'erreur, 0 sinon.
+ */
+extern int8_t Simulator_stop(void);
+
+/**
+ * @brief Donne la position reelle du robot virtuel.
+ *
+ * @param position La position du robot.
+ */
+extern void Simulator_getTruePosition(Position* position);
+
+#endif /* SIMULATOR_ */
@@ -0,0 +1,269 @@
+/**
+ * @file tracker.c
+ *
+ * @brief Suit la position du robot annonce par annonce avec un filtre de Kalman a vitesse constante.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tracker.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+
+#include "../MathematicianLOG/mathematicianLOG.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La taille de l'etat : la position puis la vitesse, sur les deux axes.
+ */
+#define STATE_SIZE (4)
+
+/**
+ * @brief L'indice de la vitesse d'un axe dans l'etat, a partir de celui de sa position.
+ */
+#define SPEED_OFFSET (2)
+
+/**
+ * @brief La distance au-dessous de laquelle le robot est sur la balise, en centimetre : la direction de la
+ * distance n'y est pas definie.
+ */
+#define DISTANCE_DIRECTION_MIN (1.0)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le mutex qui protege l'etat suivi.
+ */
+static pthread_mutex_t trackerMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Vrai si le filtre a une position de depart.
+ */
+static bool isInitialized = false;
+
+/**
+ * @brief L'etat suivi, X, Y, vitesse en X, vitesse en Y, en centimetre et centimetre par seconde.
+ */
+static double state[STATE_SIZE];
+
+/**
+ * @brief La covariance de #state.
+ */
+static double covariance[STATE_SIZE][STATE_SIZE];
+
+/**
+ * @brief La date de #state sur l'horloge monotone, en nanoseconde.
+ */
+static uint64_t stateTime = 0;
+
+/**
+ * @brief La date de la derniere annonce acceptee ou de la position de depart, en nanoseconde.
+ */
+static uint64_t lastAcceptedTime = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Predit un etat et sa covariance avec le modele a vitesse constante.
+ *
+ * La covariance est F P F^T + Q, ou Q est le bruit d'une acceleration blanche de densite #TRACKER_ACCELERATION_NOISE.
+ *
+ * @param predictedState L'etat a predire.
+ * @param predictedCovariance La covariance de l'etat a predire.
+ * @param duration La duree de la prediction, en seconde, sans effet si elle n'est pas positive.
+ */
+static void predict(double predictedState[STATE_SIZE], double predictedCovariance[STATE_SIZE][STATE_SIZE], double duration);
+
+/**
+ * @brief Arrondit une coordonnee au centimetre, une coordonnee negative est ramenee a 0.
+ *
+ * @param coordinate La coordonnee en centimetre.
+ * @return uint32_t La coordonnee arrondie.
+ */
+static uint32_t roundCoordinate(double coordinate);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void Tracker_reset() {
+    pthread_mutex_lock(&trackerMutex);
+    isInitialized = false;
+    stateTime = 0;
+    lastAcceptedTime = 0;
+    pthread_mutex_unlock(&trackerMutex);
+}
+
+extern bool Tracker_setPosition(const Position* position, uint64_t timestamp) {
+    bool isReset;
+
+    pthread_mutex_lock(&trackerMutex);
+    isReset = !isInitialized || timestamp > lastAcceptedTime + (uint64_t) TRACKER_TIMEOUT * 1000000ULL;
+    if (isReset) {
+        memset(state, 0, sizeof(state));
+        memset(covariance, 0, sizeof(covariance));
+        state[0] = position->X;
+        state[1] = position->Y;
+        for (int axis = 0; axis < SPEED_OFFSET; axis++) {
+            covariance[axis][axis] = TRACKER_POSITION_VARIANCE_INITIAL;
+            covariance[axis + SPEED_OFFSET][axis + SPEED_OFFSET] = TRACKER_SPEED_VARIANCE_INITIAL;
+        }
+        stateTime = timestamp;
+        lastAcceptedTime = timestamp;
+        isInitialized = true;
+    }
+    pthread_mutex_unlock(&trackerMutex);
+
+    return isReset;
+}
+
+extern int8_t Tracker_updateRange(const BeaconData* beaconData) {
+    float distance;
+    float distanceVariance;
+    double crossCovariance[STATE_SIZE];
+    int8_t returnError = 0;
+
+    if (Mathematician_getRange(beaconData, &distance, &distanceVariance) < 0) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&trackerMutex);
+    if (!isInitialized) {
+        pthread_mutex_unlock(&trackerMutex);
+        return -1;
+    }
+
+    if (beaconData->timestamp > stateTime) {
+        predict(state, covariance, (beaconData->timestamp - stateTime) / 1e9);
+        stateTime = beaconData->timestamp;
+    }
+
+    double dx = state[0] - beaconData->position.X;
+    double dy = state[1] - beaconData->position.Y;
+    double predictedDistance = sqrt(dx * dx + dy * dy);
+
+    if (predictedDistance < DISTANCE_DIRECTION_MIN) {
+        returnError = -1;
+    } else {
+        /* H = [dx / d, dy / d, 0, 0] : seules les deux premieres colonnes de la covariance servent */
+        double directionX = dx / predictedDistance;
+        double directionY = dy / predictedDistance;
+        double innovation = distance - predictedDistance;
+
+        for (int i = 0; i < STATE_SIZE; i++) {
+            crossCovariance[i] = covariance[i][0] * directionX + covariance[i][1] * directionY;
+        }
+        double innovationVariance = crossCovariance[0] * directionX + crossCovariance[1] * directionY + distanceVariance;
+
+        if (!(innovation * innovation <= TRACKER_INNOVATION_GATE * innovationVariance)) {
+            returnError = -1;
+        } else {
+            for (int i = 0; i < STATE_SIZE; i++) {
+                state[i] += crossCovariance[i] / innovationVariance * innovation;
+            }
+            /* P = P - K S K^T avec K = P H^T / S, symetrique par construction */
+            for (int i = 0; i < STATE_SIZE; i++) {
+                for (int j = 0; j < STATE_SIZE; j++) {
+                    covariance[i][j] -= crossCovariance[i] * crossCovariance[j] / innovationVariance;
+                }
+            }
+            lastAcceptedTime = beaconData->timestamp > lastAcceptedTime ? beaconData->timestamp : lastAcceptedTime;
+        }
+    }
+    pthread_mutex_unlock(&trackerMutex);
+
+    return returnError;
+}
+
+extern int8_t Tracker_getState(uint64_t timestamp, TrackerState* trackerState) {
+    double predictedState[STATE_SIZE];
+    double predictedCovariance[STATE_SIZE][STATE_SIZE];
+
+    pthread_mutex_lock(&trackerMutex);
+    if (!isInitialized) {
+        pthread_mutex_unlock(&trackerMutex);
+        return -1;
+    }
+    memcpy(predictedState, state, sizeof(state));
+    memcpy(predictedCovariance, covariance, sizeof(covariance));
+    trackerState->timestamp = lastAcceptedTime;
+    if (timestamp > stateTime) {
+        predict(predictedState, predictedCovariance, (timestamp - stateTime) / 1e9);
+    }
+    pthread_mutex_unlock(&trackerMutex);
+
+    trackerState->position.X = roundCoordinate(predictedState[0]);
+    trackerState->position.Y = roundCoordinate(predictedState[1]);
+    trackerState->speedX = (float) predictedState[SPEED_OFFSET];
+    trackerState->speedY = (float) predictedState[SPEED_OFFSET + 1];
+    trackerState->positionVariance = (float) ((predictedCovariance[0][0] + predictedCovariance[1][1]) / 2);
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void predict(double predictedState[STATE_SIZE], double predictedCovariance[STATE_SIZE][STATE_SIZE], double duration) {
+    double transitioned[STATE_SIZE][STATE_SIZE];
+
+    if (duration <= 0) {
+        return;
+    }
+
+    for (int axis = 0; axis < SPEED_OFFSET; axis++) {
+        predictedState[axis] += duration * predictedState[axis + SPEED_OFFSET];
+    }
+
+    /* F P : chaque ligne de position recoit la ligne de sa vitesse, puis (F P) F^T sur les colonnes */
+    for (int i = 0; i < STATE_SIZE; i++) {
+        for (int j = 0; j < STATE_SIZE; j++) {
+            transitioned[i][j] = predictedCovariance[i][j] + (i < SPEED_OFFSET ? duration * predictedCovariance[i + SPEED_OFFSET][j] : 0);
+        }
+    }
+    for (int i = 0; i < STATE_SIZE; i++) {
+        for (int j = 0; j < STATE_SIZE; j++) {
+            predictedCovariance[i][j] = transitioned[i][j] + (j < SPEED_OFFSET ? duration * transitioned[i][j + SPEED_OFFSET] : 0);
+        }
+    }
+
+    for (int axis = 0; axis < SPEED_OFFSET; axis++) {
+        predictedCovariance[axis][axis] += TRACKER_ACCELERATION_NOISE * duration * duration * duration / 3;
+        predictedCovariance[axis][axis + SPEED_OFFSET] += TRACKER_ACCELERATION_NOISE * duration * duration / 2;
+        predictedCovariance[axis + SPEED_OFFSET][axis] += TRACKER_ACCELERATION_NOISE * duration * duration / 2;
+        predictedCovariance[axis + SPEED_OFFSET][axis + SPEED_OFFSET] += TRACKER_ACCELERATION_NOISE * duration;
+    }
+}
+
+static uint32_t roundCoordinate(double coordinate) {
+    coordinate = round(coordinate);
+    return coordinate > 0 ? (uint32_t) coordinate : 0;
+}
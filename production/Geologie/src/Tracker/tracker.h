@@ -0,0 +1,127 @@
+/**
+ * @file tracker.h
+ *
+ * @brief Suit la position du robot annonce par annonce avec un filtre de Kalman a vitesse constante.
+ *
+ * L'etat suivi est la position et la vitesse du robot. Chaque annonce d'une balise donne une distance par le modele
+ * d'attenuation de Mathematician : l'etat est predit jusqu'a la date de l'annonce puis corrige par une mise a jour
+ * scalaire du filtre de Kalman etendu, sans attendre la fin de la fenetre de scan. Les matrices sont de taille fixe,
+ * aucune mise a jour n'alloue de memoire.
+ *
+ * Les distances seules ne suffisent pas a placer le robot : le filtre part d'une position donnee par
+ * #Tracker_setPosition, celle calculee par Mathematician sur toutes les balises.
+ *
+ * Tracker est protege contre les acces concurrents : il est mis a jour par l'etage de fusion de Receiver et lu par
+ * le thread de Scanner.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+#ifndef TRACKER_
+#define TRACKER_
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../common.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La densite spectrale de l'acceleration du robot, en centimetre carre par seconde cube : le bruit de
+ * l'hypothese de vitesse constante.
+ */
+#define TRACKER_ACCELERATION_NOISE (2500)
+
+/**
+ * @brief La variance de la position de depart sur chaque axe, en centimetre carre.
+ */
+#define TRACKER_POSITION_VARIANCE_INITIAL (10000)
+
+/**
+ * @brief La variance de la vitesse de depart sur chaque axe, en centimetre carre par seconde carree.
+ */
+#define TRACKER_SPEED_VARIANCE_INITIAL (2500)
+
+/**
+ * @brief Le seuil sur l'ecart normalise au carre d'une distance, au-dela duquel l'annonce est rejetee (3 ecarts types).
+ */
+#define TRACKER_INNOVATION_GATE (9)
+
+/**
+ * @brief La duree sans annonce acceptee, en milliseconde, apres laquelle #Tracker_setPosition repart de la position donnee.
+ */
+#define TRACKER_TIMEOUT (5000)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief L'etat suivi par Tracker.
+ */
+typedef struct {
+    Position position;          /**< La position du robot. */
+    float speedX;               /**< La vitesse du robot sur l'axe des abscisses, en centimetre par seconde. */
+    float speedY;               /**< La vitesse du robot sur l'axe des ordonnees, en centimetre par seconde. */
+    float positionVariance;     /**< La moyenne des variances de la position sur les deux axes, en centimetre carre. */
+    uint64_t timestamp;         /**< La date de la derniere annonce prise en compte sur l'horloge monotone, en nanoseconde. */
+} TrackerState;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Oublie l'etat suivi, le filtre attend une nouvelle position de depart.
+ */
+extern void Tracker_reset();
+
+/**
+ * @brief Donne une position de depart au filtre, s'il n'en a pas encore ou s'il n'a accepte aucune annonce depuis
+ * #TRACKER_TIMEOUT.
+ *
+ * @param position La position calculee par Mathematician.
+ * @param timestamp La date de capture de la position sur l'horloge monotone, en nanoseconde.
+ * @return bool Vrai si le filtre est reparti de cette position.
+ */
+extern bool Tracker_setPosition(const Position* position, uint64_t timestamp);
+
+/**
+ * @brief Prend en compte la distance donnee par l'annonce d'une balise.
+ *
+ * Une annonce anterieure a l'etat suivi corrige l'etat sans le predire en arriere.
+ *
+ * @param beaconData La balise et la puissance de l'annonce, sa date de reception dans timestamp.
+ * @return int8_t 0 si l'etat a ete corrige, -1 si le filtre n'a pas de position de depart, si la distance n'est pas
+ * utilisable ou si elle est rejetee par #TRACKER_INNOVATION_GATE.
+ */
+extern int8_t Tracker_updateRange(const BeaconData* beaconData);
+
+/**
+ * @brief Donne l'etat suivi predit a une date, sans le modifier.
+ *
+ * @param timestamp La date sur l'horloge monotone en nanoseconde, l'etat n'est pas predit si elle est anterieure.
+ * @param state L'etat a remplir, sa date reste celle de la derniere annonce prise en compte.
+ * @return int8_t 0 en cas de succes, -1 si le filtre n'a pas de position de depart.
+ */
+extern int8_t Tracker_getState(uint64_t timestamp, TrackerState* state);
+
+#endif // TRACKER_
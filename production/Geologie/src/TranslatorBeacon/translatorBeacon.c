@@ -22,12 +22,15 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <inttypes.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <arpa/inet.h>
 #include "translatorBeacon.h"
 #include "../Receiver/receiver.h"
+#include "../tools.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -39,14 +42,286 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#define POSITION_LENGTH 5
-#define DEVICE_NAME_FIRST_BYTE 5
+/**
+ * @brief Les types des structures AD (longueur, type, valeur) lues dans les donnees d'annonce.
+ */
+#define AD_TYPE_UUID16_INCOMPLETE 0x02
+#define AD_TYPE_UUID16_COMPLETE 0x03
+#define AD_TYPE_NAME_SHORT 0x08
+#define AD_TYPE_NAME_COMPLETE 0x09
+#define AD_TYPE_TX_POWER 0x0A
+#define AD_TYPE_SERVICE_DATA16 0x16
+#define AD_TYPE_MANUFACTURER_DATA 0xFF
+
+/**
+ * @brief Le nom d'une balise, tel qu'emis par BalisePy : son identifiant, puis sa position, par exemple b1x00550y00200.
+ */
 #define DEVICE_NAME_LENGTH 2
-#define DEVICE_POSITION_X_FIRST_BYTE 8
-#define DEVICE_POSITION_Y_FIRST_BYTE 14
-#define DEVICE_UUID_FIRST_BYTE 21
+#define POSITION_LENGTH 5
+#define DEVICE_POSITION_X_FIRST_BYTE 3
+#define DEVICE_POSITION_Y_FIRST_BYTE 9
+#define DEVICE_NAME_FULL_LENGTH (DEVICE_POSITION_Y_FIRST_BYTE + POSITION_LENGTH)
+
 #define DEVICE_UUID_LENGTH 2
 
+/**
+ * @brief Les donnees constructeur compactes d'une balise, telles qu'emises par BalisePy, en petit-boutiste : l'identifiant
+ * de societe, la version du format, l'identifiant de la balise, X et Y en centimetre sur 16 bits, la puissance
+ * d'emission calibree en dBm et le numero de sequence.
+ */
+#define COMPACT_COMPANY_ID 0xFFFF
+#define COMPACT_VERSION 0x01
+#define COMPACT_VERSION_BYTE 2
+#define COMPACT_NAME_BYTE 3
+#define COMPACT_POSITION_X_BYTE 5
+#define COMPACT_POSITION_Y_BYTE 7
+#define COMPACT_TX_POWER_BYTE 9
+#define COMPACT_SEQUENCE_BYTE 10
+#define COMPACT_LENGTH 11
+
+/**
+ * @brief Un iBeacon, dans les donnees constructeur d'Apple : le type 0x02 et la taille 0x15 des donnees qui suivent,
+ * l'UUID, le major et le minor en gros-boutiste, puis la puissance mesuree a 1 m en dBm.
+ */
+#define IBEACON_COMPANY_ID 0x004C
+#define IBEACON_TYPE 0x02
+#define IBEACON_DATA_SIZE 0x15
+#define IBEACON_TYPE_BYTE 2
+#define IBEACON_DATA_SIZE_BYTE 3
+#define IBEACON_IDENTIFIER_BYTE 4
+#define IBEACON_TX_POWER_BYTE 24
+#define IBEACON_LENGTH 25
+
+/**
+ * @brief Une trame UID d'Eddystone, dans les donnees du service 0xFEAA : le type de trame 0x00, la puissance calibree
+ * a 0 m en dBm, l'espace de noms sur 10 octets et l'instance sur 6.
+ */
+#define EDDYSTONE_UUID 0xFEAA
+#define EDDYSTONE_FRAME_UID 0x00
+#define EDDYSTONE_FRAME_TYPE_BYTE 2
+#define EDDYSTONE_TX_POWER_BYTE 3
+#define EDDYSTONE_IDENTIFIER_BYTE 4
+#define EDDYSTONE_IDENTIFIER_LENGTH 16
+#define EDDYSTONE_LENGTH 20
+
+/**
+ * @brief Le nombre d'alveoles de la table de hachage des balises tierces, une puissance de 2 double du nombre maximal.
+ */
+#define THIRD_PARTY_NB_BUCKETS (2 * TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY)
+
+/**
+ * @brief La taille maximale d'une ligne du fichier des balises tierces.
+ */
+#define THIRD_PARTY_LINE_LENGTH 128
+
+/**
+ * @brief Le RSSI d'un rapport d'annonce etendue quand le controleur ne l'a pas mesure.
+ */
+#define RSSI_UNAVAILABLE 127
+
+/**
+ * @brief L'etat des donnees dans le type d'un rapport d'annonce etendue, 0 si les donnees sont completes.
+ */
+#define EXTENDED_DATA_STATUS_MASK 0x0060
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+
+//                                              Prototypes de fonctions
+
+//
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @fn static void translateAdvertisingData(const uint8_t * data, uint8_t length, BeaconsSignalBatch * batch, uint8_t index)
+ * @brief Parcourt les structures AD des donnees d'annonce et en extrait l'identifiant, la position, le premier UUID
+ * de service 16 bits, la puissance d'emission et le numero de sequence de la balise
+ *
+ * Les donnees sont lues en place, qu'elles viennent d'une annonce classique ou etendue, et l'ordre des structures
+ * est indifferent. Les donnees constructeur compactes sont lues a position fixe et priment sur le nom, qui reste
+ * lu pour les balises qui n'emettent que le format texte. Une annonce sans l'un ni l'autre n'est pas celle d'une
+ * balise : son UUID est laisse a 0 pour qu'elle soit ecartee.
+ *
+ * @param data les donnees d'annonce
+ * @param length la taille des donnees
+ * @param batch le lot a remplir, hors RSSI
+ * @param index l'indice de l'element a remplir
+ */
+static void translateAdvertisingData(const uint8_t * data, uint8_t length, BeaconsSignalBatch * batch, uint8_t index);
+
+/**
+ * @fn static uint16_t translateReport(const uint8_t * report, const uint8_t * end, bool isExtended, BeaconsSignalBatch * batch, uint8_t index)
+ * @brief Traduit un rapport d'annonce, classique ou etendu, dans l'element d'indice index du lot
+ *
+ * Un fragment d'annonce etendue ou un rapport sans RSSI est rendu avec un UUID nul.
+ *
+ * @param report le debut du rapport
+ * @param end la fin des rapports
+ * @param isExtended vrai pour un rapport d'un LE Extended Advertising Report
+ * @param batch le lot a remplir
+ * @param index l'indice de l'element a remplir
+ * @return la taille du rapport, 0 s'il depasse la fin des rapports
+ */
+static uint16_t translateReport(const uint8_t * report, const uint8_t * end, bool isExtended, BeaconsSignalBatch * batch, uint8_t index);
+
+/**
+ * @fn static void translateOne(const uint8_t * report, bool isExtended, BeaconSignal * bs)
+ * @brief Traduit un rapport d'annonce seul dans un #BeaconSignal
+ *
+ * @param report le rapport
+ * @param isExtended vrai pour un rapport d'un LE Extended Advertising Report
+ * @param bs le signal a remplir
+ */
+static void translateOne(const uint8_t * report, bool isExtended, BeaconSignal * bs);
+
+/**
+ * @fn static uint32_t parseCoordinate(const uint8_t * digits, uint32_t * isInvalid)
+ * @brief Convertit les #POSITION_LENGTH chiffres ASCII d'une coordonnee, sans branchement par chiffre
+ *
+ * @param digits les chiffres, lus en place
+ * @param isInvalid mis a une valeur non nulle si l'un des caracteres n'est pas un chiffre
+ * @return la coordonnee
+ */
+static uint32_t parseCoordinate(const uint8_t * digits, uint32_t * isInvalid);
+
+/**
+ * @fn static uint32_t isInvalidName(const uint8_t * name)
+ * @brief Verifie que les #DEVICE_NAME_LENGTH caracteres d'un identifiant sont de l'ASCII imprimable, sans espace
+ *
+ * Un identifiant avec un octet nul serait tronque une fois envoye a GEOMOBILE.
+ *
+ * @param name l'identifiant, lu en place
+ * @return une valeur non nulle si l'un des caracteres n'est pas imprimable
+ */
+static uint32_t isInvalidName(const uint8_t * name);
+
+/**
+ * @fn static const BeaconFormat * findFormat(uint8_t adType, uint16_t key)
+ * @brief Cherche le format d'annonce d'une structure AD de donnees constructeur ou de donnees de service
+ *
+ * @param adType le type de la structure AD
+ * @param key l'identifiant de societe ou l'UUID de service qui ouvre sa valeur
+ * @return le format, NULL s'il n'est pas reconnu
+ */
+static const struct BeaconFormat * findFormat(uint8_t adType, uint16_t key);
+
+/**
+ * @fn static bool decodeCompact(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index)
+ * @brief Lit a position fixe les donnees constructeur compactes d'une balise BalisePy
+ *
+ * @param value la valeur de la structure AD, qui commence par l'identifiant de societe
+ * @param length la taille de la valeur
+ * @param batch le lot a remplir
+ * @param index l'indice de l'element a remplir
+ * @return vrai si les donnees sont celles d'une balise
+ */
+static bool decodeCompact(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index);
+
+/**
+ * @fn static bool decodeIBeacon(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index)
+ * @brief Lit un iBeacon et retrouve la balise tierce qui l'emet
+ *
+ * @param value la valeur de la structure AD, qui commence par l'identifiant de societe
+ * @param length la taille de la valeur
+ * @param batch le lot a remplir
+ * @param index l'indice de l'element a remplir
+ * @return vrai si la balise est enregistree
+ */
+static bool decodeIBeacon(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index);
+
+/**
+ * @fn static bool decodeEddystone(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index)
+ * @brief Lit une trame UID d'Eddystone et retrouve la balise tierce qui l'emet
+ *
+ * Les autres trames d'Eddystone (URL, TLM, EID) ne portent pas d'identifiant stable et sont ecartees.
+ *
+ * @param value la valeur de la structure AD, qui commence par l'UUID du service
+ * @param length la taille de la valeur
+ * @param batch le lot a remplir
+ * @param index l'indice de l'element a remplir
+ * @return vrai si la balise est enregistree
+ */
+static bool decodeEddystone(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index);
+
+/**
+ * @fn static bool decodeThirdParty(ThirdPartyFormat format, const uint8_t * identifier, int8_t txPower, BeaconsSignalBatch * batch, uint8_t index)
+ * @brief Remplit l'element du lot avec l'identifiant et la position enregistres d'une balise tierce
+ *
+ * @param format le format emis par la balise
+ * @param identifier l'identifiant emis, de #TRANSLATOR_BEACON_IDENTIFIER_SIZE octets
+ * @param txPower la puissance calibree annoncee
+ * @param batch le lot a remplir
+ * @param index l'indice de l'element a remplir
+ * @return vrai si la balise est enregistree
+ */
+static bool decodeThirdParty(ThirdPartyFormat format, const uint8_t * identifier, int8_t txPower, BeaconsSignalBatch * batch, uint8_t index);
+
+/**
+ * @fn static uint32_t hashIdentifier(ThirdPartyFormat format, const uint8_t * identifier)
+ * @brief Calcule l'alveole de depart d'une balise tierce dans la table de hachage (FNV-1a)
+ *
+ * @param format le format emis par la balise
+ * @param identifier l'identifiant emis
+ * @return l'alveole de depart
+ */
+static uint32_t hashIdentifier(ThirdPartyFormat format, const uint8_t * identifier);
+
+/**
+ * @fn static bool parseHex(const char * text, uint8_t * bytes, uint8_t nbBytes)
+ * @brief Convertit exactement nbBytes octets ecrits en hexadecimal, les tirets etant ignores
+ *
+ * @param text le texte
+ * @param bytes les octets a remplir
+ * @param nbBytes le nombre d'octets attendus
+ * @return vrai si le texte est valide
+ */
+static bool parseHex(const char * text, uint8_t * bytes, uint8_t nbBytes);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+
+//                                              Variable et structure extern
+
+//
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Un format d'annonce reconnu par l'identifiant de societe ou l'UUID de service qui ouvre sa structure AD.
+ */
+typedef struct BeaconFormat {
+	uint8_t adType;		/**< Le type de la structure AD : donnees constructeur ou donnees de service. */
+	uint16_t key;		/**< L'identifiant de societe ou l'UUID de service. */
+	uint16_t uuid;		/**< L'UUID rendu pour le signal, 0 pour garder le premier UUID de service de l'annonce. */
+	bool (*decode)(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index);
+} BeaconFormat;
+
+/**
+ * @brief Les formats d'annonce lus, les balises du commerce n'annoncant pas l'UUID des balises.
+ *
+ * La table a quelques entrees : le choix du format reste en temps constant pour chaque rapport.
+ */
+static const BeaconFormat FORMATS[] = {
+	{ AD_TYPE_MANUFACTURER_DATA, COMPACT_COMPANY_ID, 0, decodeCompact },
+	{ AD_TYPE_MANUFACTURER_DATA, IBEACON_COMPANY_ID, BEACONS_UUID, decodeIBeacon },
+	{ AD_TYPE_SERVICE_DATA16, EDDYSTONE_UUID, BEACONS_UUID, decodeEddystone }
+};
+
+#define NB_FORMATS (sizeof(FORMATS) / sizeof(FORMATS[0]))
+
+/**
+ * @brief Les balises tierces enregistrees.
+ */
+static ThirdPartyBeacon thirdPartyBeacons[TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY];
+static uint8_t nbThirdPartyBeacons = 0;
+
+/**
+ * @brief La table de hachage a adressage ouvert de l'identifiant emis vers l'indice + 1, 0 pour une alveole libre.
+ */
+static uint8_t thirdPartyBuckets[THIRD_PARTY_NB_BUCKETS];
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -63,33 +338,454 @@ extern int TranslatorBeacon_new() {
 }
 
 extern int TranslatorBeacon_free() {
+    nbThirdPartyBeacons = 0;
+    memset(thirdPartyBuckets, 0, sizeof(thirdPartyBuckets));
     return 0;
 }
 
+extern int8_t TranslatorBeacon_addThirdPartyBeacon(const ThirdPartyBeacon * thirdPartyBeacon) {
 
-extern BeaconSignal TranslatorBeacon_translateChannelToBeaconsSignal(BeaconsChannel * info) {
+	uint32_t bucket = hashIdentifier(thirdPartyBeacon->format, thirdPartyBeacon->identifier);
 
-    BeaconSignal bs;
+	while (thirdPartyBuckets[bucket] != 0) {
+		const ThirdPartyBeacon * registered = &thirdPartyBeacons[thirdPartyBuckets[bucket] - 1];
+		if (registered->format == thirdPartyBeacon->format
+			&& memcmp(registered->identifier, thirdPartyBeacon->identifier, TRANSLATOR_BEACON_IDENTIFIER_SIZE) == 0) {
+			LOG("[TranslatorBeacon] The third party beacon %.2s is already registered as %.2s%s", (const char *) thirdPartyBeacon->name, (const char *) registered->name, "\n");
+			return -1;
+		}
+		bucket = (bucket + 1) & (THIRD_PARTY_NB_BUCKETS - 1);
+	}
+
+	if (nbThirdPartyBeacons >= TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY) {
+		LOG("[TranslatorBeacon] At most %d third party beacons can be registered%s", TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY, "\n");
+		return -1;
+	}
+
+	thirdPartyBeacons[nbThirdPartyBeacons] = *thirdPartyBeacon;
+	thirdPartyBeacons[nbThirdPartyBeacons].name[SIZE_BEACON_ID - 1] = '\0';
+	thirdPartyBuckets[bucket] = ++nbThirdPartyBeacons;
+
+	return 0;
+
+}
+
+extern int8_t TranslatorBeacon_loadThirdPartyBeacons(const char * path) {
+
+	char line[THIRD_PARTY_LINE_LENGTH];
+	char format[16];
+	char first[48];
+	char second[16];
+	char name[SIZE_BEACON_ID];
+	uint16_t major;
+	uint16_t minor;
+	uint32_t lineNumber = 0;
+	int8_t returnError = 0;
+	FILE * file = fopen(path, "r");
+
+	if (file == NULL) {
+		LOG("[TranslatorBeacon] Fail to open the third party beacons file %s%s", path, "\n");
+		return -1;
+	}
+
+	while (returnError == 0 && fgets(line, sizeof(line), file) != NULL) {
+		ThirdPartyBeacon thirdPartyBeacon;
+		bool isValid = false;
+
+		lineNumber++;
+		memset(&thirdPartyBeacon, 0, sizeof(thirdPartyBeacon));
+		if (sscanf(line, "%15s", format) != 1 || format[0] == '#') {
+			continue;		// Ligne vide ou commentaire
+		}
+
+		if (strcmp(format, "ibeacon") == 0) {
+			thirdPartyBeacon.format = TRANSLATOR_BEACON_IBEACON;
+			isValid = sscanf(line, "%*s %47s %" SCNu16 " %" SCNu16 " %2s %" SCNu32 " %" SCNu32, first, &major, &minor, name, &thirdPartyBeacon.position.X, &thirdPartyBeacon.position.Y) == 6
+				&& parseHex(first, thirdPartyBeacon.identifier, 16);
+			/* Le major et le minor sont emis en gros-boutiste */
+			thirdPartyBeacon.identifier[16] = (uint8_t) (major >> 8);
+			thirdPartyBeacon.identifier[17] = (uint8_t) major;
+			thirdPartyBeacon.identifier[18] = (uint8_t) (minor >> 8);
+			thirdPartyBeacon.identifier[19] = (uint8_t) minor;
+		} else if (strcmp(format, "eddystone") == 0) {
+			thirdPartyBeacon.format = TRANSLATOR_BEACON_EDDYSTONE;
+			isValid = sscanf(line, "%*s %47s %15s %2s %" SCNu32 " %" SCNu32, first, second, name, &thirdPartyBeacon.position.X, &thirdPartyBeacon.position.Y) == 5
+				&& parseHex(first, thirdPartyBeacon.identifier, 10)
+				&& parseHex(second, thirdPartyBeacon.identifier + 10, 6);
+		}
+
+		if (!isValid || strlen(name) != SIZE_BEACON_ID - 1) {
+			LOG("[TranslatorBeacon] Invalid line %d of %s%s", lineNumber, path, "\n");
+			returnError = -1;
+		} else {
+			memcpy(thirdPartyBeacon.name, name, SIZE_BEACON_ID);
+			returnError = TranslatorBeacon_addThirdPartyBeacon(&thirdPartyBeacon);
+		}
+	}
+
+	fclose(file);
+
+	if (returnError == 0) {
+		LOG("[TranslatorBeacon] %d third party beacons registered%s", nbThirdPartyBeacons, "\n");
+	}
+
+	return returnError;
+
+}
+
+extern uint8_t TranslatorBeacon_getThirdPartyBeacons(ThirdPartyBeacon * beacons, uint8_t nbMaxThirdPartyBeacons) {
+
+	uint8_t nbCopied = nbThirdPartyBeacons < nbMaxThirdPartyBeacons ? nbThirdPartyBeacons : nbMaxThirdPartyBeacons;
+
+	memcpy(beacons, thirdPartyBeacons, nbCopied * sizeof(ThirdPartyBeacon));
 
-    char posX[POSITION_LENGTH];
-	char posY[POSITION_LENGTH];
+	return nbCopied;
+
+}
 
-	memcpy(bs.name, info->data + DEVICE_NAME_FIRST_BYTE, DEVICE_NAME_LENGTH);
-	bs.name[2] =  '\0';
 
-	bs.uuid[0] = (uint32_t) info->data[DEVICE_UUID_FIRST_BYTE];
-	bs.uuid[1] = (uint32_t) info->data[DEVICE_UUID_FIRST_BYTE + 1];
+extern BeaconSignal TranslatorBeacon_translateChannelToBeaconsSignal(const BeaconsChannel * info) {
+
+    BeaconSignal bs;
 
-	memcpy(posX, info->data + DEVICE_POSITION_X_FIRST_BYTE, POSITION_LENGTH);
+	translateOne((const uint8_t *) info, false, &bs);
 
-	sscanf(posX, "%d", (int32_t*) &(bs.position.X));
+    return bs;
+
+}
 
-	memcpy(posY, info->data + DEVICE_POSITION_Y_FIRST_BYTE, POSITION_LENGTH);
+extern BeaconSignal TranslatorBeacon_translateExtendedChannelToBeaconsSignal(const BeaconsExtendedChannel * info) {
 
-	sscanf(posY, "%d", (int32_t*) &(bs.position.Y));
+    BeaconSignal bs;
 
-	bs.rssi = (int8_t) info->data[info->length - 1];
+	translateOne((const uint8_t *) info, true, &bs);
 
     return bs;
 
 }
+
+extern uint8_t TranslatorBeacon_translateReports(const uint8_t * reports, uint16_t size, uint8_t nbReports, bool isExtended, BeaconsSignalBatch * batch, uint16_t * consumedSize) {
+
+	const uint8_t * cursor = reports;
+	const uint8_t * end = reports + size;
+	uint8_t i;
+
+	for (i = 0; i < nbReports && i < batch->capacity; i++) {
+		uint16_t reportSize = translateReport(cursor, end, isExtended, batch, i);
+		if (reportSize == 0) {
+			break;		// Rapport tronque, le nombre de rapports annonce est faux
+		}
+		cursor += reportSize;
+	}
+
+	batch->nbSignals = i;
+	if (consumedSize != NULL) {
+		*consumedSize = (uint16_t) (cursor - reports);
+	}
+
+	return i;
+
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+
+//                                              Fonctions static
+
+//
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void translateOne(const uint8_t * report, bool isExtended, BeaconSignal * bs) {
+
+	uint8_t name[1][SIZE_BEACON_ID];
+	uint16_t uuid;
+	BeaconsSignalBatch batch = {
+		.name = name,
+		.uuid = &uuid,
+		.rssi = &bs->rssi,
+		.txPower = &bs->txPower,
+		.sequence = &bs->sequence,
+		.position = &bs->position,
+		.capacity = 1
+	};
+
+	/* Le rapport seul est suppose complet : sa fin est donnee par sa propre taille */
+	const uint8_t * end = isExtended
+		? report + BEACONS_EXTENDED_CHANNEL_SIZE + ((const BeaconsExtendedChannel *) report)->length
+		: report + LE_ADVERTISING_INFO_SIZE + ((const BeaconsChannel *) report)->length + 1;
+	translateReport(report, end, isExtended, &batch, 0);
+
+	memcpy(bs->name, name[0], SIZE_BEACON_ID);
+	bs->uuid[0] = (uint32_t) (uuid & 0xFF);
+	bs->uuid[1] = (uint32_t) (uuid >> 8);
+
+}
+
+static uint16_t translateReport(const uint8_t * report, const uint8_t * end, bool isExtended, BeaconsSignalBatch * batch, uint8_t index) {
+
+	uint16_t reportSize;
+
+	if (isExtended) {
+		const BeaconsExtendedChannel * info = (const BeaconsExtendedChannel *) report;
+
+		/* Le RSSI et la puissance d'emission precedent les donnees */
+		if (report + BEACONS_EXTENDED_CHANNEL_SIZE > end || report + BEACONS_EXTENDED_CHANNEL_SIZE + info->length > end) {
+			return 0;
+		}
+		reportSize = BEACONS_EXTENDED_CHANNEL_SIZE + info->length;
+
+		translateAdvertisingData(info->data, info->length, batch, index);
+		batch->rssi[index] = info->rssi;
+		if (info->txPower != BEACON_TX_POWER_UNKNOWN) {
+			batch->txPower[index] = info->txPower;
+		}
+
+		/* Les donnees d'une balise tiennent dans un seul rapport, les fragments d'une annonce plus longue sont ecartes */
+		if ((btohs(info->evtType) & EXTENDED_DATA_STATUS_MASK) != 0 || info->rssi == RSSI_UNAVAILABLE) {
+			batch->uuid[index] = 0;
+		}
+	} else {
+		const BeaconsChannel * info = (const BeaconsChannel *) report;
+
+		/* Le RSSI suit les donnees de la trame */
+		if (report + LE_ADVERTISING_INFO_SIZE > end || report + LE_ADVERTISING_INFO_SIZE + info->length + 1 > end) {
+			return 0;
+		}
+		reportSize = LE_ADVERTISING_INFO_SIZE + info->length + 1;
+
+		translateAdvertisingData(info->data, info->length, batch, index);
+		batch->rssi[index] = (int8_t) info->data[info->length];
+	}
+
+	return reportSize;
+
+}
+
+static void translateAdvertisingData(const uint8_t * data, uint8_t length, BeaconsSignalBatch * batch, uint8_t index) {
+
+	const uint8_t * nameValue = NULL;
+	const uint8_t * uuidValue = NULL;
+	const BeaconFormat * format = NULL;
+	const uint8_t * formatValue = NULL;
+	uint8_t formatLength = 0;
+	uint8_t * name = batch->name[index];
+	Position * position = &batch->position[index];
+	uint32_t isInvalid = 0;
+	uint16_t i = 0;
+
+	batch->txPower[index] = BEACON_TX_POWER_UNKNOWN;
+	batch->sequence[index] = BEACON_SEQUENCE_UNKNOWN;
+
+	/* Chaque structure AD : un octet de longueur (type compris), un octet de type, puis la valeur */
+	while (i + 1 < length && data[i] != 0 && i + 1 + data[i] <= length) {
+		const uint8_t * value = data + i + 2;
+		uint8_t valueLength = data[i] - 1;
+
+		switch (data[i + 1]) {
+			case AD_TYPE_NAME_SHORT:
+			case AD_TYPE_NAME_COMPLETE:
+				if (valueLength >= DEVICE_NAME_FULL_LENGTH) {
+					nameValue = value;
+				}
+				break;
+
+			case AD_TYPE_UUID16_INCOMPLETE:
+			case AD_TYPE_UUID16_COMPLETE:
+				if (uuidValue == NULL && valueLength >= DEVICE_UUID_LENGTH) {
+					uuidValue = value;
+				}
+				break;
+
+			case AD_TYPE_TX_POWER:
+				if (valueLength >= 1) {
+					batch->txPower[index] = (int8_t) value[0];
+				}
+				break;
+
+			case AD_TYPE_MANUFACTURER_DATA:
+			case AD_TYPE_SERVICE_DATA16:
+				/* Le format est choisi par l'identifiant de societe ou l'UUID de service qui ouvre la valeur */
+				if (format == NULL && valueLength >= 2) {
+					format = findFormat(data[i + 1], (uint16_t) (value[0] | (value[1] << 8)));
+					formatValue = value;
+					formatLength = valueLength;
+				}
+				break;
+
+			default:
+				break;
+		}
+
+		i += data[i] + 1;
+	}
+
+	if (format != NULL && format->decode(formatValue, formatLength, batch, index)) {
+		if (format->uuid != 0) {
+			batch->uuid[index] = format->uuid;
+		} else {
+			batch->uuid[index] = uuidValue != NULL ? (uint16_t) (uuidValue[0] | (uuidValue[1] << 8)) : 0;
+		}
+		return;
+	}
+
+	if (nameValue != NULL) {
+		memcpy(name, nameValue, DEVICE_NAME_LENGTH);
+		isInvalid |= isInvalidName(nameValue);
+		position->X = parseCoordinate(nameValue + DEVICE_POSITION_X_FIRST_BYTE, &isInvalid);
+		position->Y = parseCoordinate(nameValue + DEVICE_POSITION_Y_FIRST_BYTE, &isInvalid);
+	} else {
+		position->X = 0;
+		position->Y = 0;
+	}
+	name[nameValue != NULL ? DEVICE_NAME_LENGTH : 0] = '\0';
+
+	/* L'UUID est garde dans l'ordre des octets de la trame, petit-boutiste */
+	if (uuidValue != NULL && nameValue != NULL && !isInvalid) {
+		batch->uuid[index] = (uint16_t) (uuidValue[0] | (uuidValue[1] << 8));
+	} else {
+		batch->uuid[index] = 0;
+	}
+
+}
+
+static const BeaconFormat * findFormat(uint8_t adType, uint16_t key) {
+
+	for (uint8_t i = 0; i < NB_FORMATS; i++) {
+		if (FORMATS[i].key == key && FORMATS[i].adType == adType) {
+			return &FORMATS[i];
+		}
+	}
+
+	return NULL;
+
+}
+
+static bool decodeCompact(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index) {
+
+	if (length < COMPACT_LENGTH || value[COMPACT_VERSION_BYTE] != COMPACT_VERSION || isInvalidName(value + COMPACT_NAME_BYTE)) {
+		return false;
+	}
+
+	memcpy(batch->name[index], value + COMPACT_NAME_BYTE, DEVICE_NAME_LENGTH);
+	batch->name[index][DEVICE_NAME_LENGTH] = '\0';
+	batch->position[index].X = (uint32_t) (value[COMPACT_POSITION_X_BYTE] | (value[COMPACT_POSITION_X_BYTE + 1] << 8));
+	batch->position[index].Y = (uint32_t) (value[COMPACT_POSITION_Y_BYTE] | (value[COMPACT_POSITION_Y_BYTE + 1] << 8));
+	batch->txPower[index] = (int8_t) value[COMPACT_TX_POWER_BYTE];
+	batch->sequence[index] = value[COMPACT_SEQUENCE_BYTE];
+
+	return true;
+
+}
+
+static bool decodeIBeacon(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index) {
+
+	if (length < IBEACON_LENGTH || value[IBEACON_TYPE_BYTE] != IBEACON_TYPE || value[IBEACON_DATA_SIZE_BYTE] != IBEACON_DATA_SIZE) {
+		return false;
+	}
+
+	/* L'UUID, le major et le minor se suivent : ils forment l'identifiant tel quel */
+	return decodeThirdParty(TRANSLATOR_BEACON_IBEACON, value + IBEACON_IDENTIFIER_BYTE, (int8_t) value[IBEACON_TX_POWER_BYTE], batch, index);
+
+}
+
+static bool decodeEddystone(const uint8_t * value, uint8_t length, BeaconsSignalBatch * batch, uint8_t index) {
+
+	uint8_t identifier[TRANSLATOR_BEACON_IDENTIFIER_SIZE] = { 0 };
+
+	if (length < EDDYSTONE_LENGTH || value[EDDYSTONE_FRAME_TYPE_BYTE] != EDDYSTONE_FRAME_UID) {
+		return false;
+	}
+
+	memcpy(identifier, value + EDDYSTONE_IDENTIFIER_BYTE, EDDYSTONE_IDENTIFIER_LENGTH);
+	return decodeThirdParty(TRANSLATOR_BEACON_EDDYSTONE, identifier, (int8_t) value[EDDYSTONE_TX_POWER_BYTE], batch, index);
+
+}
+
+static bool decodeThirdParty(ThirdPartyFormat format, const uint8_t * identifier, int8_t txPower, BeaconsSignalBatch * batch, uint8_t index) {
+
+	uint32_t bucket = hashIdentifier(format, identifier);
+
+	while (thirdPartyBuckets[bucket] != 0) {
+		const ThirdPartyBeacon * registered = &thirdPartyBeacons[thirdPartyBuckets[bucket] - 1];
+		if (registered->format == format && memcmp(registered->identifier, identifier, TRANSLATOR_BEACON_IDENTIFIER_SIZE) == 0) {
+			memcpy(batch->name[index], registered->name, SIZE_BEACON_ID);
+			batch->position[index] = registered->position;
+			batch->txPower[index] = txPower;
+			return true;
+		}
+		bucket = (bucket + 1) & (THIRD_PARTY_NB_BUCKETS - 1);
+	}
+
+	return false;		// Une balise du commerce qui n'a pas ete posee
+
+}
+
+static uint32_t hashIdentifier(ThirdPartyFormat format, const uint8_t * identifier) {
+
+	uint32_t hash = (2166136261u ^ (uint32_t) format) * 16777619u;
+
+	for (uint8_t i = 0; i < TRANSLATOR_BEACON_IDENTIFIER_SIZE; i++) {
+		hash = (hash ^ identifier[i]) * 16777619u;
+	}
+
+	return hash & (THIRD_PARTY_NB_BUCKETS - 1);
+
+}
+
+static bool parseHex(const char * text, uint8_t * bytes, uint8_t nbBytes) {
+
+	uint8_t nbDigits = 0;
+
+	for (; *text != '\0'; text++) {
+		uint8_t digit;
+
+		if (*text == '-') {
+			continue;
+		} else if (*text >= '0' && *text <= '9') {
+			digit = (uint8_t) (*text - '0');
+		} else if (*text >= 'a' && *text <= 'f') {
+			digit = (uint8_t) (*text - 'a' + 10);
+		} else if (*text >= 'A' && *text <= 'F') {
+			digit = (uint8_t) (*text - 'A' + 10);
+		} else {
+			return false;
+		}
+
+		if (nbDigits >= 2 * nbBytes) {
+			return false;
+		}
+		bytes[nbDigits / 2] = (uint8_t) (nbDigits % 2 == 0 ? digit << 4 : bytes[nbDigits / 2] | digit);
+		nbDigits++;
+	}
+
+	return nbDigits == 2 * nbBytes;
+
+}
+
+static uint32_t parseCoordinate(const uint8_t * digits, uint32_t * isInvalid) {
+
+	uint32_t value = 0;
+
+	for (uint8_t i = 0; i < POSITION_LENGTH; i++) {
+		uint32_t digit = (uint32_t) digits[i] - '0';	// Un caractere hors de '0'..'9' donne un chiffre superieur a 9
+		*isInvalid |= digit > 9;
+		value = value * 10 + digit;
+	}
+
+	return value;
+
+}
+
+static uint32_t isInvalidName(const uint8_t * name) {
+
+	uint32_t isInvalid = 0;
+
+	for (uint8_t i = 0; i < DEVICE_NAME_LENGTH; i++) {
+		isInvalid |= (uint8_t) (name[i] - '!') > '~' - '!';	// Hors de '!'..'~', y compris l'octet nul
+	}
+
+	return isInvalid;
+
+}
@@ -71,6 +71,57 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief Le nombre maximal de rapports d'annonce dans un evenement HCI, atteint avec des rapports classiques vides.
+ */
+#define TRANSLATOR_BEACON_NB_MAX_REPORTS ((HCI_MAX_EVENT_SIZE - EVT_LE_META_EVENT_SIZE - 1) / (LE_ADVERTISING_INFO_SIZE + 1))
+
+/**
+ * @brief Les signaux traduits d'un lot de rapports d'annonce, champ par champ.
+ *
+ * Les tableaux sont fournis par l'appelant, chacun d'au moins capacity elements : l'element i de chaque tableau
+ * correspond au rapport i du lot.
+ */
+typedef struct {
+    uint8_t (*name)[SIZE_BEACON_ID];    /**< L'identifiant de chaque balise, vide si le rapport n'en donne pas. */
+    uint16_t* uuid;                     /**< Le premier UUID de service 16 bits, 0 si le rapport n'est pas celui d'une balise. */
+    int8_t* rssi;                       /**< Le RSSI de chaque rapport. */
+    int8_t* txPower;                    /**< La puissance d'emission, #BEACON_TX_POWER_UNKNOWN si elle n'est pas annoncee. */
+    uint16_t* sequence;                 /**< Le numero de sequence, #BEACON_SEQUENCE_UNKNOWN si la balise emet le format texte. */
+    Position* position;                 /**< La position de chaque balise. */
+    uint8_t capacity;                   /**< Le nombre d'elements de chaque tableau. */
+    uint8_t nbSignals;                  /**< Le nombre d'elements remplis par la derniere traduction. */
+} BeaconsSignalBatch;
+
+/**
+ * @brief Le nombre maximal de balises tierces enregistrees.
+ */
+#define TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY (64)
+
+/**
+ * @brief La taille de l'identifiant d'une balise tierce : l'UUID, le major et le minor d'un iBeacon, tels qu'emis ;
+ * l'espace de noms et l'instance d'une balise Eddystone-UID, completes par des 0.
+ */
+#define TRANSLATOR_BEACON_IDENTIFIER_SIZE (20)
+
+/**
+ * @brief Les formats des balises du commerce, dont la position n'est pas annoncee.
+ */
+typedef enum {
+    TRANSLATOR_BEACON_IBEACON = 1,      /**< Un iBeacon, dans les donnees constructeur d'Apple. */
+    TRANSLATOR_BEACON_EDDYSTONE         /**< Une trame UID d'Eddystone, dans les donnees du service 0xFEAA. */
+} ThirdPartyFormat;
+
+/**
+ * @brief Une balise du commerce et la position ou elle a ete posee.
+ */
+typedef struct {
+    ThirdPartyFormat format;                                /**< Le format emis par la balise. */
+    uint8_t identifier[TRANSLATOR_BEACON_IDENTIFIER_SIZE];  /**< L'identifiant emis par la balise. */
+    uint8_t name[SIZE_BEACON_ID];                           /**< L'identifiant donne a la balise dans GEOLOGIE. */
+    Position position;                                      /**< La position de la balise. */
+} ThirdPartyBeacon;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 //
@@ -105,17 +156,117 @@ extern int TranslatorBeacon_new();
 
 extern int TranslatorBeacon_free();
 
+/**
+
+ * @fn extern int8_t TranslatorBeacon_addThirdPartyBeacon(const ThirdPartyBeacon * thirdPartyBeacon)
+
+ * @brief Enregistre une balise du commerce, avant le demarrage du scan
+
+ * Son signal est ensuite rendu avec l'identifiant et la position enregistres et l'UUID #BEACONS_UUID.
+
+ * Les balises enregistrees sont oubliees par TranslatorBeacon_free().
+
+ * @return retourne -1 si le registre est plein ou si la balise y est deja, 0 sinon
+
+*/
+
+extern int8_t TranslatorBeacon_addThirdPartyBeacon(const ThirdPartyBeacon * thirdPartyBeacon);
+
+/**
+
+ * @fn extern int8_t TranslatorBeacon_loadThirdPartyBeacons(const char * path)
+
+ * @brief Enregistre les balises du commerce d'un fichier, une par ligne
+
+ * ibeacon <uuid> <major> <minor> <id> <x> <y>
+
+ * eddystone <espace de noms> <instance> <id> <x> <y>
+
+ * Les identifiants emis sont en hexadecimal, les tirets de l'UUID sont permis, la position est en centimetre.
+
+ * Les lignes vides et celles commencant par # sont ignorees.
+
+ * @return retourne -1 si le fichier ne peut etre lu ou si une ligne est invalide, 0 sinon
+
+*/
+
+extern int8_t TranslatorBeacon_loadThirdPartyBeacons(const char * path);
+
+/**
+
+ * @fn extern uint8_t TranslatorBeacon_getThirdPartyBeacons(ThirdPartyBeacon * beacons, uint8_t nbMaxThirdPartyBeacons)
+
+ * @brief Recopie les balises du commerce enregistrees, dans leur ordre d'enregistrement
+
+ * Sert a les enregistrer a nouveau dans un autre processus avec TranslatorBeacon_addThirdPartyBeacon().
+
+ * @return retourne le nombre de balises recopiees
+
+*/
+
+extern uint8_t TranslatorBeacon_getThirdPartyBeacons(ThirdPartyBeacon * beacons, uint8_t nbMaxThirdPartyBeacons);
+
 /**
 
  * @fn extern BeaconsSignal TranslatorBeacon_translateChannelToBeaconsSignal(BleChannel)
 
  * @brief Demande la traduction de la trame passee en parametre
 
+ * Le RSSI est lu dans l'octet qui suit les donnees de la trame, comme dans un LE advertising report.
+
+ * Les structures AD des donnees sont lues en place. Les donnees constructeur compactes de BalisePy, ou l'iBeacon ou
+
+ * l'Eddystone-UID d'une balise du commerce enregistree, priment sur le nom de la balise ; une trame sans l'un ni
+
+ * l'autre valide est rendue avec un UUID nul.
+
+ * @return retourne une structure de BeaconsSignal
+
+*/
+
+extern BeaconSignal TranslatorBeacon_translateChannelToBeaconsSignal(const BeaconsChannel * beaconsChannel);
+
+/**
+
+ * @fn extern BeaconSignal TranslatorBeacon_translateExtendedChannelToBeaconsSignal(const BeaconsExtendedChannel * beaconsExtendedChannel)
+
+ * @brief Demande la traduction d'un rapport d'annonce etendue de Bluetooth 5
+
+ * Le RSSI et la puissance d'emission sont lus dans l'en-tete du rapport, qui precede les donnees. La puissance
+
+ * d'emission annoncee dans les donnees n'est retenue que si l'en-tete ne la donne pas.
+
  * @return retourne une structure de BeaconsSignal
 
 */
 
-extern BeaconSignal TranslatorBeacon_translateChannelToBeaconsSignal(BeaconsChannel * beaconsChannel);
+extern BeaconSignal TranslatorBeacon_translateExtendedChannelToBeaconsSignal(const BeaconsExtendedChannel * beaconsExtendedChannel);
+
+/**
+
+ * @fn extern uint8_t TranslatorBeacon_translateReports(const uint8_t * reports, uint16_t size, uint8_t nbReports, bool isExtended, BeaconsSignalBatch * batch, uint16_t * consumedSize)
+
+ * @brief Traduit en une fois les rapports d'un LE Advertising Report ou d'un LE Extended Advertising Report
+
+ * Les rapports sont lus en place. La traduction s'arrete au premier rapport tronque ou quand le lot est plein.
+
+ * @param reports le premier rapport, qui suit le nombre de rapports de l'evenement
+
+ * @param size la taille des rapports
+
+ * @param nbReports le nombre de rapports annonce par l'evenement
+
+ * @param isExtended vrai pour les rapports d'un LE Extended Advertising Report
+
+ * @param batch le lot a remplir, dont nbSignals est mis a jour
+
+ * @param consumedSize la taille des rapports traduits, pour reprendre apres un lot plein, peut etre NULL
+
+ * @return retourne le nombre de rapports traduits
+
+*/
+
+extern uint8_t TranslatorBeacon_translateReports(const uint8_t * reports, uint16_t size, uint8_t nbReports, bool isExtended, BeaconsSignalBatch * batch, uint16_t * consumedSize);
 
 
 #endif /* TRANSLATORBEACON_H */
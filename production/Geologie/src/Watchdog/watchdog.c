@@ -90,6 +90,11 @@ void Watchdog_start(Watchdog *this)
     timer_settime(this->timerId, 0, &spec, NULL);
 }
 
+void Watchdog_setDelay(Watchdog *this, uint32_t delay)
+{
+    this->myDelay = delay;
+}
+
 void Watchdog_cancel(Watchdog *this)
 {
     if (this != NULL)
@@ -64,6 +64,14 @@ extern Watchdog *Watchdog_construct(uint32_t delay, WatchdogCallback callback);
  */
 extern void Watchdog_start(Watchdog * this);
 
+/**
+ * Changes the delay of the watchdog, taken into account at the next start.
+ *
+ * @param this watchdog's instance
+ * @param delay expressed in microseconds
+ */
+extern void Watchdog_setDelay(Watchdog * this, uint32_t delay);
+
 /**
  * Disarms the watchdog.
  *
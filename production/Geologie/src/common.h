@@ -32,7 +32,31 @@
  * reserve au caractere de fin de chaine.
  */
 #define SIZE_BEACON_ID (3)
-#define NB_CALIBRATION_POSITIONS (10)
+
+/**
+ * @brief L'indice d'une balise qui n'est pas enregistree dans BeaconRegistry.
+ */
+#define BEACON_INDEX_NONE (UINT16_MAX)
+
+/**
+ * @brief La puissance d'emission d'une balise qui ne l'annonce pas, la valeur "non disponible" de HCI.
+ */
+#define BEACON_TX_POWER_UNKNOWN (127)
+
+/**
+ * @brief Le numero de sequence d'un signal dont l'annonce n'en porte pas, celle d'une balise qui emet le format texte.
+ */
+#define BEACON_SEQUENCE_UNKNOWN (UINT16_MAX)
+
+/**
+ * @brief Le nombre de distances d'une #RangeTable : une par RSSI entier.
+ */
+#define RANGE_TABLE_SIZE (256)
+
+/**
+ * @brief Le nombre de positions de calibration visitees par Geographer, chacune donne un coefficient par balise a Scanner.
+ */
+#define NB_CALIBRATION_POSITION (25)
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -57,6 +81,13 @@ typedef uint8_t ExperimentalTrajectId;
  */
 typedef uint8_t CalibrationPositionId;
 
+/**
+ * @brief L'indice dense d'une balise, attribue par BeaconRegistry a sa premiere trame.
+ *
+ * Son identifiant sous forme de chaine n'est retrouve qu'au moment de l'envoyer a GEOMOBILE.
+ */
+typedef uint16_t BeaconIndex;
+
 /**
  * @brief Type representant une puissance de reception d'un signal bluetooth.
  */
@@ -87,26 +118,39 @@ typedef struct {
  *
  */
 typedef struct {
-    uint8_t beaconId[SIZE_BEACON_ID];               /**< L'identifiant de la balise auquel le coefficient d'attenuation est lie. */
+    BeaconIndex beaconIndex;                        /**< L'indice de la balise auquel le coefficient d'attenuation est lie. */
     CalibrationPositionId positionId;               /**< L'identifiant de la position de calibration auquel le coefficient d'attenuation est lie. */
     AttenuationCoefficient attenuationCoefficient;  /**< Le coefficient d'attenuation. */
 } BeaconCoefficients;
 
+/**
+ * @brief Ce que le coefficient d'attenuation d'une balise donne a chaque calcul de distance, rempli une fois par
+ * Mathematician_fillRangeTable a chaque changement de coefficient.
+ */
+typedef struct {
+    AttenuationCoefficient coefficient;     /**< Le coefficient d'attenuation dont la table est remplie. */
+    float relativeDeviation;                /**< ln(10) / (10 * coefficient), l'ecart type relatif de la distance pour un ecart type de 1 dB du RSSI. */
+    float distances[RANGE_TABLE_SIZE];      /**< La distance en centimetre du RSSI r a l'indice r - INT8_MIN. */
+} RangeTable;
+
 /**
  * @brief Creation d'une structure qui va prendre les differentes donnees d'une balise
  */
 typedef struct {
-    uint8_t ID[SIZE_BEACON_ID];
+    BeaconIndex index;
     Position position;
     Power power;
     AttenuationCoefficient coefficientAverage;
+    uint64_t timestamp;     /**< La date de reception du signal dont provient la puissance, sur l'horloge monotone, en nanoseconde. */
+    float rssiVariance;     /**< La variance de la puissance de la balise, 0 si elle n'est pas encore connue. */
+    const RangeTable* rangeTable;   /**< La table remplie avec le coefficient de la balise, NULL pour calculer distance et ecart type a chaque fois. */
 } BeaconData;
 
 /**
  * @brief Stucture contenant les donnee de calibration d'une balise.
  */
 typedef struct {
-    uint8_t beaconId[SIZE_BEACON_ID];           /**< L'identifiant de la balise. */
+    BeaconIndex beaconIndex;                    /**< L'indice de la balise. */
     BeaconCoefficients* beaconCoefficient;      /**< Le tableau de #BeaconCoefficient lie a la balise. */
     uint8_t nbCoefficient;                      /**< Le nombre de #BeaconCoefficient lie a la balise. */
     AttenuationCoefficient coefficientAverage;  /**< La moyenne du tableau de #BeaconCoefficient lie a la balise. */
@@ -143,11 +187,31 @@ typedef struct {
  */
 typedef struct {
     uint8_t name[SIZE_BEACON_ID];   /**< L'identifiant de la balise emettrice du signal */
+    BeaconIndex index;              /**< L'indice de la balise emettrice, attribue par Receiver. */
     uint32_t uuid[2];               /**< Le mode du signal bluetooth. */
     int8_t rssi;                    /**< La puissance du signal bluetooth. */
+    float rssiVariance;             /**< La variance du RSSI filtre sur la fenetre de FilterBank, en dBm carre, tenue par Receiver pour les balises de l'ensemble actif, 0 si elle n'est pas encore connue. */
+    int8_t txPower;                 /**< La puissance d'emission annoncee par la balise en dBm, #BEACON_TX_POWER_UNKNOWN si elle ne l'annonce pas. */
+    uint16_t sequence;              /**< Le numero de sequence de l'annonce, de 0 a 255, #BEACON_SEQUENCE_UNKNOWN si elle n'en porte pas. */
     Position position;              /**< La #Position de la balise extraite de son signal. */
+    uint8_t adapter;                /**< L'adaptateur Bluetooth qui a recu le signal, attribue par Receiver. */
+    uint64_t timestamp;             /**< La date de reception du signal par le noyau sur l'horloge monotone, en nanoseconde. */
 } BeaconSignal;
 
+/**
+ * @brief Structure contenant les statistiques de reception d'une balise de l'ensemble actif, tenues par Receiver.
+ *
+ * La moyenne, la variance et le debit portent sur les annonces recues depuis l'entree de la balise dans l'ensemble actif.
+ */
+typedef struct {
+    BeaconIndex index;          /**< L'indice de la balise. */
+    uint32_t lastSeenAge;       /**< Le temps ecoule depuis la derniere annonce recue, en milliseconde, a la lecture des statistiques. */
+    float advertisingRate;      /**< Le nombre d'annonces recues par seconde. */
+    float rssiMean;             /**< La moyenne du RSSI brut des annonces. */
+    float rssiVariance;         /**< La variance du RSSI brut des annonces. */
+    uint16_t nbDropouts;        /**< Le nombre de fois ou la balise a ete retiree de l'ensemble actif faute d'annonce. */
+} BeaconStatistics;
+
 /**
  * @brief Structure contenant les informations les charges memoire et processeur.
  */
@@ -16,13 +16,26 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <math.h>
 #include <pthread.h>
 #include <signal.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
+#include "BeaconRegistry/beaconRegistry.h"
+#include "FilterBank/filterBank.h"
+#include "Fingerprint/fingerprint.h"
 #include "ManagerLOG/managerLOG.h"
+#include "ParticleFilter/particleFilter.h"
+#include "Receiver/receiver.h"
+#include "Regulator/regulator.h"
+#include "Scanner/scanner.h"
+#include "Simulator/simulator.h"
+#include "TranslatorBeacon/translatorBeacon.h"
 #include "tools.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +56,11 @@ static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
  */
 static pthread_mutex_t clientMutex = PTHREAD_MUTEX_INITIALIZER;
 
+/**
+ * @brief Vrai si les balises sont simulees par Simulator.
+ */
+static bool isSimulated = false;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Prototypes de fonctions
@@ -71,6 +89,38 @@ static void setUp(void);
  */
 static void tearDown(void);
 
+/**
+ * @brief Lit les options de la ligne de commande.
+ *
+ * - -r capture : rejoue la capture btsnoop ou pcap a la place du peripherique HCI ;
+ * - -s vitesse : facteur de vitesse du rejeu, 1 par defaut, 0 pour rejouer sans attendre ;
+ * - -t trajet : simule les balises vues le long du trajet experimental a la place du peripherique HCI ;
+ * - -b balises : nombre de balises simulees, 50 par defaut ;
+ * - -v vitesse : vitesse du robot simule en cm/s, 50 par defaut ;
+ * - -a frequence : nombre d'annonces par seconde de chaque balise simulee, 10 par defaut ;
+ * - -n bruit : ecart type du bruit du RSSI simule en dB, 2 par defaut ;
+ * - -f filtre : filtre du RSSI de chaque balise, raw (par defaut), ema, median ou hampel ;
+ * - -w fenetre : taille de la fenetre glissante des filtres median et hampel, 9 par defaut ;
+ * - -i intervalle : intervalle de scan du peripherique HCI en ms, 10 par defaut ;
+ * - -e ecoute : fenetre de scan du peripherique HCI en ms, au plus l'intervalle, egale a l'intervalle par defaut ;
+ * - -A : scan actif, passif par defaut ;
+ * - -X : scan etendu de Bluetooth 5, qui recoit aussi les annonces etendues des balises, classique par defaut ;
+ * - -c capacite : nombre maximal de balises suivies, 256 par defaut ;
+ * - -d peripheriques : numeros des peripheriques hciN scannes en parallele, separes par des virgules, le peripherique par defaut sinon ;
+ * - -T delai : delai sans annonce en ms apres lequel une balise est retiree de l'ensemble actif, 5000 par defaut, 0 pour jamais ;
+ * - -F : rythme du scan et du calcul de position fixe, adapte a l'activite du robot par defaut ;
+ * - -P coeur : scan dans un processus isole, epingle au coeur donne, -1 pour n'en epingler a aucun ;
+ * - -R fichier : balises du commerce (iBeacon, Eddystone-UID) et leur position, une par ligne ;
+ * - -k periode : envoie en plus la position suivie annonce par annonce toutes les periode ms, desactive par defaut ;
+ * - -p particules : calcule la position avec un filtre particulaire de ce nombre de particules, desactive par defaut ;
+ * - -j fils : nombre de threads du filtre particulaire, un par coeur par defaut ;
+ * - -m voisins : releve les empreintes radio pendant la calibration et calcule la position avec ce nombre de plus proches voisins de la carte, desactive par defaut.
+ *
+ * @param argc Le nombre d'arguments.
+ * @param argv Les arguments.
+ */
+static void parseOptions(int argc, char* argv[]);
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Fonctions publiques
@@ -83,13 +133,23 @@ static void tearDown(void);
  * @return int 0
  */
 int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], RECEIVER_SCAN_PROCESS_ARGUMENT) == 0) {
+        return Receiver_runScanProcess(argc, argv);
+    }
+
     TRACE("%s", "\033[2J\033[;H");
     LOG(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> GEOLOGIE is launched <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<%s", "\n\n");
 
+    parseOptions(argc, argv);
+
     setUp();
 
     ManagerLOG_startGEOLOGIE();
 
+    if (isSimulated) {
+        Simulator_start();
+    }
+
     atexit(errorHandler);
 
     pthread_cond_wait(&cond, &clientMutex);
@@ -103,6 +163,177 @@ int main(int argc, char* argv[]) {
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static void parseOptions(int argc, char* argv[]) {
+    const char* capturePath = NULL;
+    float captureSpeed = 1.0f;
+    SimulatorConfiguration simulatorConfiguration = {
+        .trajectId = 0,
+        .speed = 50,
+        .nbBeacons = 50,
+        .advertisingRate = 10,
+        .noise = 2,
+        .attenuationCoefficient = 2,
+        .seed = 1
+    };
+    FilterBankConfiguration filterBankConfiguration;
+    FilterBank_getConfiguration(&filterBankConfiguration);
+
+    ReceiverScanConfiguration scanConfiguration;
+    Receiver_getScanConfiguration(&scanConfiguration);
+    bool isScanWindowSet = false;
+    uint16_t beaconsCapacity = BEACON_REGISTRY_CAPACITY_DEFAULT;
+    int hciDevices[RECEIVER_NB_MAX_ADAPTERS];
+    uint8_t nbHciDevices = 0;
+    char* hciDevice;
+
+    int option;
+
+    while ((option = getopt(argc, argv, "r:s:t:b:v:a:n:f:w:i:e:AXc:d:T:FP:R:k:p:j:m:")) != -1) {
+        switch (option) {
+            case 'r':
+                capturePath = optarg;
+                break;
+
+            case 's':
+                captureSpeed = strtof(optarg, NULL);
+                break;
+
+            case 't':
+                simulatorConfiguration.trajectId = (ExperimentalTrajectId) atoi(optarg);
+                break;
+
+            case 'b':
+                simulatorConfiguration.nbBeacons = (uint16_t) atoi(optarg);
+                break;
+
+            case 'v':
+                simulatorConfiguration.speed = strtof(optarg, NULL);
+                break;
+
+            case 'a':
+                simulatorConfiguration.advertisingRate = strtof(optarg, NULL);
+                break;
+
+            case 'n':
+                simulatorConfiguration.noise = strtof(optarg, NULL);
+                break;
+            case 'f':
+                if (strcmp(optarg, "ema") == 0) {
+                    filterBankConfiguration.type = FILTER_BANK_EMA;
+                } else if (strcmp(optarg, "median") == 0) {
+                    filterBankConfiguration.type = FILTER_BANK_MEDIAN;
+                } else if (strcmp(optarg, "hampel") == 0) {
+                    filterBankConfiguration.type = FILTER_BANK_HAMPEL;
+                } else if (strcmp(optarg, "raw") == 0) {
+                    filterBankConfiguration.type = FILTER_BANK_RAW;
+                } else {
+                    LOG("[Main] Unknown filter %s%s", optarg, "\n");
+                    exit(1);
+                }
+                break;
+            case 'w':
+                filterBankConfiguration.window = (uint8_t) atoi(optarg);
+                break;
+            case 'i':
+                scanConfiguration.interval = (uint16_t) lroundf(strtof(optarg, NULL) * 1000 / RECEIVER_SCAN_TIME_UNIT);
+                break;
+            case 'e':
+                scanConfiguration.window = (uint16_t) lroundf(strtof(optarg, NULL) * 1000 / RECEIVER_SCAN_TIME_UNIT);
+                isScanWindowSet = true;
+                break;
+            case 'A':
+                scanConfiguration.isActive = true;
+                break;
+            case 'X':
+                scanConfiguration.isExtended = true;
+                break;
+            case 'c':
+                beaconsCapacity = (uint16_t) atoi(optarg);
+                break;
+            case 'd':
+                for (hciDevice = strtok(optarg, ","); hciDevice != NULL; hciDevice = strtok(NULL, ",")) {
+                    if (nbHciDevices >= RECEIVER_NB_MAX_ADAPTERS) {
+                        LOG("[Main] At most %d HCI devices can be scanned%s", RECEIVER_NB_MAX_ADAPTERS, "\n");
+                        exit(1);
+                    }
+                    /* hci1 ou 1 */
+                    hciDevices[nbHciDevices++] = atoi(strncmp(hciDevice, "hci", 3) == 0 ? hciDevice + 3 : hciDevice);
+                }
+                break;
+            case 'T':
+                Receiver_setBeaconTimeout((uint32_t) strtoul(optarg, NULL, 10));
+                break;
+            case 'F':
+                Regulator_setEnabled(false);
+                break;
+            case 'P':
+                Receiver_setScanProcess(true, atoi(optarg));
+                break;
+            case 'R':
+                if (TranslatorBeacon_loadThirdPartyBeacons(optarg) < 0) {
+                    exit(1);
+                }
+                break;
+            case 'k':
+                Scanner_setTrackingPeriod((uint32_t) strtoul(optarg, NULL, 10));
+                break;
+            case 'p':
+                ParticleFilter_setNbParticles((uint32_t) strtoul(optarg, NULL, 10));
+                break;
+            case 'j':
+                ParticleFilter_setNbWorkers((uint8_t) atoi(optarg));
+                break;
+            case 'm':
+                Fingerprint_setNbNeighbours((uint8_t) atoi(optarg));
+                break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-r capture [-s speed]] [-t traject [-b beacons] [-v speed] [-a rate] [-n noise]] [-f raw|ema|median|hampel [-w window]] [-i interval] [-e window] [-A] [-X] [-c capacity] [-d hci0,hci1,...] [-T timeout] [-F] [-P cpu] [-R beacons] [-k period] [-p particles [-j threads]] [-m neighbours]%s", argv[0], "\n");
+                exit(1);
+        }
+    }
+
+    if (BeaconRegistry_new(beaconsCapacity) < 0) {
+        exit(1);
+    }
+
+    if (FilterBank_configure(&filterBankConfiguration) < 0) {
+        exit(1);
+    }
+
+    if (!isScanWindowSet) {
+        scanConfiguration.window = scanConfiguration.interval;
+    }
+    if (Receiver_setScanConfiguration(&scanConfiguration) < 0) {
+        exit(1);
+    }
+
+    if (nbHciDevices > 0 && Receiver_setHciDevices(hciDevices, nbHciDevices) < 0) {
+        exit(1);
+    }
+
+    if (capturePath != NULL && simulatorConfiguration.trajectId != 0) {
+        LOG("[Main] A capture can not be replayed during a simulation%s", "\n");
+        exit(1);
+    }
+
+    if (capturePath != NULL) {
+        LOG("[Main] Replay of %s at speed x%.1f%s", capturePath, captureSpeed, "\n");
+        Receiver_setCaptureFile(capturePath, captureSpeed);
+    }
+
+    if (simulatorConfiguration.trajectId != 0) {
+        LOG("[Main] Simulation of %d beacons along the traject %d%s", simulatorConfiguration.nbBeacons, simulatorConfiguration.trajectId, "\n");
+        if (simulatorConfiguration.nbBeacons > beaconsCapacity) {
+            LOG("[Main] Only %d of the %d simulated beacons will be tracked%s", beaconsCapacity, simulatorConfiguration.nbBeacons, "\n");
+        }
+        if (Simulator_new(&simulatorConfiguration) < 0) {
+            exit(1);
+        }
+        isSimulated = true;
+    }
+}
+
 static void setUp(void) {
     int8_t returnError = EXIT_SUCCESS;
     sig_t returnErrorSignal = NULL;
@@ -155,6 +386,13 @@ static void errorHandler(void) {
 
     ManagerLOG_stopGEOLOGIE();
 
+    if (isSimulated) {
+        Simulator_stop();
+        Simulator_free();
+    }
+
+    BeaconRegistry_free();
+
     tearDown();
 
     LOG("\n>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> GEOLOGIE is stopped <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<%s", "\n\n");
@@ -0,0 +1,178 @@
+/**
+ * @file beaconRegistry_test.c
+ *
+ * @brief Ensemble de test pour BeaconRegistry.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#include "cmocka.h"
+
+#include "BeaconRegistry/beaconRegistry.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La capacite du registre pendant les tests, qui n'est pas une puissance de 2.
+ */
+#define NB_BEACONS_TEST (1000)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les caracteres des identifiants composes par les tests.
+ */
+static const char NAME_ALPHABET_TEST[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module BeaconRegistry.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int beaconRegistry_run_tests(void);
+
+static void test_BeaconRegistry_getIndex(void** state);
+static void test_BeaconRegistry_getNameUnknown(void** state);
+static void test_BeaconRegistry_full(void** state);
+static void test_BeaconRegistry_new(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int createRegistry(void** state) {
+    return BeaconRegistry_new(NB_BEACONS_TEST);
+}
+
+static int freeRegistry(void** state) {
+    BeaconRegistry_free();
+    return 0;
+}
+
+/**
+ * @brief Compose un identifiant different pour chaque numero, au format de BalisePy.
+ */
+static void composeName(uint16_t number, uint8_t* name) {
+    name[0] = NAME_ALPHABET_TEST[number / 62];
+    name[1] = NAME_ALPHABET_TEST[number % 62];
+    name[2] = '\0';
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_BeaconRegistry_getIndex(void** state) {
+    BeaconIndex indexA1 = BeaconRegistry_getIndex((const uint8_t*) "A1");
+    BeaconIndex indexA2 = BeaconRegistry_getIndex((const uint8_t*) "A2");
+    BeaconIndex indexB1 = BeaconRegistry_getIndex((const uint8_t*) "B1");
+
+    /* Les indices sont attribues dans l'ordre d'arrivee, sans trou */
+    assert_int_equal(0, indexA1);
+    assert_int_equal(1, indexA2);
+    assert_int_equal(2, indexB1);
+    assert_int_equal(3, BeaconRegistry_getNbBeacons());
+
+    /* Une balise deja vue garde son indice */
+    assert_int_equal(indexA2, BeaconRegistry_getIndex((const uint8_t*) "A2"));
+    assert_int_equal(3, BeaconRegistry_getNbBeacons());
+
+    assert_memory_equal("A1", BeaconRegistry_getName(indexA1), SIZE_BEACON_ID);
+    assert_memory_equal("B1", BeaconRegistry_getName(indexB1), SIZE_BEACON_ID);
+}
+
+static void test_BeaconRegistry_getNameUnknown(void** state) {
+    const uint8_t noName[SIZE_BEACON_ID] = {0};
+
+    BeaconRegistry_getIndex((const uint8_t*) "A1");
+
+    assert_memory_equal(noName, BeaconRegistry_getName(1), SIZE_BEACON_ID);
+    assert_memory_equal(noName, BeaconRegistry_getName(BEACON_INDEX_NONE), SIZE_BEACON_ID);
+}
+
+static void test_BeaconRegistry_full(void** state) {
+    uint8_t name[SIZE_BEACON_ID];
+
+    for (uint16_t i = 0; i < NB_BEACONS_TEST; i++) {
+        composeName(i, name);
+        assert_int_equal(i, BeaconRegistry_getIndex(name));
+    }
+
+    /* Le registre plein refuse les nouvelles balises mais retrouve toujours les anciennes */
+    composeName(NB_BEACONS_TEST, name);
+    assert_int_equal(BEACON_INDEX_NONE, BeaconRegistry_getIndex(name));
+
+    for (uint16_t i = 0; i < NB_BEACONS_TEST; i++) {
+        composeName(i, name);
+        assert_int_equal(i, BeaconRegistry_getIndex(name));
+        assert_memory_equal(name, BeaconRegistry_getName(i), SIZE_BEACON_ID);
+    }
+    assert_int_equal(NB_BEACONS_TEST, BeaconRegistry_getNbBeacons());
+}
+
+static void test_BeaconRegistry_new(void** state) {
+    assert_int_equal(-1, BeaconRegistry_new(0));
+    assert_int_equal(0, BeaconRegistry_getCapacity());
+
+    /* Sans registre, aucune balise n'est enregistree */
+    assert_int_equal(BEACON_INDEX_NONE, BeaconRegistry_getIndex((const uint8_t*) "A1"));
+
+    /* Un nouveau registre repart vide */
+    assert_int_equal(0, BeaconRegistry_new(2));
+    assert_int_equal(0, BeaconRegistry_getIndex((const uint8_t*) "A1"));
+    assert_int_equal(0, BeaconRegistry_new(3));
+    assert_int_equal(3, BeaconRegistry_getCapacity());
+    assert_int_equal(0, BeaconRegistry_getNbBeacons());
+    assert_int_equal(0, BeaconRegistry_getIndex((const uint8_t*) "B1"));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ensemble des tests a executer.
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_BeaconRegistry_getIndex, createRegistry, freeRegistry),
+    cmocka_unit_test_setup_teardown(test_BeaconRegistry_getNameUnknown, createRegistry, freeRegistry),
+    cmocka_unit_test_setup_teardown(test_BeaconRegistry_full, createRegistry, freeRegistry),
+    cmocka_unit_test_setup_teardown(test_BeaconRegistry_new, NULL, freeRegistry),
+};
+
+extern int beaconRegistry_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module BeaconRegistry", tests, NULL, NULL);
+}
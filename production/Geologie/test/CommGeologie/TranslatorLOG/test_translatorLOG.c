@@ -27,7 +27,7 @@
 /**
  * @brief Nombre de suites de tests a excuter.
  */
-#define NB_SUITE_TESTS_TRANSLATOR_LOG (9)
+#define NB_SUITE_TESTS_TRANSLATOR_LOG (10)
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -98,6 +98,13 @@ extern int32_t test_TranslatorLOG_run_translateForRepCalibrationPosition(void);
  */
 extern int32_t test_TranslatorLOG_run_translateSignalCalibrationPosition(void);
 
+/**
+ * @brief Execute les tests de TranslatorLOG_translateForSendBeaconsStatistics.
+ *
+ * @return int32_t 0 en cas de succes, le numero du test qui a echoue sinon.
+ */
+extern int32_t test_TranslatorLOG_run_translateForSendBeaconsStatistics(void);
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Fonctions
@@ -116,7 +123,8 @@ static int32_t (*suite_tests[])(void) = {
     test_TranslatorLOG_run_translateForSendExperimentalTrajects,
     test_TranslatorLOG_run_translateForSendCalibrationData,
     test_TranslatorLOG_run_translateForRepCalibrationPosition,
-    test_TranslatorLOG_run_translateSignalCalibrationPosition
+    test_TranslatorLOG_run_translateSignalCalibrationPosition,
+    test_TranslatorLOG_run_translateForSendBeaconsStatistics
 };
 
 /**
@@ -23,6 +23,7 @@
 
 #include "cmocka.h"
 
+#include "BeaconRegistry/beaconRegistry.h"
 #include "CommGeologie/TranslatorLOG/translatorLOG.h"
 #include "CommGeologie/com_common.h"
 #include "common.h"
@@ -55,19 +56,16 @@ typedef struct {
  */
 static BeaconData beaconsDataTest_A[3] = {
     {
-        .ID = "A1",
         .position = {.X = 0, .Y = 0},
         .power = 0,
         .coefficientAverage = 2
     },
     {
-        .ID = "A2",
         .position = {.X = 2295105740, .Y = 3431517320},
         .power = -100,
         .coefficientAverage = 3.5
     },
     {
-        .ID = "A3",
         .position = {.X = 2857740885, .Y = 1437226410},
         .power = -55.55,
         .coefficientAverage = 2.5
@@ -113,7 +111,6 @@ static Trame trameExpected_A[65] = {
  */
 static BeaconData beaconsDataTest_B[1] = {
     {
-        .ID = "B0",
         .position = { .X = 2863311530, .Y = 1431655765},
         .power = -25.75,
         .coefficientAverage = 4
@@ -173,6 +170,22 @@ static ParameterTestAllBeaconData parameterTest[] = {
  */
 extern int test_TranslatorLOG_run_translateForSendAllBeaconsData(void);
 
+/**
+ * @brief Enregistre les balises des tests et reporte leur indice dans les donnees d'entree.
+ *
+ * @param state Non utilise.
+ * @return int 0.
+ */
+static int registerBeacons(void** state);
+
+/**
+ * @brief Detruit le registre des balises des tests.
+ *
+ * @param state Non utilise.
+ * @return int 0.
+ */
+static int unregisterBeacons(void** state);
+
 /**
  * @brief La fonction test permettant de verifier le bon fonctionnement de TranslatorLOG_translateForSendAllBeaconsData.
  *
@@ -196,7 +209,16 @@ static const struct CMUnitTest testsAllBeaconsData[] = {
 
 
 extern int test_TranslatorLOG_run_translateForSendAllBeaconsData(void) {
-    return cmocka_run_group_tests_name("Test of the module translatorLOG for function TranslatorLOG_translateForSendAllBeaconsData", testsAllBeaconsData, NULL, NULL);
+    return cmocka_run_group_tests_name("Test of the module translatorLOG for function TranslatorLOG_translateForSendAllBeaconsData", testsAllBeaconsData, registerBeacons, unregisterBeacons);
+}
+
+static int registerBeacons(void** state) {
+    BeaconRegistry_new(BEACON_REGISTRY_CAPACITY_DEFAULT);
+    beaconsDataTest_A[0].index = BeaconRegistry_getIndex((const uint8_t*) "A1");
+    beaconsDataTest_A[1].index = BeaconRegistry_getIndex((const uint8_t*) "A2");
+    beaconsDataTest_A[2].index = BeaconRegistry_getIndex((const uint8_t*) "A3");
+    beaconsDataTest_B[0].index = BeaconRegistry_getIndex((const uint8_t*) "B0");
+    return 0;
 }
 
 static void test_TranslatorLOG_translateForSendAllBeaconsData(void** state) {
@@ -212,3 +234,8 @@ static void test_TranslatorLOG_translateForSendAllBeaconsData(void** state) {
     /* Test trame */
     assert_memory_equal(parameter->trameExpected, currentResult, sizeResult);
 }
+
+static int unregisterBeacons(void** state) {
+    BeaconRegistry_free();
+    return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_translatorLOG_sendBeaconsStatistics.c
+ *
+ * @brief Ensemble de test pour tester TranslatorLOG_translateForSendBeaconsStatistics.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cmocka.h"
+
+#include "BeaconRegistry/beaconRegistry.h"
+#include "CommGeologie/TranslatorLOG/translatorLOG.h"
+#include "CommGeologie/com_common.h"
+#include "common.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Structure passee au fonction test.
+ */
+typedef struct {
+    Trame* trameExpected;                       /**< La trame attendue en resultat. */
+    uint16_t sizeTrameExpected;                 /**< La taille de la trame attendue en resultat. */
+    Date dateInput;                             /**< La date donne en entree. */
+    uint8_t nbBeaconInput;                      /**< Le nombre de balises donnee en entree. */
+    BeaconStatistics* beaconsStatisticsInput;   /**< Les statistiques des balises donnees en entree. */
+} ParameterTestBeaconsStatistics;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les statistiques des balises du test A.
+ */
+static BeaconStatistics beaconsStatisticsTest_A[2] = {
+    {
+        .lastSeenAge = 0,
+        .advertisingRate = 0,
+        .rssiMean = 0,
+        .rssiVariance = 0,
+        .nbDropouts = 0
+    },
+    {
+        .lastSeenAge = 16909060,
+        .advertisingRate = 10,
+        .rssiMean = -60.5,
+        .rssiVariance = 2.25,
+        .nbDropouts = 258
+    }
+};
+
+/**
+ * @brief La trame attendue du test A.
+ */
+static Trame trameExpected_A[50] = {
+    // Header
+    SEND_BEACONS_STATISTICS,    // CMD
+    0x00, 0x2F,                 // Size - 47
+
+    0x02,                       // Nb BeaconsStatistics - 2
+
+    0x00, 0x00, 0x00, 0x00,     // Date
+
+    // Beacon S1
+    0x53, 0x31, 0x00,           // ID
+    0x00, 0x00, 0x00, 0x00,     // Last seen age
+    0x00, 0x00, 0x00, 0x00,     // Advertising rate
+    0x00, 0x00, 0x00, 0x00,     // RSSI mean
+    0x00, 0x00, 0x00, 0x00,     // RSSI variance
+    0x00, 0x00,                 // Dropouts
+
+    // Beacon S2
+    0x53, 0x32, 0x00,           // ID
+    0x01, 0x02, 0x03, 0x04,     // Last seen age
+    0x41, 0x20, 0x00, 0x00,     // Advertising rate
+    0xC2, 0x72, 0x00, 0x00,     // RSSI mean
+    0x40, 0x10, 0x00, 0x00,     // RSSI variance
+    0x01, 0x02,                 // Dropouts
+};
+
+/**
+ * @brief La trame attendue du test B, sans balise active.
+ */
+static Trame trameExpected_B[8] = {
+    // Header
+    SEND_BEACONS_STATISTICS,    // CMD
+    0x00, 0x05,                 // Size - 5
+
+    0x00,                       // Nb BeaconsStatistics - 0
+
+    0xA5, 0xA5, 0xA5, 0xA5,     // TimeStamp
+};
+
+/**
+ * @brief Ensemble des donnees de tests.
+ */
+static ParameterTestBeaconsStatistics parameterTest[] = {
+    {
+        .nbBeaconInput = 2,
+        .beaconsStatisticsInput = beaconsStatisticsTest_A,
+        .dateInput = 0,
+        .sizeTrameExpected = 50,
+        .trameExpected = trameExpected_A
+    },
+    {
+        .nbBeaconInput = 0,
+        .beaconsStatisticsInput = NULL,
+        .dateInput = 2779096485,
+        .sizeTrameExpected = 8,
+        .trameExpected = trameExpected_B
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Execute les tests de TranslatorLOG_translateForSendBeaconsStatistics.
+ *
+ * @return int 0 en cas de succes, le numero du test qui a echoue sinon.
+ */
+extern int test_TranslatorLOG_run_translateForSendBeaconsStatistics(void);
+
+/**
+ * @brief Enregistre les balises des tests et reporte leur indice dans les donnees d'entree.
+ *
+ * @param state Non utilise.
+ * @return int 0.
+ */
+static int registerBeacons(void** state);
+
+/**
+ * @brief Detruit le registre des balises des tests.
+ *
+ * @param state Non utilise.
+ * @return int 0.
+ */
+static int unregisterBeacons(void** state);
+
+/**
+ * @brief La fonction test permettant de verifier le bon fonctionnement de TranslatorLOG_translateForSendBeaconsStatistics.
+ *
+ * @param state Les donnees de test #ParameterTestBeaconsStatistics.
+ */
+static void test_TranslatorLOG_translateForSendBeaconsStatistics(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ensemble des tests a executer.
+ */
+static const struct CMUnitTest testsBeaconsStatistics[] = {
+    cmocka_unit_test_prestate(test_TranslatorLOG_translateForSendBeaconsStatistics, &(parameterTest[0])),
+    cmocka_unit_test_prestate(test_TranslatorLOG_translateForSendBeaconsStatistics, &(parameterTest[1])),
+};
+
+
+extern int test_TranslatorLOG_run_translateForSendBeaconsStatistics(void) {
+    return cmocka_run_group_tests_name("Test of the module translatorLOG for function TranslatorLOG_translateForSendBeaconsStatistics", testsBeaconsStatistics, registerBeacons, unregisterBeacons);
+}
+
+static int registerBeacons(void** state) {
+    BeaconRegistry_new(BEACON_REGISTRY_CAPACITY_DEFAULT);
+    beaconsStatisticsTest_A[0].index = BeaconRegistry_getIndex((const uint8_t*) "S1");
+    beaconsStatisticsTest_A[1].index = BeaconRegistry_getIndex((const uint8_t*) "S2");
+    return 0;
+}
+
+static void test_TranslatorLOG_translateForSendBeaconsStatistics(void** state) {
+    ParameterTestBeaconsStatistics* parameter = (ParameterTestBeaconsStatistics*) *state;
+
+    /* Test trame sizeResult */
+    uint16_t sizeResult = TranslatorLOG_getTrameSize(SEND_BEACONS_STATISTICS, parameter->nbBeaconInput);
+    assert_int_equal(parameter->sizeTrameExpected, sizeResult);
+
+    Trame currentResult[sizeResult];
+    TranslatorLOG_translateForSendBeaconsStatistics(parameter->nbBeaconInput, parameter->beaconsStatisticsInput, parameter->dateInput, currentResult);
+
+    /* Test trame */
+    assert_memory_equal(parameter->trameExpected, currentResult, sizeResult);
+}
+
+static int unregisterBeacons(void** state) {
+    BeaconRegistry_free();
+    return 0;
+}
@@ -23,6 +23,7 @@
 
 #include "cmocka.h"
 
+#include "BeaconRegistry/beaconRegistry.h"
 #include "CommGeologie/TranslatorLOG/translatorLOG.h"
 #include "CommGeologie/com_common.h"
 #include "common.h"
@@ -54,17 +55,14 @@ typedef struct {
  */
 static BeaconCoefficients beaconsCoefficient_A1[3] = {
     {
-        .beaconId = "A1",
         .positionId = 0,
         .attenuationCoefficient = 2,
     },
     {
-        .beaconId = "A1",
         .positionId = 255,
         .attenuationCoefficient = 2.5,
     },
     {
-        .beaconId = "A1",
         .positionId = 126,
         .attenuationCoefficient = 4,
     }
@@ -75,7 +73,6 @@ static BeaconCoefficients beaconsCoefficient_A1[3] = {
  */
 static BeaconCoefficients beaconsCoefficient_A2[1] = {
     {
-        .beaconId = "A2",
         .positionId = 75,
         .attenuationCoefficient = 3.5,
     }
@@ -86,13 +83,11 @@ static BeaconCoefficients beaconsCoefficient_A2[1] = {
  */
 static CalibrationData calibrationsData_A[2] = {
     {
-        .beaconId = "A1",
         .beaconCoefficient = beaconsCoefficient_A1,
         .nbCoefficient = 3,
         .coefficientAverage = 2.833,
     },
     {
-        .beaconId = "A2",
         .beaconCoefficient = beaconsCoefficient_A2,
         .nbCoefficient = 1,
         .coefficientAverage = 3.5,
@@ -132,7 +127,6 @@ static Trame trameExpected_A[40] = {
  */
 static BeaconCoefficients beaconsCoefficient_B1[1] = {
     {
-        .beaconId = "B1",
         .positionId = 85,
         .attenuationCoefficient = 3.725,
     },
@@ -143,7 +137,6 @@ static BeaconCoefficients beaconsCoefficient_B1[1] = {
  */
 static CalibrationData calibrationsData_B[1] = {
     {
-        .beaconId = "B1",
         .beaconCoefficient = beaconsCoefficient_B1,
         .nbCoefficient = 1,
         .coefficientAverage = 3.725,
@@ -198,6 +191,22 @@ static ParameterTestCalibrationData parameterTest[] = {
  */
 extern int test_TranslatorLOG_run_translateForSendCalibrationData(void);
 
+/**
+ * @brief Enregistre les balises des tests et reporte leur indice dans les donnees d'entree.
+ *
+ * @param state Non utilise.
+ * @return int 0.
+ */
+static int registerBeacons(void** state);
+
+/**
+ * @brief Detruit le registre des balises des tests.
+ *
+ * @param state Non utilise.
+ * @return int 0.
+ */
+static int unregisterBeacons(void** state);
+
 /**
  * @brief La fonction test permettant de verifier le bon fonctionnement de TranslatorLOG_translateForSendCalibrationData.
  *
@@ -221,7 +230,25 @@ static const struct CMUnitTest testsExperimentalTraject[] = {
 
 
 extern int test_TranslatorLOG_run_translateForSendCalibrationData(void) {
-    return cmocka_run_group_tests_name("Test of the module translatorLOG for function TranslatorLOG_translateForSendCalibrationData", testsExperimentalTraject, NULL, NULL);
+    return cmocka_run_group_tests_name("Test of the module translatorLOG for function TranslatorLOG_translateForSendCalibrationData", testsExperimentalTraject, registerBeacons, unregisterBeacons);
+}
+
+static int registerBeacons(void** state) {
+    BeaconRegistry_new(BEACON_REGISTRY_CAPACITY_DEFAULT);
+    BeaconIndex indexA1 = BeaconRegistry_getIndex((const uint8_t*) "A1");
+    BeaconIndex indexA2 = BeaconRegistry_getIndex((const uint8_t*) "A2");
+    BeaconIndex indexB1 = BeaconRegistry_getIndex((const uint8_t*) "B1");
+
+    for (uint8_t i = 0; i < 3; i++) {
+        beaconsCoefficient_A1[i].beaconIndex = indexA1;
+    }
+    beaconsCoefficient_A2[0].beaconIndex = indexA2;
+    beaconsCoefficient_B1[0].beaconIndex = indexB1;
+
+    calibrationsData_A[0].beaconIndex = indexA1;
+    calibrationsData_A[1].beaconIndex = indexA2;
+    calibrationsData_B[0].beaconIndex = indexB1;
+    return 0;
 }
 
 static void test_TranslatorLOG_translateForSendCalibrationData(void** state) {
@@ -238,3 +265,8 @@ static void test_TranslatorLOG_translateForSendCalibrationData(void** state) {
     /* Test trame */
     assert_memory_equal(parameter->trameExpected, currentResult, sizeResult);
 }
+
+static int unregisterBeacons(void** state) {
+    BeaconRegistry_free();
+    return 0;
+}
@@ -43,13 +43,19 @@
  */
 #define SIZE_TIMESTAMP (4)
 
+/**
+ * @brief La taille de l'anciennete d'une position en octet.
+ */
+#define SIZE_CAPTURE_AGE (4)
+
 /**
  * @brief Structure passee aux fonctions tests.
  */
 typedef struct {
-    Trame trameExpected[SIZE_HEADER + SIZE_POSITION + SIZE_TIMESTAMP];  /**< La #Trame attendue en resultat de TranslatorLOG_translateForSendCurrentPosition */
-    Position positionInput;                                             /**< La #Position passee a TranslatorLOG_translateForSendCurrentPosition */
-    Date dateInput;                                                     /**< La #Date passee a TranslatorLOG_translateForSendCurrentPosition */
+    Trame trameExpected[SIZE_HEADER + SIZE_POSITION + SIZE_TIMESTAMP + SIZE_CAPTURE_AGE];   /**< La #Trame attendue en resultat de TranslatorLOG_translateForSendCurrentPosition */
+    Position positionInput;                                                                 /**< La #Position passee a TranslatorLOG_translateForSendCurrentPosition */
+    uint32_t captureAgeInput;                                                               /**< L'anciennete passee a TranslatorLOG_translateForSendCurrentPosition */
+    Date dateInput;                                                                         /**< La #Date passee a TranslatorLOG_translateForSendCurrentPosition */
 } ParameterTestCurrentPosition;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -64,44 +70,50 @@ typedef struct {
 static ParameterTestCurrentPosition parameterTest[] = {
     {
         .positionInput = { .X = 0, .Y = 0},
+        .captureAgeInput = 0,
         .dateInput = 0,
         .trameExpected = {
             // Header
             SEND_CURRENT_POSITION,          // CMD
-            0x00, 0x0C,                     // Size - 12
+            0x00, 0x10,                     // Size - 16
 
             // Data
             0x00, 0x00, 0x00, 0x00,         // TimeStamp
             0x00, 0x00, 0x00, 0x00,         // Position X
             0x00, 0x00, 0x00, 0x00,         // Position Y
+            0x00, 0x00, 0x00, 0x00,         // Capture age
         }
     },
     {
         .positionInput = { .X = 4294967295, .Y = 4294967295},
+        .captureAgeInput = CAPTURE_AGE_UNKNOWN,
         .dateInput = 4294967295,
         .trameExpected = {
             // Header
             SEND_CURRENT_POSITION,          // CMD
-            0x00, 0x0C,                     // Size - 12
+            0x00, 0x10,                     // Size - 16
 
             // Data
             0xFF, 0xFF, 0xFF, 0xFF,         // TimeStamp
             0xFF, 0xFF, 0xFF, 0xFF,         // Position X
             0xFF, 0xFF, 0xFF, 0xFF,         // Position Y
+            0xFF, 0xFF, 0xFF, 0xFF,         // Capture age
         }
     },
     {
         .positionInput = { .X = 2863311530, .Y = 1431655765},
+        .captureAgeInput = 16909060,
         .dateInput = 2779096485,
         .trameExpected = {
             // Header
             SEND_CURRENT_POSITION,          // CMD
-            0x00, 0x0C,                     // Size - 12
+            0x00, 0x10,                     // Size - 16
 
             // Data
             0xA5, 0xA5, 0xA5, 0xA5,         // TimeStamp
             0xAA, 0xAA, 0xAA, 0xAA,         // Position X
             0x55, 0x55, 0x55, 0x55,         // Position Y
+            0x01, 0x02, 0x03, 0x04,         // Capture age
         }
     },
 };
@@ -151,10 +163,10 @@ static void test_TranslatorLOG_translateForSendCurrentPosition(void** state) {
 
     /* Test trame sizeResult */
     uint16_t sizeResult = TranslatorLOG_getTrameSize(SEND_CURRENT_POSITION, 0);
-    assert_int_equal(SIZE_HEADER + SIZE_POSITION + SIZE_TIMESTAMP, sizeResult);
+    assert_int_equal(SIZE_HEADER + SIZE_POSITION + SIZE_TIMESTAMP + SIZE_CAPTURE_AGE, sizeResult);
 
     Trame currentResult[sizeResult];
-    TranslatorLOG_translateForSendCurrentPosition(&(parameter->positionInput), parameter->dateInput, currentResult);
+    TranslatorLOG_translateForSendCurrentPosition(&(parameter->positionInput), parameter->captureAgeInput, parameter->dateInput, currentResult);
 
     /* Test trame */
     assert_memory_equal(parameter->trameExpected, currentResult, sizeResult);
@@ -0,0 +1,277 @@
+/**
+ * @file filterBank_test.c
+ *
+ * @brief Ensemble de test pour FilterBank.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cmocka.h"
+
+#include "FilterBank/filterBank.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de trames passees dans la mediane glissante pour la comparer a la reference.
+ */
+#define NB_SAMPLES (1000)
+
+/**
+ * @brief La tolerance sur les variances comparees, en dBm carre.
+ */
+#define EPSILON_VARIANCE (1e-4)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La configuration par defaut, restauree apres chaque test.
+ */
+static FilterBankConfiguration defaultConfiguration;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module FilterBank.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int filterBank_run_tests(void);
+
+static void test_FilterBank_configureInvalid(void** state);
+static void test_FilterBank_raw(void** state);
+static void test_FilterBank_ema(void** state);
+static void test_FilterBank_median(void** state);
+static void test_FilterBank_hampel(void** state);
+static void test_FilterBank_reset(void** state);
+static void test_FilterBank_variance(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int saveConfiguration(void** state) {
+    FilterBank_getConfiguration(&defaultConfiguration);
+    return 0;
+}
+
+static int restoreConfiguration(void** state) {
+    configuration = defaultConfiguration;
+    return 0;
+}
+
+static int compareRssi(const void* a, const void* b) {
+    return *(const int8_t*) a - *(const int8_t*) b;
+}
+
+/**
+ * @brief Calcule la mediane des dernieres trames par un tri, comme reference.
+ */
+static int8_t getReferenceMedian(const int8_t* samples, uint32_t nbSamples, uint8_t window) {
+    int8_t sorted[FILTER_BANK_WINDOW_MAX];
+    uint8_t nbValues = nbSamples < window ? nbSamples : window;
+
+    memcpy(sorted, samples + nbSamples - nbValues, nbValues);
+    qsort(sorted, nbValues, sizeof(int8_t), compareRssi);
+
+    if (nbValues % 2 == 1) {
+        return sorted[nbValues / 2];
+    }
+    return (int8_t) lroundf((sorted[nbValues / 2 - 1] + sorted[nbValues / 2]) / 2.0f);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_FilterBank_configureInvalid(void** state) {
+    FilterBankConfiguration invalidConfigurations[] = {
+        {.type = FILTER_BANK_MEDIAN, .window = 0, .alpha = 0.5f, .threshold = 3},
+        {.type = FILTER_BANK_MEDIAN, .window = FILTER_BANK_WINDOW_MAX + 1, .alpha = 0.5f, .threshold = 3},
+        {.type = FILTER_BANK_EMA, .window = 5, .alpha = 0, .threshold = 3},
+        {.type = FILTER_BANK_EMA, .window = 5, .alpha = 1.5f, .threshold = 3},
+        {.type = FILTER_BANK_HAMPEL, .window = 5, .alpha = 0.5f, .threshold = 0},
+        {.type = FILTER_BANK_HAMPEL + 1, .window = 5, .alpha = 0.5f, .threshold = 3}
+    };
+    FilterBankConfiguration currentConfiguration;
+
+    for (uint8_t i = 0; i < sizeof(invalidConfigurations) / sizeof(FilterBankConfiguration); i++) {
+        assert_int_equal(-1, FilterBank_configure(&invalidConfigurations[i]));
+    }
+
+    /* La configuration courante n'a pas change */
+    FilterBank_getConfiguration(&currentConfiguration);
+    assert_int_equal(defaultConfiguration.type, currentConfiguration.type);
+    assert_int_equal(defaultConfiguration.window, currentConfiguration.window);
+}
+
+static void test_FilterBank_raw(void** state) {
+    RssiFilter filter;
+    FilterBank_reset(&filter);
+
+    assert_int_equal(FILTER_BANK_RAW, defaultConfiguration.type);
+    assert_int_equal(-60, FilterBank_update(&filter, -60));
+    assert_int_equal(-90, FilterBank_update(&filter, -90));
+    assert_int_equal(-61, FilterBank_update(&filter, -61));
+}
+
+static void test_FilterBank_ema(void** state) {
+    FilterBankConfiguration emaConfiguration = {.type = FILTER_BANK_EMA, .window = 1, .alpha = 0.5f, .threshold = 3};
+    RssiFilter filter;
+
+    assert_int_equal(0, FilterBank_configure(&emaConfiguration));
+    FilterBank_reset(&filter);
+
+    /* La premiere trame initialise la moyenne */
+    assert_int_equal(-60, FilterBank_update(&filter, -60));
+    assert_int_equal(-65, FilterBank_update(&filter, -70));
+    assert_int_equal(-73, FilterBank_update(&filter, -80));
+    assert_int_equal(-66, FilterBank_update(&filter, -60));
+}
+
+static void test_FilterBank_median(void** state) {
+    const uint8_t windows[] = {1, 2, 5, 8, 9, FILTER_BANK_WINDOW_MAX};
+    int8_t samples[NB_SAMPLES];
+    uint32_t random = 12345;
+    RssiFilter filter;
+
+    for (uint8_t w = 0; w < sizeof(windows); w++) {
+        FilterBankConfiguration medianConfiguration = {.type = FILTER_BANK_MEDIAN, .window = windows[w], .alpha = 0.5f, .threshold = 3};
+        assert_int_equal(0, FilterBank_configure(&medianConfiguration));
+        FilterBank_reset(&filter);
+
+        for (uint32_t i = 0; i < NB_SAMPLES; i++) {
+            /* RSSI pseudo-aleatoires avec beaucoup de valeurs egales */
+            random = random * 1103515245 + 12345;
+            samples[i] = (int8_t) (-40 - (int8_t) ((random >> 16) % 50));
+
+            assert_int_equal(getReferenceMedian(samples, i + 1, windows[w]), FilterBank_update(&filter, samples[i]));
+        }
+    }
+}
+
+static void test_FilterBank_hampel(void** state) {
+    const int8_t noisy[] = {-60, -61, -59, -62, -60, -58, -61, -60, -59};
+    FilterBankConfiguration hampelConfiguration = {.type = FILTER_BANK_HAMPEL, .window = 9, .alpha = 0.5f, .threshold = 3};
+    RssiFilter filter;
+
+    assert_int_equal(0, FilterBank_configure(&hampelConfiguration));
+    FilterBank_reset(&filter);
+
+    /* Le bruit ordinaire passe sans etre modifie */
+    for (uint8_t i = 0; i < sizeof(noisy); i++) {
+        assert_int_equal(noisy[i], FilterBank_update(&filter, noisy[i]));
+    }
+
+    /* Un pic isole est remplace par la mediane */
+    assert_int_equal(-60, FilterBank_update(&filter, -95));
+    assert_int_equal(-61, FilterBank_update(&filter, -61));
+
+    /* Un changement durable finit par etre suivi */
+    int8_t rssi = 0;
+    for (uint8_t i = 0; i < hampelConfiguration.window; i++) {
+        rssi = FilterBank_update(&filter, (int8_t) (-80 + i % 2));
+    }
+    assert_in_range(rssi, -80, -79);
+}
+
+static void test_FilterBank_reset(void** state) {
+    FilterBankConfiguration medianConfiguration = {.type = FILTER_BANK_MEDIAN, .window = 5, .alpha = 0.5f, .threshold = 3};
+    RssiFilter filter;
+
+    assert_int_equal(0, FilterBank_configure(&medianConfiguration));
+    FilterBank_reset(&filter);
+    FilterBank_update(&filter, -90);
+    FilterBank_update(&filter, -90);
+
+    /* Apres une remise a zero, les anciennes trames ne comptent plus */
+    FilterBank_reset(&filter);
+    assert_int_equal(-50, FilterBank_update(&filter, -50));
+}
+
+static void test_FilterBank_variance(void** state) {
+    FilterBankConfiguration rawConfiguration = {.type = FILTER_BANK_RAW, .window = 3, .alpha = 0.5f, .threshold = 3};
+    RssiFilter filter;
+
+    assert_int_equal(0, FilterBank_configure(&rawConfiguration));
+    FilterBank_reset(&filter);
+
+    /* Une seule estimation ne donne pas de variance */
+    FilterBank_update(&filter, -60);
+    assert_float_equal(0, FilterBank_getVariance(&filter), EPSILON_VARIANCE);
+
+    FilterBank_update(&filter, -62);
+    assert_float_equal(1, FilterBank_getVariance(&filter), EPSILON_VARIANCE);
+    FilterBank_update(&filter, -64);
+    assert_float_equal(8.0f / 3, FilterBank_getVariance(&filter), EPSILON_VARIANCE);
+
+    /* Seules les estimations de la fenetre comptent */
+    FilterBank_update(&filter, -64);
+    FilterBank_update(&filter, -64);
+    assert_float_equal(FILTER_BANK_VARIANCE_MIN, FilterBank_getVariance(&filter), EPSILON_VARIANCE);
+
+    /* C'est la dispersion des estimations rendues, pas celle des trames recues */
+    FilterBankConfiguration medianConfiguration = {.type = FILTER_BANK_MEDIAN, .window = 3, .alpha = 0.5f, .threshold = 3};
+    assert_int_equal(0, FilterBank_configure(&medianConfiguration));
+    FilterBank_reset(&filter);
+    FilterBank_update(&filter, -60);
+    FilterBank_update(&filter, -60);
+    FilterBank_update(&filter, -90);
+    assert_float_equal(FILTER_BANK_VARIANCE_MIN, FilterBank_getVariance(&filter), EPSILON_VARIANCE);
+
+    FilterBank_reset(&filter);
+    assert_float_equal(0, FilterBank_getVariance(&filter), EPSILON_VARIANCE);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ensemble des tests a executer.
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_FilterBank_configureInvalid, saveConfiguration, restoreConfiguration),
+    cmocka_unit_test_setup_teardown(test_FilterBank_raw, saveConfiguration, restoreConfiguration),
+    cmocka_unit_test_setup_teardown(test_FilterBank_ema, saveConfiguration, restoreConfiguration),
+    cmocka_unit_test_setup_teardown(test_FilterBank_median, saveConfiguration, restoreConfiguration),
+    cmocka_unit_test_setup_teardown(test_FilterBank_hampel, saveConfiguration, restoreConfiguration),
+    cmocka_unit_test_setup_teardown(test_FilterBank_reset, saveConfiguration, restoreConfiguration),
+    cmocka_unit_test_setup_teardown(test_FilterBank_variance, saveConfiguration, restoreConfiguration),
+};
+
+extern int filterBank_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module FilterBank", tests, NULL, NULL);
+}
@@ -0,0 +1,392 @@
+/**
+ * @file fingerprint_test.c
+ *
+ * @brief Ensemble de test pour Fingerprint.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cmocka.h"
+
+#include "Fingerprint/fingerprint.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de balises aux coins et aux milieux des murs de la piece de test.
+ */
+#define NB_BEACONS_TEST (8)
+
+/**
+ * @brief Le nombre de positions de calibration par cote de la grille de test.
+ */
+#define GRID_SIZE (5)
+
+/**
+ * @brief L'ecart entre deux positions de calibration de la grille, en centimetre.
+ */
+#define GRID_STEP (200)
+
+/**
+ * @brief Le nombre de balises et d'empreintes de la carte aleatoire, plus de balises que de dimensions.
+ */
+#define NB_BEACONS_RANDOM (24)
+#define NB_REFERENCES_RANDOM (3000)
+
+/**
+ * @brief Le nombre de recherches comparees a la recherche exhaustive.
+ */
+#define NB_QUERIES_RANDOM (200)
+
+/**
+ * @brief Le coefficient d'attenuation des balises simulees.
+ */
+#define COEFFICIENT_TEST (2)
+
+/**
+ * @brief L'ecart admis sur une position entre deux positions de calibration, en centimetre.
+ */
+#define EPSILON_POSITION (60)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les balises d'une piece de 10 m de cote.
+ */
+static const Position BEACONS_POSITION[NB_BEACONS_TEST] = {
+    { .X = 0, .Y = 0 },
+    { .X = 500, .Y = 0 },
+    { .X = 1000, .Y = 0 },
+    { .X = 1000, .Y = 500 },
+    { .X = 1000, .Y = 1000 },
+    { .X = 500, .Y = 1000 },
+    { .X = 0, .Y = 1000 },
+    { .X = 0, .Y = 500 },
+};
+
+/**
+ * @brief L'etat du generateur pseudo-aleatoire des cartes aleatoires.
+ */
+static uint32_t randomState;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module Fingerprint.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int fingerprint_run_tests(void);
+
+static int tearDownFingerprint(void** state);
+
+static void test_Fingerprint_disabled(void** state);
+static void test_Fingerprint_nearestReference(void** state);
+static void test_Fingerprint_betweenReferences(void** state);
+static void test_Fingerprint_notEnoughBeacons(void** state);
+static void test_Fingerprint_selectDimensions(void** state);
+static void test_Fingerprint_matchesExhaustiveSearch(void** state);
+static void test_Fingerprint_newCalibration(void** state);
+static void test_Fingerprint_strongestMeasures(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int tearDownFingerprint(void** state) {
+    Fingerprint_free();
+    Fingerprint_setNbNeighbours(0);
+    return 0;
+}
+
+/**
+ * @brief Remplit les balises recues sans bruit depuis une position.
+ */
+static void makeBeaconsData(uint32_t x, uint32_t y, BeaconData* beaconsData) {
+    const Position robot = { .X = x, .Y = y };
+    const AttenuationCoefficient coefficient = COEFFICIENT_TEST;
+
+    for (uint8_t i = 0; i < NB_BEACONS_TEST; i++) {
+        beaconsData[i].index = i;
+        beaconsData[i].position = BEACONS_POSITION[i];
+        beaconsData[i].coefficientAverage = coefficient;
+        beaconsData[i].power = Mathematician_getPower(&BEACONS_POSITION[i], &robot, &coefficient);
+    }
+}
+
+/**
+ * @brief Releve les empreintes de la grille de calibration et construit la carte.
+ */
+static void calibrateGrid() {
+    BeaconData beaconsData[NB_BEACONS_TEST];
+
+    for (uint32_t i = 0; i < GRID_SIZE; i++) {
+        for (uint32_t j = 0; j < GRID_SIZE; j++) {
+            const Position position = { .X = GRID_STEP / 2 + i * GRID_STEP, .Y = GRID_STEP / 2 + j * GRID_STEP };
+            makeBeaconsData(position.X, position.Y, beaconsData);
+            assert_int_equal(0, Fingerprint_addReference(&position, beaconsData, NB_BEACONS_TEST));
+        }
+    }
+    assert_int_equal(0, Fingerprint_build());
+}
+
+/**
+ * @brief Tire une puissance entre -95 et -40 dBm, ou aucune une fois sur quatre.
+ *
+ * @return int32_t La puissance, 0 si la balise n'est pas recue.
+ */
+static int32_t nextRandomPower() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState >> 8) % 4 == 0 ? 0 : -95 + (int32_t) ((randomState >> 12) % 56);
+}
+
+/**
+ * @brief Remplit des balises recues avec des puissances aleatoires.
+ *
+ * @return uint32_t Le nombre de balises recues.
+ */
+static uint32_t makeRandomBeaconsData(BeaconData* beaconsData) {
+    uint32_t nbBeacons = 0;
+
+    for (uint8_t i = 0; i < NB_BEACONS_RANDOM; i++) {
+        int32_t power = nextRandomPower();
+        if (power != 0) {
+            beaconsData[nbBeacons].index = i;
+            beaconsData[nbBeacons].power = (Power) power;
+            nbBeacons++;
+        }
+    }
+    return nbBeacons;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_Fingerprint_disabled(void** state) {
+    const Position position = { .X = 100, .Y = 100 };
+    Position currentPosition = { .X = 1, .Y = 2 };
+    BeaconData beaconsData[NB_BEACONS_TEST];
+
+    /* Sans voisin, aucune empreinte n'est relevee et le calcul reste celui de Mathematician */
+    makeBeaconsData(100, 100, beaconsData);
+    assert_false(Fingerprint_isEnabled());
+    assert_int_equal(-1, Fingerprint_addReference(&position, beaconsData, NB_BEACONS_TEST));
+    assert_int_equal(-1, Fingerprint_build());
+    assert_false(Fingerprint_isReady());
+    assert_int_equal(-1, Fingerprint_getCurrentPosition(beaconsData, NB_BEACONS_TEST, &currentPosition));
+    assert_int_equal(1, currentPosition.X);
+    assert_int_equal(2, currentPosition.Y);
+}
+
+static void test_Fingerprint_nearestReference(void** state) {
+    BeaconData beaconsData[NB_BEACONS_TEST];
+    Position currentPosition;
+
+    Fingerprint_setNbNeighbours(1);
+    calibrateGrid();
+    assert_true(Fingerprint_isReady());
+
+    /* Une empreinte relevee a une position de calibration la retrouve exactement */
+    for (uint32_t i = 0; i < GRID_SIZE; i++) {
+        for (uint32_t j = 0; j < GRID_SIZE; j++) {
+            makeBeaconsData(GRID_STEP / 2 + i * GRID_STEP, GRID_STEP / 2 + j * GRID_STEP, beaconsData);
+            assert_int_equal(0, Fingerprint_getCurrentPosition(beaconsData, NB_BEACONS_TEST, &currentPosition));
+            assert_int_equal(GRID_STEP / 2 + i * GRID_STEP, currentPosition.X);
+            assert_int_equal(GRID_STEP / 2 + j * GRID_STEP, currentPosition.Y);
+        }
+    }
+}
+
+static void test_Fingerprint_betweenReferences(void** state) {
+    BeaconData beaconsData[NB_BEACONS_TEST];
+    Position currentPosition;
+
+    Fingerprint_setNbNeighbours(4);
+    calibrateGrid();
+
+    /* Au centre de quatre positions de calibration, la moyenne ponderee tombe entre elles */
+    makeBeaconsData(400, 600, beaconsData);
+    assert_int_equal(0, Fingerprint_getCurrentPosition(beaconsData, NB_BEACONS_TEST, &currentPosition));
+    assert_in_range(currentPosition.X, 400 - EPSILON_POSITION, 400 + EPSILON_POSITION);
+    assert_in_range(currentPosition.Y, 600 - EPSILON_POSITION, 600 + EPSILON_POSITION);
+}
+
+static void test_Fingerprint_notEnoughBeacons(void** state) {
+    BeaconData beaconsData[NB_BEACONS_TEST];
+    Position currentPosition = { .X = 1, .Y = 2 };
+
+    Fingerprint_setNbNeighbours(3);
+    calibrateGrid();
+
+    /* Deux balises de la carte et une inconnue ne suffisent pas */
+    makeBeaconsData(500, 500, beaconsData);
+    beaconsData[2].index = 200;
+    assert_int_equal(-1, Fingerprint_getCurrentPosition(beaconsData, 3, &currentPosition));
+    assert_int_equal(1, currentPosition.X);
+    assert_int_equal(2, currentPosition.Y);
+}
+
+static void test_Fingerprint_selectDimensions(void** state) {
+    const Position position = { .X = 0, .Y = 0 };
+    BeaconData beaconsData[FINGERPRINT_NB_DIMENSIONS + 4];
+
+    /* Les balises 16 a 19 ne sont recues qu'a la premiere position : elles restent hors de la carte */
+    Fingerprint_setNbNeighbours(1);
+    for (uint8_t i = 0; i < FINGERPRINT_NB_DIMENSIONS + 4; i++) {
+        beaconsData[i].index = i;
+        beaconsData[i].power = -50;
+    }
+    assert_int_equal(0, Fingerprint_addReference(&position, beaconsData, FINGERPRINT_NB_DIMENSIONS + 4));
+    assert_int_equal(0, Fingerprint_addReference(&position, beaconsData, FINGERPRINT_NB_DIMENSIONS));
+    assert_int_equal(0, Fingerprint_build());
+
+    assert_int_equal(FINGERPRINT_NB_DIMENSIONS, nbDimensions);
+    for (uint8_t i = 0; i < FINGERPRINT_NB_DIMENSIONS + 4; i++) {
+        if (i < FINGERPRINT_NB_DIMENSIONS) {
+            assert_in_range(beaconDimensions[i], 0, FINGERPRINT_NB_DIMENSIONS - 1);
+        } else {
+            assert_int_equal(-1, beaconDimensions[i]);
+        }
+    }
+}
+
+static void test_Fingerprint_matchesExhaustiveSearch(void** state) {
+    BeaconData beaconsData[NB_BEACONS_RANDOM];
+    Position currentPosition;
+
+    randomState = 0x9E3779B9U;
+    Fingerprint_setNbNeighbours(FINGERPRINT_NB_NEIGHBOURS_MAX);
+    for (uint32_t r = 0; r < NB_REFERENCES_RANDOM; r++) {
+        const Position position = { .X = r, .Y = 2 * r };
+        uint32_t nbBeacons = makeRandomBeaconsData(beaconsData);
+        assert_int_equal(0, Fingerprint_addReference(&position, beaconsData, nbBeacons));
+    }
+    assert_int_equal(0, Fingerprint_build());
+    assert_int_equal(NB_REFERENCES_RANDOM, nbNodes);
+
+    /* Les voisins trouves dans l'arbre sont a la meme distance que les plus proches de la recherche exhaustive */
+    for (uint32_t q = 0; q < NB_QUERIES_RANDOM; q++) {
+        float nearest[FINGERPRINT_NB_NEIGHBOURS_MAX];
+        uint8_t nbNearest = 0;
+        uint32_t nbBeacons = makeRandomBeaconsData(beaconsData);
+
+        if (Fingerprint_getCurrentPosition(beaconsData, nbBeacons, &currentPosition) < 0) {
+            continue;
+        }
+        for (uint32_t n = 0; n < nbNodes; n++) {
+            float squaredDistance = 0;
+            for (uint8_t d = 0; d < FINGERPRINT_NB_DIMENSIONS; d++) {
+                squaredDistance += (queryRssi[d] - nodes[n].rssi[d]) * (queryRssi[d] - nodes[n].rssi[d]);
+            }
+            uint8_t k = nbNearest < FINGERPRINT_NB_NEIGHBOURS_MAX ? nbNearest++ : FINGERPRINT_NB_NEIGHBOURS_MAX;
+            while (k > 0 && nearest[k - 1] > squaredDistance) {
+                if (k < FINGERPRINT_NB_NEIGHBOURS_MAX) {
+                    nearest[k] = nearest[k - 1];
+                }
+                k--;
+            }
+            if (k < FINGERPRINT_NB_NEIGHBOURS_MAX) {
+                nearest[k] = squaredDistance;
+            }
+        }
+
+        assert_int_equal(FINGERPRINT_NB_NEIGHBOURS_MAX, nbNeighboursFound);
+        for (uint8_t k = 0; k < FINGERPRINT_NB_NEIGHBOURS_MAX; k++) {
+            assert_float_equal(nearest[k], neighbours[k].squaredDistance, 1e-3);
+        }
+    }
+}
+
+static void test_Fingerprint_newCalibration(void** state) {
+    const Position position = { .X = 300, .Y = 700 };
+    BeaconData beaconsData[NB_BEACONS_TEST];
+    Position currentPosition;
+
+    Fingerprint_setNbNeighbours(3);
+    calibrateGrid();
+
+    /* La premiere empreinte apres la construction commence une nouvelle carte */
+    makeBeaconsData(300, 700, beaconsData);
+    assert_int_equal(0, Fingerprint_addReference(&position, beaconsData, NB_BEACONS_TEST));
+    assert_false(Fingerprint_isReady());
+    assert_int_equal(0, Fingerprint_build());
+    assert_int_equal(1, nbNodes);
+
+    makeBeaconsData(800, 200, beaconsData);
+    assert_int_equal(0, Fingerprint_getCurrentPosition(beaconsData, NB_BEACONS_TEST, &currentPosition));
+    assert_int_equal(300, currentPosition.X);
+    assert_int_equal(700, currentPosition.Y);
+}
+
+static void test_Fingerprint_strongestMeasures(void** state) {
+    const Position position = { .X = 0, .Y = 0 };
+    BeaconData beaconsData[FINGERPRINT_NB_MEASURES_MAX + 8];
+
+    /* Les balises les plus fortes arrivent apres une empreinte pleine de balises faibles */
+    Fingerprint_setNbNeighbours(1);
+    for (uint8_t i = 0; i < FINGERPRINT_NB_MEASURES_MAX + 8; i++) {
+        beaconsData[i].index = i;
+        beaconsData[i].power = i < 8 ? -95 : (i < FINGERPRINT_NB_MEASURES_MAX ? -80 : -40 - i);
+    }
+    assert_int_equal(0, Fingerprint_addReference(&position, beaconsData, FINGERPRINT_NB_MEASURES_MAX + 8));
+
+    assert_int_equal(FINGERPRINT_NB_MEASURES_MAX, references[0].nbMeasures);
+    for (uint8_t m = 0; m < references[0].nbMeasures; m++) {
+        assert_true(references[0].beacons[m] >= 8);
+        assert_float_equal(beaconsData[references[0].beacons[m]].power, references[0].powers[m], 0);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_Fingerprint_disabled, NULL, tearDownFingerprint),
+    cmocka_unit_test_setup_teardown(test_Fingerprint_nearestReference, NULL, tearDownFingerprint),
+    cmocka_unit_test_setup_teardown(test_Fingerprint_betweenReferences, NULL, tearDownFingerprint),
+    cmocka_unit_test_setup_teardown(test_Fingerprint_notEnoughBeacons, NULL, tearDownFingerprint),
+    cmocka_unit_test_setup_teardown(test_Fingerprint_selectDimensions, NULL, tearDownFingerprint),
+    cmocka_unit_test_setup_teardown(test_Fingerprint_matchesExhaustiveSearch, NULL, tearDownFingerprint),
+    cmocka_unit_test_setup_teardown(test_Fingerprint_newCalibration, NULL, tearDownFingerprint),
+    cmocka_unit_test_setup_teardown(test_Fingerprint_strongestMeasures, NULL, tearDownFingerprint),
+};
+
+extern int fingerprint_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module Fingerprint", tests, NULL, NULL);
+}
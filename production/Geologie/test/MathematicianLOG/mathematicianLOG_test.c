@@ -35,6 +35,11 @@
 
 #define EPSILON (0.0001)
 #define EPSILONPOSITION (1)
+
+/**
+ * @brief L'ecart tolere sur la position calculee avec une balise bruitee, en centimetre.
+ */
+#define EPSILON_NOISY_POSITION (10)
 /**
  * @struct ParametersTestCalculDistancePosition
  *
@@ -58,6 +63,18 @@ typedef struct {
     float expectedDistance;    /**< Le resultat de la conversion attendue */
 } ParametersTestCalculDistancePower;
 
+/**
+ * @struct ParametersTestGetPower
+ *
+ * @brief Structure des donnees passees en parametre des fonctions de test pour le calcul de la puissance recue d'une balise.
+ */
+typedef struct {
+    AttenuationCoefficient attenuationCoefficient;  /**< Le coefficient d'attenuation */
+    Position beaconPosition;    /**< La position de la balise */
+    Position position;          /**< La position du recepteur */
+    Power expectedPower;        /**< La puissance attendue */
+} ParametersTestGetPower;
+
 /**
  * @struct ParametersTestGetAverageCalcul
  *
@@ -100,6 +117,17 @@ typedef struct {
     Position expectedCurrentPosition;    /**< Le resultat de la conversion attendue */
 } ParametersTestGetCurrentPosition;
 
+/**
+ * @struct ParametersTestGetCaptureTime
+ *
+ * @brief Structure des donnees passees en parametre des fonctions de test pour la date de capture de la position.
+ */
+typedef struct {
+    BeaconData * beaconsData;       /**< Les données balises données en entrée */
+    uint8_t nbBeacon;               /**< nombre de balise. */
+    uint64_t expectedCaptureTime;   /**< La date de capture attendue */
+} ParametersTestGetCaptureTime;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //                                              Variable et structure extern
@@ -158,6 +186,18 @@ static ParametersTestCalculDistancePower parametersTestCalculDistancePower[] = {
     {.attenuationCoefficient = 6,.power = -80,   .expectedDistance = 316.2277}
 };
 
+/**
+ * @brief Tableau contenant les donnees de test pour le calcul de la puissance recue, inverses de #parametersTestCalculDistancePower.
+ *
+ */
+static ParametersTestGetPower parametersTestGetPower[] = {
+    {.attenuationCoefficient = 1, .beaconPosition = {.X = 0, .Y = 0}, .position = {.X = 100, .Y = 0},    .expectedPower = -50},
+    {.attenuationCoefficient = 2, .beaconPosition = {.X = 500, .Y = 500}, .position = {.X = 500, .Y = 3662},    .expectedPower = -79.99924},
+    {.attenuationCoefficient = 3, .beaconPosition = {.X = 300, .Y = 400}, .position = {.X = 0, .Y = 0},    .expectedPower = -70.9691},
+    {.attenuationCoefficient = 4, .beaconPosition = {.X = 1000, .Y = 0}, .position = {.X = 0, .Y = 0},    .expectedPower = -90},
+    {.attenuationCoefficient = 2, .beaconPosition = {.X = 600, .Y = 200}, .position = {.X = 600, .Y = 200},    .expectedPower = -30}
+};
+
 /**
  * @brief Teste le calcul d'une distance avec deux positions.
  *
@@ -227,6 +267,13 @@ static BeaconCoefficients beaconsDataTest_B[5] = {
  */
 static void test_distanceCalculWithPower(void** state);
 
+/**
+ * @brief Teste le calcul de la puissance recue d'une balise
+ *
+ * @param state
+ */
+static void test_getPower(void** state);
+
 /**
  * @brief Teste le calcul de la position actuelle
  *
@@ -235,6 +282,62 @@ static void test_distanceCalculWithPower(void** state);
 
 static void test_getCurrentPosition(void** state);
 
+/**
+ * @brief Teste le calcul de la position actuelle avec des balises alignees ou trop peu nombreuses
+ *
+ * @param state
+ */
+static void test_getCurrentPositionDegenerate(void** state);
+
+/**
+ * @brief Teste que le poids d'une balise au RSSI instable limite son erreur sur la position actuelle
+ *
+ * @param state
+ */
+static void test_getCurrentPositionWeighted(void** state);
+
+/**
+ * @brief Teste l'affinage d'une position proche de la position reelle
+ *
+ * @param state
+ */
+static void test_refineCurrentPositionWarmStart(void** state);
+
+/**
+ * @brief Teste que l'affinage reduit les ecarts de distance de la position des moindres carres lineaires
+ *
+ * @param state
+ */
+static void test_refineCurrentPositionNoisy(void** state);
+
+/**
+ * @brief Teste l'affinage avec trop peu de balises
+ *
+ * @param state
+ */
+static void test_refineCurrentPositionDegenerate(void** state);
+
+/**
+ * @brief Teste la date de capture de la position actuelle
+ *
+ * @param state
+ */
+static void test_getCaptureTime(void** state);
+
+/**
+ * @brief Teste que la table des distances suit le modele d'attenuation pour chaque RSSI entier
+ *
+ * @param state
+ */
+static void test_fillRangeTable(void** state);
+
+/**
+ * @brief Teste que la distance d'une balise est lue dans sa table quand sa puissance est entiere
+ *
+ * @param state
+ */
+static void test_getRangeTable(void** state);
+
 /**
  * @brief Ensemble des donnees de tests pour le calcul des moyennes des coefficient d'attenuation.
  */
@@ -321,7 +424,7 @@ static BeaconData parametersTestGetCurrentPositionB[4] = {
     },
     {
         .position = { .X = 1600, .Y= 1700},
-        .power = -98,
+        .power = -97.74779653,
         .coefficientAverage = 4,
     }
 };
@@ -401,6 +504,63 @@ static ParametersTestGetCurrentPosition parameterTestCurrentPosition[] = {
     }
 };
 
+/**
+ * @brief Des balises alignees sur l'axe des abscisses, avec lesquelles aucune position ne peut etre calculee.
+ */
+static BeaconData parametersTestGetCurrentPositionAligned[3] = {
+    {
+        .position = { .X = 0, .Y= 400},
+        .power = -70,
+        .coefficientAverage = 3,
+    },
+    {
+        .position = { .X = 600, .Y= 400},
+        .power = -65,
+        .coefficientAverage = 3,
+    },
+    {
+        .position = { .X = 1400, .Y= 400},
+        .power = -75,
+        .coefficientAverage = 3,
+    }
+};
+
+/**
+ * @brief Les balises, plus fortes en tete, dont la derniere est la plus ancienne : toutes sont utilisees pour la position.
+ */
+static BeaconData parametersTestGetCaptureTimeA[4] = {
+    { .timestamp = 3000000000 },
+    { .timestamp = 1500000000 },
+    { .timestamp = 2000000000 },
+    { .timestamp = 1000000000 },
+};
+
+/**
+ * @brief Ensemble des donnees de tests pour la date de capture de la position actuelle.
+ */
+static ParametersTestGetCaptureTime parameterTestCaptureTime[] = {
+    {
+        .nbBeacon = 4,
+        .beaconsData = parametersTestGetCaptureTimeA,
+        .expectedCaptureTime = 1000000000,
+    },
+    {
+        .nbBeacon = 3,
+        .beaconsData = parametersTestGetCaptureTimeA,
+        .expectedCaptureTime = 1500000000,
+    },
+    {
+        .nbBeacon = 1,
+        .beaconsData = parametersTestGetCaptureTimeA,
+        .expectedCaptureTime = 3000000000,
+    },
+    {
+        .nbBeacon = 0,
+        .beaconsData = parametersTestGetCaptureTimeA,
+        .expectedCaptureTime = 0,
+    }
+};
+
 /**
  * @brief Teste la moyenne des coefficient d'attenuation avec différentes balises
  *
@@ -447,6 +607,13 @@ static const struct CMUnitTest tests[] =
     cmocka_unit_test_prestate(test_distanceCalculWithPower, &(parametersTestCalculDistancePower[13])),
     cmocka_unit_test_prestate(test_distanceCalculWithPower, &(parametersTestCalculDistancePower[14])),
 
+    // Calcul de la puissance recue
+    cmocka_unit_test_prestate(test_getPower, &(parametersTestGetPower[0])),
+    cmocka_unit_test_prestate(test_getPower, &(parametersTestGetPower[1])),
+    cmocka_unit_test_prestate(test_getPower, &(parametersTestGetPower[2])),
+    cmocka_unit_test_prestate(test_getPower, &(parametersTestGetPower[3])),
+    cmocka_unit_test_prestate(test_getPower, &(parametersTestGetPower[4])),
+
     // Calcul du coefficient d'attenuation
 
     cmocka_unit_test_prestate(test_getAverageCalcul, &(parameterTest[0])),
@@ -463,6 +630,23 @@ static const struct CMUnitTest tests[] =
     cmocka_unit_test_prestate(test_getCurrentPosition, &(parameterTestCurrentPosition[1])),
     cmocka_unit_test_prestate(test_getCurrentPosition, &(parameterTestCurrentPosition[2])),
     cmocka_unit_test_prestate(test_getCurrentPosition, &(parameterTestCurrentPosition[3])),
+    cmocka_unit_test(test_getCurrentPositionDegenerate),
+    cmocka_unit_test(test_getCurrentPositionWeighted),
+    cmocka_unit_test(test_refineCurrentPositionWarmStart),
+    cmocka_unit_test(test_refineCurrentPositionNoisy),
+    cmocka_unit_test(test_refineCurrentPositionDegenerate),
+
+    // Date de capture de la position actuelle
+
+    cmocka_unit_test_prestate(test_getCaptureTime, &(parameterTestCaptureTime[0])),
+    cmocka_unit_test_prestate(test_getCaptureTime, &(parameterTestCaptureTime[1])),
+    cmocka_unit_test_prestate(test_getCaptureTime, &(parameterTestCaptureTime[2])),
+    cmocka_unit_test_prestate(test_getCaptureTime, &(parameterTestCaptureTime[3])),
+
+    // Table des distances par RSSI
+
+    cmocka_unit_test(test_fillRangeTable),
+    cmocka_unit_test(test_getRangeTable),
 };
 
 /**
@@ -490,6 +674,13 @@ static void test_distanceCalculWithPower(void** state) {
     assert_float_equal(result, param->expectedDistance, EPSILON);
 }
 
+static void test_getPower(void** state) {
+    ParametersTestGetPower* param = (ParametersTestGetPower*) *state;
+    Power result;
+    result = Mathematician_getPower(&param->beaconPosition, &param->position, &param->attenuationCoefficient);
+    assert_float_equal(result, param->expectedPower, EPSILON);
+}
+
 static void test_getAverageCalcul(void** state) {
     ParametersTestGetAverageCalcul * param = (ParametersTestGetAverageCalcul*) *state;
     float result;
@@ -510,3 +701,161 @@ static void test_getCurrentPosition(void** state) {
     assert_float_equal(param->currentPosition.X, param->expectedCurrentPosition.X,EPSILONPOSITION);
     assert_float_equal(param->currentPosition.Y, param->expectedCurrentPosition.Y,EPSILONPOSITION);
 }
+
+static void test_getCurrentPositionDegenerate(void** state) {
+    Position currentPosition = { .X = 123, .Y = 456 };
+
+    assert_int_equal(-1, Mathematician_getCurrentPosition(parametersTestGetCurrentPositionAligned, 3, &currentPosition));
+    assert_int_equal(-1, Mathematician_getCurrentPosition(parametersTestGetCurrentPositionA, 2, &currentPosition));
+
+    /* La position precedente est conservee */
+    assert_int_equal(123, currentPosition.X);
+    assert_int_equal(456, currentPosition.Y);
+
+    assert_int_equal(0, Mathematician_getCurrentPosition(parametersTestGetCurrentPositionA, 3, &currentPosition));
+}
+
+static void test_getCurrentPositionWeighted(void** state) {
+    const Position expectedPosition = { .X = 600, .Y = 500 };
+    const Position beaconsPosition[] = {
+        { .X = 0, .Y = 0 }, { .X = 1200, .Y = 0 }, { .X = 1200, .Y = 1000 },
+        { .X = 0, .Y = 1000 }, { .X = 600, .Y = 1400 }, { .X = 300, .Y = 300 }
+    };
+    const uint32_t nbBeacons = sizeof(beaconsPosition) / sizeof(beaconsPosition[0]);
+    BeaconData beaconsData[sizeof(beaconsPosition) / sizeof(beaconsPosition[0])];
+    Position currentPosition;
+
+    for (uint32_t i = 0; i < nbBeacons; i++) {
+        beaconsData[i].position = beaconsPosition[i];
+        beaconsData[i].coefficientAverage = 3;
+        beaconsData[i].power = Mathematician_getPower(&beaconsPosition[i], &expectedPosition, &beaconsData[i].coefficientAverage);
+        beaconsData[i].rssiVariance = 4;
+        beaconsData[i].rangeTable = NULL;
+    }
+
+    /* Sans bruit, toutes les balises donnent la meme position */
+    assert_int_equal(0, Mathematician_getCurrentPosition(beaconsData, nbBeacons, &currentPosition));
+    assert_float_equal(currentPosition.X, expectedPosition.X, EPSILONPOSITION);
+    assert_float_equal(currentPosition.Y, expectedPosition.Y, EPSILONPOSITION);
+
+    /* La balise la plus proche se trompe de 6 dB mais son RSSI est tres instable */
+    beaconsData[5].power += 6;
+    beaconsData[5].rssiVariance = 400;
+    assert_int_equal(0, Mathematician_getCurrentPosition(beaconsData, nbBeacons, &currentPosition));
+    assert_float_equal(currentPosition.X, expectedPosition.X, EPSILON_NOISY_POSITION);
+    assert_float_equal(currentPosition.Y, expectedPosition.Y, EPSILON_NOISY_POSITION);
+}
+
+static void test_refineCurrentPositionWarmStart(void** state) {
+    MathematicianSolveReport report;
+
+    /* Le recepteur s'est deplace de quelques centimetres depuis la position precedente */
+    Position currentPosition = { .X = 815, .Y = 490 };
+
+    assert_int_equal(0, Mathematician_refineCurrentPosition(parametersTestGetCurrentPositionA, 3, &currentPosition, &report));
+    assert_true(report.converged);
+    assert_true(report.nbIterations <= 3);
+    assert_true(report.residual < 1);
+    assert_float_equal(currentPosition.X, 800, EPSILONPOSITION);
+    assert_float_equal(currentPosition.Y, 500, EPSILONPOSITION);
+}
+
+static void test_refineCurrentPositionNoisy(void** state) {
+    const Position expectedPosition = { .X = 600, .Y = 500 };
+    const Position beaconsPosition[] = {
+        { .X = 0, .Y = 0 }, { .X = 1200, .Y = 0 }, { .X = 1200, .Y = 1000 }, { .X = 0, .Y = 1000 }, { .X = 600, .Y = 1400 }
+    };
+    const Power noise[] = { 1.5, -2, 0.5, -1, 2.5 };
+    const uint32_t nbBeacons = sizeof(beaconsPosition) / sizeof(beaconsPosition[0]);
+    BeaconData beaconsData[sizeof(beaconsPosition) / sizeof(beaconsPosition[0])];
+    MathematicianSolveReport report;
+    RangeSystem linearSystem;
+    RangeSystem refinedSystem;
+    Position currentPosition;
+
+    for (uint32_t i = 0; i < nbBeacons; i++) {
+        beaconsData[i].position = beaconsPosition[i];
+        beaconsData[i].coefficientAverage = 3;
+        beaconsData[i].power = Mathematician_getPower(&beaconsPosition[i], &expectedPosition, &beaconsData[i].coefficientAverage) + noise[i];
+        beaconsData[i].rssiVariance = 4;
+        beaconsData[i].rangeTable = NULL;
+    }
+
+    assert_int_equal(0, Mathematician_getCurrentPosition(beaconsData, nbBeacons, &currentPosition));
+    accumulateRangeSystem(beaconsData, nbBeacons, currentPosition.X, currentPosition.Y, &linearSystem);
+
+    assert_int_equal(0, Mathematician_refineCurrentPosition(beaconsData, nbBeacons, &currentPosition, &report));
+    assert_true(report.converged);
+    assert_true(report.nbIterations <= MATHEMATICIAN_NB_ITERATIONS_MAX);
+    accumulateRangeSystem(beaconsData, nbBeacons, currentPosition.X, currentPosition.Y, &refinedSystem);
+
+    assert_true(refinedSystem.cost <= linearSystem.cost);
+    assert_float_equal(report.residual, sqrt(refinedSystem.squaredResiduals / nbBeacons), 1);
+}
+
+static void test_refineCurrentPositionDegenerate(void** state) {
+    MathematicianSolveReport report;
+    Position currentPosition = { .X = 123, .Y = 456 };
+
+    assert_int_equal(-1, Mathematician_refineCurrentPosition(parametersTestGetCurrentPositionA, 2, &currentPosition, &report));
+    assert_int_equal(123, currentPosition.X);
+    assert_int_equal(456, currentPosition.Y);
+
+    /* Avec des balises alignees l'amortissement garde un pas defini */
+    assert_int_equal(0, Mathematician_refineCurrentPosition(parametersTestGetCurrentPositionAligned, 3, &currentPosition, &report));
+    assert_true(report.nbIterations <= MATHEMATICIAN_NB_ITERATIONS_MAX);
+}
+
+static void test_getCaptureTime(void** state) {
+    ParametersTestGetCaptureTime* param = (ParametersTestGetCaptureTime*) *state;
+    assert_int_equal(param->expectedCaptureTime, Mathematician_getCaptureTime(param->beaconsData, param->nbBeacon));
+}
+
+static void test_fillRangeTable(void** state) {
+    const AttenuationCoefficient coefficients[] = { 2, 3.2 };
+    RangeTable rangeTable;
+
+    for (uint8_t c = 0; c < sizeof(coefficients) / sizeof(coefficients[0]); c++) {
+        Mathematician_fillRangeTable(&coefficients[c], &rangeTable);
+        assert_float_equal(rangeTable.coefficient, coefficients[c], EPSILON);
+        assert_float_equal(rangeTable.relativeDeviation, log(10) / (10 * coefficients[c]), 1e-6);
+        for (int16_t rssi = INT8_MIN; rssi <= INT8_MAX; rssi++) {
+            Power power = rssi;
+            double expectedDistance = distanceCalculWithPower(&power, &coefficients[c]);
+            assert_float_equal(rangeTable.distances[rssi - INT8_MIN], expectedDistance, expectedDistance * 1e-6);
+        }
+    }
+}
+
+static void test_getRangeTable(void** state) {
+    RangeTable rangeTable;
+    BeaconData beaconData = { .power = -70, .coefficientAverage = 3, .rssiVariance = 4 };
+    float expectedDistance;
+    float expectedVariance;
+    float distance;
+    float variance;
+
+    assert_int_equal(0, Mathematician_getRange(&beaconData, &expectedDistance, &expectedVariance));
+
+    /* La table donne la meme distance et la meme variance que le calcul */
+    Mathematician_fillRangeTable(&beaconData.coefficientAverage, &rangeTable);
+    beaconData.rangeTable = &rangeTable;
+    assert_int_equal(0, Mathematician_getRange(&beaconData, &distance, &variance));
+    assert_float_equal(distance, expectedDistance, expectedDistance * 1e-6);
+    assert_float_equal(variance, expectedVariance, expectedVariance * 1e-5);
+
+    /* L'ecart type relatif vient lui aussi de la table, sans logarithme */
+    rangeTable.relativeDeviation *= 2;
+    assert_int_equal(0, Mathematician_getRange(&beaconData, &distance, &variance));
+    assert_float_equal(variance, 4 * expectedVariance, expectedVariance * 1e-5);
+
+    /* La distance d'un RSSI entier vient de la table, celle d'une puissance fractionnaire du calcul */
+    rangeTable.distances[-70 - INT8_MIN] = 1234;
+    assert_int_equal(0, Mathematician_getRange(&beaconData, &distance, &variance));
+    assert_float_equal(distance, 1234, EPSILON);
+
+    beaconData.power = -70.5;
+    Power power = beaconData.power;
+    assert_int_equal(0, Mathematician_getRange(&beaconData, &distance, &variance));
+    assert_float_equal(distance, distanceCalculWithPower(&power, &beaconData.coefficientAverage), 1e-2);
+}
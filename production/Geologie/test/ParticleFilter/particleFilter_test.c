@@ -0,0 +1,311 @@
+/**
+ * @file particleFilter_test.c
+ *
+ * @brief Ensemble de test pour ParticleFilter.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cmocka.h"
+
+#include "ParticleFilter/particleFilter.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de balises aux coins de la piece de test.
+ */
+#define NB_BEACONS_TEST (4)
+
+/**
+ * @brief Le nombre de particules des tests de position, volontairement pas multiple de la taille d'une tranche.
+ */
+#define NB_PARTICLES_TEST (10001)
+
+/**
+ * @brief La duree d'un cycle simule, en nanoseconde.
+ */
+#define CYCLE_DURATION (100000000ULL)
+
+/**
+ * @brief Le nombre de cycles simules avant de verifier la position.
+ */
+#define NB_CYCLES_TEST (10)
+
+/**
+ * @brief Le coefficient d'attenuation des balises simulees.
+ */
+#define COEFFICIENT_TEST (2)
+
+/**
+ * @brief L'ecart admis sur une position, en centimetre.
+ */
+#define EPSILON_POSITION (20)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les balises aux coins d'une piece de 10 m de cote.
+ */
+static const Position BEACONS_POSITION[NB_BEACONS_TEST] = {
+    { .X = 0, .Y = 0 },
+    { .X = 1000, .Y = 0 },
+    { .X = 1000, .Y = 1000 },
+    { .X = 0, .Y = 1000 },
+};
+
+/**
+ * @brief La date de capture du dernier cycle simule, en nanoseconde.
+ */
+static uint64_t captureTime;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module ParticleFilter.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int particleFilter_run_tests(void);
+
+static int setUpOneWorker(void** state);
+static int setUpFourWorkers(void** state);
+static int tearDownParticleFilter(void** state);
+
+static void test_ParticleFilter_disabled(void** state);
+static void test_ParticleFilter_notEnoughBeacons(void** state);
+static void test_ParticleFilter_stationary(void** state);
+static void test_ParticleFilter_split(void** state);
+static void test_ParticleFilter_resampleSystematic(void** state);
+static void test_ParticleFilter_kidnapped(void** state);
+static void test_ParticleFilter_strongestBeacons(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int setUpOneWorker(void** state) {
+    captureTime = 1000000000ULL;
+    ParticleFilter_setNbParticles(NB_PARTICLES_TEST);
+    ParticleFilter_setNbWorkers(1);
+    return ParticleFilter_new();
+}
+
+static int setUpFourWorkers(void** state) {
+    captureTime = 1000000000ULL;
+    ParticleFilter_setNbParticles(NB_PARTICLES_TEST);
+    ParticleFilter_setNbWorkers(4);
+    return ParticleFilter_new();
+}
+
+static int tearDownParticleFilter(void** state) {
+    ParticleFilter_free();
+    ParticleFilter_setNbParticles(0);
+    ParticleFilter_setNbWorkers(0);
+    return 0;
+}
+
+/**
+ * @brief Simule des cycles ou les balises sont recues sans bruit depuis une position.
+ *
+ * @return int8_t Le retour du dernier cycle.
+ */
+static int8_t runCycles(uint32_t nbCycles, uint32_t x, uint32_t y, Position* position) {
+    const Position robot = { .X = x, .Y = y };
+    const AttenuationCoefficient coefficient = COEFFICIENT_TEST;
+    BeaconData beaconsData[NB_BEACONS_TEST];
+    int8_t returnError = -1;
+
+    for (uint32_t cycle = 0; cycle < nbCycles; cycle++) {
+        captureTime += CYCLE_DURATION;
+        for (uint8_t i = 0; i < NB_BEACONS_TEST; i++) {
+            beaconsData[i].index = i;
+            beaconsData[i].position = BEACONS_POSITION[i];
+            beaconsData[i].coefficientAverage = coefficient;
+            beaconsData[i].power = Mathematician_getPower(&BEACONS_POSITION[i], &robot, &coefficient);
+            beaconsData[i].timestamp = captureTime;
+            beaconsData[i].rssiVariance = MATHEMATICIAN_RSSI_VARIANCE_MIN;
+            beaconsData[i].rangeTable = NULL;
+        }
+        returnError = ParticleFilter_getCurrentPosition(beaconsData, NB_BEACONS_TEST, position);
+    }
+    return returnError;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_ParticleFilter_disabled(void** state) {
+    Position position = { .X = 1, .Y = 2 };
+
+    /* Sans particule, le calcul reste celui de Mathematician */
+    assert_int_equal(0, ParticleFilter_new());
+    assert_false(ParticleFilter_isEnabled());
+    assert_int_equal(-1, runCycles(1, 300, 600, &position));
+    assert_int_equal(1, position.X);
+    assert_int_equal(2, position.Y);
+    ParticleFilter_free();
+}
+
+static void test_ParticleFilter_notEnoughBeacons(void** state) {
+    Position position = { .X = 1, .Y = 2 };
+    BeaconData beaconsData[2] = {
+        { .position = { .X = 0, .Y = 0 }, .power = -60, .coefficientAverage = COEFFICIENT_TEST },
+        { .position = { .X = 1000, .Y = 0 }, .power = -60, .coefficientAverage = COEFFICIENT_TEST },
+    };
+
+    assert_true(ParticleFilter_isEnabled());
+    assert_int_equal(-1, ParticleFilter_getCurrentPosition(beaconsData, 2, &position));
+    assert_int_equal(1, position.X);
+    assert_int_equal(2, position.Y);
+}
+
+static void test_ParticleFilter_stationary(void** state) {
+    Position position;
+
+    assert_int_equal(0, runCycles(NB_CYCLES_TEST, 300, 600, &position));
+    assert_in_range(position.X, 300 - EPSILON_POSITION, 300 + EPSILON_POSITION);
+    assert_in_range(position.Y, 600 - EPSILON_POSITION, 600 + EPSILON_POSITION);
+}
+
+static void test_ParticleFilter_split(void** state) {
+    Position position;
+
+    /* Les tranches se suivent, commencent sur une ligne de cache et couvrent toutes les particules */
+    assert_int_equal(4, nbWorkers);
+    assert_int_equal(0, workers[0].begin);
+    for (uint8_t i = 0; i < nbWorkers; i++) {
+        assert_int_equal(0, workers[i].begin % CHUNK_GRANULARITY);
+        if (i > 0) {
+            assert_int_equal(workers[i - 1].end, workers[i].begin);
+        }
+    }
+    assert_int_equal(NB_PARTICLES_TEST, workers[nbWorkers - 1].end);
+
+    assert_int_equal(0, runCycles(NB_CYCLES_TEST, 300, 600, &position));
+    assert_in_range(position.X, 300 - EPSILON_POSITION, 300 + EPSILON_POSITION);
+    assert_in_range(position.Y, 600 - EPSILON_POSITION, 600 + EPSILON_POSITION);
+}
+
+static void test_ParticleFilter_resampleSystematic(void** state) {
+    uint32_t nbCopies[3] = { 0, 0, 0 };
+
+    /* La moitie du poids sur la particule 3, un quart sur les particules 5000 et 9000 */
+    for (uint32_t i = 0; i < NB_PARTICLES_TEST; i++) {
+        particlesX[i] = (float) i;
+        particlesY[i] = 0;
+        weights[i] = i == 3 ? 0.5f : (i == 5000 || i == 9000 ? 0.25f : 0);
+    }
+    totalWeight = 0;
+    for (uint8_t w = 0; w < nbWorkers; w++) {
+        workers[w].cumulativeWeight = totalWeight;
+        workers[w].sumWeights = 0;
+        for (uint32_t i = workers[w].begin; i < workers[w].end; i++) {
+            workers[w].sumWeights += weights[i];
+        }
+        totalWeight += workers[w].sumWeights;
+    }
+    resampleOffset = 0.5;
+    runPhase(PHASE_RESAMPLE);
+
+    /* Le reechantillonnage systematique copie chaque particule a une unite pres de son poids fois N */
+    for (uint32_t k = 0; k < NB_PARTICLES_TEST; k++) {
+        nbCopies[0] += resampledX[k] == 3;
+        nbCopies[1] += resampledX[k] == 5000;
+        nbCopies[2] += resampledX[k] == 9000;
+    }
+    assert_int_equal(NB_PARTICLES_TEST, nbCopies[0] + nbCopies[1] + nbCopies[2]);
+    assert_in_range(nbCopies[0], NB_PARTICLES_TEST / 2, NB_PARTICLES_TEST / 2 + 1);
+    assert_in_range(nbCopies[1], NB_PARTICLES_TEST / 4, NB_PARTICLES_TEST / 4 + 1);
+    assert_in_range(nbCopies[2], NB_PARTICLES_TEST / 4, NB_PARTICLES_TEST / 4 + 1);
+}
+
+static void test_ParticleFilter_kidnapped(void** state) {
+    Position position;
+
+    assert_int_equal(0, runCycles(NB_CYCLES_TEST, 300, 600, &position));
+
+    /* Le robot est deplace d'un coup : les particules sont reparties et retrouvent la nouvelle position */
+    assert_int_equal(0, runCycles(NB_CYCLES_TEST, 800, 200, &position));
+    assert_in_range(position.X, 800 - EPSILON_POSITION, 800 + EPSILON_POSITION);
+    assert_in_range(position.Y, 200 - EPSILON_POSITION, 200 + EPSILON_POSITION);
+}
+
+static void test_ParticleFilter_strongestBeacons(void** state) {
+    BeaconData beaconsData[PARTICLE_FILTER_NB_BEACONS_MAX + NB_BEACONS_TEST];
+    const uint32_t nbBeacons = PARTICLE_FILTER_NB_BEACONS_MAX + NB_BEACONS_TEST;
+    Position position;
+
+    /* Les balises les plus fortes arrivent apres une table pleine de balises faibles, dont les quatre premieres plus encore */
+    for (uint32_t i = 0; i < nbBeacons; i++) {
+        beaconsData[i].index = (BeaconIndex) i;
+        beaconsData[i].position = BEACONS_POSITION[i % NB_BEACONS_TEST];
+        beaconsData[i].coefficientAverage = COEFFICIENT_TEST;
+        beaconsData[i].power = i < NB_BEACONS_TEST ? -95 : (i < PARTICLE_FILTER_NB_BEACONS_MAX ? -90 : -50 - (Power) (i - PARTICLE_FILTER_NB_BEACONS_MAX));
+        beaconsData[i].timestamp = captureTime;
+        beaconsData[i].rssiVariance = MATHEMATICIAN_RSSI_VARIANCE_MIN;
+        beaconsData[i].rangeTable = NULL;
+    }
+
+    assert_int_equal(0, ParticleFilter_getCurrentPosition(beaconsData, nbBeacons, &position));
+    assert_int_equal(PARTICLE_FILTER_NB_BEACONS_MAX, nbBeaconsUsed);
+
+    /* Les plus fortes ont pris la place des plus faibles */
+    uint32_t nbStrongest = 0;
+    for (uint32_t b = 0; b < nbBeaconsUsed; b++) {
+        nbStrongest += beaconsPower[b] > -90;
+        assert_true(beaconsPower[b] >= -90);
+    }
+    assert_int_equal(NB_BEACONS_TEST, nbStrongest);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_ParticleFilter_disabled, NULL, tearDownParticleFilter),
+    cmocka_unit_test_setup_teardown(test_ParticleFilter_notEnoughBeacons, setUpOneWorker, tearDownParticleFilter),
+    cmocka_unit_test_setup_teardown(test_ParticleFilter_stationary, setUpOneWorker, tearDownParticleFilter),
+    cmocka_unit_test_setup_teardown(test_ParticleFilter_split, setUpFourWorkers, tearDownParticleFilter),
+    cmocka_unit_test_setup_teardown(test_ParticleFilter_resampleSystematic, setUpFourWorkers, tearDownParticleFilter),
+    cmocka_unit_test_setup_teardown(test_ParticleFilter_kidnapped, setUpFourWorkers, tearDownParticleFilter),
+    cmocka_unit_test_setup_teardown(test_ParticleFilter_strongestBeacons, setUpOneWorker, tearDownParticleFilter),
+};
+
+extern int particleFilter_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module ParticleFilter", tests, NULL, NULL);
+}
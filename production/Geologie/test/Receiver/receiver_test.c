@@ -0,0 +1,784 @@
+/**
+ * @file receiver_test.c
+ *
+ * @brief Ensemble de test pour Receiver.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <sched.h>
+#include <string.h>
+
+#include "cmocka.h"
+
+#include "Receiver/receiver.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de publications faites par le thread de scan simule.
+ */
+#define NB_PUBLICATIONS (200000)
+
+/**
+ * @brief Le nombre de rapports ajoutes par chaque adaptateur simule.
+ */
+#define NB_REPORTS_PER_ADAPTER (100000)
+
+/**
+ * @brief La capacite du registre des balises pendant les tests.
+ */
+#define NB_BEACONS_TEST (8)
+
+/**
+ * @brief La capacite du registre pendant le test du passage a l'echelle.
+ */
+#define NB_BEACONS_SITE (256)
+
+/**
+ * @brief La taille d'un rapport d'advertising de balise dans un evenement, RSSI compris.
+ */
+#define SIZE_REPORT (LE_ADVERTISING_INFO_SIZE + 23 + 1)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les donnees d'annonce d'une balise, comme emises par BalisePy.
+ */
+static const uint8_t BEACON_ADVERTISING_DATA[] = {
+    0x02, 0x01, 0x06, 0x0F, 0x09, 'b', '1', 'x', '0', '0', '5', '5', '0', 'y', '0', '0', '2', '0', '0', 0x03, 0x03, 0x1A, 0x18
+};
+
+/**
+ * @brief Les donnees d'annonce d'un autre peripherique, sans le service des balises.
+ */
+static const uint8_t OTHER_ADVERTISING_DATA[] = {
+    0x02, 0x01, 0x06, 0x0F, 0x09, 'p', 'h', 'o', 'n', 'e', '0', '0', '0', '0', '0', '0', '0', '0', '0', 0x03, 0x03, 0x0F, 0x18
+};
+
+/**
+ * @brief Les donnees d'annonce d'un iBeacon du commerce : major 1, minor 258.
+ */
+static const uint8_t IBEACON_ADVERTISING_DATA[] = {
+    0x02, 0x01, 0x06,
+    0x1A, 0xFF, 0x4C, 0x00, 0x02, 0x15,
+    0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB, 0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0,    // UUID
+    0x00, 0x01, 0x01, 0x02,     // Major, minor
+    0xC5                        // -59 dBm a 1 m
+};
+
+/**
+ * @brief Un LE Extended Advertising Report enregistre : une annonce complete de la balise b1 recue sur les PHY 1M puis
+ * 2M, suivie d'un fragment incomplet d'une annonce plus longue.
+ */
+static const uint8_t EXTENDED_ADVERTISING_EVENT[] = {
+    EVT_LE_META_EVENT, 0x60, EVT_LE_EXTENDED_ADVERTISING_REPORT, 0x02,
+    0x00, 0x00,                                 // Type : annonce etendue, donnees completes
+    0x00, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,   // Adresse
+    0x01, 0x02, 0x00,                           // PHY primaire 1M, PHY secondaire 2M, SID
+    0xFC, 0xC6,                                 // Puissance d'emission -4 dBm, RSSI -58 dBm
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,        // Intervalle periodique, adresse directe
+    0x17,                                       // Taille des donnees
+    0x02, 0x01, 0x06, 0x0F, 0x09, 'b', '1', 'x', '0', '0', '5', '5', '0', 'y', '0', '0', '2', '0', '0', 0x03, 0x03, 0x1A, 0x18,
+    0x20, 0x00,                                 // Type : annonce etendue, donnees incompletes
+    0x00, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0x01, 0x02, 0x00,
+    0xFC, 0xD8,                                 // Puissance d'emission -4 dBm, RSSI -40 dBm
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x17,
+    0x02, 0x01, 0x06, 0x0F, 0x09, 'b', '1', 'x', '0', '0', '5', '5', '0', 'y', '0', '0', '2', '0', '0', 0x03, 0x03, 0x1A, 0x18
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module Receiver.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int receiver_run_tests(void);
+
+static void test_Receiver_ingestHciEvent(void** state);
+static void test_Receiver_ingestExtendedHciEvent(void** state);
+static void test_Receiver_ingestTruncatedHciEvent(void** state);
+static void test_Receiver_getBeaconsSignalWithoutPublication(void** state);
+static void test_Receiver_getBeaconsSignalConsistent(void** state);
+static void test_Receiver_setScanConfiguration(void** state);
+static void test_Receiver_manyBeacons(void** state);
+static void test_Receiver_setHciDevices(void** state);
+static void test_Receiver_mergeReportsInTimestampOrder(void** state);
+static void test_Receiver_reportRingFull(void** state);
+static void test_Receiver_mergeReportsConcurrent(void** state);
+static void test_Receiver_beaconsStatistics(void** state);
+static void test_Receiver_evictStaleBeacons(void** state);
+static void test_Receiver_kernelTimestamps(void** state);
+static void test_Receiver_hciTimestamp(void** state);
+static void test_Receiver_scanProcess(void** state);
+static void test_Receiver_scanProcessThirdPartyBeacons(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int resetReceiver(void** state) {
+    BeaconRegistry_new(NB_BEACONS_TEST);
+    initAdapters();
+    return allocateBeaconsSignal(NB_BEACONS_TEST);
+}
+
+static int freeReceiver(void** state) {
+    const int defaultHciDevice = -1;
+
+    Receiver_setHciDevices(&defaultHciDevice, 1);
+    Receiver_setBeaconTimeout(RECEIVER_BEACON_TIMEOUT_DEFAULT);
+    freeBeaconsSignal();
+    BeaconRegistry_free();
+    return 0;
+}
+
+static uint16_t composeReport(uint8_t* report, const uint8_t* advertisingData, int8_t rssi) {
+    report[0] = 0x00;
+    report[1] = 0x01;
+    memset(report + 2, 0xAA, 6);
+    report[8] = 23;
+    memcpy(report + 9, advertisingData, 23);
+    report[9 + 23] = (uint8_t) rssi;
+    return SIZE_REPORT;
+}
+
+static uint16_t composeEvent(uint8_t* event, uint8_t nbReports, const uint8_t* reports, uint16_t reportsSize) {
+    event[0] = EVT_LE_META_EVENT;
+    event[1] = (uint8_t) (2 + reportsSize);
+    event[2] = EVT_LE_ADVERTISING_REPORT;
+    event[3] = nbReports;
+    memcpy(event + 4, reports, reportsSize);
+    return 4 + reportsSize;
+}
+
+/**
+ * @brief Fait recevoir par l'adaptateur 0 une annonce de la balise bN, puis la fusionne.
+ */
+static void ingestBeacon(char number, int8_t rssi, uint64_t timestamp) {
+    uint8_t advertisingData[sizeof(BEACON_ADVERTISING_DATA)];
+    uint8_t reports[SIZE_REPORT];
+    uint8_t event[HCI_MAX_EVENT_SIZE];
+
+    memcpy(advertisingData, BEACON_ADVERTISING_DATA, sizeof(advertisingData));
+    advertisingData[6] = (uint8_t) number;
+    uint16_t eventSize = composeEvent(event, 1, reports, composeReport(reports, advertisingData, rssi));
+    ingestHciEvent(&shared->adapters[0], event, eventSize, timestamp);
+    mergeReports();
+}
+
+/**
+ * @brief Simule le thread de scan : publie des tables dont toutes les balises portent le numero de la publication.
+ */
+static void* runPublications(void* _) {
+    for (uint32_t publication = 1; publication <= NB_PUBLICATIONS; publication++) {
+        NbBeaconsSignal = 1 + publication % NB_BEACONS_TEST;
+        for (uint32_t i = 0; i < NbBeaconsSignal; i++) {
+            beaconsSignal[i].position.X = publication;
+            beaconsSignal[i].position.Y = publication;
+            beaconsSignal[i].rssi = (int8_t) publication;
+        }
+        isBeaconsSignalUpdated = true;
+        mergeReports();
+    publishBeaconsSignal();
+    }
+    return NULL;
+}
+
+/**
+ * @brief Simule le thread de scan d'un adaptateur : ajoute a sa file les rapports de sa balise, de date croissante.
+ *
+ * L'adaptateur attend que sa file se libere au lieu de perdre des rapports.
+ */
+static void* runAdapter(void* adapter) {
+    Adapter* this = (Adapter*) adapter;
+    uint8_t advertisingData[sizeof(BEACON_ADVERTISING_DATA)];
+    uint8_t reports[SIZE_REPORT];
+    uint8_t event[HCI_MAX_EVENT_SIZE];
+
+    memcpy(advertisingData, BEACON_ADVERTISING_DATA, sizeof(advertisingData));
+    advertisingData[6] = (uint8_t) ('1' + this->id);
+    uint16_t eventSize = composeEvent(event, 1, reports, composeReport(reports, advertisingData, -60));
+
+    for (uint64_t i = 1; i <= NB_REPORTS_PER_ADAPTER; i++) {
+        while (this->ring.head - __atomic_load_n(&this->ring.tail, __ATOMIC_ACQUIRE) >= REPORT_RING_SIZE) {
+            sched_yield();
+        }
+        ingestHciEvent(this, event, eventSize, i * RECEIVER_NB_MAX_ADAPTERS + this->id);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Attend au plus une seconde que l'etage de fusion ait traite le nombre de rapports donne.
+ *
+ * @return Vrai si les rapports ont ete traites a temps.
+ */
+static bool waitMergedReports(uint64_t nbReports) {
+    const struct timespec delay = { .tv_sec = 0, .tv_nsec = 10000000 };
+
+    for (uint32_t i = 0; i < 100; i++) {
+        if (__atomic_load_n(&nbMergedReports, __ATOMIC_RELAXED) >= nbReports) {
+            return true;
+        }
+        nanosleep(&delay, NULL);
+    }
+    return false;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_Receiver_ingestHciEvent(void** state) {
+    uint8_t reports[3 * SIZE_REPORT];
+    uint8_t event[HCI_MAX_EVENT_SIZE];
+    uint16_t reportsSize = 0;
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+
+    reportsSize += composeReport(reports + reportsSize, BEACON_ADVERTISING_DATA, -70);
+    reportsSize += composeReport(reports + reportsSize, OTHER_ADVERTISING_DATA, -40);
+    reportsSize += composeReport(reports + reportsSize, BEACON_ADVERTISING_DATA, -65);
+    uint16_t eventSize = composeEvent(event, 3, reports, reportsSize);
+
+    assert_int_equal(3, ingestHciEvent(&shared->adapters[0], event, eventSize, 0));
+    mergeReports();
+    publishBeaconsSignal();
+
+    /* Le peripherique sans le service des balises est ignore, la derniere trame de la balise est conservee */
+    assert_int_equal(1, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+    assert_string_equal("b1", (char*) beaconsSignalRead[0].name);
+    assert_int_equal(BeaconRegistry_getIndex((const uint8_t*) "b1"), beaconsSignalRead[0].index);
+    assert_int_equal(-65, beaconsSignalRead[0].rssi);
+}
+
+static void test_Receiver_ingestExtendedHciEvent(void** state) {
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+
+    assert_int_equal(HCI_EVENT_HDR_SIZE + EXTENDED_ADVERTISING_EVENT[1], sizeof(EXTENDED_ADVERTISING_EVENT));
+    assert_int_equal(2, ingestHciEvent(&shared->adapters[0], EXTENDED_ADVERTISING_EVENT, sizeof(EXTENDED_ADVERTISING_EVENT), 0));
+    mergeReports();
+    publishBeaconsSignal();
+
+    /* Le fragment incomplet est ignore, le RSSI et la puissance d'emission viennent de l'en-tete du rapport */
+    assert_int_equal(1, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+    assert_string_equal("b1", (char*) beaconsSignalRead[0].name);
+    assert_int_equal(-58, beaconsSignalRead[0].rssi);
+    assert_int_equal(-4, beaconsSignalRead[0].txPower);
+
+    /* Un rapport etendu tronque arrete la lecture de l'evenement */
+    assert_int_equal(1, ingestHciEvent(&shared->adapters[0], EXTENDED_ADVERTISING_EVENT, sizeof(EXTENDED_ADVERTISING_EVENT) - 1, 0));
+    assert_int_equal(1, mergeReports());
+}
+
+static void test_Receiver_ingestTruncatedHciEvent(void** state) {
+    uint8_t reports[2 * SIZE_REPORT];
+    uint8_t event[HCI_MAX_EVENT_SIZE];
+    uint16_t reportsSize = 0;
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+
+    reportsSize += composeReport(reports + reportsSize, BEACON_ADVERTISING_DATA, -70);
+    reportsSize += composeReport(reports + reportsSize, BEACON_ADVERTISING_DATA, -60);
+    uint16_t eventSize = composeEvent(event, 2, reports, reportsSize);
+
+    /* Le second rapport est tronque avant son RSSI, le nombre de rapports annonce est faux */
+    assert_int_equal(1, ingestHciEvent(&shared->adapters[0], event, eventSize - 1, 0));
+    event[3] = 5;
+    assert_int_equal(2, ingestHciEvent(&shared->adapters[0], event, eventSize, 0));
+
+    /* Evenement trop court ou qui n'est pas un advertising report */
+    assert_int_equal(0, ingestHciEvent(&shared->adapters[0], event, 3, 0));
+    event[2] = 0x01;
+    assert_int_equal(0, ingestHciEvent(&shared->adapters[0], event, eventSize, 0));
+
+    mergeReports();
+    publishBeaconsSignal();
+    assert_int_equal(1, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+    assert_int_equal(-60, beaconsSignalRead[0].rssi);
+}
+
+static void test_Receiver_getBeaconsSignalWithoutPublication(void** state) {
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+
+    assert_int_equal(0, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+
+    /* Une table inchangee n'est pas republiee */
+    assert_int_equal(0, mergeReports());
+    publishBeaconsSignal();
+    assert_int_equal(0, snapshots[0].sequence);
+    assert_int_equal(0, snapshots[1].sequence);
+}
+
+static void test_Receiver_getBeaconsSignalConsistent(void** state) {
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+    uint32_t lastPublication = 0;
+    uint32_t nbReads = 0;
+    pthread_t publicationThread;
+
+    assert_int_equal(0, pthread_create(&publicationThread, NULL, &runPublications, NULL));
+
+    while (lastPublication < NB_PUBLICATIONS) {
+        uint32_t nbBeaconsSignalRead = Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST);
+        if (nbBeaconsSignalRead == 0) {
+            continue;
+        }
+
+        /* Une copie coherente ne melange pas deux publications et n'est jamais plus ancienne que la precedente */
+        uint32_t publication = beaconsSignalRead[0].position.X;
+        assert_int_equal(1 + publication % NB_BEACONS_TEST, nbBeaconsSignalRead);
+        for (uint32_t i = 0; i < nbBeaconsSignalRead; i++) {
+            assert_int_equal(publication, beaconsSignalRead[i].position.X);
+            assert_int_equal(publication, beaconsSignalRead[i].position.Y);
+            assert_int_equal((int8_t) publication, beaconsSignalRead[i].rssi);
+        }
+        assert_true(publication >= lastPublication);
+
+        lastPublication = publication;
+        nbReads++;
+    }
+
+    pthread_join(publicationThread, NULL);
+    assert_true(nbReads > 0);
+}
+
+static void test_Receiver_setScanConfiguration(void** state) {
+    ReceiverScanConfiguration defaultConfiguration;
+    ReceiverScanConfiguration currentConfiguration;
+    ReceiverScanConfiguration invalidConfigurations[] = {
+        {.interval = RECEIVER_SCAN_TIME_MIN - 1, .window = RECEIVER_SCAN_TIME_MIN - 1, .isActive = false},
+        {.interval = RECEIVER_SCAN_TIME_MAX + 1, .window = 0x0010, .isActive = false},
+        {.interval = 0x0010, .window = 0x0020, .isActive = false}
+    };
+    ReceiverScanConfiguration dutyCycleConfiguration = {.interval = 0x00A0, .window = 0x0030, .isActive = true};
+
+    Receiver_getScanConfiguration(&defaultConfiguration);
+    uint32_t version = shared->scanConfigurationVersion;
+
+    for (uint8_t i = 0; i < sizeof(invalidConfigurations) / sizeof(ReceiverScanConfiguration); i++) {
+        assert_int_equal(-1, Receiver_setScanConfiguration(&invalidConfigurations[i]));
+    }
+    Receiver_getScanConfiguration(&currentConfiguration);
+    assert_int_equal(defaultConfiguration.interval, currentConfiguration.interval);
+    assert_int_equal(defaultConfiguration.window, currentConfiguration.window);
+    assert_int_equal(version, shared->scanConfigurationVersion);
+
+    /* Une configuration valide change de version, les threads de scan la reappliquent */
+    assert_int_equal(0, Receiver_setScanConfiguration(&dutyCycleConfiguration));
+    assert_int_equal(version + 1, shared->scanConfigurationVersion);
+    Receiver_getScanConfiguration(&currentConfiguration);
+    assert_int_equal(0x00A0, currentConfiguration.interval);
+    assert_int_equal(0x0030, currentConfiguration.window);
+    assert_true(currentConfiguration.isActive);
+
+    assert_int_equal(0, Receiver_setScanConfiguration(&defaultConfiguration));
+}
+
+static void test_Receiver_manyBeacons(void** state) {
+    uint8_t advertisingData[sizeof(BEACON_ADVERTISING_DATA)];
+    uint8_t reports[SIZE_REPORT];
+    uint8_t event[HCI_MAX_EVENT_SIZE];
+    BeaconSignal* beaconsSignalRead = calloc(NB_BEACONS_SITE, sizeof(BeaconSignal));
+
+    BeaconRegistry_new(NB_BEACONS_SITE);
+    allocateBeaconsSignal(NB_BEACONS_SITE);
+    initAdapters();
+    memcpy(advertisingData, BEACON_ADVERTISING_DATA, sizeof(advertisingData));
+
+    /* Plus de balises que la capacite : les premieres vues sont suivies, les suivantes ignorees */
+    for (uint16_t i = 0; i < NB_BEACONS_SITE + 44; i++) {
+        advertisingData[5] = (uint8_t) ('A' + i / 26);
+        advertisingData[6] = (uint8_t) ('a' + i % 26);
+        uint16_t eventSize = composeEvent(event, 1, reports, composeReport(reports, advertisingData, (int8_t) (-40 - i % 50)));
+        assert_int_equal(1, ingestHciEvent(&shared->adapters[0], event, eventSize, 0));
+    }
+    mergeReports();
+    publishBeaconsSignal();
+
+    assert_int_equal(NB_BEACONS_SITE, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_SITE));
+    for (uint16_t i = 0; i < NB_BEACONS_SITE; i++) {
+        assert_int_equal(i, beaconsSignalRead[i].index);
+        assert_int_equal(-40 - i % 50, beaconsSignalRead[i].rssi);
+    }
+
+    /* La lecture est bornee par la taille du tableau du lecteur */
+    assert_int_equal(3, Receiver_getBeaconsSignal(beaconsSignalRead, 3));
+
+    free(beaconsSignalRead);
+}
+
+static void test_Receiver_setHciDevices(void** state) {
+    const int hciDevices[RECEIVER_NB_MAX_ADAPTERS + 1] = {0, 1, 2, 3, 4};
+    const int invalidHciDevice = -2;
+
+    assert_int_equal(-1, Receiver_setHciDevices(hciDevices, 0));
+    assert_int_equal(-1, Receiver_setHciDevices(hciDevices, RECEIVER_NB_MAX_ADAPTERS + 1));
+    assert_int_equal(-1, Receiver_setHciDevices(&invalidHciDevice, 1));
+
+    assert_int_equal(0, Receiver_setHciDevices(hciDevices, 2));
+    initAdapters();
+    assert_int_equal(2, nbAdapters);
+    assert_int_equal(1, shared->adapters[1].deviceId);
+    assert_int_equal(1, shared->adapters[1].id);
+    assert_true(shared->adapters[1].isHciDevice);
+
+    /* Une socket donnee remplace tous les peripheriques */
+    Receiver_setHciSocket(42);
+    initAdapters();
+    assert_int_equal(1, nbAdapters);
+    assert_int_equal(42, shared->adapters[0].socket);
+    assert_false(shared->adapters[0].isHciDevice);
+    Receiver_setHciSocket(-1);
+}
+
+static void test_Receiver_mergeReportsInTimestampOrder(void** state) {
+    const int hciDevices[] = {0, 1};
+    uint8_t reports[SIZE_REPORT];
+    uint8_t event[HCI_MAX_EVENT_SIZE];
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+
+    Receiver_setHciDevices(hciDevices, 2);
+    initAdapters();
+
+    /* Les trames de la balise arrivent sur les deux adaptateurs, l'adaptateur 0 ajoute d'abord ses deux rapports */
+    uint16_t eventSize = composeEvent(event, 1, reports, composeReport(reports, BEACON_ADVERTISING_DATA, -70));
+    ingestHciEvent(&shared->adapters[0], event, eventSize, 10);
+    eventSize = composeEvent(event, 1, reports, composeReport(reports, BEACON_ADVERTISING_DATA, -60));
+    ingestHciEvent(&shared->adapters[0], event, eventSize, 30);
+    eventSize = composeEvent(event, 1, reports, composeReport(reports, BEACON_ADVERTISING_DATA, -50));
+    ingestHciEvent(&shared->adapters[1], event, eventSize, 20);
+
+    assert_int_equal(3, mergeReports());
+    publishBeaconsSignal();
+
+    /* Le dernier rapport retenu est le plus recent, quel que soit l'ordre d'ajout des adaptateurs */
+    assert_int_equal(1, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+    assert_int_equal(-60, beaconsSignalRead[0].rssi);
+    assert_int_equal(0, beaconsSignalRead[0].adapter);
+    assert_int_equal(30, beaconsSignalRead[0].timestamp);
+    assert_int_equal(0, mergeReports());
+}
+
+static void test_Receiver_reportRingFull(void** state) {
+    uint8_t reports[SIZE_REPORT];
+    uint8_t event[HCI_MAX_EVENT_SIZE];
+
+    uint16_t eventSize = composeEvent(event, 1, reports, composeReport(reports, BEACON_ADVERTISING_DATA, -70));
+    for (uint32_t i = 0; i < REPORT_RING_SIZE + 3; i++) {
+        assert_int_equal(1, ingestHciEvent(&shared->adapters[0], event, eventSize, i));
+    }
+
+    /* Les rapports qui ne tiennent plus dans la file sont perdus, la file se vide ensuite normalement */
+    assert_int_equal(3, shared->adapters[0].ring.nbDroppedReports);
+    assert_int_equal(REPORT_RING_SIZE, mergeReports());
+    assert_int_equal(1, ingestHciEvent(&shared->adapters[0], event, eventSize, REPORT_RING_SIZE + 3));
+    assert_int_equal(1, mergeReports());
+}
+
+static void test_Receiver_mergeReportsConcurrent(void** state) {
+    const int hciDevices[] = {0, 1};
+    uint64_t lastTimestamps[2] = {0, 0};
+    pthread_t adapterThreads[2];
+
+    Receiver_setHciDevices(hciDevices, 2);
+    initAdapters();
+
+    for (uint8_t i = 0; i < 2; i++) {
+        assert_int_equal(0, pthread_create(&adapterThreads[i], NULL, &runAdapter, &shared->adapters[i]));
+    }
+
+    while (nbMergedReports < 2 * NB_REPORTS_PER_ADAPTER) {
+        mergeReports();
+
+        /* Chaque balise n'est entendue que par un adaptateur : ses rapports sont fusionnes dans leur ordre d'ajout */
+        for (uint32_t slot = 0; slot < NbBeaconsSignal; slot++) {
+            assert_true(beaconsSignal[slot].timestamp >= lastTimestamps[beaconsSignal[slot].adapter]);
+            assert_int_equal(beaconsSignal[slot].adapter, beaconsSignal[slot].timestamp % RECEIVER_NB_MAX_ADAPTERS);
+            lastTimestamps[beaconsSignal[slot].adapter] = beaconsSignal[slot].timestamp;
+        }
+    }
+
+    for (uint8_t i = 0; i < 2; i++) {
+        pthread_join(adapterThreads[i], NULL);
+        assert_int_equal(0, shared->adapters[i].ring.nbDroppedReports);
+    }
+    assert_int_equal(2, NbBeaconsSignal);
+    assert_int_equal(NB_REPORTS_PER_ADAPTER * RECEIVER_NB_MAX_ADAPTERS, lastTimestamps[0]);
+    assert_int_equal(NB_REPORTS_PER_ADAPTER * RECEIVER_NB_MAX_ADAPTERS + 1, lastTimestamps[1]);
+}
+
+static void test_Receiver_beaconsStatistics(void** state) {
+    BeaconStatistics beaconsStatisticsRead[NB_BEACONS_TEST];
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+
+    ingestBeacon('1', -70, 1000000000);
+    ingestBeacon('1', -60, 1100000000);
+    ingestBeacon('1', -50, 1200000000);
+    publishBeaconsSignal();
+
+    /* Trois annonces en 200 ms, de RSSI brut -70, -60 et -50 */
+    assert_int_equal(1, Receiver_getBeaconsStatistics(beaconsStatisticsRead, NB_BEACONS_TEST));
+    assert_int_equal(BeaconRegistry_getIndex((const uint8_t*) "b1"), beaconsStatisticsRead[0].index);
+    assert_float_equal(10, beaconsStatisticsRead[0].advertisingRate, 0.01);
+    assert_float_equal(-60, beaconsStatisticsRead[0].rssiMean, 0.01);
+    assert_float_equal(200.0 / 3, beaconsStatisticsRead[0].rssiVariance, 0.01);
+    assert_int_equal(0, beaconsStatisticsRead[0].nbDropouts);
+    assert_true(beaconsStatisticsRead[0].lastSeenAge > 0);
+
+    /* Sans filtre, la variance publiee avec le RSSI est celle des RSSI bruts de la fenetre du filtre */
+    assert_int_equal(1, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+    assert_float_equal(200.0 / 3, beaconsSignalRead[0].rssiVariance, 0.01);
+}
+
+static void test_Receiver_evictStaleBeacons(void** state) {
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+    BeaconStatistics beaconsStatisticsRead[NB_BEACONS_TEST];
+
+    ingestBeacon('1', -70, 1000000000);
+    ingestBeacon('2', -60, 3000000000);
+    ingestBeacon('3', -50, 2000000000);
+    BeaconIndex index1 = BeaconRegistry_getIndex((const uint8_t*) "b1");
+    BeaconIndex index2 = BeaconRegistry_getIndex((const uint8_t*) "b2");
+    BeaconIndex index3 = BeaconRegistry_getIndex((const uint8_t*) "b3");
+
+    /* Sans delai, aucune balise n'est retiree */
+    Receiver_setBeaconTimeout(0);
+    evictStaleBeacons(10000000000);
+    assert_int_equal(3, NbBeaconsSignal);
+
+    /* b1 et b3 se taisent depuis plus d'une seconde, b2 prend la place de b1 */
+    Receiver_setBeaconTimeout(1000);
+    evictStaleBeacons(3500000000);
+    publishBeaconsSignal();
+
+    assert_int_equal(1, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+    assert_int_equal(index2, beaconsSignalRead[0].index);
+    assert_int_equal(-60, beaconsSignalRead[0].rssi);
+    assert_int_equal(0, beaconsSignalSlot[index2]);
+    assert_int_equal(SLOT_NONE, beaconsSignalSlot[index1]);
+    assert_int_equal(SLOT_NONE, beaconsSignalSlot[index3]);
+
+    /* b1 revient : ses statistiques repartent de zero mais son retrait est compte */
+    ingestBeacon('1', -40, 4000000000);
+    publishBeaconsSignal();
+
+    assert_int_equal(2, Receiver_getBeaconsStatistics(beaconsStatisticsRead, NB_BEACONS_TEST));
+    assert_int_equal(index1, beaconsStatisticsRead[1].index);
+    assert_float_equal(-40, beaconsStatisticsRead[1].rssiMean, 0.01);
+    assert_float_equal(0, beaconsStatisticsRead[1].rssiVariance, 0.01);
+    assert_int_equal(1, beaconsStatisticsRead[1].nbDropouts);
+    assert_int_equal(0, beaconsStatisticsRead[0].nbDropouts);
+}
+
+static void test_Receiver_kernelTimestamps(void** state) {
+    int sockets[2];
+    uint8_t reports[SIZE_REPORT];
+    uint8_t event[HCI_TYPE_LEN + HCI_MAX_EVENT_SIZE];
+    const struct timespec delay = { .tv_sec = 0, .tv_nsec = 20000000 };
+
+    assert_int_equal(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets));
+    Receiver_setHciSocket(sockets[0]);
+    initAdapters();
+    assert_int_equal(0, openHciDevice(&shared->adapters[0]));
+
+    event[0] = HCI_EVENT_PKT;
+    uint16_t eventSize = HCI_TYPE_LEN + composeEvent(event + HCI_TYPE_LEN, 1, reports, composeReport(reports, BEACON_ADVERTISING_DATA, -60));
+
+    uint64_t sendTime = getMonotonicTime();
+    assert_int_equal(eventSize, write(sockets[1], event, eventSize));
+    nanosleep(&delay, NULL);
+    uint64_t readTime = getMonotonicTime();
+
+    /* L'evenement est date de sa reception par le noyau, pas de sa lecture 20 ms plus tard */
+    assert_int_equal(1, drainHciEvents(&shared->adapters[0]));
+    assert_true(shared->adapters[0].hciEventsTimestamp[0] + 1000000 >= sendTime);
+    assert_true(shared->adapters[0].hciEventsTimestamp[0] + 10000000 < readTime);
+
+    /* La date suit le rapport jusqu'a la table des balises */
+    ingestHciEvent(&shared->adapters[0], event + HCI_TYPE_LEN, eventSize - HCI_TYPE_LEN, shared->adapters[0].hciEventsTimestamp[0]);
+    mergeReports();
+    assert_int_equal(shared->adapters[0].hciEventsTimestamp[0], beaconsSignal[0].timestamp);
+
+    Receiver_setHciSocket(-1);
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+static void test_Receiver_hciTimestamp(void** state) {
+    uint8_t control[CMSG_SPACE(sizeof(struct timeval))];
+    const struct timeval date = { .tv_sec = 1700000000, .tv_usec = 123456 };
+    struct msghdr message = { .msg_control = control, .msg_controllen = sizeof(control) };
+
+    /* Une socket HCI brute date l'evenement dans un struct timeval, au niveau SOL_HCI */
+    struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_HCI;
+    header->cmsg_type = HCI_CMSG_TSTAMP;
+    header->cmsg_len = CMSG_LEN(sizeof(date));
+    memcpy(CMSG_DATA(header), &date, sizeof(date));
+    assert_true(getKernelTimestamp(&message) == 1700000000123456000ULL);
+
+    /* Un autre message de controle de la socket HCI n'est pas une date */
+    header->cmsg_type = HCI_CMSG_TSTAMP + 1;
+    assert_true(getKernelTimestamp(&message) == 0);
+}
+
+static void test_Receiver_scanProcess(void** state) {
+    int sockets[2];
+    uint8_t reports[SIZE_REPORT];
+    uint8_t event[HCI_TYPE_LEN + HCI_MAX_EVENT_SIZE];
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+    const struct timespec delay = { .tv_sec = 0, .tv_nsec = 10000000 };
+
+    assert_int_equal(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets));
+    Receiver_setHciSocket(sockets[0]);
+    Receiver_setScanProcess(true, 0);
+    assert_int_equal(0, createSharedState());
+    initAdapters();
+    assert_int_equal(0, startScanProcess());
+    pid_t firstScanProcess = scanProcess;
+    assert_true(firstScanProcess > 0);
+
+    event[0] = HCI_EVENT_PKT;
+    uint16_t eventSize = HCI_TYPE_LEN + composeEvent(event + HCI_TYPE_LEN, 1, reports, composeReport(reports, BEACON_ADVERTISING_DATA, -60));
+
+    /* Le rapport lu par le processus de scan passe par la file en memoire partagee */
+    assert_int_equal(eventSize, write(sockets[1], event, eventSize));
+    assert_true(waitMergedReports(1));
+    assert_int_equal(1, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+    assert_int_equal(-60, beaconsSignalRead[0].rssi);
+
+    /* Un processus de scan tue est relance par l'etage de fusion */
+    assert_int_equal(0, kill(firstScanProcess, SIGKILL));
+    for (uint32_t i = 0; i < 100 && __atomic_load_n(&scanProcess, __ATOMIC_RELAXED) == firstScanProcess; i++) {
+        nanosleep(&delay, NULL);
+    }
+    assert_true(__atomic_load_n(&scanProcess, __ATOMIC_RELAXED) != firstScanProcess);
+
+    assert_int_equal(eventSize, write(sockets[1], event, eventSize));
+    assert_true(waitMergedReports(2));
+
+    /* Les parametres du scan changes pendant le scan sont gardes apres l'arret */
+    ReceiverScanConfiguration configuration = { .interval = 0x0020, .window = 0x0010, .isActive = true };
+    assert_int_equal(0, Receiver_setScanConfiguration(&configuration));
+
+    performAction(A_STOP, NULL);
+    assert_int_equal(-1, scanProcess);
+    assert_true(shared == &localShared);
+    Receiver_getScanConfiguration(&configuration);
+    assert_int_equal(0x0020, configuration.interval);
+
+    configuration.interval = 0x0010;
+    configuration.isActive = false;
+    Receiver_setScanConfiguration(&configuration);
+    Receiver_setScanProcess(false, RECEIVER_CPU_ANY);
+    Receiver_setHciSocket(-1);
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+static void test_Receiver_scanProcessThirdPartyBeacons(void** state) {
+    ThirdPartyBeacon thirdPartyBeacon = { .format = TRANSLATOR_BEACON_IBEACON, .name = "i1", .position = { .X = 1000, .Y = 2000 } };
+    int sockets[2];
+    uint8_t report[LE_ADVERTISING_INFO_SIZE + sizeof(IBEACON_ADVERTISING_DATA) + 1];
+    uint8_t event[HCI_TYPE_LEN + HCI_MAX_EVENT_SIZE];
+    BeaconSignal beaconsSignalRead[NB_BEACONS_TEST];
+
+    /* Le registre est rempli dans le processus de GEOLOGIE, comme par l'option -R */
+    memcpy(thirdPartyBeacon.identifier, IBEACON_ADVERTISING_DATA + 9, TRANSLATOR_BEACON_IDENTIFIER_SIZE);
+    assert_int_equal(0, TranslatorBeacon_addThirdPartyBeacon(&thirdPartyBeacon));
+
+    assert_int_equal(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets));
+    Receiver_setHciSocket(sockets[0]);
+    Receiver_setScanProcess(true, 0);
+    assert_int_equal(0, createSharedState());
+    initAdapters();
+    assert_int_equal(0, startScanProcess());
+
+    report[0] = 0x00;
+    report[1] = 0x01;
+    memset(report + 2, 0xAA, 6);
+    report[8] = sizeof(IBEACON_ADVERTISING_DATA);
+    memcpy(report + 9, IBEACON_ADVERTISING_DATA, sizeof(IBEACON_ADVERTISING_DATA));
+    report[sizeof(report) - 1] = (uint8_t) -70;
+    event[0] = HCI_EVENT_PKT;
+    uint16_t eventSize = HCI_TYPE_LEN + composeEvent(event + HCI_TYPE_LEN, 1, report, sizeof(report));
+
+    /* Le processus de scan reconnait l'iBeacon enregistre avant son lancement */
+    assert_int_equal(eventSize, write(sockets[1], event, eventSize));
+    assert_true(waitMergedReports(1));
+    assert_int_equal(1, Receiver_getBeaconsSignal(beaconsSignalRead, NB_BEACONS_TEST));
+    assert_string_equal("i1", beaconsSignalRead[0].name);
+    assert_int_equal(1000, beaconsSignalRead[0].position.X);
+    assert_int_equal(2000, beaconsSignalRead[0].position.Y);
+    assert_int_equal(-70, beaconsSignalRead[0].rssi);
+
+    performAction(A_STOP, NULL);
+    Receiver_setScanProcess(false, RECEIVER_CPU_ANY);
+    Receiver_setHciSocket(-1);
+    close(sockets[0]);
+    close(sockets[1]);
+    TranslatorBeacon_free();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ensemble des tests a executer.
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_Receiver_ingestHciEvent, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_ingestExtendedHciEvent, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_ingestTruncatedHciEvent, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_getBeaconsSignalWithoutPublication, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_getBeaconsSignalConsistent, resetReceiver, freeReceiver),
+    cmocka_unit_test(test_Receiver_setScanConfiguration),
+    cmocka_unit_test_setup_teardown(test_Receiver_manyBeacons, NULL, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_setHciDevices, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_mergeReportsInTimestampOrder, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_reportRingFull, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_mergeReportsConcurrent, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_beaconsStatistics, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_evictStaleBeacons, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_kernelTimestamps, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_hciTimestamp, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_scanProcess, resetReceiver, freeReceiver),
+    cmocka_unit_test_setup_teardown(test_Receiver_scanProcessThirdPartyBeacons, resetReceiver, freeReceiver),
+};
+
+extern int receiver_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module Receiver", tests, NULL, NULL);
+}
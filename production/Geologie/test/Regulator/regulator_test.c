@@ -0,0 +1,220 @@
+/**
+ * @file regulator_test.c
+ *
+ * @brief Ensemble de test pour Regulator.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cmocka.h"
+
+#include "Regulator/regulator.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La capacite du registre des balises pendant les tests.
+ */
+#define NB_BEACONS_TEST (8)
+
+/**
+ * @brief Le nombre de balises recues a chaque cycle simule.
+ */
+#define NB_BEACONS_CYCLE (4)
+
+/**
+ * @brief La duree d'un cycle simule, en nanoseconde.
+ */
+#define CYCLE_DURATION (1000000000ULL)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La date de capture de la derniere position simulee.
+ */
+static uint64_t captureTime;
+
+/**
+ * @brief Une charge processeur faible et une charge forte.
+ */
+static const ProcessorAndMemoryLoad LOW_LOAD = { .memoryLoad = 20, .processorLoad = 10 };
+static const ProcessorAndMemoryLoad HIGH_LOAD = { .memoryLoad = 20, .processorLoad = 80 };
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module Regulator.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int regulator_run_tests(void);
+
+static int setUpRegulator(void** state);
+static int tearDownRegulator(void** state);
+
+static void test_Regulator_parked(void** state);
+static void test_Regulator_parkedUnderLoad(void** state);
+static void test_Regulator_moving(void** state);
+static void test_Regulator_unstableSignal(void** state);
+static void test_Regulator_disabled(void** state);
+static void test_Regulator_getSetting(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int setUpRegulator(void** state) {
+    captureTime = 0;
+    if (BeaconRegistry_new(NB_BEACONS_TEST) < 0) {
+        return -1;
+    }
+    return Regulator_new();
+}
+
+static int tearDownRegulator(void** state) {
+    Regulator_free();
+    BeaconRegistry_free();
+    Regulator_setEnabled(true);
+    return 0;
+}
+
+/**
+ * @brief Simule des cycles de position d'une seconde ou toutes les balises sont recues avec la meme puissance.
+ *
+ * @return Le niveau donne au dernier cycle.
+ */
+static RegulatorLevel runCycles(uint32_t nbCycles, const Position* position, Power power, const ProcessorAndMemoryLoad* load) {
+    BeaconData beaconsData[NB_BEACONS_CYCLE];
+    RegulatorLevel level = REGULATOR_FULL;
+
+    for (BeaconIndex i = 0; i < NB_BEACONS_CYCLE; i++) {
+        beaconsData[i].index = i;
+        beaconsData[i].power = power;
+    }
+
+    for (uint32_t cycle = 0; cycle < nbCycles; cycle++) {
+        captureTime += CYCLE_DURATION;
+        level = Regulator_update(position, captureTime, beaconsData, NB_BEACONS_CYCLE, load);
+    }
+    return level;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_Regulator_parked(void** state) {
+    const Position position = { .X = 500, .Y = 500 };
+
+    assert_int_equal(REGULATOR_FULL, runCycles(REGULATOR_NB_QUIET_CYCLES - 1, &position, -60, &LOW_LOAD));
+    assert_int_equal(REGULATOR_REDUCED, runCycles(1, &position, -60, &LOW_LOAD));
+
+    /* Sans charge processeur, le niveau le plus bas n'est pas necessaire */
+    assert_int_equal(REGULATOR_REDUCED, runCycles(4 * REGULATOR_NB_QUIET_CYCLES, &position, -60, &LOW_LOAD));
+}
+
+static void test_Regulator_parkedUnderLoad(void** state) {
+    const Position position = { .X = 500, .Y = 500 };
+
+    assert_int_equal(REGULATOR_REDUCED, runCycles(REGULATOR_NB_QUIET_CYCLES, &position, -60, &HIGH_LOAD));
+    assert_int_equal(REGULATOR_IDLE, runCycles(REGULATOR_NB_QUIET_CYCLES, &position, -60, &HIGH_LOAD));
+
+    /* La charge retombe : le rythme remonte d'un niveau */
+    assert_int_equal(REGULATOR_IDLE, runCycles(REGULATOR_NB_QUIET_CYCLES - 1, &position, -60, &LOW_LOAD));
+    assert_int_equal(REGULATOR_REDUCED, runCycles(1, &position, -60, &LOW_LOAD));
+}
+
+static void test_Regulator_moving(void** state) {
+    const Position parked = { .X = 500, .Y = 500 };
+    const Position moved = { .X = 600, .Y = 500 };
+
+    assert_int_equal(REGULATOR_IDLE, runCycles(2 * REGULATOR_NB_QUIET_CYCLES, &parked, -60, &HIGH_LOAD));
+
+    /* 1 m en une seconde : le rythme repasse au maximum des le premier cycle */
+    assert_int_equal(REGULATOR_FULL, runCycles(1, &moved, -60, &HIGH_LOAD));
+    assert_float_equal(50, speed, 0.01);
+
+    /* Une position qui n'a pas ete mise a jour ne change pas la vitesse */
+    assert_int_equal(REGULATOR_FULL, Regulator_update(&parked, captureTime, NULL, 0, &HIGH_LOAD));
+    assert_float_equal(50, speed, 0.01);
+}
+
+static void test_Regulator_unstableSignal(void** state) {
+    const Position position = { .X = 500, .Y = 500 };
+
+    assert_int_equal(REGULATOR_REDUCED, runCycles(REGULATOR_NB_QUIET_CYCLES, &position, -60, &LOW_LOAD));
+
+    /* Une variation de 1 dB reste sous le seuil, une de 5 dB le depasse */
+    assert_int_equal(REGULATOR_REDUCED, runCycles(1, &position, -61, &LOW_LOAD));
+    assert_int_equal(REGULATOR_FULL, runCycles(1, &position, -66, &LOW_LOAD));
+}
+
+static void test_Regulator_disabled(void** state) {
+    const Position position = { .X = 500, .Y = 500 };
+
+    Regulator_setEnabled(false);
+    assert_int_equal(REGULATOR_FULL, runCycles(4 * REGULATOR_NB_QUIET_CYCLES, &position, -60, &HIGH_LOAD));
+}
+
+static void test_Regulator_getSetting(void** state) {
+    RegulatorSetting full;
+    RegulatorSetting idle;
+
+    Regulator_getSetting(REGULATOR_FULL, &full);
+    Regulator_getSetting(REGULATOR_IDLE, &idle);
+
+    /* Le niveau maximal est le rythme configure au demarrage, une position par seconde */
+    assert_int_equal(100, full.scanWindowPercent);
+    assert_int_equal(1000, full.updatePeriod);
+    assert_true(idle.scanWindowPercent < full.scanWindowPercent);
+    assert_true(idle.updatePeriod > full.updatePeriod);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_Regulator_parked, setUpRegulator, tearDownRegulator),
+    cmocka_unit_test_setup_teardown(test_Regulator_parkedUnderLoad, setUpRegulator, tearDownRegulator),
+    cmocka_unit_test_setup_teardown(test_Regulator_moving, setUpRegulator, tearDownRegulator),
+    cmocka_unit_test_setup_teardown(test_Regulator_unstableSignal, setUpRegulator, tearDownRegulator),
+    cmocka_unit_test_setup_teardown(test_Regulator_disabled, setUpRegulator, tearDownRegulator),
+    cmocka_unit_test(test_Regulator_getSetting),
+};
+
+extern int regulator_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module Regulator", tests, NULL, NULL);
+}
@@ -0,0 +1,364 @@
+/**
+ * @file replayer_test.c
+ *
+ * @brief Ensemble de test pour Replayer.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cmocka.h"
+
+#include "Replayer/replayer.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La taille maximale d'une capture de test.
+ */
+#define SIZE_CAPTURE_MAX (512)
+
+/**
+ * @brief Le modele du nom des captures de test.
+ */
+#define CAPTURE_PATH_TEMPLATE "/tmp/geologie_replayer_XXXXXX"
+
+/**
+ * @brief Une capture construite en memoire avant d'etre ecrite dans un fichier.
+ */
+typedef struct {
+    uint8_t data[SIZE_CAPTURE_MAX];     /**< Le contenu de la capture */
+    size_t size;                        /**< La taille de la capture */
+    char path[sizeof(CAPTURE_PATH_TEMPLATE)];   /**< Le chemin du fichier de la capture */
+} Capture;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Un LE advertising report d'une balise, a partir de l'en-tete hci_event_hdr.
+ */
+static const uint8_t ADVERTISING_EVENT[] = {
+    0x3E, 0x2A,                                     // LE Meta event, taille
+    0x02, 0x01,                                     // LE advertising report, 1 rapport
+    0x00, 0x00, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, // Type, type d'adresse, adresse
+    0x17,                                           // Taille des donnees
+    0x02, 0x01, 0x06, 0x0F, 0x09, 'b', '1', 'x', '3', '0', '0', '0', '0', 'y', '4', '0', '0', '0', '0', 0x03, 0x03, 0x1A, 0x18,
+    0xBD                                            // RSSI
+};
+
+/**
+ * @brief Un evenement Command Complete, a partir de l'en-tete hci_event_hdr.
+ */
+static const uint8_t COMMAND_COMPLETE_EVENT[] = {0x0E, 0x04, 0x01, 0x0B, 0x20, 0x00};
+
+/**
+ * @brief Une commande LE Set Scan Enable, a partir de l'en-tete de la commande.
+ */
+static const uint8_t SCAN_ENABLE_COMMAND[] = {0x0C, 0x20, 0x02, 0x01, 0x00};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module Replayer.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int replayer_run_tests(void);
+
+static void test_Replayer_btsnoopH4(void** state);
+static void test_Replayer_btsnoopHci(void** state);
+static void test_Replayer_pcapH4WithPhdr(void** state);
+static void test_Replayer_pcapH4BigEndianNanosecond(void** state);
+static void test_Replayer_truncatedRecord(void** state);
+static void test_Replayer_unknownFormat(void** state);
+static void test_Replayer_speed(void** state);
+static void test_Replayer_stop(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void appendBytes(Capture* capture, const void* bytes, size_t size) {
+    assert_true(capture->size + size <= SIZE_CAPTURE_MAX);
+    memcpy(capture->data + capture->size, bytes, size);
+    capture->size += size;
+}
+
+static void appendUint32(Capture* capture, uint32_t value, bool bigEndian) {
+    uint8_t bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[bigEndian ? i : 3 - i] = (uint8_t) (value >> (24 - 8 * i));
+    }
+    appendBytes(capture, bytes, sizeof(bytes));
+}
+
+static void appendBtsnoopHeader(Capture* capture, uint32_t datalink) {
+    appendBytes(capture, BTSNOOP_ID, BTSNOOP_ID_SIZE);
+    appendUint32(capture, BTSNOOP_VERSION, true);
+    appendUint32(capture, datalink, true);
+}
+
+static void appendBtsnoopRecord(Capture* capture, uint32_t flags, uint64_t timestamp, uint8_t h4Type, const uint8_t* data, uint32_t size) {
+    uint32_t recordSize = size + (h4Type != 0 ? 1 : 0);
+
+    appendUint32(capture, recordSize, true);
+    appendUint32(capture, recordSize, true);
+    appendUint32(capture, flags, true);
+    appendUint32(capture, 0, true);
+    appendUint32(capture, (uint32_t) (timestamp >> 32), true);
+    appendUint32(capture, (uint32_t) timestamp, true);
+    if (h4Type != 0) {
+        appendBytes(capture, &h4Type, 1);
+    }
+    appendBytes(capture, data, size);
+}
+
+static void appendPcapHeader(Capture* capture, uint32_t magic, uint32_t linktype, bool bigEndian) {
+    appendUint32(capture, magic, bigEndian);
+    appendBytes(capture, (uint8_t[]) {0x00, 0x02, 0x00, 0x04}, 4);     // Version 2.4, non verifiee
+    appendUint32(capture, 0, bigEndian);
+    appendUint32(capture, 0, bigEndian);
+    appendUint32(capture, UINT16_MAX, bigEndian);
+    appendUint32(capture, linktype, bigEndian);
+}
+
+static void appendPcapRecord(Capture* capture, uint32_t second, uint32_t fraction, bool bigEndian, bool withPhdr, uint8_t h4Type, const uint8_t* data, uint32_t size) {
+    uint32_t recordSize = size + 1 + (withPhdr ? PCAP_PHDR_SIZE : 0);
+
+    appendUint32(capture, second, bigEndian);
+    appendUint32(capture, fraction, bigEndian);
+    appendUint32(capture, recordSize, bigEndian);
+    appendUint32(capture, recordSize, bigEndian);
+    if (withPhdr) {
+        appendUint32(capture, 1, true);     // Recu par l'hote, toujours en grand boutiste
+    }
+    appendBytes(capture, &h4Type, 1);
+    appendBytes(capture, data, size);
+}
+
+static void writeCapture(Capture* capture) {
+    strcpy(capture->path, CAPTURE_PATH_TEMPLATE);
+    int fd = mkstemp(capture->path);
+    assert_true(fd >= 0);
+    assert_int_equal(capture->size, write(fd, capture->data, capture->size));
+    close(fd);
+}
+
+static void removeCapture(Capture* capture) {
+    Replayer_close();
+    unlink(capture->path);
+}
+
+static void assertNextEvent(const uint8_t* expectedEvent, uint16_t expectedSize) {
+    const uint8_t* event = NULL;
+    uint16_t size = 0;
+
+    assert_true(Replayer_nextHciEvent(&event, &size));
+    assert_int_equal(expectedSize, size);
+    assert_memory_equal(expectedEvent, event, expectedSize);
+
+    /* L'evenement est lu en place dans la projection de la capture */
+    assert_true(event > capture && event + size <= capture + captureSize);
+}
+
+static void assertEndOfCapture(void) {
+    const uint8_t* event;
+    uint16_t size;
+
+    assert_false(Replayer_nextHciEvent(&event, &size));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_Replayer_btsnoopH4(void** state) {
+    Capture captureFile = {.size = 0};
+
+    appendBtsnoopHeader(&captureFile, BTSNOOP_DATALINK_H4);
+    appendBtsnoopRecord(&captureFile, 0x02, 1000, 0x01, SCAN_ENABLE_COMMAND, sizeof(SCAN_ENABLE_COMMAND));
+    appendBtsnoopRecord(&captureFile, 0x03, 2000, 0x04, COMMAND_COMPLETE_EVENT, sizeof(COMMAND_COMPLETE_EVENT));
+    appendBtsnoopRecord(&captureFile, 0x01, 3000, 0x02, ADVERTISING_EVENT, 8);     // ACL, ignore
+    appendBtsnoopRecord(&captureFile, 0x03, 4000, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    writeCapture(&captureFile);
+
+    assert_int_equal(0, Replayer_open(captureFile.path, REPLAYER_SPEED_MAX));
+    assertNextEvent(COMMAND_COMPLETE_EVENT, sizeof(COMMAND_COMPLETE_EVENT));
+    assertNextEvent(ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    assertEndOfCapture();
+
+    removeCapture(&captureFile);
+}
+
+static void test_Replayer_btsnoopHci(void** state) {
+    Capture captureFile = {.size = 0};
+
+    appendBtsnoopHeader(&captureFile, BTSNOOP_DATALINK_HCI);
+    appendBtsnoopRecord(&captureFile, 0x02, 1000, 0, SCAN_ENABLE_COMMAND, sizeof(SCAN_ENABLE_COMMAND));
+    appendBtsnoopRecord(&captureFile, 0x03, 2000, 0, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    writeCapture(&captureFile);
+
+    assert_int_equal(0, Replayer_open(captureFile.path, REPLAYER_SPEED_MAX));
+    assertNextEvent(ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    assertEndOfCapture();
+
+    removeCapture(&captureFile);
+}
+
+static void test_Replayer_pcapH4WithPhdr(void** state) {
+    Capture captureFile = {.size = 0};
+
+    appendPcapHeader(&captureFile, PCAP_MAGIC_MICROSECOND, PCAP_LINKTYPE_H4_WITH_PHDR, false);
+    appendPcapRecord(&captureFile, 10, 0, false, true, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    appendPcapRecord(&captureFile, 10, 500, false, true, 0x01, SCAN_ENABLE_COMMAND, sizeof(SCAN_ENABLE_COMMAND));
+    appendPcapRecord(&captureFile, 10, 900, false, true, 0x04, COMMAND_COMPLETE_EVENT, sizeof(COMMAND_COMPLETE_EVENT));
+    writeCapture(&captureFile);
+
+    assert_int_equal(0, Replayer_open(captureFile.path, REPLAYER_SPEED_MAX));
+    assertNextEvent(ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    assertNextEvent(COMMAND_COMPLETE_EVENT, sizeof(COMMAND_COMPLETE_EVENT));
+    assertEndOfCapture();
+
+    removeCapture(&captureFile);
+}
+
+static void test_Replayer_pcapH4BigEndianNanosecond(void** state) {
+    Capture captureFile = {.size = 0};
+
+    appendPcapHeader(&captureFile, PCAP_MAGIC_NANOSECOND, PCAP_LINKTYPE_H4, true);
+    appendPcapRecord(&captureFile, 10, 0, true, false, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    writeCapture(&captureFile);
+
+    assert_int_equal(0, Replayer_open(captureFile.path, REPLAYER_SPEED_MAX));
+    assert_int_equal(FORMAT_PCAP_H4, format);
+    assert_true(isNanosecond);
+    assertNextEvent(ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    assertEndOfCapture();
+
+    removeCapture(&captureFile);
+}
+
+static void test_Replayer_truncatedRecord(void** state) {
+    Capture captureFile = {.size = 0};
+
+    appendBtsnoopHeader(&captureFile, BTSNOOP_DATALINK_H4);
+    appendBtsnoopRecord(&captureFile, 0x03, 1000, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    appendBtsnoopRecord(&captureFile, 0x03, 2000, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    captureFile.size -= 10;     // Capture interrompue pendant l'ecriture du dernier enregistrement
+    writeCapture(&captureFile);
+
+    assert_int_equal(0, Replayer_open(captureFile.path, REPLAYER_SPEED_MAX));
+    assertNextEvent(ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    assertEndOfCapture();
+    assertEndOfCapture();
+
+    removeCapture(&captureFile);
+}
+
+static void test_Replayer_unknownFormat(void** state) {
+    Capture captureFile = {.size = 0};
+
+    appendBytes(&captureFile, "This is not a capture file", 26);
+    writeCapture(&captureFile);
+
+    assert_int_equal(-1, Replayer_open(captureFile.path, REPLAYER_SPEED_MAX));
+    assertEndOfCapture();
+
+    removeCapture(&captureFile);
+
+    assert_int_equal(-1, Replayer_open("/tmp/geologie_replayer_missing", REPLAYER_SPEED_MAX));
+}
+
+static void test_Replayer_speed(void** state) {
+    Capture captureFile = {.size = 0};
+    struct timespec startTime;
+    struct timespec endTime;
+
+    /* Deux evenements enregistres a 200 ms d'intervalle, rejoues 10 fois plus vite */
+    appendBtsnoopHeader(&captureFile, BTSNOOP_DATALINK_H4);
+    appendBtsnoopRecord(&captureFile, 0x03, 1000000, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    appendBtsnoopRecord(&captureFile, 0x03, 1200000, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    writeCapture(&captureFile);
+
+    assert_int_equal(0, Replayer_open(captureFile.path, 10.0f));
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    assertNextEvent(ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    assertNextEvent(ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    long elapsed = (endTime.tv_sec - startTime.tv_sec) * 1000L + (endTime.tv_nsec - startTime.tv_nsec) / 1000000L;
+    assert_in_range(elapsed, 19, 150);
+
+    removeCapture(&captureFile);
+}
+
+static void test_Replayer_stop(void** state) {
+    Capture captureFile = {.size = 0};
+
+    appendBtsnoopHeader(&captureFile, BTSNOOP_DATALINK_H4);
+    appendBtsnoopRecord(&captureFile, 0x03, 1000, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    appendBtsnoopRecord(&captureFile, 0x03, 2000, 0x04, ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    writeCapture(&captureFile);
+
+    assert_int_equal(0, Replayer_open(captureFile.path, REPLAYER_SPEED_MAX));
+    assertNextEvent(ADVERTISING_EVENT, sizeof(ADVERTISING_EVENT));
+    Replayer_stop();
+    assertEndOfCapture();
+
+    removeCapture(&captureFile);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ensemble des tests a executer.
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_Replayer_btsnoopH4),
+    cmocka_unit_test(test_Replayer_btsnoopHci),
+    cmocka_unit_test(test_Replayer_pcapH4WithPhdr),
+    cmocka_unit_test(test_Replayer_pcapH4BigEndianNanosecond),
+    cmocka_unit_test(test_Replayer_truncatedRecord),
+    cmocka_unit_test(test_Replayer_unknownFormat),
+    cmocka_unit_test(test_Replayer_speed),
+    cmocka_unit_test(test_Replayer_stop),
+};
+
+extern int replayer_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module Replayer", tests, NULL, NULL);
+}
@@ -0,0 +1,263 @@
+/**
+ * @file scanner_test.c
+ *
+ * @brief Ensemble de test pour Scanner.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cmocka.h"
+
+#include "Scanner/scanner.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de balises recues a chaque position de calibration, plus que ne le permettaient 10 positions par balise.
+ */
+#define NB_BEACONS_TEST (120)
+
+/**
+ * @brief Le nombre de balises calibrees du site, plus que n'en contient une trame envoyee a GEOMOBILE.
+ */
+#define NB_BEACONS_SITE (300)
+
+/**
+ * @brief Le coefficient d'attenuation mesure pour chaque balise.
+ */
+#define COEFFICIENT_TEST (2)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de donnees de calibration recues par Geographer a la fin du calcul de moyenne.
+ */
+static uint8_t nbCalibrationDataSent = 0;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Bouchons
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void __wrap_Scanner_transitionFct(MqMsgScanner msg) {
+    __real_Scanner_transitionFct(msg);
+}
+
+void __wrap_ScannerTime_out() {
+    __real_ScannerTime_out();
+}
+
+Watchdog* __wrap_Watchdog_construct(uint32_t delay, WatchdogCallback callback) {
+    return NULL;
+}
+
+void __wrap_Watchdog_start(Watchdog* this) {
+}
+
+void __wrap_Watchdog_destroy(Watchdog* this) {
+}
+
+void Watchdog_setDelay(Watchdog* this, uint32_t delay) {
+}
+
+void Watchdog_cancel(Watchdog* this) {
+}
+
+void __wrap_Receiver_new() {
+}
+
+void __wrap_Receiver_free() {
+}
+
+uint32_t __wrap_Receiver_getBeaconsSignal(BeaconSignal* beaconsSignal, uint32_t nbMaxBeaconsSignal) {
+    return 0;
+}
+
+int8_t __wrap_Receiver_ask4StartReceiver() {
+    return 0;
+}
+
+int8_t __wrap_Receiver_ask4StopReceiver() {
+    return 0;
+}
+
+int8_t __wrap_Bookkeeper_new() {
+    return 0;
+}
+
+int8_t __wrap_Bookkeeper_free() {
+    return 0;
+}
+
+int8_t __wrap_Bookkeeper_askStartBookkeeper() {
+    return 0;
+}
+
+int8_t __wrap_Bookkeeper_askStopBookkeeper() {
+    return 0;
+}
+
+int8_t __wrap_Bookkeeper_ask4CurrentProcessorAndMemoryLoad() {
+    return 0;
+}
+
+AttenuationCoefficient __wrap_Mathematician_getAttenuationCoefficient(const Power* power, const Position* beaconPosition, const CalibrationPosition* calibrationPosition) {
+    return COEFFICIENT_TEST;
+}
+
+AttenuationCoefficient __wrap_Mathematician_getAverageCalcul(const BeaconCoefficients* beaconCoefficients, uint8_t nbCoefficient) {
+    return COEFFICIENT_TEST;
+}
+
+int8_t __wrap_Mathematician_getCurrentPosition(const BeaconData* beaconsData, uint32_t nbBeacon, Position* currentPosition) {
+    return -1;
+}
+
+int8_t __wrap_Geographer_signalEndUpdateAttenuation() {
+    return 0;
+}
+
+int8_t __wrap_Geographer_signalEndAverageCalcul(CalibrationData* calibrationData, uint8_t nbCalibration) {
+    nbCalibrationDataSent = nbCalibration;
+    return 0;
+}
+
+int8_t __wrap_Geographer_dateAndSendData(BeaconData* beaconsData, uint8_t nbBeacons, BeaconStatistics* beaconsStatistics, uint8_t nbBeaconsStatistics, Position* currentPosition, uint64_t captureTime, ProcessorAndMemoryLoad* currentProcessorAndMemoryLoad) {
+    return 0;
+}
+
+int8_t Geographer_sendTrackedPosition(const Position* trackedPosition, uint64_t captureTime) {
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module Scanner.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int scanner_run_tests(void);
+
+static int setUpScanner(void** state);
+static int tearDownScanner(void** state);
+static void receiveBeacons(uint32_t nbBeacons);
+static void calibrate(uint8_t nbPositions);
+
+static void test_Scanner_calibrationAllPositions(void** state);
+static void test_Scanner_calibrationAllBeacons(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int setUpScanner(void** state) {
+    nbCalibrationDataSent = 0;
+    if (BeaconRegistry_new((uint16_t) (intptr_t) *state) < 0) {
+        return -1;
+    }
+    Scanner_new();
+    return beaconsCapacity == 0 ? -1 : 0;
+}
+
+static int tearDownScanner(void** state) {
+    Scanner_free();
+    BeaconRegistry_free();
+    mq_close(descripteur);
+    mq_unlink(BAL);
+    return 0;
+}
+
+static void receiveBeacons(uint32_t nbBeacons) {
+    for (uint32_t i = 0; i < nbBeacons; i++) {
+        beaconsData[i].index = (BeaconIndex) i;
+        beaconsData[i].position.X = (i % 20) * 100;
+        beaconsData[i].position.Y = (i / 20) * 100;
+        beaconsData[i].power = -60;
+    }
+    nbBeaconsAvailable = nbBeacons;
+}
+
+static void calibrate(uint8_t nbPositions) {
+    MqMsgScanner msg = { .event = E_ASK_UPDATE_COEF_FROM_POSITION };
+
+    for (uint8_t id = 0; id < nbPositions; id++) {
+        msg.calibrationPosition.id = id;
+        msg.calibrationPosition.position.X = (id % 5) * 200;
+        msg.calibrationPosition.position.Y = (id / 5) * 200;
+        perform_askCalibrationFromPosition(&msg);
+    }
+}
+
+static void test_Scanner_calibrationAllPositions(void** state) {
+    receiveBeacons(NB_BEACONS_TEST);
+
+    /* Chaque position de Geographer garde le coefficient de toutes les balises */
+    calibrate(NB_CALIBRATION_POSITION);
+    assert_int_equal(NB_CALIBRATION_POSITION * NB_BEACONS_TEST, nbBeaconsCoefficients);
+
+    perform_askCalibrationAverage(NULL);
+    assert_int_equal(0, nbBeaconsCoefficients);
+    assert_int_equal(NB_BEACONS_TEST, nbCalibrationDataSent);
+    for (uint32_t i = 0; i < NB_BEACONS_TEST; i++) {
+        assert_int_equal(i, calibrationData[i].beaconIndex);
+        assert_int_equal(NB_CALIBRATION_POSITION, calibrationData[i].nbCoefficient);
+    }
+}
+
+static void test_Scanner_calibrationAllBeacons(void** state) {
+    receiveBeacons(NB_BEACONS_SITE);
+    calibrate(NB_CALIBRATION_POSITION);
+    perform_askCalibrationAverage(NULL);
+
+    /* Chaque balise a son coefficient moyen, meme au-dela de celles envoyees a Geographer */
+    assert_int_equal(NB_BEACONS_SENT_MAX, nbCalibrationDataSent);
+    for (uint32_t i = 0; i < NB_BEACONS_SITE; i++) {
+        assert_int_equal(NB_CALIBRATION_POSITION, calibrationData[i].nbCoefficient);
+        assert_int_equal(COEFFICIENT_TEST, publishedRangeTables[i]->coefficient);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_prestate_setup_teardown(test_Scanner_calibrationAllPositions, setUpScanner, tearDownScanner, (void*) NB_BEACONS_TEST),
+    cmocka_unit_test_prestate_setup_teardown(test_Scanner_calibrationAllBeacons, setUpScanner, tearDownScanner, (void*) NB_BEACONS_SITE),
+};
+
+extern int scanner_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module Scanner", tests, NULL, NULL);
+}
@@ -0,0 +1,259 @@
+/**
+ * @file simulator_test.c
+ *
+ * @brief Ensemble de test pour Simulator.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <poll.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cmocka.h"
+
+#include "Simulator/simulator.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief La duree de la simulation du test d'emission, en milliseconde.
+ */
+#define SIMULATION_DURATION (300)
+
+/**
+ * @brief Les positions attendues le long du trajet de test.
+ */
+typedef struct {
+    float distance;             /**< La distance parcourue */
+    Position expectedPosition;  /**< La position attendue */
+} ParametersTestTrajectPosition;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le trajet de test, 1500 cm de long.
+ */
+static Position TEST_TRAJECT_POSITIONS[] = {
+    {.X = 300, .Y = 300},
+    {.X = 1300, .Y = 300},
+    {.X = 1300, .Y = 800}
+};
+
+static const ExperimentalTraject TEST_TRAJECT = {.id = 1, .traject = TEST_TRAJECT_POSITIONS, .nbPosition = 3};
+
+static ParametersTestTrajectPosition parametersTestTrajectPosition[] = {
+    {.distance = 0,     .expectedPosition = {.X = 300, .Y = 300}},
+    {.distance = 500,   .expectedPosition = {.X = 800, .Y = 300}},
+    {.distance = 1250,  .expectedPosition = {.X = 1300, .Y = 550}},
+    {.distance = 1500,  .expectedPosition = {.X = 1300, .Y = 800}},
+    {.distance = 1750,  .expectedPosition = {.X = 1300, .Y = 550}},     // Retour
+    {.distance = 2900,  .expectedPosition = {.X = 400, .Y = 300}},
+    {.distance = 3000,  .expectedPosition = {.X = 300, .Y = 300}},
+    {.distance = 3500,  .expectedPosition = {.X = 800, .Y = 300}},      // Nouvel aller
+};
+
+/**
+ * @brief La socket donnee a Receiver par Simulator.
+ */
+static int receiverSocket = -1;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Bouchons
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void __wrap_Receiver_setHciSocket(int socket) {
+    receiverSocket = socket;
+}
+
+const ExperimentalTraject* Geographer_getExperimentalTraject(ExperimentalTrajectId id) {
+    return id == TEST_TRAJECT.id ? &TEST_TRAJECT : NULL;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module Simulator.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int simulator_run_tests(void);
+
+static void test_Simulator_trajectPosition(void** state);
+static void test_Simulator_placeBeacons(void** state);
+static void test_Simulator_invalidConfiguration(void** state);
+static void test_Simulator_advertisingReports(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_Simulator_trajectPosition(void** state) {
+    ParametersTestTrajectPosition* param = (ParametersTestTrajectPosition*) *state;
+    SimulatorConfiguration simulatorConfiguration = {.trajectId = 1, .nbBeacons = 1, .advertisingRate = 1};
+    Position position;
+
+    assert_int_equal(0, Simulator_new(&simulatorConfiguration));
+    assert_float_equal(1500, trajectLength, 0.01);
+
+    getTrajectPosition(param->distance, &position);
+    assert_int_equal(param->expectedPosition.X, position.X);
+    assert_int_equal(param->expectedPosition.Y, position.Y);
+
+    Simulator_free();
+}
+
+static void test_Simulator_placeBeacons(void** state) {
+    SimulatorConfiguration simulatorConfiguration = {.trajectId = 1, .nbBeacons = 9, .advertisingRate = 1};
+
+    assert_int_equal(0, Simulator_new(&simulatorConfiguration));
+
+    /* Grille de 3 x 3 sur la zone [100, 1500] x [100, 1000] */
+    assert_int_equal(100, beacons[0].position.X);
+    assert_int_equal(100, beacons[0].position.Y);
+    assert_int_equal(800, beacons[4].position.X);
+    assert_int_equal(550, beacons[4].position.Y);
+    assert_int_equal(1500, beacons[8].position.X);
+    assert_int_equal(1000, beacons[8].position.Y);
+
+    /* Annonce de la balise 4, "04x00800y00550" */
+    const uint8_t expectedAdvertisingData[ADVERTISING_DATA_LENGTH] = {
+        0x02, 0x01, 0x06, 0x0F, 0x09, '0', '4', 'x', '0', '0', '8', '0', '0', 'y', '0', '0', '5', '5', '0', 0x03, 0x03, 0x1A, 0x18
+    };
+    assert_memory_equal(expectedAdvertisingData, beacons[4].advertisingData, ADVERTISING_DATA_LENGTH);
+
+    Simulator_free();
+}
+
+static void test_Simulator_invalidConfiguration(void** state) {
+    SimulatorConfiguration unknownTraject = {.trajectId = 2, .nbBeacons = 1, .advertisingRate = 1};
+    SimulatorConfiguration noBeacon = {.trajectId = 1, .nbBeacons = 0, .advertisingRate = 1};
+    SimulatorConfiguration noAdvertising = {.trajectId = 1, .nbBeacons = 1, .advertisingRate = 0};
+
+    assert_int_equal(-1, Simulator_new(&unknownTraject));
+    assert_int_equal(-1, Simulator_new(&noBeacon));
+    assert_int_equal(-1, Simulator_new(&noAdvertising));
+}
+
+static void test_Simulator_advertisingReports(void** state) {
+    SimulatorConfiguration simulatorConfiguration = {
+        .trajectId = 1,
+        .speed = 0,
+        .nbBeacons = 60,
+        .advertisingRate = 100,
+        .noise = 0,
+        .attenuationCoefficient = 2,
+        .seed = 42
+    };
+    uint8_t event[HCI_TYPE_LEN + HCI_MAX_EVENT_SIZE];
+    uint32_t nbReports[60] = {0};
+    uint32_t nbReportsTotal = 0;
+    struct pollfd pollFd;
+
+    assert_int_equal(0, Simulator_new(&simulatorConfiguration));
+    assert_true(receiverSocket >= 0);
+    assert_int_equal(0, Simulator_start());
+
+    pollFd.fd = receiverSocket;
+    pollFd.events = POLLIN;
+    while (poll(&pollFd, 1, SIMULATION_DURATION) > 0) {
+        ssize_t size = recv(receiverSocket, event, sizeof(event), 0);
+        assert_true(size > ADVERTISING_EVENT_HEADER_SIZE);
+
+        assert_int_equal(HCI_EVENT_PKT, event[0]);
+        assert_int_equal(EVT_LE_META_EVENT, event[1]);
+        assert_int_equal(size - HCI_TYPE_LEN - HCI_EVENT_HDR_SIZE, event[2]);
+        assert_int_equal(EVT_LE_ADVERTISING_REPORT, event[3]);
+        assert_int_equal(size, ADVERTISING_EVENT_HEADER_SIZE + event[4] * ADVERTISING_REPORT_SIZE);
+
+        for (uint8_t i = 0; i < event[4]; i++) {
+            const BeaconsChannel* report = (const BeaconsChannel*) (event + ADVERTISING_EVENT_HEADER_SIZE + i * ADVERTISING_REPORT_SIZE);
+            uint16_t beaconIndex = report->bdaddr.b[0] | (report->bdaddr.b[1] << 8);
+
+            assert_in_range(beaconIndex, 0, 59);
+            assert_int_equal(ADVERTISING_DATA_LENGTH, report->length);
+            assert_memory_equal(beacons[beaconIndex].advertisingData, report->data, ADVERTISING_DATA_LENGTH);
+
+            /* Sans bruit et a l'arret, le RSSI suit exactement le modele d'attenuation */
+            Power power = Mathematician_getPower(&beacons[beaconIndex].position, &TEST_TRAJECT_POSITIONS[0], &simulatorConfiguration.attenuationCoefficient);
+            assert_int_equal(lroundf(power), (int8_t) report->data[ADVERTISING_DATA_LENGTH]);
+
+            nbReports[beaconIndex]++;
+            nbReportsTotal++;
+        }
+
+        if (nbReportsTotal >= 60 * 20) {
+            break;
+        }
+    }
+
+    assert_int_equal(0, Simulator_stop());
+
+    /* 20 annonces par balise en un peu plus de 200 ms */
+    assert_true(nbReportsTotal >= 60 * 20);
+    for (uint16_t i = 0; i < 60; i++) {
+        assert_in_range(nbReports[i], 15, 30);
+    }
+
+    Position position;
+    Simulator_getTruePosition(&position);
+    assert_int_equal(TEST_TRAJECT_POSITIONS[0].X, position.X);
+    assert_int_equal(TEST_TRAJECT_POSITIONS[0].Y, position.Y);
+
+    Simulator_free();
+    assert_int_equal(-1, receiverSocket);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Ensemble des tests a executer.
+ */
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_prestate(test_Simulator_trajectPosition, &(parametersTestTrajectPosition[0])),
+    cmocka_unit_test_prestate(test_Simulator_trajectPosition, &(parametersTestTrajectPosition[1])),
+    cmocka_unit_test_prestate(test_Simulator_trajectPosition, &(parametersTestTrajectPosition[2])),
+    cmocka_unit_test_prestate(test_Simulator_trajectPosition, &(parametersTestTrajectPosition[3])),
+    cmocka_unit_test_prestate(test_Simulator_trajectPosition, &(parametersTestTrajectPosition[4])),
+    cmocka_unit_test_prestate(test_Simulator_trajectPosition, &(parametersTestTrajectPosition[5])),
+    cmocka_unit_test_prestate(test_Simulator_trajectPosition, &(parametersTestTrajectPosition[6])),
+    cmocka_unit_test_prestate(test_Simulator_trajectPosition, &(parametersTestTrajectPosition[7])),
+    cmocka_unit_test(test_Simulator_placeBeacons),
+    cmocka_unit_test(test_Simulator_invalidConfiguration),
+    cmocka_unit_test(test_Simulator_advertisingReports),
+};
+
+extern int simulator_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module Simulator", tests, NULL, NULL);
+}
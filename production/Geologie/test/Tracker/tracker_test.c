@@ -0,0 +1,279 @@
+/**
+ * @file tracker_test.c
+ *
+ * @brief Ensemble de test pour Tracker.
+ *
+ * @version 2.0
+ * @date 17-10-2026
+ * @copyright Geo-Boot
+ * @license BSD 2-clauses
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Include
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cmocka.h"
+
+#include "Tracker/tracker.c"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Define
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Le nombre de balises aux coins de la piece de test.
+ */
+#define NB_BEACONS_TEST (4)
+
+/**
+ * @brief La duree entre deux annonces simulees, en nanoseconde : chaque balise annonce a 10 Hz.
+ */
+#define ADVERTISEMENT_PERIOD (25000000ULL)
+
+/**
+ * @brief Le coefficient d'attenuation des balises simulees.
+ */
+#define COEFFICIENT_TEST (2)
+
+/**
+ * @brief L'ecart admis sur une position suivie, en centimetre.
+ */
+#define EPSILON_POSITION (10)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Variable et structure extern
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Les balises aux coins d'une piece de 10 m de cote.
+ */
+static const Position BEACONS_POSITION[NB_BEACONS_TEST] = {
+    { .X = 0, .Y = 0 },
+    { .X = 1000, .Y = 0 },
+    { .X = 1000, .Y = 1000 },
+    { .X = 0, .Y = 1000 },
+};
+
+/**
+ * @brief La date de la derniere annonce simulee, en nanoseconde.
+ */
+static uint64_t advertisementTime;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Prototypes de fonctions
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lance la suite de test du module Tracker.
+ *
+ * @return int 0 en cas de succes, le nombre de tests qui ont echoue sinon.
+ */
+extern int tracker_run_tests(void);
+
+static int setUpTracker(void** state);
+static int tearDownTracker(void** state);
+
+static void test_Tracker_notInitialized(void** state);
+static void test_Tracker_stationary(void** state);
+static void test_Tracker_moving(void** state);
+static void test_Tracker_outlierRejected(void** state);
+static void test_Tracker_getStatePredicts(void** state);
+static void test_Tracker_timeout(void** state);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions static
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int setUpTracker(void** state) {
+    Tracker_reset();
+    advertisementTime = 1000000000ULL;
+    return 0;
+}
+
+static int tearDownTracker(void** state) {
+    Tracker_reset();
+    return 0;
+}
+
+/**
+ * @brief Construit l'annonce d'une balise recue sans bruit depuis une position.
+ *
+ * @param beacon L'indice de la balise dans #BEACONS_POSITION.
+ * @param x L'abscisse du robot en centimetre.
+ * @param y L'ordonnee du robot en centimetre.
+ * @param timestamp La date de l'annonce en nanoseconde.
+ * @return BeaconData L'annonce.
+ */
+static BeaconData makeAdvertisement(uint8_t beacon, uint32_t x, uint32_t y, uint64_t timestamp) {
+    const Position position = { .X = x, .Y = y };
+    const AttenuationCoefficient coefficient = COEFFICIENT_TEST;
+    BeaconData beaconData = {
+        .index = beacon,
+        .position = BEACONS_POSITION[beacon],
+        .coefficientAverage = coefficient,
+        .timestamp = timestamp,
+        .rssiVariance = MATHEMATICIAN_RSSI_VARIANCE_MIN,
+    };
+
+    beaconData.power = Mathematician_getPower(&BEACONS_POSITION[beacon], &position, &coefficient);
+    return beaconData;
+}
+
+/**
+ * @brief Simule les annonces des balises, chacune a son tour, depuis une position fixe.
+ *
+ * @return Le nombre d'annonces acceptees.
+ */
+static uint32_t runAdvertisements(uint32_t nbAdvertisements, uint32_t x, uint32_t y) {
+    uint32_t nbAccepted = 0;
+
+    for (uint32_t i = 0; i < nbAdvertisements; i++) {
+        advertisementTime += ADVERTISEMENT_PERIOD;
+        BeaconData beaconData = makeAdvertisement((advertisementTime / ADVERTISEMENT_PERIOD) % NB_BEACONS_TEST, x, y, advertisementTime);
+        if (Tracker_updateRange(&beaconData) == 0) {
+            nbAccepted++;
+        }
+    }
+    return nbAccepted;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions de test
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void test_Tracker_notInitialized(void** state) {
+    TrackerState trackerState;
+    BeaconData beaconData = makeAdvertisement(0, 500, 500, advertisementTime);
+
+    /* Sans position de depart, les distances ne suffisent pas */
+    assert_int_equal(-1, Tracker_updateRange(&beaconData));
+    assert_int_equal(-1, Tracker_getState(advertisementTime, &trackerState));
+}
+
+static void test_Tracker_stationary(void** state) {
+    const Position start = { .X = 450, .Y = 560 };
+    TrackerState trackerState;
+
+    assert_true(Tracker_setPosition(&start, advertisementTime));
+    assert_int_equal(200, runAdvertisements(200, 500, 500));
+
+    assert_int_equal(0, Tracker_getState(advertisementTime, &trackerState));
+    assert_int_equal(500, trackerState.position.X);
+    assert_int_equal(500, trackerState.position.Y);
+    assert_float_equal(0, trackerState.speedX, 5);
+    assert_float_equal(0, trackerState.speedY, 5);
+    assert_true(trackerState.positionVariance < TRACKER_POSITION_VARIANCE_INITIAL);
+    assert_true(trackerState.timestamp == advertisementTime);
+}
+
+static void test_Tracker_moving(void** state) {
+    const Position start = { .X = 200, .Y = 500 };
+    TrackerState trackerState;
+    uint32_t x = 200;
+
+    assert_true(Tracker_setPosition(&start, advertisementTime));
+
+    /* 1 cm toutes les 25 ms : 40 cm/s vers les X croissants, pendant 10 s */
+    for (uint32_t i = 0; i < 400; i++) {
+        x++;
+        runAdvertisements(1, x, 500);
+    }
+
+    assert_int_equal(0, Tracker_getState(advertisementTime, &trackerState));
+    assert_in_range(trackerState.position.X, x - EPSILON_POSITION, x + EPSILON_POSITION);
+    assert_in_range(trackerState.position.Y, 500 - EPSILON_POSITION, 500 + EPSILON_POSITION);
+    assert_float_equal(40, trackerState.speedX, 5);
+    assert_float_equal(0, trackerState.speedY, 5);
+}
+
+static void test_Tracker_outlierRejected(void** state) {
+    const Position start = { .X = 500, .Y = 500 };
+    TrackerState before;
+    TrackerState after;
+
+    Tracker_setPosition(&start, advertisementTime);
+    runAdvertisements(200, 500, 500);
+    Tracker_getState(advertisementTime, &before);
+
+    /* Une annonce qui place le robot a 3 m de sa position est rejetee sans deplacer l'etat */
+    BeaconData outlier = makeAdvertisement(0, 800, 800, advertisementTime);
+    assert_int_equal(-1, Tracker_updateRange(&outlier));
+
+    Tracker_getState(advertisementTime, &after);
+    assert_int_equal(before.position.X, after.position.X);
+    assert_int_equal(before.position.Y, after.position.Y);
+}
+
+static void test_Tracker_getStatePredicts(void** state) {
+    const Position start = { .X = 200, .Y = 500 };
+    TrackerState trackerState;
+    uint32_t x = 200;
+
+    Tracker_setPosition(&start, advertisementTime);
+    for (uint32_t i = 0; i < 400; i++) {
+        x++;
+        runAdvertisements(1, x, 500);
+    }
+
+    /* Une demi-seconde sans annonce : la position est predite avec la vitesse, l'etat suivi ne change pas */
+    assert_int_equal(0, Tracker_getState(advertisementTime + 500000000ULL, &trackerState));
+    assert_in_range(trackerState.position.X, x + 20 - EPSILON_POSITION, x + 20 + EPSILON_POSITION);
+    assert_true(trackerState.timestamp == advertisementTime);
+    assert_true(stateTime == advertisementTime);
+}
+
+static void test_Tracker_timeout(void** state) {
+    const Position start = { .X = 500, .Y = 500 };
+    const Position moved = { .X = 200, .Y = 300 };
+    TrackerState trackerState;
+
+    Tracker_setPosition(&start, advertisementTime);
+    runAdvertisements(40, 500, 500);
+
+    /* Le filtre suit des annonces : la position de Mathematician ne le remplace pas */
+    assert_false(Tracker_setPosition(&moved, advertisementTime));
+
+    /* Sans annonce acceptee pendant TRACKER_TIMEOUT, il repart de la position donnee */
+    advertisementTime += (uint64_t) (TRACKER_TIMEOUT + 1) * 1000000ULL;
+    assert_true(Tracker_setPosition(&moved, advertisementTime));
+    assert_int_equal(0, Tracker_getState(advertisementTime, &trackerState));
+    assert_int_equal(200, trackerState.position.X);
+    assert_int_equal(300, trackerState.position.Y);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//                                              Fonctions publiques
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(test_Tracker_notInitialized, setUpTracker, tearDownTracker),
+    cmocka_unit_test_setup_teardown(test_Tracker_stationary, setUpTracker, tearDownTracker),
+    cmocka_unit_test_setup_teardown(test_Tracker_moving, setUpTracker, tearDownTracker),
+    cmocka_unit_test_setup_teardown(test_Tracker_outlierRejected, setUpTracker, tearDownTracker),
+    cmocka_unit_test_setup_teardown(test_Tracker_getStatePredicts, setUpTracker, tearDownTracker),
+    cmocka_unit_test_setup_teardown(test_Tracker_timeout, setUpTracker, tearDownTracker),
+};
+
+extern int tracker_run_tests(void) {
+    return cmocka_run_group_tests_name("Test of the module Tracker", tests, NULL, NULL);
+}
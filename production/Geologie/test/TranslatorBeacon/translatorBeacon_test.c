@@ -21,6 +21,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "cmocka.h"
 
@@ -37,6 +38,11 @@
  */
 #define SIZE_TRAME (24)
 
+/**
+ * @brief Le modele du chemin du fichier des balises tierces ecrit par les tests.
+ */
+#define THIRD_PARTY_PATH_TEMPLATE "/tmp/geologie_beacons_XXXXXX"
+
 /**
  * @brief Structure passee au fonction test.
  */
@@ -149,6 +155,54 @@ int32_t tearDown(void** state);
  */
 void test_translateChannelToBeaconsSignal(void** state);
 
+/**
+ * @brief Fonction test de #TranslatorBeacon_translateExtendedChannelToBeaconsSignal.
+ *
+ * @param state Les donnees #TestData passe au test.
+ */
+void test_translateExtendedChannelToBeaconsSignal(void** state);
+
+/**
+ * @brief Teste la lecture de structures AD dans un autre ordre, avec la puissance d'emission.
+ *
+ * @param state Parametre passe pour mettre en place les tests, ici ignore.
+ */
+void test_translateReorderedAdvertisingData(void** state);
+
+/**
+ * @brief Teste que les annonces sans nom de balise valide sont ecartees.
+ *
+ * @param state Parametre passe pour mettre en place les tests, ici ignore.
+ */
+void test_translateMalformedAdvertisingData(void** state);
+
+/**
+ * @brief Fonction test de #TranslatorBeacon_translateReports.
+ *
+ * @param state Parametre passe pour mettre en place les tests, ici ignore.
+ */
+void test_translateReports(void** state);
+
+/**
+ * @brief Teste la lecture des donnees constructeur compactes et le retour au nom quand elles ne sont pas reconnues.
+ *
+ * @param state Parametre passe pour mettre en place les tests, ici ignore.
+ */
+void test_translateCompactAdvertisingData(void** state);
+
+/**
+ * @brief Teste la lecture des iBeacon et des Eddystone-UID des balises tierces chargees depuis un fichier.
+ *
+ * @param state Parametre passe pour mettre en place les tests, ici ignore.
+ */
+void test_translateThirdPartyAdvertisingData(void** state);
+
+/**
+ * @brief Teste le refus des fichiers de balises tierces invalides.
+ *
+ * @param state Parametre passe pour mettre en place les tests, ici ignore.
+ */
+void test_loadInvalidThirdPartyBeacons(void** state);
 
 /**
  * @brief Suite de test de la conversion des tableau d'octet e, structure.
@@ -157,6 +211,14 @@ static const struct CMUnitTest tests[] = {
     cmocka_unit_test_prestate(test_translateChannelToBeaconsSignal, &(parametersTestData[0])),
     cmocka_unit_test_prestate(test_translateChannelToBeaconsSignal, &(parametersTestData[1])),
     cmocka_unit_test_prestate(test_translateChannelToBeaconsSignal, &(parametersTestData[2])),
+    cmocka_unit_test_prestate(test_translateExtendedChannelToBeaconsSignal, &(parametersTestData[0])),
+    cmocka_unit_test_prestate(test_translateExtendedChannelToBeaconsSignal, &(parametersTestData[1])),
+    cmocka_unit_test(test_translateReorderedAdvertisingData),
+    cmocka_unit_test(test_translateMalformedAdvertisingData),
+    cmocka_unit_test(test_translateReports),
+    cmocka_unit_test(test_translateCompactAdvertisingData),
+    cmocka_unit_test(test_translateThirdPartyAdvertisingData),
+    cmocka_unit_test(test_loadInvalidThirdPartyBeacons),
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -173,6 +235,25 @@ int32_t tearDown(void** state) {
     return TranslatorBeacon_free();
 }
 
+/**
+ * @brief Ecrit un fichier de balises tierces temporaire et le charge.
+ *
+ * @return Le retour de #TranslatorBeacon_loadThirdPartyBeacons.
+ */
+static int8_t loadThirdPartyBeaconsForTest(const char* content) {
+    char path[] = THIRD_PARTY_PATH_TEMPLATE;
+    int fd = mkstemp(path);
+    int8_t returnError;
+
+    assert_true(fd >= 0);
+    assert_int_equal(strlen(content), write(fd, content, strlen(content)));
+    close(fd);
+
+    returnError = TranslatorBeacon_loadThirdPartyBeacons(path);
+    unlink(path);
+    return returnError;
+}
+
 int32_t translatorBeacon_run_tests() {
     return cmocka_run_group_tests_name("Test of TranslatorBeacon_translateChannelToBeaconsSignal", tests, setUp, tearDown);
 }
@@ -183,11 +264,13 @@ void test_translateChannelToBeaconsSignal(void** state) {
     BeaconSignal* expectedResult = &(param->resultExpected);
     BeaconSignal currentResult;
 
-    BeaconsChannel inputData;
-    inputData.length = SIZE_TRAME;
-    memcpy(inputData.data, param->inputData, SIZE_TRAME);
+    /* Comme dans un LE advertising report, le RSSI (dernier octet de la trame) suit les donnees */
+    uint8_t inputBuffer[LE_ADVERTISING_INFO_SIZE + SIZE_TRAME];
+    BeaconsChannel* inputData = (BeaconsChannel*) inputBuffer;
+    inputData->length = SIZE_TRAME - 1;
+    memcpy(inputData->data, param->inputData, SIZE_TRAME);
 
-    currentResult = TranslatorBeacon_translateChannelToBeaconsSignal(&inputData);
+    currentResult = TranslatorBeacon_translateChannelToBeaconsSignal(inputData);
 
     /* Beacon ID */
     assert_string_equal(expectedResult->name, currentResult.name);
@@ -202,3 +285,284 @@ void test_translateChannelToBeaconsSignal(void** state) {
     /* RSSI */
     assert_int_equal(expectedResult->rssi, currentResult.rssi);
 }
+
+void test_translateExtendedChannelToBeaconsSignal(void** state) {
+    TestData* param = (TestData*) *state;
+
+    BeaconSignal* expectedResult = &(param->resultExpected);
+    BeaconSignal currentResult;
+
+    /* Comme dans un LE extended advertising report, le RSSI et la puissance d'emission precedent les donnees */
+    uint8_t inputBuffer[BEACONS_EXTENDED_CHANNEL_SIZE + SIZE_TRAME];
+    BeaconsExtendedChannel* inputData = (BeaconsExtendedChannel*) inputBuffer;
+    memset(inputBuffer, 0, sizeof(inputBuffer));
+    inputData->rssi = expectedResult->rssi;
+    inputData->txPower = -4;
+    inputData->length = SIZE_TRAME - 1;
+    memcpy(inputData->data, param->inputData, SIZE_TRAME - 1);
+
+    currentResult = TranslatorBeacon_translateExtendedChannelToBeaconsSignal(inputData);
+
+    /* Beacon ID */
+    assert_string_equal(expectedResult->name, currentResult.name);
+
+    /* Beacon Position */
+    assert_int_equal(expectedResult->position.X, currentResult.position.X);
+    assert_int_equal(expectedResult->position.Y, currentResult.position.Y);
+
+    /* UUID */
+    assert_memory_equal(expectedResult->uuid, currentResult.uuid, DEVICE_UUID_LENGTH);
+
+    /* RSSI et puissance d'emission */
+    assert_int_equal(expectedResult->rssi, currentResult.rssi);
+    assert_int_equal(-4, currentResult.txPower);
+}
+
+/**
+ * @brief Traduit des donnees d'annonce placees dans un LE advertising report, suivies du RSSI -60.
+ */
+static BeaconSignal translateAdvertisingDataForTest(const uint8_t* advertisingData, uint8_t length) {
+    uint8_t inputBuffer[LE_ADVERTISING_INFO_SIZE + HCI_MAX_EVENT_SIZE];
+    BeaconsChannel* inputData = (BeaconsChannel*) inputBuffer;
+
+    inputData->length = length;
+    memcpy(inputData->data, advertisingData, length);
+    inputData->data[length] = (uint8_t) -60;
+
+    return TranslatorBeacon_translateChannelToBeaconsSignal(inputData);
+}
+
+void test_translateReorderedAdvertisingData(void** state) {
+    const uint8_t advertisingData[] = {
+        0x03, 0x03, 0x1A, 0x18,                         // UUID
+        0x02, 0x0A, 0xF4,                               // Puissance d'emission -12 dBm
+        0x02, 0x01, 0x06,                               // Flags
+        0x0F, 0x08, 'b', '7', 'x', '0', '1', '2', '3', '4', 'y', '0', '0', '0', '4', '2'    // Nom abrege
+    };
+
+    BeaconSignal currentResult = translateAdvertisingDataForTest(advertisingData, sizeof(advertisingData));
+
+    assert_string_equal("b7", currentResult.name);
+    assert_int_equal(1234, currentResult.position.X);
+    assert_int_equal(42, currentResult.position.Y);
+    assert_int_equal(0x1A, currentResult.uuid[0]);
+    assert_int_equal(0x18, currentResult.uuid[1]);
+    assert_int_equal(-12, currentResult.txPower);
+    assert_int_equal(-60, currentResult.rssi);
+}
+
+void test_translateMalformedAdvertisingData(void** state) {
+    uint8_t advertisingData[] = {
+        0x02, 0x01, 0x06,
+        0x0F, 0x09, 'b', '1', 'x', '0', '0', '5', '5', '0', 'y', '0', '0', '2', '0', '0',
+        0x03, 0x03, 0x1A, 0x18
+    };
+    BeaconSignal currentResult;
+
+    /* Sans puissance d'emission annoncee */
+    currentResult = translateAdvertisingDataForTest(advertisingData, sizeof(advertisingData));
+    assert_int_equal(0x1A, currentResult.uuid[0]);
+    assert_int_equal(BEACON_TX_POWER_UNKNOWN, currentResult.txPower);
+
+    /* Une position qui n'est pas en chiffres */
+    advertisingData[10] = 'z';
+    currentResult = translateAdvertisingDataForTest(advertisingData, sizeof(advertisingData));
+    assert_int_equal(0, currentResult.uuid[0]);
+    assert_int_equal(0, currentResult.uuid[1]);
+    advertisingData[10] = '5';
+
+    /* Un identifiant avec un octet nul, trouve par translatorBeacon_fuzz */
+    advertisingData[6] = '\0';
+    currentResult = translateAdvertisingDataForTest(advertisingData, sizeof(advertisingData));
+    assert_int_equal(0, currentResult.uuid[0]);
+    advertisingData[6] = '1';
+
+    /* Un nom dont la longueur depasse les donnees n'est pas lu */
+    currentResult = translateAdvertisingDataForTest(advertisingData, 10);
+    assert_string_equal("", currentResult.name);
+    assert_int_equal(0, currentResult.uuid[0]);
+
+    /* Une structure de longueur nulle termine les donnees */
+    advertisingData[3] = 0x00;
+    currentResult = translateAdvertisingDataForTest(advertisingData, sizeof(advertisingData));
+    assert_int_equal(0, currentResult.uuid[0]);
+}
+
+void test_translateReports(void** state) {
+    /* Les rapports d'un LE advertising report : la balise b1, un telephone, puis la balise b2 */
+    const uint8_t reports[] = {
+        0x00, 0x01, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x17,
+        0x02, 0x01, 0x06, 0x0F, 0x09, 'b', '1', 'x', '0', '0', '5', '5', '0', 'y', '0', '0', '2', '0', '0', 0x03, 0x03, 0x1A, 0x18,
+        0xBA,
+        0x00, 0x01, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0xBB, 0x03,
+        0x02, 0x01, 0x06,
+        0xC4,
+        0x00, 0x01, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x1A,
+        0x02, 0x01, 0x06, 0x02, 0x0A, 0x04, 0x0F, 0x09, 'b', '2', 'x', '0', '1', '0', '0', '0', 'y', '0', '0', '0', '0', '7', 0x03, 0x03, 0x1A, 0x18,
+        0xB0
+    };
+    uint8_t names[2][SIZE_BEACON_ID];
+    uint16_t uuids[2];
+    int8_t rssis[2];
+    int8_t txPowers[2];
+    uint16_t sequences[2];
+    Position positions[2];
+    BeaconsSignalBatch batch = { .name = names, .uuid = uuids, .rssi = rssis, .txPower = txPowers, .sequence = sequences, .position = positions, .capacity = 2 };
+    uint16_t consumedSize;
+
+    /* Le lot est plein apres deux rapports, le suivant est traduit en reprenant apres la taille consommee */
+    assert_int_equal(2, TranslatorBeacon_translateReports(reports, sizeof(reports), 3, false, &batch, &consumedSize));
+    assert_int_equal(2, batch.nbSignals);
+    assert_int_equal(2 * LE_ADVERTISING_INFO_SIZE + 23 + 3 + 2, consumedSize);
+    assert_string_equal("b1", names[0]);
+    assert_int_equal(0x181A, uuids[0]);
+    assert_int_equal(-70, rssis[0]);
+    assert_int_equal(550, positions[0].X);
+    assert_int_equal(200, positions[0].Y);
+    assert_int_equal(0, uuids[1]);
+    assert_int_equal(-60, rssis[1]);
+    assert_int_equal(BEACON_SEQUENCE_UNKNOWN, sequences[0]);
+
+    assert_int_equal(1, TranslatorBeacon_translateReports(reports + consumedSize, sizeof(reports) - consumedSize, 1, false, &batch, NULL));
+    assert_string_equal("b2", names[0]);
+    assert_int_equal(0x181A, uuids[0]);
+    assert_int_equal(4, txPowers[0]);
+    assert_int_equal(-80, rssis[0]);
+    assert_int_equal(1000, positions[0].X);
+    assert_int_equal(7, positions[0].Y);
+
+    /* Un rapport tronque arrete la traduction */
+    assert_int_equal(0, TranslatorBeacon_translateReports(reports + consumedSize, sizeof(reports) - consumedSize - 1, 1, false, &batch, &consumedSize));
+    assert_int_equal(0, batch.nbSignals);
+    assert_int_equal(0, consumedSize);
+}
+
+void test_translateCompactAdvertisingData(void** state) {
+    uint8_t advertisingData[] = {
+        0x02, 0x01, 0x06,
+        0x0C, 0xFF, 0xFF, 0xFF, 0x01, 'b', '3', 0x30, 0x75, 0x40, 0x9C, 0xC4, 0x2A,    // b3 en (30000, 40000), -60 dBm, sequence 42
+        0x03, 0x03, 0x1A, 0x18,
+        0x0F, 0x09, 'b', '1', 'x', '0', '0', '5', '5', '0', 'y', '0', '0', '2', '0', '0'
+    };
+    const uint8_t shortAdvertisingData[] = {
+        0x0B, 0xFF, 0xFF, 0xFF, 0x01, 'b', '3', 0x30, 0x75, 0x40, 0x9C, 0xC4,
+        0x03, 0x03, 0x1A, 0x18
+    };
+    BeaconSignal currentResult;
+
+    /* Les donnees compactes priment sur le nom */
+    currentResult = translateAdvertisingDataForTest(advertisingData, sizeof(advertisingData));
+    assert_string_equal("b3", currentResult.name);
+    assert_int_equal(30000, currentResult.position.X);
+    assert_int_equal(40000, currentResult.position.Y);
+    assert_int_equal(-60, currentResult.txPower);
+    assert_int_equal(42, currentResult.sequence);
+    assert_int_equal(0x1A, currentResult.uuid[0]);
+    assert_int_equal(0x18, currentResult.uuid[1]);
+
+    /* Sans le nom, les donnees compactes suffisent */
+    currentResult = translateAdvertisingDataForTest(advertisingData, 20);
+    assert_string_equal("b3", currentResult.name);
+    assert_int_equal(0x1A, currentResult.uuid[0]);
+
+    /* Une autre societe ou une autre version : retour au nom */
+    advertisingData[5] = 0x4C;
+    currentResult = translateAdvertisingDataForTest(advertisingData, sizeof(advertisingData));
+    assert_string_equal("b1", currentResult.name);
+    assert_int_equal(550, currentResult.position.X);
+    assert_int_equal(BEACON_TX_POWER_UNKNOWN, currentResult.txPower);
+    assert_int_equal(BEACON_SEQUENCE_UNKNOWN, currentResult.sequence);
+    advertisingData[5] = 0xFF;
+    advertisingData[7] = 0x02;
+    currentResult = translateAdvertisingDataForTest(advertisingData, sizeof(advertisingData));
+    assert_string_equal("b1", currentResult.name);
+
+    /* Des donnees compactes trop courtes ne sont pas celles d'une balise */
+    currentResult = translateAdvertisingDataForTest(shortAdvertisingData, sizeof(shortAdvertisingData));
+    assert_string_equal("", currentResult.name);
+    assert_int_equal(0, currentResult.uuid[0]);
+    assert_int_equal(BEACON_SEQUENCE_UNKNOWN, currentResult.sequence);
+}
+
+void test_translateThirdPartyAdvertisingData(void** state) {
+    uint8_t iBeaconData[] = {
+        0x02, 0x01, 0x06,
+        0x1A, 0xFF, 0x4C, 0x00, 0x02, 0x15,
+        0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB, 0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0,    // UUID
+        0x00, 0x01, 0x01, 0x02,     // Major 1, minor 258
+        0xC5                        // -59 dBm a 1 m
+    };
+    uint8_t eddystoneData[] = {
+        0x02, 0x01, 0x06,
+        0x03, 0x03, 0xAA, 0xFE,
+        0x17, 0x16, 0xAA, 0xFE, 0x00, 0xEE,
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99,     // Espace de noms
+        0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF,                             // Instance
+        0x00, 0x00
+    };
+    BeaconSignal currentResult;
+
+    assert_int_equal(0, loadThirdPartyBeaconsForTest(
+        "# Balises du commerce\n"
+        "ibeacon E2C56DB5-DFFB-48D2-B060-D0F5A71096E0 1 258 i1 1000 2000\n"
+        "\n"
+        "eddystone 00112233445566778899 aabbccddeeff e1 3000 500\n"));
+
+    currentResult = translateAdvertisingDataForTest(iBeaconData, sizeof(iBeaconData));
+    assert_string_equal("i1", currentResult.name);
+    assert_int_equal(1000, currentResult.position.X);
+    assert_int_equal(2000, currentResult.position.Y);
+    assert_int_equal(-59, currentResult.txPower);
+    assert_int_equal(BEACON_SEQUENCE_UNKNOWN, currentResult.sequence);
+    assert_int_equal(BEACONS_UUID & 0xFF, currentResult.uuid[0]);
+    assert_int_equal(BEACONS_UUID >> 8, currentResult.uuid[1]);
+
+    currentResult = translateAdvertisingDataForTest(eddystoneData, sizeof(eddystoneData));
+    assert_string_equal("e1", currentResult.name);
+    assert_int_equal(3000, currentResult.position.X);
+    assert_int_equal(500, currentResult.position.Y);
+    assert_int_equal(-18, currentResult.txPower);
+    assert_int_equal(BEACONS_UUID & 0xFF, currentResult.uuid[0]);
+
+    /* Un autre minor, une autre instance ou une trame Eddystone sans identifiant : balise inconnue */
+    iBeaconData[28] = 0x03;
+    currentResult = translateAdvertisingDataForTest(iBeaconData, sizeof(iBeaconData));
+    assert_int_equal(0, currentResult.uuid[0]);
+    assert_string_equal("", currentResult.name);
+    eddystoneData[28] = 0x00;
+    currentResult = translateAdvertisingDataForTest(eddystoneData, sizeof(eddystoneData));
+    assert_int_equal(0, currentResult.uuid[0]);
+    eddystoneData[28] = 0xFF;
+    eddystoneData[11] = 0x10;
+    currentResult = translateAdvertisingDataForTest(eddystoneData, sizeof(eddystoneData));
+    assert_int_equal(0, currentResult.uuid[0]);
+
+    /* Les balises enregistrees sont oubliees a la liberation */
+    eddystoneData[11] = 0x00;
+    TranslatorBeacon_free();
+    currentResult = translateAdvertisingDataForTest(eddystoneData, sizeof(eddystoneData));
+    assert_int_equal(0, currentResult.uuid[0]);
+}
+
+void test_loadInvalidThirdPartyBeacons(void** state) {
+    ThirdPartyBeacon thirdPartyBeacon = { .format = TRANSLATOR_BEACON_EDDYSTONE, .name = "e1" };
+
+    assert_int_equal(-1, TranslatorBeacon_loadThirdPartyBeacons("/tmp/geologie_beacons_missing"));
+    assert_int_equal(-1, loadThirdPartyBeaconsForTest("altbeacon 0011 e1 0 0\n"));
+    assert_int_equal(-1, loadThirdPartyBeaconsForTest("eddystone 0011223344556677889 aabbccddeeff e1 0 0\n"));
+    assert_int_equal(-1, loadThirdPartyBeaconsForTest("ibeacon E2C56DB5-DFFB-48D2-B060-D0F5A71096E0 1 2 i1 1000\n"));
+
+    /* Une balise deja enregistree */
+    assert_int_equal(0, TranslatorBeacon_addThirdPartyBeacon(&thirdPartyBeacon));
+    assert_int_equal(-1, TranslatorBeacon_addThirdPartyBeacon(&thirdPartyBeacon));
+
+    /* Le registre plein */
+    for (uint8_t i = 1; i < TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY; i++) {
+        thirdPartyBeacon.identifier[0] = i;
+        assert_int_equal(0, TranslatorBeacon_addThirdPartyBeacon(&thirdPartyBeacon));
+    }
+    thirdPartyBeacon.identifier[0] = TRANSLATOR_BEACON_NB_MAX_THIRD_PARTY;
+    assert_int_equal(-1, TranslatorBeacon_addThirdPartyBeacon(&thirdPartyBeacon));
+
+    TranslatorBeacon_free();
+}
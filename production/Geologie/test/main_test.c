@@ -3,14 +3,16 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
+#include <string.h>
 #include "../src/tools.h"
+#include "../src/Receiver/receiver.h"
 
 #include "cmocka.h"
 
 /**
  * @brief Nombre de suites de tests a excuter.
  */
-#define NB_SUITE_TESTS (3)
+#define NB_SUITE_TESTS (13)
 
 /**
  * @brief Fonction lançant la suite des tests pour TranslatorLOG.
@@ -33,13 +35,93 @@ extern int32_t translatorBeacon_run_tests(void);
  */
 extern int mathematician_run_tests();
 
+/**
+ * @brief Lance la suite de test du module Replayer.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int replayer_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module Simulator.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int simulator_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module Receiver.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int receiver_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module FilterBank.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int filterBank_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module BeaconRegistry.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int beaconRegistry_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module Regulator.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int regulator_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module Tracker.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int tracker_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module ParticleFilter.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int particleFilter_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module Fingerprint.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int fingerprint_run_tests(void);
+
+/**
+ * @brief Lance la suite de test du module Scanner.
+ *
+ * @return 0 en cas de succees ou le nombre de tests qui ont echoue.
+ */
+extern int scanner_run_tests(void);
+
 /**
  * @brief Liste des suites de tests a excuter.
  */
 static int32_t (*suite_tests[])(void) = {
     translatorBeacon_run_tests,
     translatorLOG_run_tests,
-    mathematician_run_tests
+    mathematician_run_tests,
+    replayer_run_tests,
+    simulator_run_tests,
+    receiver_run_tests,
+    filterBank_run_tests,
+    beaconRegistry_run_tests,
+    regulator_run_tests,
+    tracker_run_tests,
+    particleFilter_run_tests,
+    fingerprint_run_tests,
+    scanner_run_tests
 };
 
 /**
@@ -48,6 +130,11 @@ static int32_t (*suite_tests[])(void) = {
  * @retval int32_t 0.
  */
 int32_t main(int argc, char* argv[]) {
+    /* Le processus de scan teste par Receiver est lance sur l'executable de test */
+    if (argc > 1 && strcmp(argv[1], RECEIVER_SCAN_PROCESS_ARGUMENT) == 0) {
+        return Receiver_runScanProcess(argc, argv);
+    }
+
     for (int i = 0; i < NB_SUITE_TESTS; i++) {
         suite_tests[i]();
     }